@@ -112,6 +112,21 @@ typedef struct { int64_t h; uint64_t l; } __int128_t;
 // Dependencies
 //
 
+// THREADZ uses the LOCKLESS memory model: R/M/W cycles lock individual
+// words rather than taking a global memory lock
+#ifdef THREADZ
+#ifndef LOCKLESS
+#define LOCKLESS
+#endif
+#endif
+
+// THREADZ runs payload channel connects on a pool of IOM worker threads
+// rather than on the CPU that did the CIOC
+#if defined(THREADZ) && !defined(IO_THREADZ) && \
+    !defined(IO_ASYNC_PAYLOAD_CHAN) && !defined(IO_ASYNC_PAYLOAD_CHAN_THREAD)
+#define IOM_ASYNC
+#endif
+
 // ISOLTS requires multiple CPU support
 #ifdef ISOLTS
 #if !defined(ROUND_ROBIN) && !defined(LOCKLESS)
@@ -164,6 +179,36 @@ typedef struct { int64_t h; uint64_t l; } __int128_t;
 // Instruction profiler
 // #define MATRIX
 
+// Sampling profiler (profile/profile_show commands)
+#define PROFILER
+
+// Binary instruction trace (btrace/nobtrace commands)
+#define BTRACE
+
+// Decoded instruction cache
+#define DECODE_CACHE
+
+// Appending unit translation cache
+#define APU_TLB
+
+// Disk I/O with pread/pwrite on the image descriptor instead of
+// fseek/fread/fflush on the shared FILE
+#ifndef __MINGW64__
+#define DISK_PIO
+#endif
+
+// Disk units with the ASYNC flag run their transfers on a worker thread
+// per unit and send the terminate interrupt when the host I/O completes
+#if defined(DISK_PIO) && !defined(NO_EV_POLL) && !defined(IO_THREADZ)
+#define DISK_ASYNC
+#endif
+
+// Dispatch instructions through a table of case labels (GCC "labels as
+// values") rather than the doInstruction switch
+#ifdef __GNUC__
+#define THREADED_DISPATCH
+#endif
+
 // Run TR on work done, not wall clock.
 // Define one of these; tied to memory access (MEM) or to instruction 
 // execution (EXEC)
@@ -602,12 +647,15 @@ typedef enum
 #ifdef __GNUC__
 #define NO_RETURN   __attribute__ ((noreturn))
 #define UNUSED      __attribute__ ((unused))
+#define NO_INLINE   __attribute__ ((noinline))
 #elif defined (__MINGW64__)
 #define NO_RETURN   __attribute__ ((noreturn))
 #define UNUSED      __attribute__ ((unused))
+#define NO_INLINE   __attribute__ ((noinline))
 #else
 #define NO_RETURN
 #define UNUSED
+#define NO_INLINE
 #endif
 
 #define MAX_DEV_NAME_LEN 64
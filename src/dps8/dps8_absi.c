@@ -30,14 +30,21 @@
 #include "dps8_utils.h"
 
 #include "udplib.h"
+#if defined(THREADZ) || defined(LOCKLESS)
+#include "threadz.h"
+#endif
 
 #define DBG_CTR 1
 
 static struct absi_state
   {
     int link;
+    // The event loop's watch of the link's socket
+    uv_poll_t * poll;
   } absi_state [N_ABSI_UNITS_MAX];
 
+static void absi_poll_cb (uv_poll_t * handle, int status, int events);
+
 #define N_ABSI_UNITS 1 // default
 
 #define UNIT_FLAGS ( UNIT_FIX | UNIT_ATTABLE | UNIT_ROABLE | UNIT_DISABLE | \
@@ -138,11 +145,32 @@ static t_stat absiAttach (UNIT * uptr, const char * cptr)
         return ret;
       }
 
+    // Process packets as they arrive
+    absi_state[unitno].poll = malloc (sizeof (uv_poll_t));
+    if (absi_state[unitno].poll)
+      {
+#if defined(THREADZ) || defined(LOCKLESS)
+        lock_libuv ();
+#endif
+        uv_poll_init (uv_default_loop (), absi_state[unitno].poll,
+                      udp_get_socket (absi_state[unitno].link));
+        absi_state[unitno].poll->data = (void *) (intptr_t) unitno;
+        uv_poll_start (absi_state[unitno].poll, UV_READABLE, absi_poll_cb);
+#if defined(THREADZ) || defined(LOCKLESS)
+        unlock_libuv ();
+#endif
+      }
+
     uptr->flags |= UNIT_ATT;
     uptr->filename = pfn;
     return SCPE_OK;
   }
 
+static void absi_poll_close_cb (uv_handle_t * handle)
+  {
+    free (handle);
+  }
+
 // Detach (connect) ...
 static t_stat absiDetach (UNIT * uptr)
   {
@@ -153,6 +181,19 @@ static t_stat absiDetach (UNIT * uptr)
     if (absi_state[unitno].link == NOLINK)
       return SCPE_OK;
 
+    if (absi_state[unitno].poll)
+      {
+#if defined(THREADZ) || defined(LOCKLESS)
+        lock_libuv ();
+#endif
+        uv_poll_stop (absi_state[unitno].poll);
+        uv_close ((uv_handle_t *) absi_state[unitno].poll, absi_poll_close_cb);
+#if defined(THREADZ) || defined(LOCKLESS)
+        unlock_libuv ();
+#endif
+        absi_state[unitno].poll = NULL;
+      }
+
     ret = udp_release (absi_state[unitno].link);
     if (ret != SCPE_OK)
       return ret;
@@ -300,45 +341,56 @@ int absi_iom_cmd (uint iomUnitIdx, uint chan)
     return IOM_CMD_ERROR;
   }
 
-void absi_process_event (void)
+static void absi_process_unit (uint unit)
   {
 #define psz 17000
     uint16_t pkt[psz];
-    for (uint32 unit = 0; unit < absi_dev.numunits; unit ++)
+    if (absi_state[unit].link == NOLINK)
+      return;
+    //int sz = udp_receive ((int) unit, pkt, psz);
+    int sz = udp_receive (absi_state[unit].link, pkt, psz);
+    if (sz < 0)
       {
-        if (absi_state[unit].link == NOLINK)
-          continue;
-        //int sz = udp_receive ((int) unit, pkt, psz);
-        int sz = udp_receive (absi_state[unit].link, pkt, psz);
-        if (sz < 0)
-          {
-            printf ("udp_receive failed\n");
-          }
-        else if (sz == 0)
+        printf ("udp_receive failed\n");
+      }
+    else if (sz == 0)
+      {
+        //printf ("udp_receive 0\n");
+      }
+    else
+      {
+        for (int i = 0; i < sz; i ++)
           {
-            //printf ("udp_receive 0\n");
+            printf ("  %06o  %04x  ", pkt[i], pkt[i]);
+            for (int b = 0; b < 16; b ++)
+              printf ("%c", pkt[i] & (1 << (16 - b)) ? '1' : '0');
+            printf ("\n");
           }
-        else
+        // Send a NOP reply
+        //int16_t reply[2] = 0x0040
+        int rc = udp_send (absi_state[unit].link, pkt, (uint16_t) sz, 
+                           PFLG_FINAL);
+        if (rc < 0)
           {
-            for (int i = 0; i < sz; i ++)
-              {
-                printf ("  %06o  %04x  ", pkt[i], pkt[i]);
-                for (int b = 0; b < 16; b ++)
-                  printf ("%c", pkt[i] & (1 << (16 - b)) ? '1' : '0');
-                printf ("\n");
-              }
-            // Send a NOP reply
-            //int16_t reply[2] = 0x0040
-            int rc = udp_send (absi_state[unit].link, pkt, (uint16_t) sz, 
-                               PFLG_FINAL);
-            if (rc < 0)
-              {
-                printf ("udp_send failed\n");
-              }
+            printf ("udp_send failed\n");
           }
       }
   }
 
+// The link's socket is readable
+
+static void absi_poll_cb (uv_poll_t * handle, UNUSED int status,
+                          UNUSED int events)
+  {
+    absi_process_unit ((uint) (intptr_t) handle->data);
+  }
+
+void absi_process_event (void)
+  {
+    for (uint32 unit = 0; unit < absi_dev.numunits; unit ++)
+      absi_process_unit (unit);
+  }
+
 
 
 
@@ -1074,9 +1074,6 @@ startCA:;
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-                lock_rmw ();
-#endif
 
                 word18 saveCA = cpu.TPR.CA;
                 word36 indword;
@@ -1118,9 +1115,6 @@ startCA:;
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-                unlock_rmw ();
-#endif
 
                 sim_debug (DBG_ADDRMOD, & cpu_dev,
                            "IT_MOD(IT_AD): wrote tally word %012"PRIo64
@@ -1149,9 +1143,6 @@ startCA:;
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-                lock_rmw ();
-#endif
 
                 word18 saveCA = cpu.TPR.CA;
                 word36 indword;
@@ -1194,9 +1185,6 @@ startCA:;
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-                unlock_rmw ();
-#endif
 
                 sim_debug (DBG_ADDRMOD, & cpu_dev,
                            "IT_MOD(IT_SD): wrote tally word %012"PRIo64
@@ -1229,9 +1217,6 @@ startCA:;
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-                lock_rmw ();
-#endif
 
                 word18 saveCA = cpu.TPR.CA;
                 word36 indword;
@@ -1275,9 +1260,6 @@ startCA:;
 
 #ifdef TEST_FENCE
     fence ();
-#endif
-#ifdef THREADZ
-                unlock_rmw ();
 #endif
                 cpu.TPR.CA = Yi;
                 return;
@@ -1306,9 +1288,6 @@ startCA:;
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-                lock_rmw ();
-#endif
 
                 word36 indword;
                 Read (cpu.TPR.CA, & indword, APU_DATA_RMW);
@@ -1355,9 +1334,6 @@ startCA:;
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-                unlock_rmw ();
-#endif
 
                 cpu.TPR.CA = computedAddress;
                 return;
@@ -1396,9 +1372,6 @@ startCA:;
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-                lock_rmw ();
-#endif
 
                 word18 saveCA = cpu.TPR.CA;
                 word36 indword;
@@ -1446,9 +1419,6 @@ startCA:;
 
 #ifdef TEST_FENCE
     fence ();
-#endif
-#ifdef THREADZ
-                unlock_rmw ();
 #endif
                 // If the TAG of the indirect word invokes a register, that is,
                 // specifies r, ri, or ir modification, the effective Td value
@@ -1520,9 +1490,6 @@ startCA:;
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-                lock_rmw ();
-#endif
 
                 word18 saveCA = cpu.TPR.CA;
                 word36 indword;
@@ -1569,9 +1536,6 @@ startCA:;
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-                unlock_rmw ();
-#endif
 
                 // If the TAG of the indirect word invokes a register, that is,
                 // specifies r, ri, or ir modification, the effective Td value
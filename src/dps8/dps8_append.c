@@ -160,6 +160,9 @@ static void selftest_ptwaw (void)
 void do_ldbr (word36 * Ypair)
   {
     CPTUR (cptUseDSBR);
+#ifdef APU_TLB
+    apu_tlb_flush ();
+#endif
 #ifdef WAM
     if (! cpu.switches.disable_wam) 
       {
@@ -300,11 +303,6 @@ static void modify_dsptw (word15 segno)
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-    bool lck = get_rmw_lock ();
-    if (! lck)
-      lock_rmw ();
-#endif
 
     word36 PTWx1;
 #ifdef LOCKLESS
@@ -320,10 +318,6 @@ static void modify_dsptw (word15 segno)
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-    if (! lck)
-      unlock_rmw ();
-#endif
 
     cpu.PTW0.U = 1;
 #ifdef L68
@@ -841,11 +835,6 @@ static void fetch_ptw (sdw_s *sdw, word18 offset)
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-    bool lck = get_rmw_lock ();
-    if (! lck)
-      lock_rmw ();
-#endif
 #ifdef LOCKLESS
     core_read_lock ((sdw->ADDR + x2) & PAMASK, & PTWx2, __func__);
 #else
@@ -875,10 +864,6 @@ static void fetch_ptw (sdw_s *sdw, word18 offset)
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-    if (! lck)
-      unlock_rmw ();
-#endif
 
 #ifdef L68
     if (cpu.MR_cache.emr && cpu.MR_cache.ihr)
@@ -1018,11 +1003,6 @@ static void modify_ptw (sdw_s *sdw, word18 offset)
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-    bool lck = get_rmw_lock ();
-    if (! lck)
-      lock_rmw ();
-#endif
 #ifdef LOCKLESS
     core_read_lock ((sdw->ADDR + x2) & PAMASK, & PTWx2, __func__);
     PTWx2 = SETBIT (PTWx2, 6);
@@ -1034,10 +1014,6 @@ static void modify_ptw (sdw_s *sdw, word18 offset)
 #endif
 #ifdef TEST_FENCE
     fence ();
-#endif
-#ifdef THREADZ
-    if (! lck)
-      unlock_rmw ();
 #endif
     cpu.PTW->M = 1;
 #ifdef L68
@@ -1046,6 +1022,19 @@ static void modify_ptw (sdw_s *sdw, word18 offset)
 #endif
   }
 
+// Missing segment and missing page faults. When the caller has set
+// cpu.apu.df_return the fault is only set up, and the caller sees
+// cpu.apu.df_taken; otherwise unwind as usual.
+
+// CANFAULT
+static void directed_fault (word2 fc, const char * msg)
+  {
+    if (! cpu.apu.df_return)
+      doFault (FAULT_DF0 + fc, fst_zero, msg);
+    setupFault (FAULT_DF0 + fc, fst_zero, msg);
+    cpu.apu.df_taken = true;
+  }
+
 static void do_ptw2 (sdw_s *sdw, word18 offset)
   {
     PNL (L68_ (cpu.apu.state |= apu_FPTW2;))
@@ -1085,7 +1074,7 @@ static void do_ptw2 (sdw_s *sdw, word18 offset)
        //Is PTW2.F set ON?
        if (! PTW2.DF)
            // initiate a directed fault
-           doFault (FAULT_DF0 + PTW2.FC, fst_zero, "PTW2.F == 0");
+           directed_fault (PTW2.FC, "PTW2.F == 0");
 
   }
 
@@ -1163,6 +1152,99 @@ static char *str_pct (processor_cycle_type t)
   
   }
 
+#ifdef APU_TLB
+/*
+ * Appending unit translation cache
+ *
+ * The common appending cycles -- operand reads and stores, indirect word
+ * fetches and instruction fetches -- resolve to the same final address and
+ * pass the same ring and access checks for as long as the SDW and PTW they
+ * used are unchanged and the CPU keeps the same effective ring. Cache the
+ * outcome of the full walk and go straight to HI on a hit. RTCD, CALL6,
+ * ABSA, prepaging EIS instructions and the LOCKLESS RMW cycles have side
+ * effects on the TPR or PPR beyond the translation and always take the
+ * long way.
+ */
+
+void apu_tlb_flush (void)
+  {
+    for (uint i = 0; i < N_APU_TLB_ENTRIES; i ++)
+      cpu.apu_tlb[i].tag = APU_TLB_EMPTY;
+  }
+
+static inline uint apu_tlb_hash (word32 tag)
+  {
+    return (uint) ((tag * 2654435761u) >> (32 - APU_TLB_BITS)) & APU_TLB_MASK;
+  }
+
+static inline word32 apu_tlb_tag (word15 segno, word18 offset, word3 ring,
+                                  int access)
+  {
+    return ((word32) segno << 13) | ((word32) (offset >> 10) << 5) |
+           ((word32) ring << 2) | (word32) access;
+  }
+
+// Classify an appending cycle; 0 if it can not be cached.
+
+static int apu_tlb_access (processor_cycle_type thisCycle,
+                           processor_cycle_type lastCycle)
+  {
+    DCDstruct * i = & cpu.currentInstruction;
+
+    // Let the flowchart issue its warning
+    if (lastCycle == RTCD_OPERAND_FETCH)
+      return 0;
+
+    // Prepaging EIS instructions; see G
+    if (i->opcodeX && ((i->opcode & 0770) == 0200 ||
+                       (i->opcode & 0770) == 0220 ||
+                       (i->opcode & 0770) == 020 ||
+                       (i->opcode & 0770) == 0300))
+      return 0;
+
+    switch (thisCycle)
+      {
+        case OPERAND_STORE:
+        case APU_DATA_STORE:
+          return APU_TLB_WRITE;
+
+        case INSTRUCTION_FETCH:
+          // The instruction after an rtcd is checked at C
+          if (i->opcode == 0610 && ! i->opcodeX)
+            return 0;
+          return APU_TLB_EXEC;
+
+        case OPERAND_READ:
+          if (i->info->flags & CALL6_INS)
+            return 0;
+          if (i->info->flags & TRANSFER_INS)
+            return APU_TLB_EXEC;
+          return APU_TLB_READ;
+
+        case INDIRECT_WORD_FETCH:
+        case APU_DATA_READ:
+          return APU_TLB_READ;
+
+        default:
+          return 0;
+      }
+  }
+
+// Record the translation just made by the full walk.
+
+static void apu_tlb_load (word32 tag, int access, word24 base, word18 offmask)
+  {
+    // A read with SDW.R off may have borrowed PPR.PRR; see B
+    if (access == APU_TLB_READ && ! cpu.SDW->R)
+      return;
+    apu_tlb_entry_t * e = & cpu.apu_tlb[apu_tlb_hash (tag)];
+    e->tag = tag;
+    e->base = base;
+    e->offmask = offmask;
+    e->sdw = * cpu.SDW;
+  }
+#endif
+
 
 /*
  * recoding APU functions to more closely match Fig 5,6 & 8 ...
@@ -1328,6 +1410,59 @@ word24 do_append_cycle (processor_cycle_type thisCycle, word36 * data,
 	DBGAPP ("RTCD_OPERAND_FETCH ABSOLUTE mode set TSR %05o TRR %o\n", cpu.TPR.TSR, cpu.TPR.TRR);
       }
 
+#ifdef APU_TLB
+    int tlbAccess = apu_tlb_access (thisCycle, lastCycle);
+#ifdef WAM
+    // The associative memory LRU state is visible to software; don't
+    // bypass it
+    if (nomatch || (! cpu.switches.disable_wam &&
+                    (cpu.cu.SD_ON || cpu.cu.PT_ON)))
+      tlbAccess = 0;
+#endif
+    word32 tlbTag = 0;
+    if (tlbAccess)
+      {
+        // A store into the executing segment is checked against PPR.PRR;
+        // see B
+        word3 ring = cpu.TPR.TRR;
+        if (tlbAccess == APU_TLB_WRITE && cpu.TPR.TSR == cpu.PPR.PSR)
+          ring = cpu.PPR.PRR;
+        tlbTag = apu_tlb_tag (cpu.TPR.TSR, cpu.TPR.CA, ring, tlbAccess);
+        apu_tlb_entry_t * e = & cpu.apu_tlb[apu_tlb_hash (tlbTag)];
+        if (e->tag == tlbTag &&
+            ((cpu.TPR.CA >> 4) & 037777) <= e->sdw.BOUND &&
+            (tlbAccess != APU_TLB_EXEC ||
+             (cpu.PPR.PRR == ring &&
+              (cpu.rRALR == 0 || cpu.PPR.PRR < cpu.rRALR))))
+          {
+            cpu.tlbHits ++;
+            cpu.TPR.TRR = ring;
+            cpu.SDW = & e->sdw;
+            cpu.RSDWH_R1 = e->sdw.R1;
+            finalAddress = (e->base + (cpu.TPR.CA & e->offmask)) & 0xffffff;
+            if (e->sdw.U)
+              {
+                set_apu_status (apuStatus_FANP);
+                PNL (L68_ (cpu.apu.state |= apu_FANP;))
+              }
+            else
+              {
+                set_apu_status (apuStatus_FAP);
+                PNL (L68_ (cpu.apu.state |= apu_FAP;))
+#ifdef L68
+                if (cpu.MR_cache.emr && cpu.MR_cache.ihr)
+                  add_APU_history (APUH_FAP);
+#endif
+              }
+            PNL (cpu.APUMemAddr = finalAddress;)
+            DBGAPP ("do_append_cycle(TLB): (%05o:%06o) finalAddress=%08o\n",
+                    cpu.TPR.TSR, cpu.TPR.CA, finalAddress);
+            goto HI;
+          }
+        cpu.tlbMisses ++;
+      }
+#endif
+
     goto A;
 
 ////////////////////////////////////////
@@ -1364,8 +1499,11 @@ A:;
             fetch_dsptw (cpu.TPR.TSR);
             
             if (! cpu.PTW0.DF)
-              doFault (FAULT_DF0 + cpu.PTW0.FC, fst_zero,
-                       "do_append_cycle(A): PTW0.F == 0");
+              {
+                directed_fault (cpu.PTW0.FC,
+                                "do_append_cycle(A): PTW0.F == 0");
+                return 0;
+              }
             
             if (! cpu.PTW0.U)
               modify_dsptw (cpu.TPR.TSR);
@@ -1382,7 +1520,8 @@ A:;
                 DBGAPP ("do_append_cycle(A): SDW0.F == 0! "
                         "Initiating directed fault\n");
                 // initiate a directed fault ...
-                doFault (FAULT_DF0 + cpu.SDW0.FC, fst_zero, "SDW0.F == 0");
+                directed_fault (cpu.SDW0.FC, "SDW0.F == 0");
+                return 0;
               }
           }
         // load SDWAM .....
@@ -1865,8 +2004,8 @@ G:;
             if (thisCycle != ABSA_CYCLE)
               {
                 // initiate a directed fault
-                doFault (FAULT_DF0 + cpu.PTW0.FC, (_fault_subtype) {.bits=0},
-                         "PTW0.F == 0");
+                directed_fault (cpu.PTW0.FC, "PTW0.F == 0");
+                return 0;
               }
           }
         loadPTWAM (cpu.SDW->POINTER, cpu.TPR.CA, nomatch); // load PTW0 to PTWAM
@@ -1881,6 +2020,8 @@ G:;
         || (i->opcode & 0770)== 020|| (i->opcode & 0770) == 0300))
       {
         do_ptw2 (cpu.SDW, cpu.TPR.CA);
+        if (cpu.apu.df_taken)
+          return 0;
       } 
     goto I;
     
@@ -1923,6 +2064,11 @@ H:;
     
     DBGAPP ("do_append_cycle(H:FANP): (%05o:%06o) finalAddress=%08o\n",
             cpu.TPR.TSR, cpu.TPR.CA, finalAddress);
+
+#ifdef APU_TLB
+    if (tlbAccess)
+      apu_tlb_load (tlbTag, tlbAccess, cpu.SDW->ADDR & 077777760, MASK18);
+#endif
     
     //if (thisCycle == ABSA_CYCLE)
     //    goto J;
@@ -1963,6 +2109,13 @@ I:;
     DBGAPP ("do_append_cycle(H:FAP): (%05o:%06o) finalAddress=%08o\n",
             cpu.TPR.TSR, cpu.TPR.CA, finalAddress);
 
+#ifdef APU_TLB
+    if (tlbAccess)
+      apu_tlb_load (tlbTag, tlbAccess,
+                    (((word24) cpu.PTW->ADDR & 0777760) << 6) & 0xffffff,
+                    01777);
+#endif
+
     //if (thisCycle == ABSA_CYCLE)
     //    goto J;
     goto HI;
@@ -124,6 +124,9 @@ void do_cams (word36 Y);
 int dbgLookupAddress (word18 segno, word18 offset, word24 * finalAddress,
                       char * * msg);
 sdw0_s * getSDW (word15 segno);
+#ifdef APU_TLB
+void apu_tlb_flush (void);
+#endif
 
 static inline void fauxDoAppendCycle (processor_cycle_type thisCycle)
   {
@@ -0,0 +1,375 @@
+/*
+ Copyright 2013-2019 by Charles Anthony
+
+ All rights reserved.
+
+ This software is made available under the terms of the
+ ICU License -- ICU 1.8.1 and later.
+ See the LICENSE file at the top-level directory of this distribution and
+ at https://sourceforge.net/p/dps8m/code/ci/master/tree/LICENSE
+ */
+
+// Read a system_book segment, extracting segment names and numbers
+// and component names, offsets, and lengths
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dps8_book.h"
+#include "uthash.h"
+
+// Segments are found by name and by number through hash tables. Each
+// segment keeps its components sorted by txt_start, with the greatest
+// txt_start + txt_length of each prefix of that order, so that an
+// address lookup is a binary search followed by a short backward scan.
+// Each segment also has a hash table of its components by name.
+// Where names or numbers repeat, the first one added is found, as the
+// linear search this replaces did.
+
+#define BOOT_SEGMENTS_MAX 1024
+#define BOOT_COMPONENTS_MAX 4096
+
+static struct book_segment
+  {
+    char * segname;
+    int segno;
+    int * comps;              // component indices sorted by txt_start
+    unsigned int * max_end;   // max end of comps[0..k]
+    int n_comps, max_comps;
+    struct book_component * comps_by_name;
+    UT_hash_handle hh_name, hh_no;
+  } book_segments[BOOT_SEGMENTS_MAX];
+
+static int n_book_segments = 0;
+
+static struct book_component
+  {
+    char * compname;
+    int book_segment_number;
+    unsigned int txt_start, txt_length;
+    int intstat_start, intstat_length, symbol_start, symbol_length;
+    UT_hash_handle hh;
+  } book_components[BOOT_COMPONENTS_MAX];
+
+static int n_book_components = 0;
+
+static struct book_segment * seg_by_name = NULL;
+static struct book_segment * seg_by_no = NULL;
+
+static int lookup_book_segment (const char * name)
+  {
+    struct book_segment * p;
+    HASH_FIND (hh_name, seg_by_name, name, strlen (name), p);
+    return p ? (int) (p - book_segments) : -1;
+  }
+
+int book_add_segment (const char * name, int segno)
+  {
+    int n = lookup_book_segment (name);
+    if (n >= 0)
+      return n;
+    if (n_book_segments >= BOOT_SEGMENTS_MAX)
+      return -1;
+    struct book_segment * p = book_segments + n_book_segments;
+    p->segname = strdup (name);
+    p->segno = segno;
+    HASH_ADD_KEYPTR (hh_name, seg_by_name, p->segname, strlen (p->segname), p);
+    struct book_segment * q;
+    HASH_FIND (hh_no, seg_by_no, & p->segno, sizeof (p->segno), q);
+    if (! q)
+      HASH_ADD (hh_no, seg_by_no, segno, sizeof (p->segno), p);
+    n = n_book_segments;
+    n_book_segments ++;
+    return n;
+  }
+
+static unsigned int comp_end (int j)
+  {
+    return book_components[j].txt_start + book_components[j].txt_length;
+  }
+
+// Insert component j into its segment's sorted list
+
+static int index_component (int j)
+  {
+    struct book_segment * p = book_segments +
+                              book_components[j].book_segment_number;
+    if (p->n_comps == p->max_comps)
+      {
+        int max = p->max_comps ? 2 * p->max_comps : 16;
+        int * comps = realloc (p->comps, (size_t) max * sizeof (int));
+        if (! comps)
+          return -1;
+        p->comps = comps;
+        unsigned int * max_end = realloc (p->max_end,
+                                          (size_t) max * sizeof (unsigned int));
+        if (! max_end)
+          return -1;
+        p->max_end = max_end;
+        p->max_comps = max;
+      }
+    // After any components with the same txt_start
+    unsigned int start = book_components[j].txt_start;
+    int lo = 0, hi = p->n_comps;
+    while (lo < hi)
+      {
+        int mid = (lo + hi) / 2;
+        if (book_components[p->comps[mid]].txt_start <= start)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+    memmove (p->comps + lo + 1, p->comps + lo,
+             (size_t) (p->n_comps - lo) * sizeof (int));
+    p->comps[lo] = j;
+    p->n_comps ++;
+    for (int k = lo; k < p->n_comps; k ++)
+      {
+        unsigned int e = comp_end (p->comps[k]);
+        if (k && p->max_end[k - 1] > e)
+          e = p->max_end[k - 1];
+        p->max_end[k] = e;
+      }
+    return 0;
+  }
+
+int book_add_component (int segnum, const char * name, unsigned int txt_start,
+                        unsigned int txt_length, int intstat_start,
+                        int intstat_length, int symbol_start,
+                        int symbol_length)
+  {
+    if (n_book_components >= BOOT_COMPONENTS_MAX)
+      return -1;
+    struct book_component * c = book_components + n_book_components;
+    c->compname = strdup (name);
+    c->book_segment_number = segnum;
+    c->txt_start = txt_start;
+    c->txt_length = txt_length;
+    c->intstat_start = intstat_start;
+    c->intstat_length = intstat_length;
+    c->symbol_start = symbol_start;
+    c->symbol_length = symbol_length;
+    if (index_component (n_book_components))
+      return -1;
+    struct book_segment * p = book_segments + segnum;
+    struct book_component * q;
+    HASH_FIND (hh, p->comps_by_name, c->compname, strlen (c->compname), q);
+    if (! q)
+      HASH_ADD_KEYPTR (hh, p->comps_by_name, c->compname,
+                       strlen (c->compname), c);
+    int n = n_book_components;
+    n_book_components ++;
+    return n;
+  }
+
+int book_load (const char * fname)
+  {
+    // Multics 12.5 assigns segment number to collection 3 starting at 0244.
+    unsigned int c3 = 0244;
+
+#define bufSz 257
+    char filebuf[bufSz];
+    int current = -1;
+
+    FILE * fp = fopen (fname, "r");
+    if (! fp)
+      return BOOK_OPEN_ERR;
+    for (;;)
+      {
+        char * bufp = fgets (filebuf, bufSz, fp);
+        if (! bufp)
+          break;
+        char name[BOOK_SEGMENT_NAME_LEN];
+        int segno, p0, p1, p2;
+
+        // 32 is BOOK_SEGMENT_NAME_LEN - 1
+        int cnt = sscanf (filebuf, "%32s %o  (%o, %o, %o)", name, & segno,
+          & p0, & p1, & p2);
+        if (filebuf[0] != '\t' && cnt == 5)
+          {
+            int rc = book_add_segment (name, segno);
+            if (rc < 0)
+              {
+                fclose (fp);
+                return BOOK_FULL;
+              }
+            continue;
+          }
+        else
+          {
+            // Check for collection 3 segment
+            // 32 is BOOK_SEGMENT_NAME_LEN - 1
+            cnt = sscanf (filebuf, "%32s  (%o, %o, %o)", name,
+              & p0, & p1, & p2);
+            if (filebuf[0] != '\t' && cnt == 4)
+              {
+                if (strstr (name, "fw.") || strstr (name, ".ec"))
+                  continue;
+                int rc = book_add_segment (name, (int) (c3 ++));
+                if (rc < 0)
+                  {
+                    fclose (fp);
+                    return BOOK_FULL;
+                  }
+                continue;
+              }
+          }
+        cnt = sscanf (filebuf, "Bindmap for >ldd>h>e>%32s", name);
+        if (cnt != 1)
+          cnt = sscanf (filebuf, "Bindmap for >ldd>hard>e>%32s", name);
+        if (cnt == 1)
+          {
+            int rc = lookup_book_segment (name);
+            if (rc < 0)
+              {
+                // The collection 3.0 segments do not have segment numbers,
+                // and the 1st digit of the 3-tuple is 1, not 0. Ignore
+                // them for now.
+                current = -1;
+                continue;
+              }
+            current = rc;
+            continue;
+          }
+
+        unsigned int txt_start, txt_length;
+        int intstat_start, intstat_length, symbol_start, symbol_length;
+        cnt = sscanf (filebuf, "%32s %o %o %o %o %o %o", name, & txt_start,
+                      & txt_length, & intstat_start, & intstat_length,
+                      & symbol_start, & symbol_length);
+
+        if (cnt == 7)
+          {
+            if (current >= 0)
+              {
+                book_add_component (current, name, txt_start, txt_length,
+                                    intstat_start, intstat_length, symbol_start,
+                                    symbol_length);
+              }
+            continue;
+          }
+
+        cnt = sscanf (filebuf, "%32s %o  (%o, %o, %o)", name, & segno,
+          & p0, & p1, & p2);
+        if (filebuf[0] == '\t' && cnt == 5)
+          {
+            int rc = book_add_segment (name, segno);
+            if (rc < 0)
+              {
+                fclose (fp);
+                return BOOK_FULL;
+              }
+            continue;
+          }
+
+      }
+    fclose (fp);
+#undef bufSz
+    return BOOK_OK;
+  }
+
+// Given a segno:offset, try to translate to
+// component name and offset in the component
+
+// Warning: returns ptr to static buffer
+char * book_lookup_address (unsigned int segno, unsigned int offset,
+                            char * * compname, unsigned int * compoffset)
+  {
+    static char buf[129];
+    struct book_segment * p;
+    int segno_key = (int) segno;
+
+    HASH_FIND (hh_no, seg_by_no, & segno_key, sizeof (segno_key), p);
+    if (! p)
+      return NULL;
+
+    // k: the last component with txt_start <= offset
+    int lo = 0, hi = p->n_comps;
+    while (lo < hi)
+      {
+        int mid = (lo + hi) / 2;
+        if (book_components[p->comps[mid]].txt_start <= offset)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+    int k = lo - 1;
+
+    // Of the components that bracket the offset, the first added; only
+    // components at or before k can, and none before the point where
+    // max_end drops to the offset.
+    int found = -1;
+    for (int i = k; i >= 0 && p->max_end[i] > offset; i --)
+      {
+        int j = p->comps[i];
+        if (comp_end (j) > offset && (found < 0 || j < found))
+          found = j;
+      }
+    if (found >= 0)
+      {
+        sprintf (buf, "%s:%s+0%0o", p->segname,
+          book_components[found].compname,
+          offset - book_components[found].txt_start);
+        if (compname)
+          * compname = book_components[found].compname;
+        if (compoffset)
+          * compoffset = offset - book_components[found].txt_start;
+        return buf;
+      }
+
+    // Didn't find a component track bracketed the offset; use the
+    // component that was before the offset: the first added at the
+    // greatest txt_start. A component at 0 never qualifies.
+    int best = -1;
+    if (k >= 0 && book_components[p->comps[k]].txt_start > 0)
+      {
+        while (k > 0 && book_components[p->comps[k - 1]].txt_start ==
+                        book_components[p->comps[k]].txt_start)
+          k --;
+        best = p->comps[k];
+      }
+
+    if (best != -1)
+      {
+        if (compname)
+          * compname = book_components[best].compname;
+        if (compoffset)
+          * compoffset = offset - book_components[best].txt_start;
+        sprintf (buf, "%s:%s+0%0o", p->segname,
+          book_components[best].compname,
+          offset - book_components[best].txt_start);
+        return buf;
+      }
+
+    // Found a segment, but it had no components. Return the segment name
+    // as the component name
+
+    if (compname)
+      * compname = p->segname;
+    if (compoffset)
+      * compoffset = offset;
+    sprintf (buf, "%s:+0%0o", p->segname,
+             offset);
+    return buf;
+  }
+
+// Given a segment name and component name, return the
+// components segment number and offset
+
+int book_lookup_name (const char * segname, const char * compname,
+                      long * segno, long * offset)
+  {
+    int i = lookup_book_segment (segname);
+    if (i < 0)
+      return -1;
+
+    struct book_component * c;
+    HASH_FIND (hh, book_segments[i].comps_by_name, compname, strlen (compname),
+               c);
+    if (! c)
+      return -1;
+    * segno = book_segments[i].segno;
+    * offset = (long) c->txt_start;
+    return 0;
+  }
@@ -0,0 +1,36 @@
+/*
+ Copyright 2013-2019 by Charles Anthony
+
+ All rights reserved.
+
+ This software is made available under the terms of the
+ ICU License -- ICU 1.8.1 and later.
+ See the LICENSE file at the top-level directory of this distribution and
+ at https://sourceforge.net/p/dps8m/code/ci/master/tree/LICENSE
+ */
+
+#ifndef DPS8_BOOK_H
+#define DPS8_BOOK_H
+
+// Multics system book: segment names and numbers, and the components
+// bound into each segment. Independent of the simulator so that the
+// tools in src/utils can use it.
+
+#define BOOK_SEGMENT_NAME_LEN 33
+
+// book_load return codes
+#define BOOK_OK 0
+#define BOOK_OPEN_ERR -1  // errno is set
+#define BOOK_FULL -2      // too many segments or components
+
+int book_load (const char * fname);
+int book_add_segment (const char * name, int segno);
+int book_add_component (int segnum, const char * name, unsigned int txt_start,
+                        unsigned int txt_length, int intstat_start,
+                        int intstat_length, int symbol_start,
+                        int symbol_length);
+char * book_lookup_address (unsigned int segno, unsigned int offset,
+                            char * * compname, unsigned int * compoffset);
+int book_lookup_name (const char * segname, const char * compname,
+                      long * segno, long * offset);
+#endif
@@ -0,0 +1,317 @@
+/*
+ Copyright 2019 by Charles Anthony
+
+ All rights reserved.
+
+ This software is made available under the terms of the
+ ICU License -- ICU 1.8.1 and later.
+ See the LICENSE file at the top-level directory of this distribution and
+ at https://sourceforge.net/p/dps8m/code/ci/master/tree/LICENSE
+ */
+
+// Binary instruction trace
+//
+//   btrace file     record every instruction executed to file
+//   nobtrace        stop recording
+//
+// Each CPU appends a fixed part (the instruction, PPR, CA and final
+// address) and the registers that changed to its own byte ring, kept
+// like the profiler's sample rings (struct prof_ring in dps8_prof.c). A
+// writer thread empties the rings into the file every 10ms. If a ring
+// fills, records are dropped and counted, and the next record is a sync
+// record. The trace is decoded offline by src/utils/btrace. The file
+// format is described in dps8_btrace.h.
+
+#include <stdio.h>
+#include <errno.h>
+#include <time.h>
+
+#include "dps8.h"
+#include "dps8_sys.h"
+#include "dps8_cpu.h"
+#include "dps8_btrace.h"
+
+#ifdef BTRACE
+
+#define BT_RING_SIZE (1llu << 22) // Must be a power of 2
+#define BT_RING_MASK (BT_RING_SIZE - 1)
+
+struct bt_ring
+  {
+    uint8 * buf;
+    uint64 head;   // written by the CPU
+    uint64 tail;   // written by the writer
+    unsigned long long dropped;
+    unsigned long long count;  // cpu.instrCnt at the last record
+    bool resync;
+    bool begun;    // btrace_begin has filled in w0 and psr
+    uint64 w0;
+    word15 psr;
+    uint64 regs [BT_NREGS];
+  };
+
+static struct bt_ring bt_rings [N_CPU_UNITS_MAX];
+
+static bool bt_inited = false;
+static uv_mutex_t bt_lock;
+static uv_thread_t bt_thread;
+static volatile bool bt_running = false;
+static FILE * bt_fp = NULL;
+static unsigned long long bt_bytes;
+static bool bt_error;
+
+// Called from executeInstruction when cpu.btrace is set, before the
+// instruction can change the PPR or the IWB
+
+void btrace_begin (void)
+  {
+    struct bt_ring * r = bt_rings + current_running_cpu_idx;
+    uint64 w0 = (IWB_IRODD & BT_W0_IWB_MASK) |
+                ((uint64) cpu.PPR.IC << BT_W0_IC_SHIFT) |
+                ((uint64) cpu.PPR.PRR << BT_W0_PRR_SHIFT);
+    if (get_addr_mode () == ABSOLUTE_mode)
+      w0 |= BT_ABS;
+    if (get_bar_mode ())
+      w0 |= BT_BAR;
+    r->w0 = w0;
+    r->psr = cpu.PPR.PSR;
+    r->begun = true;
+  }
+
+static void bt_record (uint64 flags, uint fault_number)
+  {
+    struct bt_ring * r = bt_rings + current_running_cpu_idx;
+    if (! r->begun)
+      return;
+    r->begun = false;
+
+    uint64 regs [BT_NREGS];
+    regs[BT_REG_A] = cpu.rA;
+    regs[BT_REG_Q] = cpu.rQ;
+    regs[BT_REG_E] = cpu.rE;
+    for (uint i = 0; i < 8; i ++)
+      regs[BT_REG_X0 + i] = cpu.rX[i];
+    regs[BT_REG_IR] = cpu.cu.IR;
+    for (uint i = 0; i < 8; i ++)
+      regs[BT_REG_PR0 + i] = ((uint64) cpu.PR[i].SNR << 27) |
+                             ((uint64) cpu.PR[i].RNR << 24) |
+                             ((uint64) cpu.PR[i].PR_BITNO << 18) |
+                             (uint64) cpu.PR[i].WORDNO;
+
+    uint64 head = r->head;
+    if (BT_RING_SIZE - (head - __atomic_load_n (& r->tail, __ATOMIC_ACQUIRE))
+        < BT_REC_MAX)
+      {
+        r->dropped ++;
+        r->resync = true;
+        return;
+      }
+
+    bool sync = r->resync || cpu.instrCnt != r->count + 1;
+    r->resync = false;
+    r->count = cpu.instrCnt;
+
+    uint8 rec [BT_REC_MAX];
+    uint64 w [2 + 1 + BT_NREGS];
+    uint n = 2;
+    uint32 mask = 0;
+    w[0] = r->w0 | flags | (sync ? BT_SYNC : 0);
+    w[1] = (r->psr & BT_W1_PSR_MASK) |
+           ((uint64) (cpu.TPR.CA & MASK18) << BT_W1_CA_SHIFT) |
+           ((uint64) (cpu.iefpFinalAddress & MASK24) << BT_W1_FA_SHIFT) |
+           ((uint64) fault_number << BT_W1_FLT_SHIFT);
+    if (sync)
+      w[n ++] = cpu.instrCnt;
+    for (uint i = 0; i < BT_NREGS; i ++)
+      if (sync || regs[i] != r->regs[i])
+        {
+          mask |= 1u << i;
+          w[n ++] = regs[i];
+          r->regs[i] = regs[i];
+        }
+
+    // w0, w1, mask, rest
+    size_t len = 0;
+    memcpy (rec, w, 2 * sizeof (uint64));
+    len += 2 * sizeof (uint64);
+    memcpy (rec + len, & mask, sizeof (mask));
+    len += sizeof (mask);
+    memcpy (rec + len, w + 2, (n - 2) * sizeof (uint64));
+    len += (n - 2) * sizeof (uint64);
+
+    size_t off = head & BT_RING_MASK;
+    size_t first = BT_RING_SIZE - off < len ? BT_RING_SIZE - off : len;
+    memcpy (r->buf + off, rec, first);
+    if (first < len)
+      memcpy (r->buf, rec + first, len - first);
+    __atomic_store_n (& r->head, head + len, __ATOMIC_RELEASE);
+  }
+
+// Called from executeInstruction after the instruction completes
+
+void btrace_end (void)
+  {
+    bt_record (0, 0);
+  }
+
+// Called from doFault when the executing instruction faults
+
+void btrace_fault (uint fault_number)
+  {
+    bt_record (BT_FAULT, fault_number);
+  }
+
+static void bt_write (const void * p, size_t n)
+  {
+    if (n && fwrite (p, 1, n, bt_fp) != n)
+      bt_error = true;
+    bt_bytes += n;
+  }
+
+static void bt_pass (void)
+  {
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      {
+        struct bt_ring * r = bt_rings + i;
+        uint64 head = __atomic_load_n (& r->head, __ATOMIC_ACQUIRE);
+        uint64 tail = r->tail;
+        if (head == tail)
+          continue;
+        struct btrace_blk blk = { i, (uint32) (head - tail) };
+        bt_write (& blk, sizeof (blk));
+        size_t off = tail & BT_RING_MASK;
+        size_t len = head - tail;
+        size_t first = BT_RING_SIZE - off < len ? BT_RING_SIZE - off : len;
+        bt_write (r->buf + off, first);
+        bt_write (r->buf, len - first);
+        __atomic_store_n (& r->tail, head, __ATOMIC_RELEASE);
+      }
+  }
+
+static void bt_main (UNUSED void * arg)
+  {
+    struct timespec period = { 0, 10000000L }; // 10 ms
+    while (bt_running)
+      {
+        nanosleep (& period, NULL);
+        uv_mutex_lock (& bt_lock);
+        bt_pass ();
+        uv_mutex_unlock (& bt_lock);
+      }
+  }
+
+static t_stat bt_stop (void)
+  {
+    if (! bt_running)
+      return SCPE_OK;
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      cpus[i].btrace = false;
+    bt_running = false;
+    uv_thread_join (& bt_thread);
+    uv_mutex_lock (& bt_lock);
+    bt_pass ();
+    unsigned long long dropped = 0;
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      dropped += bt_rings[i].dropped;
+    if (fclose (bt_fp))
+      bt_error = true;
+    bt_fp = NULL;
+    uv_mutex_unlock (& bt_lock);
+    sim_msg ("btrace: %llu bytes written, %llu records dropped\n",
+             bt_bytes, dropped);
+    if (bt_error)
+      {
+        sim_warn ("btrace: write error; the trace is incomplete\n");
+        return SCPE_IOERR;
+      }
+    return SCPE_OK;
+  }
+
+static void bt_exit (void)
+  {
+    bt_stop ();
+  }
+
+static t_stat bt_start (const char * fname)
+  {
+    if (! fname || ! * fname)
+      {
+        sim_warn ("btrace: missing file name\n");
+        return SCPE_ARG;
+      }
+    if (! bt_inited)
+      {
+        uv_mutex_init (& bt_lock);
+        atexit (bt_exit);
+        bt_inited = true;
+      }
+    bt_stop ();
+
+    // The rings are kept for the life of the process; a CPU may still be
+    // finishing a record after the trace stops.
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      if (! bt_rings[i].buf)
+        {
+          bt_rings[i].buf = malloc (BT_RING_SIZE);
+          if (! bt_rings[i].buf)
+            {
+              sim_warn ("btrace: malloc failed\n");
+              return SCPE_MEM;
+            }
+        }
+
+    bt_fp = fopen (fname, "wb");
+    if (! bt_fp)
+      {
+        sim_warn ("btrace: can't open %s: %s\n", fname, strerror (errno));
+        return SCPE_OPENERR;
+      }
+    bt_bytes = 0;
+    bt_error = false;
+    struct btrace_hdr hdr;
+    memset (& hdr, 0, sizeof (hdr));
+    memcpy (hdr.magic, BTRACE_MAGIC, sizeof (hdr.magic));
+    hdr.version = BTRACE_VERSION;
+    hdr.nregs = BT_NREGS;
+    bt_write (& hdr, sizeof (hdr));
+
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      {
+        struct bt_ring * r = bt_rings + i;
+        r->tail = __atomic_load_n (& r->head, __ATOMIC_ACQUIRE);
+        r->dropped = 0;
+        __atomic_store_n (& r->resync, true, __ATOMIC_RELEASE);
+      }
+    bt_running = true;
+    if (uv_thread_create (& bt_thread, bt_main, NULL))
+      {
+        bt_running = false;
+        fclose (bt_fp);
+        bt_fp = NULL;
+        sim_warn ("btrace: can't create the writer thread\n");
+        return SCPE_IERR;
+      }
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      cpus[i].btrace = true;
+    sim_msg ("Tracing to %s\n", fname);
+    return SCPE_OK;
+  }
+
+// arg: 0 start, 1 stop
+
+t_stat btrace_cmd (int32 arg, const char * buf)
+  {
+    if (arg)
+      return bt_stop ();
+    return bt_start (buf);
+  }
+
+#else // ! BTRACE
+
+t_stat btrace_cmd (UNUSED int32 arg, UNUSED const char * buf)
+  {
+    sim_printf ("btrace not enabled; ignoring\n");
+    return SCPE_OK;
+  }
+
+#endif // BTRACE
@@ -0,0 +1,83 @@
+/*
+ Copyright 2019 by Charles Anthony
+
+ All rights reserved.
+
+ This software is made available under the terms of the
+ ICU License -- ICU 1.8.1 and later.
+ See the LICENSE file at the top-level directory of this distribution and
+ at https://sourceforge.net/p/dps8m/code/ci/master/tree/LICENSE
+ */
+
+#ifndef DPS8_BTRACE_H
+#define DPS8_BTRACE_H
+
+// Binary instruction trace
+//
+// File layout: a header, then blocks of records from one CPU, each
+// block a btrace_blk followed by len bytes of records. Records never
+// span blocks. All values are in host byte order.
+//
+// Record:
+//   uint64 w0       BT_W0_* fields
+//   uint64 w1       BT_W1_* fields
+//   uint32 regs     mask of the registers that follow, bit n for BT_REG n
+//   uint64 count    (BT_SYNC records only) cpu.instrCnt after the instruction
+//   uint64 value    for each bit set in regs, in order
+//
+// A BT_SYNC record carries every register and the instruction count; it
+// starts the trace and follows any gap (dropped records, or instructions
+// that were not traced). Other records carry the registers that changed
+// since the previous record of that CPU and count one instruction.
+
+#define BTRACE_MAGIC "DPS8BTRC"
+#define BTRACE_VERSION 1
+
+struct btrace_hdr
+  {
+    char magic [8];
+    uint32 version;
+    uint32 nregs;
+  };
+
+struct btrace_blk
+  {
+    uint32 cpu_idx;
+    uint32 len;
+  };
+
+// w0: the instruction, and the PPR when it started
+#define BT_W0_IWB_MASK  ((1llu << 36) - 1)
+#define BT_W0_IC_SHIFT  36
+#define BT_W0_PRR_SHIFT 54
+#define BT_ABS          (1llu << 57)  // absolute mode
+#define BT_BAR          (1llu << 58)  // BAR mode
+#define BT_SYNC         (1llu << 59)
+#define BT_FAULT        (1llu << 60)  // the instruction faulted
+
+// w1: PPR.PSR when it started, the last computed address, the final
+// (absolute) address, and the fault number if BT_FAULT
+#define BT_W1_PSR_MASK  077777llu
+#define BT_W1_CA_SHIFT  15
+#define BT_W1_FA_SHIFT  33
+#define BT_W1_FLT_SHIFT 57
+
+// Registers; a PR is packed as SNR << 27 | RNR << 24 | BITNO << 18 | WORDNO
+enum
+  {
+    BT_REG_A, BT_REG_Q, BT_REG_E,
+    BT_REG_X0, BT_REG_IR = BT_REG_X0 + 8,
+    BT_REG_PR0, BT_NREGS = BT_REG_PR0 + 8
+  };
+
+#define BT_REC_MAX (2 * sizeof (uint64) + sizeof (uint32) + \
+                    (1 + BT_NREGS) * sizeof (uint64))
+
+t_stat btrace_cmd (int32 arg, const char * buf);
+
+#ifdef BTRACE
+void btrace_begin (void);
+void btrace_end (void);
+void btrace_fault (uint fault_number);
+#endif
+#endif
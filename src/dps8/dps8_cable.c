@@ -120,6 +120,7 @@
 #include "dps8_crdpun.h"
 #include "dps8_prt.h"
 #include "dps8_utils.h"
+#include "dps8_snap.h"
 #ifndef __MINGW64__
 #include "dps8_absi.h"
 #endif
@@ -1421,6 +1422,36 @@ t_stat sys_cable_ripout (UNUSED int32 arg, UNUSED const char * buf)
     return SCPE_OK;
   }
 
+// Machine snapshot: the cabling is configuration, not machine state, so
+// a snapshot only records it to check that the restoring emulator is
+// cabled the same way. The host pointers in it are left out.
+
+void cable_snap (struct snap_s * s)
+  {
+    static struct cables_s scrubbed;
+    struct cables_s * c = & scrubbed;
+    memcpy (c, cables, sizeof (struct cables_s));
+    for (uint i = 0; i < N_IOM_UNITS_MAX; i ++)
+      for (uint j = 0; j < MAX_CHANNELS; j ++)
+        {
+          c->iom_to_ctlr[i][j].dev = NULL;
+          c->iom_to_ctlr[i][j].board = NULL;
+          c->iom_to_ctlr[i][j].iom_cmd = NULL;
+        }
+    for (uint j = 0; j < N_DEV_CODES; j ++)
+      {
+        for (uint i = 0; i < N_MTP_UNITS_MAX; i ++)
+          c->mtp_to_tape[i][j].iom_cmd = NULL;
+        for (uint i = 0; i < N_IPC_UNITS_MAX; i ++)
+          c->ipc_to_dsk[i][j].iom_cmd = NULL;
+        for (uint i = 0; i < N_MSP_UNITS_MAX; i ++)
+          c->msp_to_dsk[i][j].iom_cmd = NULL;
+        for (uint i = 0; i < N_URP_UNITS_MAX; i ++)
+          c->urp_to_urd[i][j].iom_cmd = NULL;
+      }
+    snap_check (s, "cables", c, sizeof (struct cables_s));
+  }
+
 void sysCableInit (void)
   {
 #if 0
@@ -284,3 +284,5 @@ t_stat sys_cable (UNUSED int32 arg, const char * buf);
 t_stat sys_cable_ripout (UNUSED int32 arg, UNUSED const char * buf);
 t_stat sys_cable_show (UNUSED int32 arg, UNUSED const char * buf);
 void sysCableInit (void);
+struct snap_s;
+void cable_snap (struct snap_s * s);
@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include <unistd.h>
 #include <signal.h>
+#include <fcntl.h>
 #ifndef __MINGW64__
 #include <termios.h>
 #endif
@@ -134,8 +135,8 @@ static DEBTAB opc_dt[] =
 // sim_activate counts in instructions, is dependent on the execution
 // model
 #if defined(THREADZ) || defined(LOCKLESS)
-// The sim_activate calls are done by the controller thread, which
-// has a 1000Hz cycle rate.
+// The sim_activate calls are done by the controller thread, whose
+// clock queue counts milliseconds.
 // 1K ~= 1 sec
 #define ACTIVATE_1SEC 1000
 #else
@@ -147,6 +148,10 @@ static DEBTAB opc_dt[] =
 
 
 static t_stat opc_svc (UNIT * unitp);
+static void console_read_timeout (uv_timer_t * handle);
+
+// Seconds a read waits for input before returning a null line
+#define CONSOLE_READ_TIMEOUT 30
 
 UNIT opc_unit[N_OPC_UNITS_MAX] =
   {
@@ -218,6 +223,7 @@ typedef struct opc_state_t
     
     // stuff saved from the Read ASCII command
     time_t startTime;
+    uv_timer_t readTimer;
     uint tally;
     uint daddr;
     UNIT * unitp;
@@ -344,6 +350,18 @@ int check_attn_key (void)
     return -1;
   }
 
+#ifndef __MINGW64__
+// Type-in on the controlling terminal; the console pass reads it
+
+static uv_poll_t console_kbd_poll;
+
+static void console_kbd_cb (UNUSED uv_poll_t * handle, UNUSED int status,
+                            UNUSED int events)
+  {
+    consoleProcess ();
+  }
+#endif
+
 // Once-only initialation
 
 void console_init (void)
@@ -366,8 +384,24 @@ void console_init (void)
         csp->autoaccept = 0;
         csp->noempty = 0;
         csp->attn_flush = 1;
+        uv_timer_init (uv_default_loop (), & csp->readTimer);
       }
 
+#ifndef __MINGW64__
+    // A pipe or file on stdin would poll readable at EOF forever; only
+    // watch a terminal. libuv makes a polled descriptor non-blocking, so
+    // poll a descriptor of our own rather than stdin's.
+    if (isatty (0))
+      {
+        int fd = open (ttyname (0), O_RDONLY | O_NOCTTY);
+        if (fd >= 0)
+          {
+            uv_poll_init (uv_default_loop (), & console_kbd_poll, fd);
+            uv_poll_start (& console_kbd_poll, UV_READABLE, console_kbd_cb);
+          }
+      }
+#endif
+
 #if 0
 //#ifndef __MINGW64__
     // The quit signal is used has the console ATTN key
@@ -414,6 +448,7 @@ static int opc_autoinput_set (UNIT * uptr, UNUSED int32 val,
                    "%s: Auto-input disabled.\n", __func__);
       }
     csp->autop = csp->auto_input;
+    ev_poll_kick ();
     return SCPE_OK;
   }
 
@@ -447,6 +482,7 @@ int add_opc_autoinput (int32 flag, const char * cptr)
     sim_debug (DBG_NOTIFY, & opc_dev,
                "%s: Auto-input now: %s\n", __func__, cptr);
     csp->autop = csp->auto_input;
+    ev_poll_kick ();
     return SCPE_OK;
   }
 
@@ -849,6 +885,11 @@ sim_warn ("uncomfortable with this\n");
             csp->readp = csp->buf;
             csp->io_mode = opc_read_mode;
             csp->startTime = time (NULL);
+            // Run the console pass now for typeahead and autoinput, and
+            // again when the read would time out
+            uv_timer_start (& csp->readTimer, console_read_timeout,
+                            (CONSOLE_READ_TIMEOUT + 1) * 1000, 0);
+            ev_poll_kick ();
             csp->tally = tally;
             csp->daddr = daddr;
             csp->unitp = unitp;
@@ -1501,7 +1542,7 @@ eol:
     if (csp->io_mode == opc_read_mode &&
         csp->tailp == csp->buf)
       {
-        if (csp->startTime + 30 < time (NULL))
+        if (csp->startTime + CONSOLE_READ_TIMEOUT < time (NULL))
           {
             console_putstr (conUnitIdx,  "CONSOLE: TIMEOUT\r\n");
             csp->readp = csp->buf;
@@ -1628,7 +1669,25 @@ eol:
 void consoleProcess (void)
   {
     for (int conUnitIdx = 0; conUnitIdx < (int) opc_dev.numunits; conUnitIdx ++)
-      consoleProcessIdx (conUnitIdx);
+      {
+        // A pass takes at most one character from the typeahead buffer;
+        // repeat while that makes progress
+        uint left;
+        do
+          {
+            left = ta_cnt - ta_next;
+            consoleProcessIdx (conUnitIdx);
+          }
+        while (ta_cnt - ta_next && ta_cnt - ta_next < left);
+      }
+  }
+
+// A read has been waiting CONSOLE_READ_TIMEOUT seconds; the console pass
+// times it out
+
+static void console_read_timeout (UNUSED uv_timer_t * handle)
+  {
+    consoleProcess ();
   }
 
 /*
@@ -20,6 +20,9 @@
 
 #include <stdio.h>
 #include <unistd.h>
+#if (defined(THREADZ) || defined(LOCKLESS)) && !defined(__MINGW64__)
+#include <sys/select.h>
+#endif
 
 #include "dps8.h"
 #include "dps8_addrmods.h"
@@ -40,10 +43,16 @@
 #include "dps8_socket_dev.h"
 #include "dps8_crdrdr.h"
 #include "dps8_absi.h"
+#include "dps8_disk.h"
 #include "dps8_utils.h"
+#include "dps8_prof.h"
+#include "dps8_snap.h"
 #ifdef M_SHARED
 #include "shm.h"
 #endif
+#ifndef SPEED
+#include "uthash.h"
+#endif
 #include "dps8_opcodetable.h"
 #include "sim_defs.h"
 #if defined(THREADZ) || defined(LOCKLESS)
@@ -147,6 +156,10 @@ static t_stat cpu_show_config (UNUSED FILE * st, UNIT * uptr,
                 cpus[cpu_unit_idx].switches.useMap);
     sim_msg ("Disable cache:            %01o(8)\n",
                 cpus[cpu_unit_idx].switches.disable_cache);
+#ifdef THREADED_DISPATCH
+    sim_msg ("Dispatch:                 %s\n",
+                cpus[cpu_unit_idx].switches.dispatch_switch ? "switch" : "table");
+#endif
 
 #ifdef AFFINITY
     if (cpus[cpu_unit_idx].set_affinity)
@@ -198,6 +211,15 @@ static config_value_list_t cfg_on_off [] =
     { NULL, 0 }
   };
 
+#ifdef THREADED_DISPATCH
+static config_value_list_t cfg_dispatch [] =
+  {
+    { "table", 0 },
+    { "switch", 1 },
+    { NULL, 0 }
+  };
+#endif
+
 static config_value_list_t cfg_cpu_mode [] =
   {
     { "gcos", 0 },
@@ -333,6 +355,9 @@ static config_list_t cpu_config_list [] =
     { "useMap", 0, 1, cfg_on_off },
     { "address", 0, 0777777, NULL },
     { "disable_cache", 0, 1, cfg_on_off },
+#ifdef THREADED_DISPATCH
+    { "dispatch", 0, 1, cfg_dispatch },
+#endif
 
     // Tuning
 
@@ -433,6 +458,10 @@ static t_stat cpu_set_config (UNIT * uptr, UNUSED int32 value,
           cpus[cpu_unit_idx].switches.useMap = v;
         else if (strcmp (p, "disable_cache") == 0)
           cpus[cpu_unit_idx].switches.disable_cache = v;
+#ifdef THREADED_DISPATCH
+        else if (strcmp (p, "dispatch") == 0)
+          cpus[cpu_unit_idx].switches.dispatch_switch = v;
+#endif
 #ifdef AFFINITY
         else if (strcmp (p, "affinity") == 0)
           if (v < 0)
@@ -605,8 +634,26 @@ static void set_cpu_cycle (cycles_e cycle)
   }
 
 // DPS8M Memory of 36 bit words is implemented as an array of 64 bit words.
-// Put state information into the unused high order bits.
-#define MEM_UNINITIALIZED (1LLU<<62)
+// The unused high order bits hold the LOCKLESS lock bit; whether a page
+// has been initialized is kept in mem_uninit.
+
+#if defined(ISOLTS) && !defined(LOCKLESS)
+uint64 mem_uninit [MEM_PAGES / 64];
+#endif
+
+// Without the shared memory file there is no way to tell which pages
+// have been written, so all of them are treated as in use.
+
+void mem_in_use (uint8 * map)
+  {
+#if defined(M_SHARED) && !defined(__MINGW64__)
+    if (shm_data_map ("state", offsetof (struct system_state_s, M),
+                      MEMSIZE * sizeof (word36),
+                      MEM_PAGE_WORDS * sizeof (word36), map) == 0)
+      return;
+#endif
+    memset (map, 1, MEM_PAGES);
+  }
 
 uint set_cpu_idx (UNUSED uint cpu_idx)
   {
@@ -635,16 +682,23 @@ void cpu_reset_unit_idx (UNUSED uint cpun, bool clear_mem)
                 // Clear lock bits
                 for (uint i = 0; i < SCU_MEM_SIZE; i ++)
                   {
-                    //scu [sci_unit_idx].M[i] = MEM_UNINITIALIZED;
-                    scu [sci_unit_idx].M[i] &= (MASK36 | MEM_UNINITIALIZED);
+                    scu [sci_unit_idx].M[i] &= MASK36;
                   }
               }
           }
 #else
-        for (uint i = 0; i < MEMSIZE; i ++)
+        // Clear lock bits. Only pages that have been written can hold any,
+        // and words are only stored to if they need it, so that untouched
+        // memory is neither read nor committed.
+        static uint8 in_use [MEM_PAGES];
+        mem_in_use (in_use);
+        for (uint pg = 0; pg < MEM_PAGES; pg ++)
           {
-            //M [i] = MEM_UNINITIALIZED;
-            M[i] &= (MASK36 | MEM_UNINITIALIZED);
+            if (! in_use [pg])
+              continue;
+            for (uint i = pg * MEM_PAGE_WORDS; i < (pg + 1) * MEM_PAGE_WORDS; i ++)
+              if (M[i] & ~MASK36)
+                M[i] &= MASK36;
           }
 #endif
       }
@@ -691,6 +745,13 @@ void cpu_reset_unit_idx (UNUSED uint cpun, bool clear_mem)
 
     memset (& cpu.PPR, 0, sizeof (struct ppr_s));
 
+#ifdef DECODE_CACHE
+    decode_cache_flush ();
+#endif
+#ifdef APU_TLB
+    apu_tlb_flush ();
+#endif
+
     setup_scbank_map ();
 
     tidy_cu ();
@@ -721,8 +782,12 @@ static t_stat simh_cpu_reset_and_clear_unit (UNUSED UNIT * uptr,
             int os = cpun->scbank_pg_os [pgnum];
             if (os < 0)
               continue;
-            for (uint addr = 0; addr < SCBANK; addr ++)
-              M [addr + (uint) os] = MEM_UNINITIALIZED;
+            memset ((void *) & M [os], 0, SCBANK * sizeof (word36));
+#ifndef LOCKLESS
+            for (uint pg = (uint) os / MEM_PAGE_WORDS;
+                 pg < ((uint) os + SCBANK) / MEM_PAGE_WORDS; pg ++)
+              mem_uninit [pg / 64] |= 1llu << (pg % 64);
+#endif
           }
       }
 #else
@@ -745,6 +810,13 @@ static t_stat simh_cpu_reset_unit (UNIT * uptr,
 #ifndef NO_EV_POLL
 static uv_loop_t * ev_poll_loop;
 static uv_timer_t ev_poll_handle;
+static uv_timer_t ev_slow_handle;
+static uv_async_t ev_poll_async;
+static bool ev_poll_async_inited = false;
+static bool ev_slow_wanted = false;
+#if !defined(THREADZ) && !defined(LOCKLESS)
+static uv_timer_t ev_idle_handle;
+#endif
 #endif
 
 static MTAB cpu_mod[] =
@@ -921,7 +993,39 @@ const char *sim_stop_messages[] =
  */
 
 #ifndef SPEED
-static bool watch_bits [MEMSIZE];
+// Watched addresses. Only a handful are ever set, so they are kept in a
+// hash, fronted by a bitmap of the memory pages that hold any of them.
+
+struct watch_s
+  {
+    uint addr;
+    UT_hash_handle hh;
+  };
+
+static struct watch_s * watch_set = NULL;
+static uint64 watch_pages [MEM_PAGES / 64];
+
+static bool mem_watched (word24 addr)
+  {
+    uint pg = addr / MEM_PAGE_WORDS;
+    if (! (watch_pages [pg / 64] & (1llu << (pg % 64))))
+      return false;
+    uint key = addr;
+    struct watch_s * w;
+    HASH_FIND_INT (watch_set, & key, w);
+    return w != NULL;
+  }
+
+static void mem_watch_clear (void)
+  {
+    struct watch_s * w, * tmp;
+    HASH_ITER (hh, watch_set, w, tmp)
+      {
+        HASH_DEL (watch_set, w);
+        free (w);
+      }
+    memset (watch_pages, 0, sizeof (watch_pages));
+  }
 #endif
 
 // XXX PPR.IC oddly incremented. ticket #6
@@ -1150,38 +1254,100 @@ static void do_stats (void)
 #endif
 
 #ifndef NO_EV_POLL
-// The 100Hz timer as expired; poll I/O
+// Devices with their own handles (sockets, absi, the keyboard, the
+// remote access ports) are serviced by their callbacks; this pass
+// covers the rest, and runs when a device asks for it (ev_poll_kick) or
+// when an FNP delay counter needs a tick. The tick timer is armed only
+// while one of those counters is running.
 
-static void ev_poll_cb (uv_timer_t * UNUSED handle)
-  {
-    // Call the one hertz stuff every 100 loops
-    static uint oneHz = 0;
-    if (oneHz ++ >= sys_opts.sys_slow_poll_interval) // ~ 1Hz
-      {
-        oneHz = 0;
-        rdrProcessEvent (); 
-#ifdef STATS
-        do_stats ();
-#endif
-        cpu.instrCntT0 = cpu.instrCntT1;
-        cpu.instrCntT1 = cpu.instrCnt;
+static void ev_poll_cb (uv_timer_t * handle);
+static void ev_slow_cb (uv_timer_t * handle);
 
-      }
-    fnpProcessEvent (); 
+static void ev_poll_pass (bool tick)
+  {
+    bool fnp_tick = fnpProcessEvent (tick);
 #ifndef __MINGW64__
-    sk_process_event (); 
+    sk_process_event ();
 #endif
     consoleProcess ();
     machine_room_process ();
 #ifdef IO_ASYNC_PAYLOAD_CHAN
     iomProcess ();
 #endif
-#ifndef __MINGW64__
-    absi_process_event ();
+#ifdef DISK_ASYNC
+    dsk_process_event ();
 #endif
     PNL (panel_process_event ());
+
+    if (fnp_tick && ! uv_is_active ((uv_handle_t *) & ev_poll_handle))
+      uv_timer_start (& ev_poll_handle, ev_poll_cb,
+                      sys_opts.sys_poll_interval, 0);
+    if (__atomic_load_n (& ev_slow_wanted, __ATOMIC_ACQUIRE) &&
+        ! uv_is_active ((uv_handle_t *) & ev_slow_handle))
+      {
+        uint64_t ms = (uint64_t) sys_opts.sys_slow_poll_interval *
+                      sys_opts.sys_poll_interval;
+        uv_timer_start (& ev_slow_handle, ev_slow_cb, ms, ms);
+      }
+  }
+
+// An FNP delay counter is running; count a tick
+
+static void ev_poll_cb (uv_timer_t * UNUSED handle)
+  {
+    ev_poll_pass (true);
   }
+
+// ~ 1Hz housekeeping; runs once something has asked for it
+// (ev_poll_slow_start)
+
+static void ev_slow_cb (uv_timer_t * UNUSED handle)
+  {
+    rdrProcessEvent (); 
+#ifdef STATS
+    do_stats ();
+#endif
+    cpu.instrCntT0 = cpu.instrCntT1;
+    cpu.instrCntT1 = cpu.instrCnt;
+  }
+
+#if !defined(THREADZ) && !defined(LOCKLESS)
+// Ends a DIS idle wait
+
+static void ev_idle_cb (uv_timer_t * UNUSED handle)
+  {
+  }
+#endif
+
+// A device has work for the CPU side
+
+static void ev_poll_async_cb (uv_async_t * UNUSED handle)
+  {
+    ev_poll_pass (false);
+  }
+#endif
+
+// Ask for an I/O pass as soon as the event loop runs. May be called from
+// any thread, and from a signal handler.
+
+void ev_poll_kick (void)
+  {
+#ifndef NO_EV_POLL
+    if (__atomic_load_n (& ev_poll_async_inited, __ATOMIC_ACQUIRE))
+      uv_async_send (& ev_poll_async);
+#endif
+  }
+
+// Start the once a second housekeeping (card reader queue, statistics,
+// machine room instruction rates). May be called from any thread.
+
+void ev_poll_slow_start (void)
+  {
+#ifndef NO_EV_POLL
+    __atomic_store_n (& ev_slow_wanted, true, __ATOMIC_RELEASE);
+    ev_poll_kick ();
 #endif
+  }
 
     
 // called once initialization
@@ -1231,7 +1397,7 @@ void cpu_init (void)
 #endif
 
 #ifndef SPEED
-    memset (& watch_bits, 0, sizeof (watch_bits));
+    mem_watch_clear ();
 #endif
 
     set_cpu_idx (0);
@@ -1239,13 +1405,40 @@ void cpu_init (void)
     memset (cpus, 0, sizeof (cpu_state_t) * N_CPU_UNITS_MAX);
     cpus [0].switches.FLT_BASE = 2; // Some of the UnitTests assume this
 
+#ifdef DECODE_CACHE
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      {
+        set_cpu_idx (i);
+        decode_cache_flush ();
+      }
+    set_cpu_idx (0);
+#endif
+#ifdef APU_TLB
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      {
+        set_cpu_idx (i);
+        apu_tlb_flush ();
+      }
+    set_cpu_idx (0);
+#endif
+
     get_serial_number ();
 
 #ifndef NO_EV_POLL
     ev_poll_loop = uv_default_loop ();
-    uv_timer_init (ev_poll_loop, & ev_poll_handle);
-    // 10 ms == 100Hz
-    uv_timer_start (& ev_poll_handle, ev_poll_cb, sys_opts.sys_poll_interval, sys_opts.sys_poll_interval);
+    if (! ev_poll_async_inited)
+      {
+        uv_timer_init (ev_poll_loop, & ev_poll_handle);
+        uv_timer_init (ev_poll_loop, & ev_slow_handle);
+#if !defined(THREADZ) && !defined(LOCKLESS)
+        uv_timer_init (ev_poll_loop, & ev_idle_handle);
+#endif
+        uv_async_init (ev_poll_loop, & ev_poll_async, ev_poll_async_cb);
+        __atomic_store_n (& ev_poll_async_inited, true, __ATOMIC_RELEASE);
+      }
+#ifdef STATS
+    ev_poll_slow_start ();
+#endif
 #endif
 
     // TODO: reset *all* other structures to zero
@@ -1323,6 +1516,7 @@ static t_stat cpu_dep (t_value val, t_addr addr, UNUSED UNIT * uptr,
     core_write (addr, w, __func__);
 #else
     M[addr] = val & DMASK;
+    MEM_INIT (addr);
 #endif
     return SCPE_OK;
   }
@@ -1521,11 +1715,71 @@ static void panel_process_event (void)
 bool bce_dis_called = false;
 
 #if defined(THREADZ) || defined(LOCKLESS)
+// The clock queue on this thread (sim_activate) counts milliseconds of
+// wall time rather than loop passes, as the loop sleeps until there is
+// something to do.
+
+static struct timespec ev_poll_charged;
+
+static void ev_poll_charge (void)
+  {
+    struct timespec now;
+    clock_gettime (CLOCK_MONOTONIC, & now);
+    long long ns = (now.tv_sec - ev_poll_charged.tv_sec) * 1000000000LL +
+                   (now.tv_nsec - ev_poll_charged.tv_nsec);
+    long long ms = ns / 1000000LL;
+    if (ms <= 0)
+      return;
+    ev_poll_charged.tv_sec += (time_t) (ms / 1000);
+    ev_poll_charged.tv_nsec += (long) (ms % 1000) * 1000000L;
+    if (ev_poll_charged.tv_nsec >= 1000000000L)
+      {
+        ev_poll_charged.tv_nsec -= 1000000000L;
+        ev_poll_charged.tv_sec ++;
+      }
+    if (ms > NOQUEUE_WAIT)
+      ms = NOQUEUE_WAIT;
+    sim_interval -= (int32) ms;
+  }
+
+// Block until the event loop has I/O or timers due, another thread
+// kicks it (ev_poll_kick; unlock_libuv does this for them), or the next
+// clock queue event is due.
+
+static void ev_poll_wait (void)
+  {
+    if ((breakEnable && stop_cpu) || bce_dis_called)
+      return;
+    lock_libuv ();
+    int timeout = uv_backend_timeout (ev_poll_loop);
+    unlock_libuv ();
+    if (sim_interval <= 0)
+      timeout = 0;
+    else if (timeout < 0 || timeout > sim_interval)
+      timeout = sim_interval;
+#ifdef __MINGW64__
+    // No pollable backend; wait out a clock queue tick
+    if (timeout > 0)
+      usleep (1000);
+#else
+    int fd = uv_backend_fd (ev_poll_loop);
+    fd_set rfds;
+    FD_ZERO (& rfds);
+    FD_SET (fd, & rfds);
+    struct timeval tv;
+    tv.tv_sec = timeout / 1000;
+    tv.tv_usec = (timeout % 1000) * 1000;
+    (void) select (fd + 1, & rfds, NULL, NULL, & tv);
+#endif
+  }
+
 // The hypervisor CPU for the threadz model
 t_stat sim_instr (void)
   {
     t_stat reason = 0;
 
+    clock_gettime (CLOCK_MONOTONIC, & ev_poll_charged);
+
 #if 0
     static bool inited = false;
     if (! inited)
@@ -1575,12 +1829,16 @@ t_stat sim_instr (void)
     do
       {
         reason = 0;
+        ev_poll_charge ();
         // Process deferred events and breakpoints
         reason = simh_hooks ();
         if (reason)
           {
             break;
           }
+        // simh_hooks charged this pass a count; ev_poll_charge has
+        // already charged the time it took
+        sim_interval ++;
 
 #if 0
 // Check for CPU 0 stopped
@@ -1611,8 +1869,6 @@ t_stat sim_instr (void)
         if (bce_dis_called)
           return STOP_STOP;
 
-// Loop runs at 1000 Hz
-
 #ifdef LOCKLESS
         lock_iom();
 #endif
@@ -1657,7 +1913,7 @@ t_stat sim_instr (void)
           }
         while ((next_time.tv_sec == new_time.tv_sec) ? (next_time.tv_nsec > new_time.tv_nsec) : (next_time.tv_sec > new_time.tv_sec));
 #else
-        usleep (1000); // 1000 us == 1 ms == 1/1000 sec.
+        ev_poll_wait ();
 #endif
       }
     while (reason == 0);
@@ -1809,79 +2065,14 @@ static bool clear_temporary_absolute_mode (void)
     //return cpu.went_appending;
   }
 
-t_stat threadz_sim_instr (void)
-  {
-//cpu.have_tst_lock = false;
+// The fetch/execute loop proper. It is kept out of threadz_sim_instr so
+// that the setjmp there does not force the compiler to treat this whole
+// function as returning twice; a fault longjmps out of here and the loop
+// is simply called again.
 
+static t_stat NO_INLINE run_cpu_cycles (void)
+  {
     t_stat reason = 0;
-      
-#if !defined(THREADZ) && !defined(LOCKLESS)
-    set_cpu_idx (0);
-#ifdef M_SHARED
-// simh needs to have the IC statically allocated, so a placeholder was
-// created. Copy the placeholder in so the IC can be set by simh.
-
-    cpus [0].PPR.IC = dummy_IC;
-#endif
-
-#ifdef ROUND_ROBIN
-    cpu.isRunning = true;
-    set_cpu_idx (cpu_dev.numunits - 1);
-
-setCPU:;
-    uint current = current_running_cpu_idx;
-    uint c;
-    for (c = 0; c < cpu_dev.numunits; c ++)
-      {
-        set_cpu_idx (c);
-        if (cpu.isRunning)
-          break;
-      }
-    if (c == cpu_dev.numunits)
-      {
-        sim_msg ("All CPUs stopped\n");
-        goto leave;
-      }
-    set_cpu_idx ((current + 1) % cpu_dev.numunits);
-    if (! cpu . isRunning)
-      goto setCPU;
-#endif
-#endif
-
-    // This allows long jumping to the top of the state machine
-    int val = setjmp (cpu.jmpMain);
-
-    switch (val)
-      {
-        case JMP_ENTRY:
-        case JMP_REENTRY:
-            reason = 0;
-            break;
-        case JMP_SYNC_FAULT_RETURN:
-            set_cpu_cycle (SYNC_FAULT_RTN_cycle);
-            break;
-        case JMP_STOP:
-            reason = STOP_STOP;
-            goto leave;
-        case JMP_REFETCH:
-
-            // Not necessarily so, but the only times
-            // this path is taken is after an RCU returning
-            // from an interrupt, which could only happen if
-            // was xfer was false; or in a DIS cycle, in
-            // which case we want it false so interrupts 
-            // can happen.
-            cpu.wasXfer = false;
-             
-            set_cpu_cycle (FETCH_cycle);
-            break;
-        case JMP_RESTART:
-            set_cpu_cycle (EXEC_cycle);
-            break;
-        default:
-          sim_warn ("longjmp value of %d unhandled\n", val);
-            goto leave;
-      }
 
     // Main instruction fetch/decode loop 
 
@@ -1941,7 +2132,7 @@ setCPU:;
         if (queueSubsample ++ > 10240) // ~ 100Hz
           {
             queueSubsample = 0;
-            fnpProcessEvent ();
+            fnpProcessEvent (true);
             consoleProcess ();
             machine_room_process ();
             absi_process_event ();
@@ -1953,9 +2144,6 @@ setCPU:;
         cpu.cycleCnt ++;
 
 #ifdef THREADZ
-        // If we faulted somewhere with the memory lock set, clear it.
-        unlock_mem_force ();
-
         // wait on run/switch
         cpuRunningWait ();
 #endif // THREADZ
@@ -2351,7 +2539,8 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "fetchCycle bit 29 sets XSF to 0\n");
                 cpu.TPR.TRR = cpu.PPR.PRR;
                 PNL (cpu.prepare_state = ps_PIA);
                 PNL (L68_ (cpu.INS_FETCH = true;))
-                fetchInstruction (cpu.PPR.IC);
+                if (fetchInstruction (cpu.PPR.IC))
+                  break; // page or segment fault; now in FAULT_cycle
               }
 
             CPT (cpt1U, 21); // go to exec cycle
@@ -2390,6 +2579,8 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "fetchCycle bit 29 sets XSF to 0\n");
                 cpu.wasInhibited = true;
 
               t_stat ret = executeInstruction ();
+              if (ret == CONT_FAULT)
+                break; // page or segment fault; now in FAULT_cycle
 #ifdef TR_WORK_EXEC
               cpu.rTRticks ++;
 #endif
@@ -2505,9 +2696,9 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "fetchCycle bit 29 sets XSF to 0\n");
 // The goal of the polling code is sample at about 100Hz; updating the timer
 // register at that rate should suffice.
 //
-//    sleep for 1/100 of a second
+//    wait for I/O, at most 1/100 of a second
 //    update the polling state to trigger a poll
-//    update the timer register by 1/100 of a second
+//    update the timer register by the time waited
 //    force the simh queues to process
 //    continue processing
 //
@@ -2554,13 +2745,18 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "fetchCycle bit 29 sets XSF to 0\n");
                     }
                   cpu.rTR = (cpu.rTR - ticks) & MASK27;
 #else // !NO_TIMEWAIT
+                  // Block until an interrupt or fault is posted to this
+                  // CPU (wakeCPU) or the timer register would run out;
+                  // the register is then brought up to date from the
+                  // time actually slept.
                   unsigned long left = cpu.rTR * 125u / 64u;
                   lock_scu ();
-                  if (!sample_interrupts ())
+                  bool pending = sample_interrupts ();
+                  unlock_scu ();
+                  if (! pending)
                     {
                       left = sleepCPU (left);
                     }
-                  unlock_scu ();
                   if (left)
                     {
                       cpu.rTR = (word27) (left * 64 / 125);
@@ -2574,29 +2770,39 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "fetchCycle bit 29 sets XSF to 0\n");
                                       fst_zero);
                           unlock_scu ();
                         }
-                      cpu.rTR = 0;
+                      // The register keeps counting through zero; leaving
+                      // it at zero would make a DIS that has TRO
+                      // inhibited spin here.
+                      cpu.rTR = MASK27;
                     }
 #endif // !NO_TIMEWAIT
                   cpu.rTRticks = 0;
                   break;
 #else // !THREADZ
-                  //usleep (10000);
-                  usleep (sys_opts.sys_poll_interval * 1000/*10000*/);
 #ifndef NO_EV_POLL
-                  // Trigger I/O polling
-#ifdef CONSOLE_FIX
-#if defined(THREADZ) || defined(LOCKLESS)
-                  lock_libuv ();
-#endif
-#endif
-                  uv_run (ev_poll_loop, UV_RUN_NOWAIT);
-#ifdef CONSOLE_FIX
-#if defined(THREADZ) || defined(LOCKLESS)
-                  unlock_libuv ();
-#endif
-#endif
+                  // Wait for I/O, bounded by the timer register
+                  // running out; while the clock queue has an event
+                  // pending, by sys_poll_interval, as idling moves the
+                  // queue on to its next event.
+                  uint64_t idle_ms = cpu.rTR / 512u + 1;
+                  if (sim_clock_queue != QUEUE_LIST_END &&
+                      idle_ms > sys_opts.sys_poll_interval)
+                    idle_ms = sys_opts.sys_poll_interval;
+                  struct timespec idle_start, idle_end;
+                  clock_gettime (CLOCK_MONOTONIC, & idle_start);
+                  uv_timer_start (& ev_idle_handle, ev_idle_cb, idle_ms, 0);
+                  uv_run (ev_poll_loop, UV_RUN_ONCE);
+                  uv_timer_stop (& ev_idle_handle);
+                  clock_gettime (CLOCK_MONOTONIC, & idle_end);
+                  // Timer register runs at 512 KHz; 512 ticks per ms
+                  long idle_us = (idle_end.tv_sec - idle_start.tv_sec) * 1000000L +
+                                 (idle_end.tv_nsec - idle_start.tv_nsec) / 1000L;
+                  word27 idle_ticks = (word27) ((idle_us * 512) / 1000);
                   fast_queue_subsample = 0;
 #else // NO_EV_POLL
+                  //usleep (10000);
+                  usleep (sys_opts.sys_poll_interval * 1000/*10000*/);
+                  word27 idle_ticks = sys_opts.sys_poll_interval * 512;
                   // this ignores the amount of time since the last poll;
                   // worst case is the poll delay of 1/50th of a second.
                   slowQueueSubsample += 10240; // ~ 1Hz
@@ -2604,7 +2810,6 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "fetchCycle bit 29 sets XSF to 0\n");
 #endif // NO_EV_POLL
 
                   sim_interval = 0;
-#endif // !THREADZ
                   // Timer register runs at 512 KHz
                   // 512000 is 1 second
                   // 512000/100 -> 5120  is .01 second
@@ -2616,13 +2821,14 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "fetchCycle bit 29 sets XSF to 0\n");
 
                   // Timer register runs at 512 KHz
                   // 512Khz / 512 is millisecods
-                  if (cpu.rTR <= sys_opts.sys_poll_interval * 512)
+                  if (cpu.rTR <= idle_ticks)
                     {
                       if (cpu.switches.tro_enable)
                         setG7fault (current_running_cpu_idx, FAULT_TRO,
                                     fst_zero);
                     }
-                  cpu.rTR = (cpu.rTR - sys_opts.sys_poll_interval * 512) & MASK27;
+                  cpu.rTR = (cpu.rTR - idle_ticks) & MASK27;
+#endif // !THREADZ
 #endif // ! ROUND_ROBIN
                   break;
                 }
@@ -2867,11 +3073,95 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "fetchCycle bit 29 sets XSF to 0\n");
       } 
 #ifdef ROUND_ROBIN
     while (0);
-    if (reason == 0)
-      goto setCPU;
 #else
     while (reason == 0);
 #endif
+    return reason;
+  }
+
+t_stat threadz_sim_instr (void)
+  {
+//cpu.have_tst_lock = false;
+
+    t_stat reason = 0;
+      
+#if !defined(THREADZ) && !defined(LOCKLESS)
+    set_cpu_idx (0);
+#ifdef M_SHARED
+// simh needs to have the IC statically allocated, so a placeholder was
+// created. Copy the placeholder in so the IC can be set by simh.
+
+    cpus [0].PPR.IC = dummy_IC;
+#endif
+
+#ifdef ROUND_ROBIN
+    cpu.isRunning = true;
+    set_cpu_idx (cpu_dev.numunits - 1);
+
+setCPU:;
+    uint current = current_running_cpu_idx;
+    uint c;
+    for (c = 0; c < cpu_dev.numunits; c ++)
+      {
+        set_cpu_idx (c);
+        if (cpu.isRunning)
+          break;
+      }
+    if (c == cpu_dev.numunits)
+      {
+        sim_msg ("All CPUs stopped\n");
+        goto leave;
+      }
+    set_cpu_idx ((current + 1) % cpu_dev.numunits);
+    if (! cpu . isRunning)
+      goto setCPU;
+#endif
+#endif
+
+    // This allows long jumping to the top of the state machine
+    int val = cpu_setjmp (cpu.jmpMain);
+
+    // A fault that unwinds from inside a Read/Write bracketed for status
+    // returns leaves this set
+    cpu.apu.df_return = false;
+
+    switch (val)
+      {
+        case JMP_ENTRY:
+        case JMP_REENTRY:
+            reason = 0;
+            break;
+        case JMP_SYNC_FAULT_RETURN:
+            set_cpu_cycle (SYNC_FAULT_RTN_cycle);
+            break;
+        case JMP_STOP:
+            reason = STOP_STOP;
+            goto leave;
+        case JMP_REFETCH:
+
+            // Not necessarily so, but the only times
+            // this path is taken is after an RCU returning
+            // from an interrupt, which could only happen if
+            // was xfer was false; or in a DIS cycle, in
+            // which case we want it false so interrupts 
+            // can happen.
+            cpu.wasXfer = false;
+             
+            set_cpu_cycle (FETCH_cycle);
+            break;
+        case JMP_RESTART:
+            set_cpu_cycle (EXEC_cycle);
+            break;
+        default:
+          sim_warn ("longjmp value of %d unhandled\n", val);
+            goto leave;
+      }
+
+    reason = run_cpu_cycles ();
+#ifdef ROUND_ROBIN
+    if (reason == 0)
+      goto setCPU;
+#endif
 
 leave:
 
@@ -2889,6 +3179,14 @@ leave:
     sim_msg ("lockWait      %15"PRIu64"\n", cpu.lockWait);
     sim_msg ("lockWaitMax   %15"PRIu64"\n", cpu.lockWaitMax);
     sim_msg ("lockYield     %15"PRIu64"\n", cpu.lockYield);
+#ifdef DECODE_CACHE
+    sim_msg ("decodeHits    %15"PRIu64"\n", cpu.decodeHits);
+    sim_msg ("decodeMisses  %15"PRIu64"\n", cpu.decodeMisses);
+#endif
+#ifdef APU_TLB
+    sim_msg ("tlbHits       %15"PRIu64"\n", cpu.tlbHits);
+    sim_msg ("tlbMisses     %15"PRIu64"\n", cpu.tlbMisses);
+#endif
 #if 0
     for (int i = 0; i < N_FAULTS; i ++)
       {
@@ -2953,36 +3251,24 @@ int operand_size (void)
 t_stat read_operand (word18 addr, processor_cycle_type cyctyp)
   {
     CPT (cpt1L, 6); // read_operand
-
-#ifdef THREADZ
-    if (cyctyp == OPERAND_READ)
-      {
-        DCDstruct * i = & cpu.currentInstruction;
-#if 1
-        if (RMWOP (i))
-#else
-        if ((i -> opcode == 0034 && ! i -> opcodeX) ||  // ldac
-            (i -> opcode == 0032 && ! i -> opcodeX) ||  // ldqc
-            (i -> opcode == 0354 && ! i -> opcodeX) ||  // stac
-            (i -> opcode == 0654 && ! i -> opcodeX) ||  // stacq
-            (i -> opcode == 0214 && ! i -> opcodeX))    // sznc
-#endif
-          {
-            lock_rmw ();
-          }
-      }
-#endif
+    bool faulted = false;
 
     switch (operand_size ())
       {
         case 1:
             CPT (cpt1L, 7); // word
-            Read (addr, & cpu.CY, cyctyp);
-            return SCPE_OK;
+            // Page and segment faults on single and double word operands
+            // come back as CONT_FAULT rather than unwinding
+            cpu.apu.df_return = true;
+            faulted = Read (addr, & cpu.CY, cyctyp);
+            cpu.apu.df_return = false;
+            break;
         case 2:
             CPT (cpt1L, 8); // double word
             addr &= 0777776;   // make even
-            Read2 (addr, cpu.Ypair, cyctyp);
+            cpu.apu.df_return = true;
+            faulted = Read2 (addr, cpu.Ypair, cyctyp);
+            cpu.apu.df_return = false;
             break;
         case 8:
             CPT (cpt1L, 9); // oct word
@@ -3004,7 +3290,7 @@ t_stat read_operand (word18 addr, processor_cycle_type cyctyp)
       }
     //cpu.TPR.CA = addr;  // restore address
     
-    return SCPE_OK;
+    return faulted ? CONT_FAULT : SCPE_OK;
 
   }
 
@@ -3012,16 +3298,21 @@ t_stat read_operand (word18 addr, processor_cycle_type cyctyp)
 
 t_stat write_operand (word18 addr, UNUSED processor_cycle_type cyctyp)
   {
+    bool faulted = false;
     switch (operand_size ())
       {
         case 1:
             CPT (cpt1L, 12); // word
-            Write (addr, cpu.CY, OPERAND_STORE);
+            cpu.apu.df_return = true;
+            faulted = Write (addr, cpu.CY, OPERAND_STORE);
+            cpu.apu.df_return = false;
             break;
         case 2:
             CPT (cpt1L, 13); // double word
             addr &= 0777776;   // make even
-            Write2 (addr + 0, cpu.Ypair, OPERAND_STORE);
+            cpu.apu.df_return = true;
+            faulted = Write2 (addr + 0, cpu.Ypair, OPERAND_STORE);
+            cpu.apu.df_return = false;
             break;
         case 8:
             CPT (cpt1L, 14); // 8 words
@@ -3042,15 +3333,7 @@ t_stat write_operand (word18 addr, UNUSED processor_cycle_type cyctyp)
             break;
       }
     
-#ifdef THREADZ
-    if (cyctyp == OPERAND_STORE)
-      {
-        DCDstruct * i = & cpu.currentInstruction;
-        if (RMWOP (i))
-          unlock_mem ();
-      }
-#endif
-    return SCPE_OK;
+    return faulted ? CONT_FAULT : SCPE_OK;
     
   }
 
@@ -3065,7 +3348,7 @@ t_stat set_mem_watch (int32 arg, const char * buf)
             return SCPE_ARG;
           }
         sim_msg ("Clearing all watch points\n");
-        memset (& watch_bits, 0, sizeof (watch_bits));
+        mem_watch_clear ();
         return SCPE_OK;
       }
     char * end;
@@ -3075,7 +3358,29 @@ t_stat set_mem_watch (int32 arg, const char * buf)
         sim_warn ("invalid argument to watch?\n");
         return SCPE_ARG;
       }
-    watch_bits [n] = arg != 0;
+    uint key = (uint) n;
+    struct watch_s * w;
+    HASH_FIND_INT (watch_set, & key, w);
+    if (arg && ! w)
+      {
+        w = malloc (sizeof (struct watch_s));
+        if (! w)
+          return SCPE_MEM;
+        w->addr = key;
+        HASH_ADD_INT (watch_set, addr, w);
+      }
+    else if (! arg && w)
+      {
+        HASH_DEL (watch_set, w);
+        free (w);
+      }
+
+    // Rebuild the page's bit from the addresses still watched in it
+    uint pg = key / MEM_PAGE_WORDS;
+    watch_pages [pg / 64] &= ~(1llu << (pg % 64));
+    for (w = watch_set; w; w = w->hh.next)
+      if (w->addr / MEM_PAGE_WORDS == pg)
+        watch_pages [pg / 64] |= 1llu << (pg % 64);
     return SCPE_OK;
   }
 #endif
@@ -3158,7 +3463,7 @@ int32 core_read (word24 addr, word36 *data, const char * ctx)
     LOCK_MEM_RD;
     *data = scu [scu_unit_idx].M[offset] & DMASK;
     UNLOCK_MEM;
-    if (watch_bits [addr])
+    if (mem_watched (addr))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o read   %08o %012"PRIo64" "
                     "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC, addr,
@@ -3166,7 +3471,7 @@ int32 core_read (word24 addr, word36 *data, const char * ctx)
       }
 #else
 #ifndef LOCKLESS
-    if (M[addr] & MEM_UNINITIALIZED)
+    if (MEM_UNINIT (addr))
       {
         sim_debug (DBG_WARN, & cpu_dev,
                    "Unitialized memory accessed at address %08o; "
@@ -3175,7 +3480,7 @@ int32 core_read (word24 addr, word36 *data, const char * ctx)
       }
 #endif
 #ifndef SPEED
-    if (watch_bits [addr])
+    if (mem_watched (addr))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o read   %08o %012"PRIo64" "
                     "(%s)\n",
@@ -3278,7 +3583,7 @@ int core_write (word24 addr, word36 data, const char * ctx)
     LOCK_MEM_WR;
     scu[sci_unit_idx].M[offset] = data & DMASK;
     UNLOCK_MEM;
-    if (watch_bits [addr])
+    if (mem_watched (addr))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o write   %08o %012"PRIo64" "
                     "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC, addr, 
@@ -3291,10 +3596,11 @@ int core_write (word24 addr, word36 data, const char * ctx)
 #else
     LOCK_MEM_WR;
     M[addr] = data & DMASK;
+    MEM_INIT (addr);
     UNLOCK_MEM;
 #endif
 #ifndef SPEED
-    if (watch_bits [addr])
+    if (mem_watched (addr))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o write  %08o %012"PRIo64" "
                     "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC, addr, 
@@ -3383,7 +3689,7 @@ int core_write_zone (word24 addr, word36 data, const char * ctx)
                               (data & cpu.zone);
     UNLOCK_MEM;
     cpu.useZone = false; // Safety
-    if (watch_bits [addr])
+    if (mem_watched (addr))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o writez %08o %012"PRIo64" "
                     "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC, addr, 
@@ -3414,11 +3720,12 @@ int core_write_zone (word24 addr, word36 data, const char * ctx)
 #endif
     LOCK_MEM_WR;
     M[addr] = (M[addr] & ~cpu.zone) | (data & cpu.zone);
+    MEM_INIT (addr);
     UNLOCK_MEM;
 #endif
     cpu.useZone = false; // Safety
 #ifndef SPEED
-    if (watch_bits [addr])
+    if (mem_watched (addr))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o writez %08o %012"PRIo64" "
                     "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC, addr, 
@@ -3487,7 +3794,7 @@ int core_read2 (word24 addr, word36 *even, word36 *odd, const char * ctx)
     *even = scu [sci_unit_idx].M[offset++] & DMASK;
     UNLOCK_MEM;
 #ifndef SPEED
-    if (watch_bits [addr])
+    if (mem_watched (addr))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o read2  %08o %012"PRIo64" "
                     "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC, addr,
@@ -3502,7 +3809,7 @@ int core_read2 (word24 addr, word36 *even, word36 *odd, const char * ctx)
     *odd = scu [sci_unit_idx].M[offset] & DMASK;
     UNLOCK_MEM;
 #ifndef SPEED
-    if (watch_bits [addr+1])
+    if (mem_watched (addr+1))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o read2  %08o %012"PRIo64" "
                     "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC, addr+1,
@@ -3515,7 +3822,7 @@ int core_read2 (word24 addr, word36 *even, word36 *odd, const char * ctx)
                 addr+1, * odd, ctx);
 #else
 #ifndef LOCKLESS
-    if (M[addr] & MEM_UNINITIALIZED)
+    if (MEM_UNINIT (addr))
       {
         sim_debug (DBG_WARN, & cpu_dev,
                    "Unitialized memory accessed at address %08o; "
@@ -3524,7 +3831,7 @@ int core_read2 (word24 addr, word36 *even, word36 *odd, const char * ctx)
       }
 #endif
 #ifndef SPEED
-    if (watch_bits [addr])
+    if (mem_watched (addr))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o read2  %08o %012"PRIo64" "
                     "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC, addr, 
@@ -3553,7 +3860,7 @@ int core_read2 (word24 addr, word36 *even, word36 *odd, const char * ctx)
     // if the even address is OK, the odd will be
     //nem_check (addr,  "core_read2 nem");
 #ifndef LOCKLESS
-    if (M[addr] & MEM_UNINITIALIZED)
+    if (MEM_UNINIT (addr))
       {
         sim_debug (DBG_WARN, & cpu_dev,
                    "Unitialized memory accessed at address %08o; "
@@ -3562,7 +3869,7 @@ int core_read2 (word24 addr, word36 *even, word36 *odd, const char * ctx)
       }
 #endif
 #ifndef SPEED
-    if (watch_bits [addr])
+    if (mem_watched (addr))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o read2  %08o %012"PRIo64" "
                     "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC, addr,
@@ -3638,7 +3945,7 @@ int core_write2 (word24 addr, word36 even, word36 odd, const char * ctx)
     word24 offset;
     uint sci_unit_idx = get_scu_unit_idx (addr, & offset);
     scu [sci_unit_idx].M[offset++] = even & DMASK;
-    if (watch_bits [addr])
+    if (mem_watched (addr))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o write2 %08o %012"PRIo64" "
                     "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC, addr,
@@ -3647,7 +3954,7 @@ int core_write2 (word24 addr, word36 even, word36 odd, const char * ctx)
     LOCK_MEM_WR;
     scu [sci_unit_idx].M[offset] = odd & DMASK;
     UNLOCK_MEM;
-    if (watch_bits [addr+1])
+    if (mem_watched (addr+1))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o write2 %08o %012"PRIo64" "
                     "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC, addr+1,
@@ -3655,7 +3962,7 @@ int core_write2 (word24 addr, word36 even, word36 odd, const char * ctx)
       }
 #else
 #ifndef SPEED
-    if (watch_bits [addr])
+    if (mem_watched (addr))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o write2 %08o %012"PRIo64" "
                     "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC, addr,
@@ -3669,6 +3976,7 @@ int core_write2 (word24 addr, word36 even, word36 odd, const char * ctx)
     addr++;
 #else
     LOCK_MEM_WR;
+    MEM_INIT (addr);
     M[addr++] = even & DMASK;
     UNLOCK_MEM;
 #endif
@@ -3680,7 +3988,7 @@ int core_write2 (word24 addr, word36 even, word36 odd, const char * ctx)
     //nem_check (addr,  "core_write2 nem");
 
 #ifndef SPEED
-    if (watch_bits [addr])
+    if (mem_watched (addr))
       {
         sim_msg ("WATCH [%"PRId64"] %05o:%06o write2 %08o %012"PRIo64" "
                     "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC, addr,
@@ -3694,6 +4002,7 @@ int core_write2 (word24 addr, word36 even, word36 odd, const char * ctx)
 #else
     LOCK_MEM_WR;
     M[addr] = odd & DMASK;
+    MEM_INIT (addr);
     UNLOCK_MEM;
 #endif
 #endif
@@ -3708,6 +4017,176 @@ int core_write2 (word24 addr, word36 even, word36 odd, const char * ctx)
   }
 #endif
 
+/*
+ * Block transfers
+ *
+ * The range is walked a SCU bank at a time (see setup_scbank_map); the
+ * ISOLTS remap and the NEM check are done once per bank and the words of
+ * the bank are then moved in a tight loop.
+ */
+
+void core_readN (word24 addr, word36 * data, uint n, const char * ctx)
+  {
+#ifdef SCUMEM
+    for (uint i = 0; i < n; i ++)
+      {
+        core_read (addr + i, data + i, ctx);
+        HDBGMRead (addr + i, data [i]);
+      }
+#else
+    PNL (cpu.portBusy = true;)
+    while (n)
+      {
+        uint run = SCBANK - addr % SCBANK;
+        if (run > n)
+          run = n;
+        word24 paddr = addr;
+#ifdef ISOLTS
+        if (cpu.switches.useMap)
+          {
+            int os = cpu.scbank_pg_os [addr / SCBANK];
+            if (os < 0)
+              {
+                doFault (FAULT_STR, fst_str_nea,  __func__);
+              }
+            paddr = (uint) os + addr % SCBANK;
+          }
+#endif
+#ifndef SPEED
+#ifdef ISOLTS
+        else
+#endif
+          nem_check (addr,  "core_readN nem");
+#endif
+        for (uint i = 0; i < run; i ++)
+          {
+#ifdef LOCKLESS
+            word36 v;
+            LOAD_ACQ_CORE_WORD (v, paddr + i);
+            data [i] = v & DMASK;
+#else
+            data [i] = M [paddr + i] & DMASK;
+#endif
+          }
+#ifndef SPEED
+        for (uint i = 0; i < run; i ++)
+          {
+            if (mem_watched (paddr + i))
+              {
+                sim_msg ("WATCH [%"PRId64"] %05o:%06o read   %08o %012"PRIo64" "
+                         "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC,
+                         paddr + i, data [i], ctx);
+                traceInstruction (0);
+              }
+          }
+#endif
+        if_sim_debug (DBG_CORE, & cpu_dev)
+          {
+            for (uint i = 0; i < run; i ++)
+              sim_debug (DBG_CORE, & cpu_dev,
+                         "core_readN %08o %012"PRIo64" (%s)\n",
+                         paddr + i, data [i], ctx);
+          }
+        for (uint i = 0; i < run; i ++)
+          HDBGMRead (addr + i, data [i]);
+#ifdef TR_WORK_MEM
+        cpu.rTRticks += run;
+#endif
+        PNL (trackport (paddr + run - 1, data [run - 1]));
+        addr += run;
+        data += run;
+        n -= run;
+      }
+#endif
+  }
+
+void core_writeN (word24 addr, word36 * data, uint n, const char * ctx)
+  {
+#ifdef SCUMEM
+    for (uint i = 0; i < n; i ++)
+      {
+        core_write (addr + i, data [i], ctx);
+      }
+#else
+    PNL (cpu.portBusy = true;)
+#ifdef ISOLTS
+    if (cpu.MR.sdpap)
+      {
+        sim_warn ("failing to implement sdpap\n");
+        cpu.MR.sdpap = 0;
+      }
+    if (cpu.MR.separ)
+      {
+        sim_warn ("failing to implement separ\n");
+        cpu.MR.separ = 0;
+      }
+#endif
+    while (n)
+      {
+        uint run = SCBANK - addr % SCBANK;
+        if (run > n)
+          run = n;
+        word24 paddr = addr;
+#ifdef ISOLTS
+        if (cpu.switches.useMap)
+          {
+            int os = cpu.scbank_pg_os [addr / SCBANK];
+            if (os < 0)
+              {
+                doFault (FAULT_STR, fst_str_nea,  __func__);
+              }
+            paddr = (uint) os + addr % SCBANK;
+          }
+#endif
+#ifndef SPEED
+#ifdef ISOLTS
+        else
+#endif
+          nem_check (addr,  "core_writeN nem");
+#endif
+        for (uint i = 0; i < run; i ++)
+          {
+#ifdef LOCKLESS
+            // Each word still goes through the lock bit so that a store
+            // cannot land in the middle of another CPU's read-modify-write.
+            word24 a = paddr + i;
+            LOCK_CORE_WORD (a);
+            STORE_REL_CORE_WORD (a, data [i]);
+#else
+            M [paddr + i] = data [i] & DMASK;
+            MEM_INIT (paddr + i);
+#endif
+          }
+#ifndef SPEED
+        for (uint i = 0; i < run; i ++)
+          {
+            if (mem_watched (paddr + i))
+              {
+                sim_msg ("WATCH [%"PRId64"] %05o:%06o write  %08o %012"PRIo64" "
+                         "(%s)\n", cpu.cycleCnt, cpu.PPR.PSR, cpu.PPR.IC,
+                         paddr + i, data [i], ctx);
+                traceInstruction (0);
+              }
+          }
+#endif
+        if_sim_debug (DBG_CORE, & cpu_dev)
+          {
+            for (uint i = 0; i < run; i ++)
+              sim_debug (DBG_CORE, & cpu_dev,
+                         "core_writeN %08o %012"PRIo64" (%s)\n",
+                         paddr + i, data [i], ctx);
+          }
+#ifdef TR_WORK_MEM
+        cpu.rTRticks += run;
+#endif
+        PNL (trackport (paddr + run - 1, data [run - 1]));
+        addr += run;
+        data += run;
+        n -= run;
+      }
+#endif
+  }
+
     
 
 /*
@@ -3750,6 +4229,41 @@ void decode_instruction (word36 inst, DCDstruct * p)
       }
   }
 
+#ifdef DECODE_CACHE
+void decode_cache_flush (void)
+  {
+    for (uint i = 0; i < N_DECODE_CACHE_ENTRIES; i ++)
+      cpu.decode_cache[i].inst = DECODE_CACHE_EMPTY;
+  }
+
+// Hash on the opcode and tag fields mixed with the low address bits; tight
+// loops are dominated by distinct opcodes with small address offsets.
+
+static inline uint decode_cache_hash (word36 inst)
+  {
+    return (uint) ((inst ^ (inst >> 18) ^ (inst >> 27)) & DECODE_CACHE_MASK);
+  }
+
+void decode_instruction_cached (word36 inst, DCDstruct * p)
+  {
+    decode_cache_entry_t * e = & cpu.decode_cache[decode_cache_hash (inst)];
+    if (e->inst == inst)
+      {
+        cpu.decodeHits ++;
+        * p = e->dcd;
+        // Keep the side effect of decode_instruction on the EIS state
+        if (p->info->ndes > 1)
+          memset (& cpu.currentEISinstruction, 0,
+                  sizeof (cpu.currentEISinstruction));
+        return;
+      }
+    cpu.decodeMisses ++;
+    decode_instruction (inst, p);
+    e->inst = inst;
+    e->dcd = * p;
+  }
+#endif
+
 // MM stuff ...
 
 //
@@ -4404,3 +4918,62 @@ void dps8_sim_debug (uint32 dbits, DEVICE * dptr, unsigned long long cnt, const
     //pthread_mutex_unlock (& debug_lock);
   }
 #endif
+
+// Machine snapshot. The CPU state is saved as is. On restore, pointers
+// into the saving emulator's cpus array are moved to this one, pointers
+// to anything else are dropped, and the caches that hold them are
+// flushed.
+
+static void * cpu_snap_rebase (void * ptr, uint64 old, cpu_state_t * now)
+  {
+    uint64 a = (uint64) (uintptr_t) ptr;
+    if (! ptr || a < old || a >= old + sizeof (cpu_state_t))
+      return NULL;
+    return (char *) now + (a - old);
+  }
+
+void cpu_snap (struct snap_s * s, uint64 cpus_base)
+  {
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      {
+        cpu_state_t * p = & cpus[i];
+        cpu_jmp_buf jmpMain;
+        memcpy (jmpMain, p->jmpMain, sizeof (cpu_jmp_buf));
+        if (! snap_io (s, "cpu", p, sizeof (cpu_state_t)))
+          continue;
+        memcpy (p->jmpMain, jmpMain, sizeof (cpu_jmp_buf));
+
+        uint64 old = cpus_base + i * sizeof (cpu_state_t);
+        p->SDW = cpu_snap_rebase (p->SDW, old, p);
+        if (! p->SDW)
+          p->SDW = & p->SDW0;
+        p->PTW = cpu_snap_rebase (p->PTW, old, p);
+        p->currentEISinstruction.in =
+          cpu_snap_rebase (p->currentEISinstruction.in, old, p);
+        p->currentEISinstruction.out =
+          cpu_snap_rebase (p->currentEISinstruction.out, old, p);
+#ifndef EIS_PTR2
+        p->currentEISinstruction.mopAddress =
+          cpu_snap_rebase (p->currentEISinstruction.mopAddress, old, p);
+#endif
+        p->currentEISinstruction.m = NULL;
+        if (p->dlyCtx)
+          p->dlyCtx = "restored";
+        if (p->currentInstruction.info)
+          p->currentInstruction.info =
+            get_iwb_info (& p->currentInstruction);
+
+        uint save = set_cpu_idx (i);
+#ifdef DECODE_CACHE
+        decode_cache_flush ();
+#endif
+#ifdef APU_TLB
+        apu_tlb_flush ();
+#endif
+        set_cpu_idx (save);
+      }
+#ifdef M_SHARED
+    if (snap_restoring (s))
+      dummy_IC = cpus[0].PPR.IC;
+#endif
+  }
@@ -27,6 +27,20 @@
 #define JMP_REFETCH           4
 #define JMP_RESTART           5
 
+// Faults and stops unwind to the top of the CPU loop. The signal mask is
+// never touched by the emulator, so don't have the C library save and
+// restore it on every fault; on the BSDs and OS X a plain setjmp/longjmp
+// pair costs two sigprocmask system calls.
+#if defined(__MINGW32__) || defined(__MINGW64__)
+#define cpu_jmp_buf           jmp_buf
+#define cpu_setjmp(env)       setjmp (env)
+#define cpu_longjmp(env, val) longjmp (env, val)
+#else
+#define cpu_jmp_buf           sigjmp_buf
+#define cpu_setjmp(env)       sigsetjmp (env, 0)
+#define cpu_longjmp(env, val) siglongjmp (env, val)
+#endif
+
 
 // The CPU supports 3 addressing modes
 // [CAC] I tell a lie: 4 modes...
@@ -686,6 +700,47 @@ typedef struct DCDstruct_s
     bool restart;         // instruction is to be restarted
   } DCDstruct;
 
+#ifdef DECODE_CACHE
+// Decoded instruction cache. Decoding is a pure function of the
+// instruction word, so entries are tagged with the word itself; a store
+// into the instruction stream (by any CPU or IOM) simply yields a
+// different word and misses, so the cache never needs invalidating on
+// memory writes.
+
+#define N_DECODE_CACHE_ENTRIES 1024 // Must be a power of 2
+#define DECODE_CACHE_MASK (N_DECODE_CACHE_ENTRIES - 1)
+#define DECODE_CACHE_EMPTY (~ (word36) 0) // Not a valid 36 bit word
+
+typedef struct
+  {
+    word36 inst;          // Instruction word; DECODE_CACHE_EMPTY if unused
+    DCDstruct dcd;        // Decoded instruction
+  } decode_cache_entry_t;
+#endif
+
+#ifdef APU_TLB
+// Appending unit translation cache. Each entry records a segment/page
+// translation that has been through the full do_append_cycle walk,
+// including the ring and access checks, for one effective ring and one
+// kind of access. Like the associative memories it stands in for, it is
+// not snooped; it is flushed by LDBR, CAMS and CAMP.
+
+#define APU_TLB_BITS 8
+#define N_APU_TLB_ENTRIES (1u << APU_TLB_BITS)
+#define APU_TLB_MASK (N_APU_TLB_ENTRIES - 1)
+#define APU_TLB_EMPTY (~ (word32) 0) // Not a valid tag
+
+enum { APU_TLB_READ = 1, APU_TLB_WRITE = 2, APU_TLB_EXEC = 3 };
+
+typedef struct
+  {
+    word32 tag;           // TSR, page, TRR, access; APU_TLB_EMPTY if unused
+    word24 base;          // Page frame or unpaged segment origin
+    word18 offmask;       // Bits of TPR.CA added to base
+    sdw_s sdw;            // SDW the translation was made with
+  } apu_tlb_entry_t;
+#endif
+
 // Emulator-only interrupt and fault info
 
 typedef struct
@@ -723,6 +778,9 @@ typedef struct
     uint serno;
     bool useMap;
     bool disable_cache;
+#ifdef THREADED_DISPATCH
+    bool dispatch_switch; // If set, dispatch through the doInstruction switch
+#endif
   } switches_t;
 
 #ifdef L68
@@ -831,6 +889,11 @@ typedef struct
 #ifdef PANEL
     word34 state;
 #endif
+    // Set around the Read/Write calls on the instruction fetch and operand
+    // paths. A directed fault (missing segment or page) is then set up with
+    // setupFault and reported back as a status instead of unwinding.
+    bool df_return;
+    bool df_taken;
   } apu_unit_data_t;
 
 typedef struct
@@ -1507,7 +1570,7 @@ enum { CUH_XINT = 0100, CUH_IFT = 040, CUH_CRD = 020, CUH_MRD = 010,
 
 typedef struct
   {
-    jmp_buf jmpMain; // This is the entry to the CPU state machine
+    cpu_jmp_buf jmpMain; // This is the entry to the CPU state machine
     cycles_e cycle;
     unsigned long long cycleCnt;
     unsigned long long instrCnt;
@@ -1538,6 +1601,22 @@ typedef struct
                 // XEC instruction
 
     DCDstruct currentInstruction;
+#ifdef DECODE_CACHE
+    decode_cache_entry_t decode_cache [N_DECODE_CACHE_ENTRIES];
+    unsigned long long decodeHits;
+    unsigned long long decodeMisses;
+#endif
+#ifdef APU_TLB
+    apu_tlb_entry_t apu_tlb [N_APU_TLB_ENTRIES];
+    unsigned long long tlbHits;
+    unsigned long long tlbMisses;
+#endif
+#ifdef PROFILER
+    volatile uint prof_flags; // PROF_ON, PROF_TICK
+#endif
+#ifdef BTRACE
+    volatile bool btrace;
+#endif
     EISstruct currentEISinstruction;
 
     events_t events;
@@ -1888,15 +1967,6 @@ static inline void trackport (word24 a, word36 d)
   }
 #endif
 
-#ifdef THREADZ
-// Ugh. Circular dependencies XXX
-void lock_mem_rd (void);
-void lock_mem_wr (void);
-void unlock_mem (void);
-#define LOCK_MEM_RD lock_mem_rd ();
-#define LOCK_MEM_WR lock_mem_wr ();
-#define UNLOCK_MEM unlock_mem ();
-#else // ! THREADZ
 #ifdef TEST_FENCE
 #define LOCK_MEM_RD fence ();
 #define LOCK_MEM_WR fence ();
@@ -1906,7 +1976,29 @@ void unlock_mem (void);
 #define LOCK_MEM_WR
 #define UNLOCK_MEM
 #endif
-#endif // ! THREADZ
+
+// Main memory is committed by the host a page at a time as it is first
+// written; the emulator tracks it in pages of MEM_PAGE_WORDS words.
+#define MEM_PAGE_WORDS 1024
+#define MEM_PAGES (MEMSIZE / MEM_PAGE_WORDS)
+
+// Set map [p] for each memory page that may hold nonzero words
+void mem_in_use (uint8 * map);
+
+#if defined(ISOLTS) && !defined(LOCKLESS)
+// Pages cleared by an ISOLTS reset and not written since; reads from them
+// are reported.
+extern uint64 mem_uninit [MEM_PAGES / 64];
+#define MEM_UNINIT(addr) \
+  ((mem_uninit [(addr) / MEM_PAGE_WORDS / 64] >> \
+    ((addr) / MEM_PAGE_WORDS % 64)) & 1)
+#define MEM_INIT(addr) \
+  (mem_uninit [(addr) / MEM_PAGE_WORDS / 64] &= \
+    ~(1llu << ((addr) / MEM_PAGE_WORDS % 64)))
+#else
+#define MEM_UNINIT(addr) 0
+#define MEM_INIT(addr)
+#endif
 
 #if defined(SPEED) && defined(INLINE_CORE)
 // Ugh. Circular dependencies XXX
@@ -2213,7 +2305,7 @@ int core_unlock_all();
 	{								\
 	  i--;								\
 	  if ((i & 0xff) == 0) {					\
-	    pthread_yield();						\
+	    sched_yield();						\
 	    cpu.lockYield++;						\
 	  }								\
 	}								\
@@ -2260,7 +2352,7 @@ int core_unlock_all();
 	   {								\
 	    i--;							\
 	    if ((i & 0xff) == 0) {					\
-	      pthread_yield();						\
+	      sched_yield();						\
 	      cpu.lockYield++;						\
 	    }								\
 	   }								\
@@ -2295,24 +2387,8 @@ int core_unlock_all();
 #endif  // defined(__FreeBSD__) && !defined(USE_COMPILER_ATOMICS)
 #endif  // LOCKLESS
 
-static inline void core_readN (word24 addr, word36 * data, uint n,
-                               UNUSED const char * ctx)
-  {
-    for (uint i = 0; i < n; i ++)
-      {
-        core_read (addr + i, data + i, ctx);
-        HDBGMRead (addr + i, * (data + i));
-      }
-  }
-
-static inline void core_writeN (word24 addr, word36 * data, uint n,
-                                UNUSED const char * ctx)
-  {
-    for (uint i = 0; i < n; i ++)
-      {
-        core_write (addr + i, data [i], ctx);
-      }
-  }
+void core_readN (word24 addr, word36 * data, uint n, const char * ctx);
+void core_writeN (word24 addr, word36 * data, uint n, const char * ctx);
 
 int is_priv_mode (void);
 //void set_went_appending (void);
@@ -2321,7 +2397,15 @@ int is_priv_mode (void);
 bool get_bar_mode (void);
 addr_modes_e get_addr_mode (void);
 void set_addr_mode (addr_modes_e mode);
+struct snap_s;
+void cpu_snap (struct snap_s * s, uint64 cpus_base);
 void decode_instruction (word36 inst, DCDstruct * p);
+#ifdef DECODE_CACHE
+void decode_instruction_cached (word36 inst, DCDstruct * p);
+void decode_cache_flush (void);
+#else
+#define decode_instruction_cached decode_instruction
+#endif
 #ifndef SPEED
 t_stat set_mem_watch (int32 arg, const char * buf);
 #endif
@@ -2332,6 +2416,8 @@ int lookup_cpu_mem_map (word24 addr, word24 * offset);
 int lookup_cpu_mem_map (word24 addr);
 #endif
 void cpu_init (void);
+void ev_poll_kick (void);
+void ev_poll_slow_start (void);
 void setup_scbank_map (void);
 #ifdef DPS8M
 void add_CU_history (void);
@@ -735,6 +735,8 @@ static int rdr_cmd (uint iomUnitIdx, uint chan)
     //    return IOM_CMD_ERROR;
     //  }
     rdr_state [unitIdx] . running = true;
+    // Start watching the deck queue directory
+    ev_poll_slow_start ();
 
     sim_debug (DBG_TRACE, & rdr_dev, "IDCW_DEV_CMD %o\n", p -> IDCW_DEV_CMD);
     switch (p -> IDCW_DEV_CMD)
@@ -792,7 +794,11 @@ static void submit (enum deckFormat fmt, char * fname)
       rdrCardReady (0 /*ASSUME0*/);
   }
 
+#ifdef IOM_ASYNC
+static void rdr_process_event (void)
+#else
 void rdrProcessEvent ()
+#endif
   {
 #ifndef __MINGW64__
     char * qdir = "/tmp/rdra";
@@ -862,6 +868,17 @@ void rdrProcessEvent ()
     closedir (dp);
   }
 
+#ifdef IOM_ASYNC
+// The reader's commands may be running on an IOM worker
+
+void rdrProcessEvent ()
+  {
+    uint ctlr_unit_idx = cables->rdr_to_urp [0 /* ASSUME0 */].ctlr_unit_idx;
+    lock_ctlr (CTLR_T_URP, ctlr_unit_idx);
+    rdr_process_event ();
+    unlock_ctlr (CTLR_T_URP, ctlr_unit_idx);
+  }
+#endif
 
 void rdrCardReady (int unitNum)
   {
@@ -816,6 +816,273 @@ char *formatDecimal (uint8_t * out, decContext *set, decNumber *r, int nout, int
 }
 
 
+#ifndef NEED_128
+// The fixed-point instructions, done in binary. Each routine gives the
+// result decNumber and formatDecimal would, or returns false (NULL) if a
+// value would need more than DEC128_DIGITS digits.
+
+#define P19 ((uint128) 10000000000000000000ULL)
+static const uint128 dec128Powers [DEC128_DIGITS + 1] =
+  {
+    1ULL, 10ULL, 100ULL, 1000ULL,
+    10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL,
+    1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+    10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, P19,
+    P19 * 10ULL, P19 * 100ULL, P19 * 1000ULL, P19 * 10000ULL,
+    P19 * 100000ULL, P19 * 1000000ULL, P19 * 10000000ULL, P19 * 100000000ULL,
+    P19 * 1000000000ULL, P19 * 10000000000ULL, P19 * 100000000000ULL, P19 * 1000000000000ULL,
+    P19 * 10000000000000ULL, P19 * 100000000000000ULL, P19 * 1000000000000000ULL, P19 * 10000000000000000ULL,
+    P19 * 100000000000000000ULL, P19 * 1000000000000000000ULL, P19 * 10000000000000000000ULL
+  };
+#undef P19
+
+// Number of digits in v; 1 for 0, DEC128_DIGITS + 1 if there are too many
+
+static int dec128Digits (uint128 v)
+  {
+    int n = 1;
+    while (n <= DEC128_DIGITS && v >= dec128Powers [n])
+      n ++;
+    return n;
+  }
+
+static uint128 dec128Abs (int128 v)
+  {
+    return v < 0 ? (uint128) - v : (uint128) v;
+  }
+
+static int128 dec128Signed (uint128 v, bool neg)
+  {
+    return neg ? - (int128) v : (int128) v;
+  }
+
+// v * 10^n, if that fits
+
+static bool dec128Shift (uint128 * v, int n)
+  {
+    if (* v == 0)
+      return true;
+    if (n < 0 || dec128Digits (* v) + n > DEC128_DIGITS)
+      return false;
+    * v *= dec128Powers [n];
+    return true;
+  }
+
+// As decBCD9ToNumber, with the sign and exponent applied
+
+bool decBCD9ToDec128 (const word9 * bcd, int length, int exponent, int sign, dec128 * d)
+  {
+    int first = 0;
+    while (first < length && bcd [first] == 0)
+      first ++;
+    if (length - first > DEC128_DIGITS)
+      return false;
+    uint128 v = 0;
+    for (int i = first; i < length; i ++)
+      {
+        uint nib = bcd [i] & 0x0f;
+        if (nib > 9)
+          doFault (FAULT_IPR, fst_ill_dig, "decBCD9ToNumber ill digit");
+        v = v * 10 + nib;
+      }
+    d -> coef = dec128Signed (v, sign == -1);
+    d -> exponent = exponent;
+    return true;
+  }
+
+// The coefficients of a and b at the lesser of their exponents
+
+static bool dec128Align (const dec128 * a, const dec128 * b, int128 * ca, int128 * cb, int * exponent)
+  {
+    int e = min (a -> exponent, b -> exponent);
+    uint128 ua = dec128Abs (a -> coef);
+    uint128 ub = dec128Abs (b -> coef);
+    if (! dec128Shift (& ua, a -> exponent - e) ||
+        ! dec128Shift (& ub, b -> exponent - e))
+      return false;
+    * ca = dec128Signed (ua, a -> coef < 0);
+    * cb = dec128Signed (ub, b -> coef < 0);
+    * exponent = e;
+    return true;
+  }
+
+// As decNumberAdd; the result has the lesser exponent.
+
+bool dec128Add (dec128 * r, const dec128 * a, const dec128 * b)
+  {
+    int128 ca, cb, sum;
+    int e;
+    if (! dec128Align (a, b, & ca, & cb, & e) ||
+        __builtin_add_overflow (ca, cb, & sum) ||
+        dec128Abs (sum) >= dec128Powers [DEC128_DIGITS])
+      return false;
+    r -> coef = sum;
+    r -> exponent = e;
+    return true;
+  }
+
+// As decNumberMultiply
+
+bool dec128Multiply (dec128 * r, const dec128 * a, const dec128 * b)
+  {
+    uint128 p;
+    if (__builtin_mul_overflow (dec128Abs (a -> coef), dec128Abs (b -> coef), & p) ||
+        p >= dec128Powers [DEC128_DIGITS])
+      return false;
+    r -> coef = dec128Signed (p, (a -> coef < 0) != (b -> coef < 0));
+    r -> exponent = a -> exponent + b -> exponent;
+    return true;
+  }
+
+// Compare a and b, and their magnitudes; -1, 0 or 1 as decNumberCompare.
+// Numbers of equal magnitude have the same adjusted exponent, so the
+// alignment can't overflow.
+
+bool dec128Compare (const dec128 * a, const dec128 * b, int * cSigned, int * cMag)
+  {
+    uint128 ua = dec128Abs (a -> coef);
+    uint128 ub = dec128Abs (b -> coef);
+    int sa = a -> coef < 0 ? -1 : ua != 0;
+    int sb = b -> coef < 0 ? -1 : ub != 0;
+
+    if (ua == 0 || ub == 0)
+      * cMag = (ua != 0) - (ub != 0);
+    else
+      {
+        int adjA = dec128Digits (ua) + a -> exponent;
+        int adjB = dec128Digits (ub) + b -> exponent;
+        if (adjA != adjB)
+          * cMag = adjA > adjB ? 1 : -1;
+        else
+          {
+            int e = min (a -> exponent, b -> exponent);
+            if (! dec128Shift (& ua, a -> exponent - e) ||
+                ! dec128Shift (& ub, b -> exponent - e))
+              return false;
+            * cMag = (ua > ub) - (ua < ub);
+          }
+      }
+
+    if (sa != sb)
+      * cSigned = sa > sb ? 1 : -1;
+    else
+      * cSigned = sa < 0 ? - * cMag : * cMag;
+    return true;
+  }
+
+// The digits of c, a fixed-point result at exponent sf, as formatDecimal
+// writes them. If the integer part doesn't fit in the nout + min(sf,0)
+// integer positions its high digits are dropped and OVR is set; when
+// there are no integer positions, formatDecimal's result depends on the
+// digits of the decNumber and isn't reproduced here.
+
+static char * dec128Format (uint8_t * out, int128 * c, int nout, int sf, bool * OVR)
+  {
+    uint128 v = dec128Abs (* c);
+    if (nout + min (sf, 0) < 1 || dec128Digits (v) > DEC128_DIGITS)
+      return NULL;
+    if (nout <= DEC128_DIGITS && v >= dec128Powers [nout])
+      {
+        v %= dec128Powers [nout];
+        * c = dec128Signed (v, * c < 0);
+        * OVR = true;
+      }
+    // v < 10^38; two 19 digit halves
+    uint64 lo = (uint64) (v % dec128Powers [19]);
+    uint64 hi = (uint64) (v / dec128Powers [19]);
+    for (int i = nout - 1; i >= 0; i --)
+      {
+        out [i] = (uint8_t) ('0' + lo % 10);
+        lo /= 10;
+        if (i == nout - 19)
+          lo = hi;
+      }
+    out [nout] = 0;
+    return (char *) out;
+  }
+
+// As formatDecimal, for fixed-point (s != CSFL). Rescaling to sf
+// truncates, setting TRUNC, or, if R, rounds half up.
+
+char * formatDecimal128 (uint8_t * out, dec128 * r, int nout, int sf, bool R, bool * OVR, bool * TRUNC)
+  {
+    * OVR = false;
+    * TRUNC = false;
+
+    uint128 v = dec128Abs (r -> coef);
+    if (sf < r -> exponent)
+      {
+        if (! dec128Shift (& v, r -> exponent - sf))
+          return NULL;
+      }
+    else if (sf > r -> exponent)
+      {
+        int d = sf - r -> exponent;
+        if (! R)
+          * TRUNC = true;
+        if (d > DEC128_DIGITS)
+          v = 0;
+        else
+          {
+            uint128 rem = v % dec128Powers [d];
+            v /= dec128Powers [d];
+            if (R && rem >= dec128Powers [d] - rem)
+              v ++;
+          }
+      }
+    r -> coef = dec128Signed (v, r -> coef < 0);
+    r -> exponent = sf;
+    return dec128Format (out, & r -> coef, nout, sf, OVR);
+  }
+
+// decNumberDivide (with 65 digits) followed by formatDecimal, for a
+// fixed-point quotient.
+//
+// The quotient is computed at exponent sf with its remainder. decNumber
+// first rounds the quotient half up to 65 digits, k digits below sf; the
+// remaining fraction f = rem / den is changed by that rounding only in
+// how it then truncates or rounds, which happens iff
+//   truncating: f >= 1 - 10^-k / 2,    i.e. den - rem <= den / (2 * 10^k)
+//   rounding:   f >= 1/2 - 10^-k / 2,  i.e. den - 2 rem <= den / 10^k
+// decNumber's quotient has the exponent e2 - e1 if it is exact there, so
+// formatDecimal finds it truncated if anything is lost at sf, or if sf is
+// above that exponent.
+
+char * divideDecimal128 (uint8_t * out, dec128 * r, const dec128 * dividend, const dec128 * divisor, int nout, int sf, bool R, bool * OVR, bool * TRUNC)
+  {
+    * OVR = false;
+    * TRUNC = false;
+
+    int ideal = dividend -> exponent - divisor -> exponent;
+    int s = ideal - sf;
+    uint128 num = dec128Abs (dividend -> coef);
+    uint128 den = dec128Abs (divisor -> coef);
+    if (den == 0 ||
+        ! dec128Shift (& num, max (s, 0)) ||
+        ! dec128Shift (& den, max (- s, 0)))
+      return NULL;
+
+    uint128 q = num / den;
+    uint128 rem = num % den;
+    int k = q ? 65 - dec128Digits (q) : 65;
+    bool up;
+    if (R)
+      up = rem >= den - rem ||
+           (k <= DEC128_DIGITS && den - 2 * rem <= den / dec128Powers [k]);
+    else
+      up = k <= DEC128_DIGITS && den - rem <= den / (2 * dec128Powers [k]);
+    if (up)
+      q ++;
+    if (! R && (rem || sf > ideal))
+      * TRUNC = true;
+
+    r -> coef = dec128Signed (q, (dividend -> coef < 0) != (divisor -> coef < 0));
+    r -> exponent = sf;
+    return dec128Format (out, & r -> coef, nout, sf, OVR);
+  }
+#endif // ! NEED_128
+
 #ifndef QUIET_UNUSED
 // If the lhs is less than the rhs in the total order then the number will be set to the value -1. If they are equal, then number is set to 0. If the lhs is greater than the rhs then the number will be set to the value 1.
 int decCompare(decNumber *lhs, decNumber *rhs, decContext *set)
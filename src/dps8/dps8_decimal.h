@@ -46,3 +46,26 @@ char *formatDecimal(uint8_t * out, decContext *set, decNumber *r, int nout, int
 //char *getBCDn(decNumber *a, int digits);
 //int decCompare(decNumber *lhs, decNumber *rhs, decContext *set);
 int decCompareMAG(decNumber *lhs, decNumber *rhs, decContext *set);
+
+#ifndef NEED_128
+// A decimal value held as a binary coefficient and a power of ten exponent.
+// The fixed-point EIS instructions use it in place of decNumber when the
+// operands and the result have at most DEC128_DIGITS significant digits;
+// the dec128 routines return false when they don't, and the instruction
+// is done with decNumber instead.
+
+#define DEC128_DIGITS 38
+
+typedef struct
+  {
+    int128 coef;
+    int exponent;
+  } dec128;
+
+bool decBCD9ToDec128 (const word9 * bcd, int length, int exponent, int sign, dec128 * d);
+bool dec128Add (dec128 * r, const dec128 * a, const dec128 * b);
+bool dec128Multiply (dec128 * r, const dec128 * a, const dec128 * b);
+bool dec128Compare (const dec128 * a, const dec128 * b, int * cSigned, int * cMag);
+char * formatDecimal128 (uint8_t * out, dec128 * r, int nout, int sf, bool R, bool * OVR, bool * TRUNC);
+char * divideDecimal128 (uint8_t * out, dec128 * r, const dec128 * dividend, const dec128 * divisor, int nout, int sf, bool R, bool * OVR, bool * TRUNC);
+#endif
@@ -37,9 +37,6 @@ static inline void fnp_core_read (word24 addr, word36 *data, UNUSED const char *
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-    lock_mem_rd ();
-#endif
 #ifdef SCUMEM
     iom_core_read (addr, data, ctx);
 #else
@@ -47,9 +44,6 @@ static inline void fnp_core_read (word24 addr, word36 *data, UNUSED const char *
 #endif
 #ifdef TEST_FENCE
     fence ();
-#endif
-#ifdef THREADZ
-    unlock_mem ();
 #endif
   }
 #define N_DIA_UNITS 1 // default
@@ -367,9 +361,6 @@ static inline void fnp_core_write (word24 addr, word36 data, UNUSED const char *
 #ifdef TEST_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-    lock_mem_wr ();
-#endif
 #ifdef SCUMEM
     iom_core_write (addr, data, ctx);
 #else
@@ -377,9 +368,6 @@ static inline void fnp_core_write (word24 addr, word36 data, UNUSED const char *
 #endif
 #ifdef TEST_FENCE
     fence ();
-#endif
-#ifdef THREADZ
-    unlock_mem ();
 #endif
   }
 
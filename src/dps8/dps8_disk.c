@@ -26,6 +26,13 @@
 #include <stdio.h>
 
 #include "dps8.h"
+#ifdef DISK_PIO
+#include <unistd.h>
+#endif
+#ifdef DISK_ASYNC
+#include <pthread.h>
+#include <signal.h>
+#endif
 #include "dps8_iom.h"
 #include "dps8_disk.h"
 #include "dps8_sys.h"
@@ -35,6 +42,7 @@
 #include "dps8_cpu.h"
 #include "sim_disk.h"
 #include "dps8_utils.h"
+#include "dps8_snap.h"
 
 #ifdef LOCKLESS
 #include "threadz.h"
@@ -193,6 +201,13 @@ static struct dsk_state
     char device_name [MAX_DEV_NAME_LEN];
 #ifdef LOCKLESS
     pthread_mutex_t dsk_lock;
+#endif
+#ifdef DISK_ASYNC
+    struct dsk_job * job;  // transfer in progress
+    struct dsk_job * work; // handed to the worker, not yet started
+    bool worker_running;
+    pthread_mutex_t job_lock;
+    pthread_cond_t job_cond;
 #endif
   } dsk_states [N_DSK_UNITS_MAX];
 
@@ -496,11 +511,16 @@ static t_stat loadDisk (uint dsk_unit_idx, const char * disk_filename, UNUSED bo
   }
 
 #define UNIT_WATCH UNIT_V_UF
+#define UNIT_ASYNC (1u << (UNIT_V_UF + 1))
 
 static MTAB disk_mod [] =
   {
     { UNIT_WATCH, 1, "WATCH", "WATCH", 0, 0, NULL, NULL },
     { UNIT_WATCH, 0, "NOWATCH", "NOWATCH", 0, 0, NULL, NULL },
+#ifdef DISK_ASYNC
+    { UNIT_ASYNC, UNIT_ASYNC, "ASYNC", "ASYNC", 0, 0, NULL, NULL },
+    { UNIT_ASYNC, 0, "NOASYNC", "NOASYNC", 0, 0, NULL, NULL },
+#endif
     {
       MTAB_dev_value, /* mask */
       0,            /* match */
@@ -604,6 +624,13 @@ void disk_init (void)
   {
     // Sets diskTypeIdx to 0: 3381
     memset (dsk_states, 0, sizeof (dsk_states));
+#ifdef DISK_ASYNC
+    for (uint i = 0; i < N_DSK_UNITS_MAX; i ++)
+      {
+        pthread_mutex_init (& dsk_states[i].job_lock, NULL);
+        pthread_cond_init (& dsk_states[i].job_cond, NULL);
+      }
+#endif
 #ifdef LOCKLESS
     for (uint i = 0; i < N_DSK_UNITS_MAX; i ++)
       {
@@ -818,16 +845,6 @@ static int diskRead (uint devUnitIdx, uint iomUnitIdx, uint chan)
         sim_debug (DBG_DEBUG, & dsk_dev,
                    "%s: Tally %d (%o)\n", __func__, tally, tally);
 
-        rc = fseek (unitp -> fileref, 
-                    (long) (disk_statep -> seekPosition * sectorSizeBytes),
-                    SEEK_SET);
-        if (rc)
-          {
-            sim_printf ("fseek (read) returned %d, errno %d\n", rc, errno);
-            p -> stati = 04202; // attn, seek incomplete
-            return -1;
-          }
-
         // Convert from word36 format to packed72 format
 
         // round tally up to sector boundary
@@ -840,17 +857,43 @@ static int diskRead (uint devUnitIdx, uint iomUnitIdx, uint chan)
         //uint tallyBytes = tallySectors * sectorSizeBytes;
         uint p72ByteCnt = (tallyWords * 36) / 8;
         uint8 diskBuffer [p72ByteCnt];
-        memset (diskBuffer, 0, sizeof (diskBuffer));
         sim_debug (DBG_TRACE, & dsk_dev, "Disk read  %3d %8d %3d\n",
                    devUnitIdx, disk_statep -> seekPosition, tallySectors);
 
+#ifdef DISK_PIO
+        ssize_t n = pread (fileno (unitp -> fileref), diskBuffer, p72ByteCnt,
+                           (off_t) disk_statep -> seekPosition *
+                             sectorSizeBytes);
+        if (n < 0)
+          {
+            sim_printf ("pread returned %ld, errno %d\n", (long) n, errno);
+            p -> stati = 04202; // attn, seek incomplete
+            p -> chanStatus = chanStatIncorrectDCW;
+            return -1;
+          }
+        // We ignore short reads-- we assume that they are reads
+        // past the write highwater mark, and return zero data,
+        // just as if the disk had been formatted with zeros.
+        if ((uint) n < p72ByteCnt)
+          memset (diskBuffer + n, 0, p72ByteCnt - (uint) n);
+#else
+        rc = fseek (unitp -> fileref, 
+                    (long) (disk_statep -> seekPosition * sectorSizeBytes),
+                    SEEK_SET);
+        if (rc)
+          {
+            sim_printf ("fseek (read) returned %d, errno %d\n", rc, errno);
+            p -> stati = 04202; // attn, seek incomplete
+            return -1;
+          }
+
+        memset (diskBuffer, 0, sizeof (diskBuffer));
         fflush (unitp->fileref);
         rc = (int) fread (diskBuffer, sectorSizeBytes,
                     tallySectors,
                     unitp -> fileref);
  
 // The rc code is wrong; it is using read() semantics, for fread().
-#if 1
         if (rc == 0) // EOF or error
           {
             if (ferror (unitp->fileref))
@@ -863,41 +906,6 @@ static int diskRead (uint devUnitIdx, uint iomUnitIdx, uint chan)
             // past the write highwater mark, and return zero data,
             // just as if the disk had been formatted with zeros.
           }
-#else
-        if (rc == 0) // eof; reading a sector beyond the high water mark.
-          {
-            // okay; buffer was zero, so just pretend that a zero filled
-            // sector was read (ala demand page zero)
-          }
-        else if (rc != (int) tallySectors)
-          {
-            sim_printf ("read returned %d, errno %d\n", rc, errno);
-            sim_printf ("tally %u\n", tally);
-            sim_printf ("tallySectors %u\n", tallySectors);
-            sim_printf ("tallyWords %u\n", tallyWords);
-            sim_printf ("p72ByteCnt %u\n", p72ByteCnt);
-            sim_printf ("fseek to %ld\n",  (long) (disk_statep -> seekPosition * sectorSizeBytes));
-            sim_printf ("devUnitIdx %u\n", devUnitIdx);
-            sim_printf ("iomUnitIdx %u\n", iomUnitIdx);
-            sim_printf ("chan %u\n", chan);
-            sim_printf ("typeIdx %u\n", typeIdx);
-            sim_printf ("sectorSizeWords %u\n", sectorSizeWords);
-            sim_printf ("sectorSizeBytes %u\n", sectorSizeBytes);
-            sim_printf ("fileref %p\n", unitp->fileref);
-            sim_printf ("knowns:\n");
-            for (uint i = 0; i < N_DSK_UNITS_MAX; i ++)
-              {
-                sim_printf ("  %u typeIdx %u seekPosition %u filename <%s> fileref %p\n",
-                  i,
-                  dsk_states[i].typeIdx,
-                  dsk_states[i].seekPosition,
-                  dsk_unit[i].filename,
-                  dsk_unit[i].fileref);
-              }
-            p -> stati = 04202; // attn, seek incomplete
-            p -> chanStatus = chanStatIncorrectDCW;
-            return -1;
-          }
 #endif
 //sim_printf ("tallySectors %u\n", tallySectors);
 //sim_printf ("p72ByteCnt %u\n", p72ByteCnt);
@@ -912,15 +920,9 @@ static int diskRead (uint devUnitIdx, uint iomUnitIdx, uint chan)
 //sim_printf ("\n");
         disk_statep -> seekPosition += tallySectors;
 
-        uint wordsProcessed = 0;
+        uint wordsProcessed = tally;
         word36 buffer [tally];
-        for (uint i = 0; i < tally; i ++)
-          {
-            word36 w;
-            extractWord36FromBuffer (diskBuffer, p72ByteCnt, & wordsProcessed,
-                                     & w);
-            buffer [i] = w;
-          }
+        extr36N (diskBuffer, buffer, tally);
         iom_indirect_data_service (iomUnitIdx, chan, buffer,
                                 & wordsProcessed, true);
       } while (p -> DDCW_22_23_TYPE != 0); // not IOTD
@@ -981,16 +983,6 @@ static int diskWrite (uint devUnitIdx, uint iomUnitIdx, uint chan)
         sim_debug (DBG_DEBUG, & dsk_dev,
                    "%s: Tally %d (%o)\n", __func__, tally, tally);
 
-        rc = fseek (unitp -> fileref, 
-                    (long) (disk_statep -> seekPosition * sectorSizeBytes),
-                    SEEK_SET);
-        if (rc)
-          {
-            sim_printf ("fseek (read) returned %d, errno %d\n", rc, errno);
-            p -> stati = 04202; // attn, seek incomplete
-            return -1;
-          }
-
         // Convert from word36 format to packed72 format
 
         // round tally up to sector boundary
@@ -1003,39 +995,53 @@ static int diskWrite (uint devUnitIdx, uint iomUnitIdx, uint chan)
         //uint tallyBytes = tallySectors * sectorSizeBytes;
         uint p72ByteCnt = (tallyWords * 36) / 8;
         uint8 diskBuffer [p72ByteCnt];
-        memset (diskBuffer, 0, sizeof (diskBuffer));
         uint wordsProcessed = 0;
-#if 0
-        for (uint i = 0; i < tally; i ++)
-          {
-            word36 w;
-            core_read (daddr + i, & w, "Disk write");
-            insertWord36toBuffer (diskBuffer, p72ByteCnt, & wordsProcessed,
-                                  w);
-          }
-#else
         word36 buffer [tally];
         iom_indirect_data_service (iomUnitIdx, chan, buffer,
                                 & wordsProcessed, false);
 // XXX is this losing information?
-        wordsProcessed = 0;
-        for (uint i = 0; i < tally; i ++)
-          {
-            insertWord36toBuffer (diskBuffer, p72ByteCnt, & wordsProcessed,
-                                  buffer [i]);
-          }
-#endif
+        // Zero from the last, possibly half filled, group to the end of
+        // the sector
+        uint p72Used = (tally / 2) * 9;
+        memset (diskBuffer + p72Used, 0, p72ByteCnt - p72Used);
+        put36N (buffer, diskBuffer, tally);
 
         sim_debug (DBG_TRACE, & dsk_dev, "Disk write %3d %8d %3d\n",
                    devUnitIdx, disk_statep -> seekPosition, tallySectors);
+#ifdef DISK_PIO
+        int fd = fileno (unitp -> fileref);
+        off_t pos = (off_t) disk_statep -> seekPosition * sectorSizeBytes;
+        uint done = 0;
+        while (done < p72ByteCnt)
+          {
+            ssize_t n = pwrite (fd, diskBuffer + done, p72ByteCnt - done,
+                                pos + done);
+            if (n < 0 && errno == EINTR)
+              continue;
+            if (n <= 0)
+              {
+                sim_printf ("pwrite returned %ld, errno %d\n", (long) n, errno);
+                p -> stati = 04202; // attn, seek incomplete
+                p -> chanStatus = chanStatIncorrectDCW;
+                return -1;
+              }
+            done += (uint) n;
+          }
+#else
+        rc = fseek (unitp -> fileref, 
+                    (long) (disk_statep -> seekPosition * sectorSizeBytes),
+                    SEEK_SET);
+        if (rc)
+          {
+            sim_printf ("fseek (read) returned %d, errno %d\n", rc, errno);
+            p -> stati = 04202; // attn, seek incomplete
+            return -1;
+          }
         rc = (int) fwrite (diskBuffer, sectorSizeBytes,
                      tallySectors,
                      unitp -> fileref);
         fflush (unitp->fileref);
 
-//sim_printf ("Disk write %8d %3d %08o\n",
-//disk_statep -> seekPosition, tallySectors, daddr);
-              
         if (rc != (int) tallySectors)
           {
             sim_printf ("fwrite returned %d, errno %d\n", rc, errno);
@@ -1043,6 +1049,10 @@ static int diskWrite (uint devUnitIdx, uint iomUnitIdx, uint chan)
             p -> chanStatus = chanStatIncorrectDCW;
             return -1;
           }
+#endif
+
+//sim_printf ("Disk write %8d %3d %08o\n",
+//disk_statep -> seekPosition, tallySectors, daddr);
 
         disk_statep -> seekPosition += tallySectors;
  
@@ -1052,6 +1062,422 @@ static int diskWrite (uint devUnitIdx, uint iomUnitIdx, uint chan)
     return 0;
   }
 
+#ifdef DISK_ASYNC
+// Asynchronous transfers
+//
+// For a unit with the ASYNC flag, a read or write that ends the channel
+// program is handed to the unit's worker thread and the command returns
+// IOM_CMD_PENDING. The DDCW list is walked when the command arrives:
+// write data is gathered from memory then, while for reads the DCW
+// fields of each DDCW are kept so the data can be delivered once the
+// host read completes. Delivery and the terminate interrupt happen in
+// the I/O pass on the event loop thread (dsk_process_event).
+//
+// A unit has at most one transfer in progress; a new command for the
+// unit waits for it (dsk_job_drain).
+
+#define DSK_JOB_MAX_DCWS 16
+
+// The channel state a DDCW's data service needs
+struct dsk_job_dcw
+  {
+    word36 DCW;
+    uint DDCW_ADDR;
+    word12 DDCW_TALLY;
+    word2 DDCW_22_23_TYPE;
+    word3 DCW_18_20_CP;
+    word6 ADDR_EXT;
+    size_t offset; // of its data in buf
+  };
+
+struct dsk_job
+  {
+    uint devUnitIdx;
+    uint iomUnitIdx;
+    uint chan;
+    bool write;
+    int fd;
+    off_t pos;
+    size_t nBytes;
+    ssize_t result;
+    int err;
+    bool done;     // host I/O finished; under the unit's job_lock
+    uint nDcws;
+    struct dsk_job_dcw dcws [DSK_JOB_MAX_DCWS];
+    size_t bufSize;
+    uint8 * buf;
+  };
+
+static void dsk_dcw_save (struct dsk_job_dcw * d, iom_chan_data_t * p)
+  {
+    d -> DCW =             p -> DCW;
+    d -> DDCW_ADDR =       p -> DDCW_ADDR;
+    d -> DDCW_TALLY =      p -> DDCW_TALLY;
+    d -> DDCW_22_23_TYPE = p -> DDCW_22_23_TYPE;
+    d -> DCW_18_20_CP =    p -> DCW_18_20_CP;
+    d -> ADDR_EXT =        p -> ADDR_EXT;
+  }
+
+static void dsk_dcw_load (iom_chan_data_t * p, struct dsk_job_dcw * d)
+  {
+    p -> DCW =             d -> DCW;
+    p -> DDCW_ADDR =       d -> DDCW_ADDR;
+    p -> DDCW_TALLY =      d -> DDCW_TALLY;
+    p -> DDCW_22_23_TYPE = d -> DDCW_22_23_TYPE;
+    p -> DCW_18_20_CP =    d -> DCW_18_20_CP;
+    p -> ADDR_EXT =        d -> ADDR_EXT;
+  }
+
+static void dsk_job_free (struct dsk_job * job)
+  {
+    free (job -> buf);
+    free (job);
+  }
+
+// Runs on the worker thread; touches only the job.
+
+static void dsk_job_work (struct dsk_job * job)
+  {
+    size_t done = 0;
+    ssize_t n = 0;
+    while (done < job->nBytes)
+      {
+        if (job->write)
+          n = pwrite (job->fd, job->buf + done, job->nBytes - done,
+                      job->pos + (off_t) done);
+        else
+          n = pread (job->fd, job->buf + done, job->nBytes - done,
+                     job->pos + (off_t) done);
+        if (n < 0 && errno == EINTR)
+          continue;
+        if (n <= 0)
+          break;
+        done += (size_t) n;
+      }
+    if (n < 0 || (job->write && done < job->nBytes))
+      {
+        job->result = -1;
+        job->err = errno;
+      }
+    else
+      {
+        // Reads past the write highwater mark return zero data.
+        if (done < job->nBytes)
+          memset (job->buf + done, 0, job->nBytes - done);
+        job->result = (ssize_t) done;
+      }
+  }
+
+// Deliver the read data and the channel status; the caller holds the
+// disk lock.
+
+static int dsk_job_finish (struct dsk_job * job, bool interrupt)
+  {
+    iom_chan_data_t * p = & iom_chan_data [job->iomUnitIdx] [job->chan];
+    int rc = 0;
+    if (dsk_states[job->devUnitIdx].job == job)
+      __atomic_store_n (& dsk_states[job->devUnitIdx].job, NULL,
+                        __ATOMIC_RELEASE);
+    if (job->result < 0)
+      {
+        sim_printf ("disk %s failed, errno %d\n",
+                    job->write ? "pwrite" : "pread", job->err);
+        p -> stati = 04202; // attn, seek incomplete
+        p -> chanStatus = chanStatIncorrectDCW;
+        rc = -1;
+      }
+    else
+      {
+        if (! job->write)
+          {
+            for (uint i = 0; i < job->nDcws; i ++)
+              {
+                dsk_dcw_load (p, & job->dcws [i]);
+                uint tally = p -> DDCW_TALLY;
+                if (tally == 0)
+                  tally = 4096;
+                uint wordsProcessed = tally;
+                word36 buffer [tally];
+                extr36N (job->buf + job->dcws [i].offset, buffer, tally);
+                iom_indirect_data_service (job->iomUnitIdx, job->chan, buffer,
+                                        & wordsProcessed, true);
+              }
+          }
+        else
+          {
+            dsk_states[job->devUnitIdx].io_mode = disk_write_mode;
+          }
+        p -> stati = 04000;
+      }
+    p -> initiate = false;
+    if (interrupt)
+      send_terminate_interrupt (job->iomUnitIdx, job->chan);
+    return rc;
+  }
+
+// A unit's worker thread: runs the host I/O of each job handed to it,
+// then has the event loop deliver it.
+
+static void * dsk_worker_main (void * arg)
+  {
+    struct dsk_state * sp = (struct dsk_state *) arg;
+
+    // Leave the signals to the simulator threads
+    sigset_t set;
+    sigfillset (& set);
+    pthread_sigmask (SIG_BLOCK, & set, NULL);
+
+    pthread_mutex_lock (& sp->job_lock);
+    for (;;)
+      {
+        while (! sp->work)
+          pthread_cond_wait (& sp->job_cond, & sp->job_lock);
+        struct dsk_job * job = sp->work;
+        sp->work = NULL;
+        pthread_mutex_unlock (& sp->job_lock);
+
+        dsk_job_work (job);
+
+        pthread_mutex_lock (& sp->job_lock);
+        job->done = true;
+        pthread_cond_broadcast (& sp->job_cond);
+        // The job may be freed once the lock is dropped
+        pthread_mutex_unlock (& sp->job_lock);
+        ev_poll_kick ();
+        pthread_mutex_lock (& sp->job_lock);
+      }
+    return NULL;
+  }
+
+// Hand the job to the unit's worker, starting it on first use. Returns
+// false if there is no worker.
+
+static bool dsk_job_start (struct dsk_job * job)
+  {
+    struct dsk_state * sp = & dsk_states [job->devUnitIdx];
+    if (! sp->worker_running)
+      {
+        pthread_t thread;
+        int rc = pthread_create (& thread, NULL, dsk_worker_main, sp);
+        if (rc)
+          {
+            sim_warn ("%s: pthread_create %d\n", __func__, rc);
+            return false;
+          }
+        pthread_detach (thread);
+        sp->worker_running = true;
+      }
+    __atomic_store_n (& sp->job, job, __ATOMIC_RELEASE);
+    pthread_mutex_lock (& sp->job_lock);
+    sp->work = job;
+    pthread_cond_broadcast (& sp->job_cond);
+    pthread_mutex_unlock (& sp->job_lock);
+    return true;
+  }
+
+// Is the unit's transfer in progress done with the host? If wait, block
+// until it is.
+
+static bool dsk_job_done (uint devUnitIdx, bool wait)
+  {
+    struct dsk_state * sp = & dsk_states [devUnitIdx];
+    pthread_mutex_lock (& sp->job_lock);
+    while (wait && ! sp->job->done)
+      pthread_cond_wait (& sp->job_cond, & sp->job_lock);
+    bool done = sp->job->done;
+    pthread_mutex_unlock (& sp->job_lock);
+    return done;
+  }
+
+// Wait for the unit's transfer in progress and complete it.
+
+static void dsk_job_drain (uint devUnitIdx)
+  {
+    struct dsk_job * job = dsk_states[devUnitIdx].job;
+    if (! job)
+      return;
+    dsk_job_done (devUnitIdx, true);
+    dsk_job_finish (job, true);
+    dsk_job_free (job);
+  }
+
+// Called from the I/O pass on the event loop thread; completes the
+// transfers whose host I/O is done.
+
+void dsk_process_event (void)
+  {
+    for (uint devUnitIdx = 0; devUnitIdx < N_DSK_UNITS_MAX; devUnitIdx ++)
+      {
+        struct dsk_state * sp = & dsk_states [devUnitIdx];
+        if (! __atomic_load_n (& sp->job, __ATOMIC_ACQUIRE))
+          continue;
+#ifdef IOM_ASYNC
+        // The controller's commands may be running on an IOM worker
+        uint ctlr_type = cables->dsk_to_ctlr [devUnitIdx].ctlr_type;
+        uint ctlr_unit_idx = cables->dsk_to_ctlr [devUnitIdx].ctlr_unit_idx;
+        lock_ctlr (ctlr_type, ctlr_unit_idx);
+#endif
+#ifdef LOCKLESS
+        lock_ptr (& dsk_states->dsk_lock);
+#endif
+        // A command for the unit may have drained it meanwhile
+        struct dsk_job * job = sp->job;
+        if (job && dsk_job_done (devUnitIdx, false))
+          {
+            dsk_job_finish (job, true);
+            dsk_job_free (job);
+          }
+#ifdef LOCKLESS
+        unlock_ptr (& dsk_states->dsk_lock);
+#endif
+#ifdef IOM_ASYNC
+        unlock_ctlr (ctlr_type, ctlr_unit_idx);
+#endif
+      }
+  }
+
+// Do the accumulated host I/O on this thread and deliver it, without a
+// terminate interrupt.
+
+static int dsk_job_run (struct dsk_job * job)
+  {
+    dsk_job_work (job);
+    int rc = dsk_job_finish (job, false);
+    job->pos += (off_t) job->nBytes;
+    job->nBytes = 0;
+    job->nDcws = 0;
+    return rc;
+  }
+
+static int diskTransferAsync (uint devUnitIdx, uint iomUnitIdx, uint chan,
+                              bool write)
+  {
+    iom_chan_data_t * p = & iom_chan_data [iomUnitIdx] [chan];
+    UNIT * unitp = & dsk_unit [devUnitIdx];
+    struct dsk_state * disk_statep = & dsk_states [devUnitIdx];
+    uint typeIdx = disk_statep->typeIdx;
+    uint sectorSizeWords = diskTypes[typeIdx].sectorSizeWords;
+    uint sectorSizeBytes = ((36 * sectorSizeWords) / 8);
+    sim_debug (DBG_NOTIFY, & dsk_dev, "%s %d\n", write ? "Write" : "Read",
+               devUnitIdx);
+    disk_statep -> io_mode = disk_read_mode;
+
+    // Only a command that ends the channel program can complete later;
+    // otherwise the IOM must carry on with the list when we return.
+    bool last = ! p -> isPCW && p -> IDCW_CONTROL == 0;
+
+    struct dsk_job * job = (struct dsk_job *) calloc (1, sizeof (* job));
+    if (! job)
+      {
+        sim_warn ("%s: job malloc fail\n", __func__);
+        return -1;
+      }
+    job->devUnitIdx = devUnitIdx;
+    job->iomUnitIdx = iomUnitIdx;
+    job->chan = chan;
+    job->write = write;
+    job->fd = fileno (unitp -> fileref);
+    job->pos = (off_t) disk_statep -> seekPosition * sectorSizeBytes;
+
+// Process DDCWs
+
+    bool ptro, send, uff;
+    do
+      {
+        int rc = iom_list_service (iomUnitIdx, chan, & ptro, & send, & uff);
+        if (rc < 0)
+          {
+            sim_printf ("%s list service failed\n", __func__);
+            dsk_job_free (job);
+            return -1;
+          }
+        if (uff)
+          {
+            sim_printf ("%s ignoring uff\n", __func__); // XXX
+          }
+        if (! send)
+          {
+            sim_printf ("%s nothing to send\n", __func__);
+            dsk_job_free (job);
+            return 1;
+          }
+        if (p -> DCW_18_20_CP == 07 || p -> DDCW_22_23_TYPE == 2)
+          {
+            sim_printf ("%s expected DDCW\n", __func__);
+            dsk_job_free (job);
+            return -1;
+          }
+
+        uint tally = p -> DDCW_TALLY;
+        if (tally == 0)
+          tally = 4096;
+
+        if (job->nDcws == DSK_JOB_MAX_DCWS)
+          {
+            // Job is full; move what it holds now. Delivery rewinds the
+            // DCW fields, so keep the current DDCW's.
+            struct dsk_job_dcw cur;
+            dsk_dcw_save (& cur, p);
+            int rc1 = dsk_job_run (job);
+            dsk_dcw_load (p, & cur);
+            if (rc1)
+              {
+                dsk_job_free (job);
+                return -1;
+              }
+          }
+
+        uint tallySectors = (tally + sectorSizeWords - 1) /
+                             sectorSizeWords;
+        uint tallyWords = tallySectors * sectorSizeWords;
+        uint p72ByteCnt = (tallyWords * 36) / 8;
+        if (job->nBytes + p72ByteCnt > job->bufSize)
+          {
+            size_t sz = job->bufSize * 2;
+            if (sz < job->nBytes + p72ByteCnt)
+              sz = job->nBytes + p72ByteCnt;
+            uint8 * buf = (uint8 *) realloc (job->buf, sz);
+            if (! buf)
+              {
+                sim_warn ("%s: buffer malloc fail\n", __func__);
+                dsk_job_free (job);
+                return -1;
+              }
+            job->buf = buf;
+            job->bufSize = sz;
+          }
+        uint8 * diskBuffer = job->buf + job->nBytes;
+        sim_debug (DBG_TRACE, & dsk_dev, "Disk %s %3d %8d %3d\n",
+                   write ? "write" : "read ", devUnitIdx,
+                   disk_statep -> seekPosition, tallySectors);
+
+        dsk_dcw_save (& job->dcws [job->nDcws], p);
+        job->dcws [job->nDcws].offset = job->nBytes;
+        job->nDcws ++;
+        if (write)
+          {
+            uint wordsProcessed = 0;
+            word36 buffer [tally];
+            iom_indirect_data_service (iomUnitIdx, chan, buffer,
+                                    & wordsProcessed, false);
+            // Zero from the last, possibly half filled, group to the end of
+            // the sector
+            uint p72Used = (tally / 2) * 9;
+            memset (diskBuffer + p72Used, 0, p72ByteCnt - p72Used);
+            put36N (buffer, diskBuffer, tally);
+          }
+        job->nBytes += p72ByteCnt;
+        disk_statep -> seekPosition += tallySectors;
+      } while (p -> DDCW_22_23_TYPE != 0); // not IOTD
+
+    if (last && dsk_job_start (job))
+      return IOM_CMD_PENDING;
+    int rc = dsk_job_run (job);
+    dsk_job_free (job);
+    return rc;
+  }
+#endif
+
 static int readStatusRegister (uint devUnitIdx, uint iomUnitIdx, uint chan)
   {
     iom_chan_data_t * p = & iom_chan_data [iomUnitIdx] [chan];
@@ -1423,6 +1849,10 @@ static int disk_cmd (uint iomUnitIdx, uint chan)
     lock_ptr (& dsk_states->dsk_lock);
 #endif
 
+#ifdef DISK_ASYNC
+    dsk_job_drain (devUnitIdx);
+#endif
+
     disk_statep -> io_mode = disk_no_mode;
     p -> stati = 0;
 
@@ -1485,7 +1915,18 @@ static int disk_cmd (uint iomUnitIdx, uint chan)
                 p -> stati = 04240; // device offline
                 break;
               }
-            int rc1 = diskRead (devUnitIdx, iomUnitIdx, chan);
+            int rc1;
+#ifdef DISK_ASYNC
+            if (unitp -> flags & UNIT_ASYNC)
+              rc1 = diskTransferAsync (devUnitIdx, iomUnitIdx, chan, false);
+            else
+#endif
+              rc1 = diskRead (devUnitIdx, iomUnitIdx, chan);
+            if (rc1 == IOM_CMD_PENDING)
+              {
+                rc = IOM_CMD_PENDING;
+                break;
+              }
             if (rc1)
               {
                 rc = IOM_CMD_ERROR;
@@ -1521,7 +1962,18 @@ static int disk_cmd (uint iomUnitIdx, uint chan)
                 break;
               }
             p -> isRead = false;
-            int rc1 = diskWrite (devUnitIdx, iomUnitIdx, chan);
+            int rc1;
+#ifdef DISK_ASYNC
+            if (unitp -> flags & UNIT_ASYNC)
+              rc1 = diskTransferAsync (devUnitIdx, iomUnitIdx, chan, true);
+            else
+#endif
+              rc1 = diskWrite (devUnitIdx, iomUnitIdx, chan);
+            if (rc1 == IOM_CMD_PENDING)
+              {
+                rc = IOM_CMD_PENDING;
+                break;
+              }
             if (rc1)
               {
                 rc = IOM_CMD_ERROR;
@@ -1872,3 +2324,66 @@ DEVICE msp_dev =
     NULL
   };
 
+// Complete every transfer in progress, so that none stores into memory
+// or interrupts while a snapshot is saved or restored.
+
+void disk_quiesce (void)
+  {
+#ifdef DISK_ASYNC
+    for (uint devUnitIdx = 0; devUnitIdx < N_DSK_UNITS_MAX; devUnitIdx ++)
+      {
+        if (! __atomic_load_n (& dsk_states [devUnitIdx].job,
+                               __ATOMIC_ACQUIRE))
+          continue;
+#ifdef IOM_ASYNC
+        uint ctlr_type = cables->dsk_to_ctlr [devUnitIdx].ctlr_type;
+        uint ctlr_unit_idx = cables->dsk_to_ctlr [devUnitIdx].ctlr_unit_idx;
+        lock_ctlr (ctlr_type, ctlr_unit_idx);
+#endif
+#ifdef LOCKLESS
+        lock_ptr (& dsk_states->dsk_lock);
+#endif
+        dsk_job_drain (devUnitIdx);
+#ifdef LOCKLESS
+        unlock_ptr (& dsk_states->dsk_lock);
+#endif
+#ifdef IOM_ASYNC
+        unlock_ctlr (ctlr_type, ctlr_unit_idx);
+#endif
+      }
+#endif
+  }
+
+// Machine snapshot: the seek state of each drive. The images are not
+// part of a snapshot, so a restore warns if a drive does not have the
+// image attached that it had when the snapshot was taken. The caller
+// has quiesced the drives (disk_quiesce).
+
+void disk_snap (struct snap_s * s)
+  {
+    for (uint i = 0; i < N_DSK_UNITS_MAX; i ++)
+      {
+        struct dsk_state * disk_statep = & dsk_states[i];
+        struct
+          {
+            uint32 io_mode;
+            uint32 seekPosition;
+            char filename [256];
+          } st;
+        memset (& st, 0, sizeof (st));
+        st.io_mode = (uint32) disk_statep->io_mode;
+        st.seekPosition = disk_statep->seekPosition;
+        if (dsk_unit[i].filename)
+          snprintf (st.filename, sizeof (st.filename), "%s",
+                    dsk_unit[i].filename);
+        if (! snap_io (s, "dsk", & st, sizeof (st)))
+          continue;
+        disk_statep->io_mode = st.io_mode;
+        disk_statep->seekPosition = st.seekPosition;
+        const char * now = dsk_unit[i].filename ? dsk_unit[i].filename : "";
+        if (strncmp (now, st.filename, sizeof (st.filename) - 1) != 0)
+          sim_warn ("restore: disk %u had %s attached; now %s\n", i,
+                    st.filename[0] ? st.filename : "nothing",
+                    now[0] ? now : "nothing");
+      }
+  }
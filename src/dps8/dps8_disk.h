@@ -21,7 +21,13 @@ extern DEVICE msp_dev;
 extern UNIT msp_unit [N_IPC_UNITS_MAX];
 
 void disk_init(void);
+struct snap_s;
+void disk_quiesce (void);
+void disk_snap (struct snap_s * s);
 t_stat attachDisk (char * label);
 int dsk_iom_cmd (uint iomUnitIdx, uint chan);
+#ifdef DISK_ASYNC
+void dsk_process_event (void);
+#endif
 
 
@@ -1000,6 +1000,200 @@ static void EISput469 (int k, uint i, word9 c469)
     EISWriteIdx (& e -> addr [k - 1], 0, w, true);
   }
 
+//
+// Word at a time character access
+//
+// EISget469 and EISput469 locate, read and (for a put) write back the
+// word of every character. 9- and 6-bit characters fill a word exactly,
+// so for them the routines below handle a word's worth of characters at
+// once. 4-bit characters, with their pad bits, are left to the character
+// at a time code.
+//
+
+// Bits in a character of operand k, or 0 if it is not 9- or 6-bit
+
+static uint EISwordCharSize (int k)
+  {
+#ifdef EIS_PTR3
+    switch (cpu.du.TAk[k-1])
+#else
+    switch (cpu.currentEISinstruction.TA [k - 1])
+#endif
+      {
+        case CTA9:
+          return 9;
+        case CTA6:
+          return 6;
+      }
+    return 0;
+  }
+
+static word36 EISReadWord469 (int k, word18 address)
+  {
+    EISstruct * e = & cpu.currentEISinstruction;
+    PNL (cpu.du.Dk_PTR_W[k-1] = address);
+#ifdef EIS_PTR
+    cpu.du.Dk_PTR_W[k-1] = address;
+#else
+    e -> addr [k - 1].address = address;
+#endif
+    return EISRead (& e -> addr [k - 1]);
+  }
+
+static void EISWriteWord469 (int k, word18 address, word36 data, bool flush)
+  {
+    EISstruct * e = & cpu.currentEISinstruction;
+    PNL (cpu.du.Dk_PTR_W[k-1] = address);
+#ifdef EIS_PTR
+    cpu.du.Dk_PTR_W[k-1] = address;
+#else
+    e -> addr [k - 1].address = address;
+#endif
+    EISWriteIdx (& e -> addr [k - 1], 0, data, flush);
+  }
+
+// cnt characters of operand k, starting with character i, left justified
+// in a word; the bits after them are not defined. cnt may be up to a
+// word's worth; only the words holding those characters are read.
+
+static word36 EISgetChars469 (int k, uint i, uint cnt, uint sz)
+  {
+    EISstruct * e = & cpu.currentEISinstruction;
+    uint nPos = 36 / sz;
+    uint nChars = i + e -> CN [k - 1];
+    word18 address = (word18) (e -> WN [k - 1] + nChars / nPos);
+    uint bit = (nChars % nPos) * sz;
+    word36 w = EISReadWord469 (k, address) << bit;
+    if (bit + cnt * sz > 36)
+      w |= EISReadWord469 (k, address + 1) >> (36 - bit);
+    return w & MASK36;
+  }
+
+// The bits of characters a through b - 1 of a word of sz bit characters
+
+static word36 charMask (uint sz, uint a, uint b)
+  {
+    if (a >= b)
+      return 0;
+    return ((((word36) 1) << ((b - a) * sz)) - 1) << (36 - b * sz);
+  }
+
+// A word of sz bit characters c
+
+static word36 charRep (uint sz, uint c)
+  {
+    word36 w = 0;
+    for (uint i = 0; i < 36; i += sz)
+      w = (w << sz) | c;
+    return w;
+  }
+
+// Advance the tally past the characters of operand ka that are equal to
+// those of operand kb, or to the characters of fillW if kb is 0, stopping
+// at the first that is not or at limit.
+
+static void EISskipEqual (uint sz, int ka, int kb, word36 fillW, uint limit)
+  {
+    uint nPos = 36 / sz;
+    while (cpu.du.CHTALLY < limit)
+      {
+        uint cnt = min (nPos, limit - cpu.du.CHTALLY);
+        word36 a = EISgetChars469 (ka, cpu.du.CHTALLY, cnt, sz);
+        word36 b = kb ? EISgetChars469 (kb, cpu.du.CHTALLY, cnt, sz) : fillW;
+        word36 x = (a ^ b) & charMask (sz, 0, cnt);
+        if (x)
+          {
+            // 28: the unused high bits of the 64 bit word
+            cpu.du.CHTALLY += ((uint) __builtin_clzll (x) - 28) / sz;
+            return;
+          }
+        cpu.du.CHTALLY += cnt;
+      }
+  }
+
+// mlr and mrl of 9- or 6-bit characters with TA1 == TA2, a word of the
+// destination at a time. The destination words of a paragraph are stored
+// together, and the tally is moved past them once they are, so that an
+// instruction restarted after a fault picks up at the first paragraph not
+// stored. Overlapping strings are left to the character loop; the result
+// of an overlay depends on the order of the character moves.
+//
+// Returns false if the move is not one it handles; otherwise the
+// characters and fill are stored and the tally is N2.
+
+static bool EISmoveWords (bool reverse, word9 fillT)
+  {
+    EISstruct * e = & cpu.currentEISinstruction;
+    uint sz = EISwordCharSize (1);
+    if (! sz || EISwordCharSize (2) != sz || e -> N2 == 0)
+      return false;
+    uint nPos = 36 / sz;
+    uint n1 = e -> N1;
+    uint n2 = e -> N2;
+    uint nMove = min (n1, n2);
+
+    // Destination characters dstLo to dstLo + nMove - 1 come from source
+    // characters srcLo on; the others are fill.
+    uint dstLo = reverse ? n2 - nMove : 0;
+    uint srcLo = reverse ? n1 - nMove : 0;
+
+    uint dFirst = e -> WN [1] + e -> CN [1] / nPos;
+    uint dLast = e -> WN [1] + (e -> CN [1] + n2 - 1) / nPos;
+    if (dLast > AMASK)
+      return false;
+    if (nMove)
+      {
+        uint sFirst = e -> WN [0] + (e -> CN [0] + srcLo) / nPos;
+        uint sLast = e -> WN [0] + (e -> CN [0] + srcLo + nMove - 1) / nPos;
+        if (sLast > AMASK || (sFirst <= dLast && dFirst <= sLast))
+          return false;
+      }
+
+    sim_debug (DBG_TRACEEXT, & cpu_dev, "%s word move\n", reverse ? "MRL" : "MLR");
+    word36 fillW = charRep (sz, fillT);
+    uint done = cpu.du.CHTALLY;
+    while (done < n2)
+      {
+        // The destination word holding the next character, and the
+        // characters of this instruction to be stored in it
+        uint next = reverse ? n2 - 1 - done : done;
+        uint wordNo = (e -> CN [1] + next) / nPos;
+        int base = (int) (wordNo * nPos) - (int) e -> CN [1];
+        uint lo = (uint) max (base, 0);
+        uint hi = min ((uint) (base + (int) nPos), n2);
+        if (reverse)
+          hi = min (hi, n2 - done);
+        else
+          lo = max (lo, done);
+
+        word36 m = charMask (sz, lo - (uint) base, hi - (uint) base);
+        word18 address = (word18) (e -> WN [1] + wordNo);
+        word36 w = 0;
+        if (m != MASK36)
+          w = EISReadWord469 (2, address) & ~m;
+        w |= fillW & m;
+
+        uint ma = max (lo, dstLo);
+        uint mb = min (hi, dstLo + nMove);
+        if (ma < mb)
+          {
+            uint pos = ma - (uint) base;
+            word36 mm = charMask (sz, pos, pos + mb - ma);
+            word36 src = EISgetChars469 (1, srcLo + ma - dstLo, mb - ma, sz);
+            w = (w & ~mm) | ((src >> (pos * sz)) & mm);
+          }
+
+        done += hi - lo;
+        bool flush = done == n2 ||
+                     (address & paragraphOffsetMask) ==
+                       (reverse ? 0 : paragraphOffsetMask);
+        EISWriteWord469 (2, address, w, flush);
+        if (flush)
+          cpu.du.CHTALLY = done;
+      }
+    return true;
+  }
+
 /*
  * return a 4- or 9-bit character at memory "*address" and position "*pos". 
  * Increment pos (and address if necesary)
@@ -3045,6 +3239,22 @@ void cmpc (void)
     PNL (L68_ (if (max (e->N1, e->N2) < 128)
       DU_CYCLE_FLEN_128;))
 
+    // Skip the equal leading characters a word at a time; the loops below
+    // find the inequality, if any.
+    uint sz = EISwordCharSize (1);
+    if (sz && EISwordCharSize (2) == sz)
+      {
+        EISskipEqual (sz, 1, 2, 0, min (e->N1, e->N2));
+        // A fill wider than the characters matches none of them.
+        if (cpu.du.CHTALLY >= min (e->N1, e->N2) && fill < (1u << sz))
+          {
+            if (e -> N1 < e -> N2)
+              EISskipEqual (sz, 2, 0, charRep (sz, fill), e->N2);
+            else if (e -> N1 > e -> N2)
+              EISskipEqual (sz, 1, 0, charRep (sz, fill), e->N1);
+          }
+      }
+
     for (; cpu.du.CHTALLY < min (e->N1, e->N2); cpu.du.CHTALLY ++)
       {
         word9 c1 = EISget469 (1, cpu.du.CHTALLY); // get Y-char1n
@@ -3616,6 +3826,33 @@ void scm (void)
 
     uint limit = e -> N1;
 
+    // Skip the characters that don't match a word at a time; the loop
+    // below confirms the match, if any. A masked character is zero when
+    // it matches; a character's high bit of (z & low) + low is set when
+    // any of its low bits are.
+    uint sz = EISwordCharSize (1);
+    if (sz)
+      {
+        uint nPos = 36 / sz;
+        word36 testW = charRep (sz, ctest);
+        word36 maskW = charRep (sz, ~mask & ((1u << sz) - 1));
+        word36 low = charRep (sz, (1u << (sz - 1)) - 1);
+        word36 high = charRep (sz, 1u << (sz - 1));
+        while (cpu.du.CHTALLY < limit)
+          {
+            uint cnt = min (nPos, limit - cpu.du.CHTALLY);
+            word36 z = (EISgetChars469 (1, cpu.du.CHTALLY, cnt, sz) ^ testW) & maskW;
+            word36 nonZero = (((z & low) + low) | z) & high;
+            word36 hit = ~nonZero & high & charMask (sz, 0, cnt);
+            if (hit)
+              {
+                cpu.du.CHTALLY += ((uint) __builtin_clzll (hit) - 28) / sz;
+                break;
+              }
+            cpu.du.CHTALLY += cnt;
+          }
+      }
+
     for ( ; cpu.du.CHTALLY < limit; cpu.du.CHTALLY ++)
       {
         word9 yCharn1 = EISget469 (1, cpu.du.CHTALLY);
@@ -4004,6 +4241,28 @@ void tct (void)
     PNL (L68_ (if (e->N1 < 128)
       DU_CYCLE_FLEN_128;))
 
+    // Fetch the source a word at a time and skip the characters that
+    // translate to zero; the loop below stores the one that doesn't.
+    if (EISwordCharSize (1))
+      {
+        uint nPos = 36 / srcSZ;
+        while (cpu.du.CHTALLY < e -> N1)
+          {
+            uint cnt = min (nPos, e -> N1 - cpu.du.CHTALLY);
+            word36 w = EISgetChars469 (1, cpu.du.CHTALLY, cnt, srcSZ);
+            uint i;
+            for (i = 0; i < cnt; i ++)
+              {
+                uint m = (w >> (36 - (i + 1) * srcSZ)) & ((1u << srcSZ) - 1);
+                if (xlate (&e->ADDR2, CTA9, m))
+                  break;
+              }
+            cpu.du.CHTALLY += i;
+            if (i < cnt)
+              break;
+          }
+      }
+
     for ( ; cpu.du.CHTALLY < e -> N1; cpu.du.CHTALLY ++)
       {
         word9 c = EISget469 (1, cpu.du.CHTALLY); // get src char
@@ -4555,6 +4814,12 @@ void mlr (void)
         return;
       }
 
+// Same size characters in strings that don't overlap; move them a word at
+// a time.
+
+    if (EISmoveWords (false, fillT))
+      goto done;
+
 // Test for the case of aligned word move; and do things a word at a time,
 // instead of a byte at a time...
 
@@ -4695,6 +4960,7 @@ void mlr (void)
               EISput469 (2, cpu.du.CHTALLY, fillT);
           }
     }
+done:;
     cleanupOperandDescriptor (1);
     cleanupOperandDescriptor (2);
 
@@ -4850,6 +5116,12 @@ void mrl (void)
     PNL (L68_ (if (max (e->N1, e->N2) < 128)
       DU_CYCLE_FLEN_128;))
 
+// Same size characters in strings that don't overlap; move them a word at
+// a time.
+
+    if (EISmoveWords (true, fillT))
+      goto done;
+
 //
 // Test for the case of aligned word move; and do things a word at a time,
 // instead of a byte at a time...
@@ -4998,6 +5270,7 @@ void mrl (void)
               }
           }
     }
+done:;
     cleanupOperandDescriptor (1);
     cleanupOperandDescriptor (2);
 
@@ -5192,6 +5465,396 @@ static void EISloadInputBufferNumeric (int k)
 }
 
 
+#ifndef NEED_128
+//
+// The fixed-point decimal instructions, with the operands and result held
+// as binary integers (see dec128 in dps8_decimal.h). Each of these does
+// the work of the decNumber code of its instruction, and returns false if
+// a value is too large for that, having done nothing that the decNumber
+// code won't do again.
+//
+
+// Numeric operand k, of n digits and scale sc. The operand address is put
+// back, so that the decNumber code can load the operand again.
+
+static bool EISloadDec128 (int k, int n, int sc, dec128 * d)
+  {
+    EISstruct * e = & cpu.currentEISinstruction;
+#ifdef EIS_PTR
+    word18 saveAddr = cpu.du.Dk_PTR_W[k - 1];
+    EISloadInputBufferNumeric (k);
+    cpu.du.Dk_PTR_W[k - 1] = saveAddr;
+#else
+    word18 saveAddr = e->addr[k - 1].address;
+    EISloadInputBufferNumeric (k);
+    e->addr[k - 1].address = saveAddr;
+#endif
+    return decBCD9ToDec128 (e->inBuffer, n, e->S[k - 1] == CSFL ? e->exponent : -sc,
+                            e->sign, d);
+  }
+
+// ad2d, ad3d, sb2d, sb3d, mp2d and mp3d, on loaded operands; op is '+',
+// '-' (op2 - op1) or '*'. The result is nout digits at scale factor sf in
+// out.
+
+static bool dec128Arith (char op, dec128 * op1, dec128 * op2, int nout,
+                         int sf, bool R, uint8_t * out, bool * Ovr,
+                         bool * Trunc, bool * neg, bool * zero)
+  {
+    dec128 op3;
+    bool ok;
+    switch (op)
+      {
+        case '+':
+          ok = dec128Add (& op3, op1, op2);
+          break;
+        case '-':
+          op1->coef = - op1->coef;
+          ok = dec128Add (& op3, op2, op1);
+          break;
+        default:
+          ok = dec128Multiply (& op3, op1, op2);
+          break;
+      }
+    if (! ok || ! formatDecimal128 (out, & op3, nout, sf, R, Ovr, Trunc))
+      return false;
+    * neg = op3.coef < 0;
+    * zero = op3.coef == 0;
+    return true;
+  }
+
+static bool EISarith128 (char op, int n1, int sc1, int n2, int sc2, int nout,
+                         int sf, bool R, uint8_t * out, bool * Ovr,
+                         bool * Trunc, bool * neg, bool * zero)
+  {
+    dec128 op1, op2;
+    if (! EISloadDec128 (1, n1, sc1, & op1) ||
+        ! EISloadDec128 (2, n2, sc2, & op2))
+      return false;
+    return dec128Arith (op, & op1, & op2, nout, sf, R, out, Ovr, Trunc, neg,
+                        zero);
+  }
+
+// mvn; as there, a zero operand is given the exponent 127
+
+static bool dec128Move (dec128 * op1, int nout, int sf, bool R,
+                        uint8_t * out, bool * Ovr, bool * Trunc, bool * neg,
+                        bool * zero)
+  {
+    if (op1->coef == 0)
+      op1->exponent = 127;
+    if (! formatDecimal128 (out, op1, nout, sf, R, Ovr, Trunc))
+      return false;
+    * neg = op1->coef < 0;
+    * zero = op1->coef == 0;
+    return true;
+  }
+
+static bool EISmove128 (int n1, int sc1, int nout, int sf, bool R,
+                        uint8_t * out, bool * Ovr, bool * Trunc, bool * neg,
+                        bool * zero)
+  {
+    dec128 op1;
+    if (! EISloadDec128 (1, n1, sc1, & op1))
+      return false;
+    return dec128Move (& op1, nout, sf, R, out, Ovr, Trunc, neg, zero);
+  }
+
+// Leading zeros of the n digit operand in p as dv2d and dv3d count them:
+// no more than the number of digits decBCD9ToNumber finds
+
+static int EISclz (const word9 * p, int n)
+  {
+    int lz = 0;
+    while (lz < n && p[lz] == 0)
+      lz ++;
+    return min (lz, lz < n ? n - lz : 1);
+  }
+
+// The quotient digits dv2d and dv3d check against 63
+
+static int dec128NQ (int n1, int clz1, const dec128 * op1, int n2, int clz2,
+                     const dec128 * op2, int sf)
+  {
+    return (n2 - clz2 + 1) - (n1 - clz1) + (op2->exponent - op1->exponent - sf);
+  }
+
+// dv2d and dv3d, on loaded operands: op2 / op1
+
+static bool dec128Divide (const dec128 * op1, const dec128 * op2, int nout,
+                          int sf, bool R, uint8_t * out, bool * Ovr,
+                          bool * Trunc, bool * neg, bool * zero)
+  {
+    dec128 op3;
+    if (! divideDecimal128 (out, & op3, op2, op1, nout, sf, R, Ovr, Trunc))
+      return false;
+    * neg = op3.coef < 0;
+    * zero = op3.coef == 0;
+    return true;
+  }
+
+// dv2d and dv3d: op2 / op1, with their divide checks
+
+static bool EISdivide128 (int n1, int sc1, int n2, int sc2, int nout, int sf,
+                          bool R, const char * zeroMsg, const char * nqMsg,
+                          uint8_t * out, bool * Ovr, bool * Trunc, bool * neg,
+                          bool * zero)
+  {
+    EISstruct * e = & cpu.currentEISinstruction;
+    dec128 op1, op2;
+    if (! EISloadDec128 (1, n1, sc1, & op1))
+      return false;
+    if (op1.coef == 0)
+      doFault (FAULT_DIV, fst_zero, zeroMsg);
+    int clz1 = EISclz (e->inBuffer, n1);
+    if (! EISloadDec128 (2, n2, sc2, & op2))
+      return false;
+    int clz2 = EISclz (e->inBuffer, n2);
+    int NQ = dec128NQ (n1, clz1, & op1, n2, clz2, & op2, sf);
+    sim_debug (DBG_TRACEEXT, & cpu_dev, "EISdivide128 clz1 %d clz2 %d NQ %d\n",
+               clz1, clz2, NQ);
+    if (NQ > 63)
+      doFault (FAULT_DIV, fst_zero, nqMsg);
+    return dec128Divide (& op1, & op2, nout, sf, R, out, Ovr, Trunc, neg,
+                         zero);
+  }
+#endif
+
+#if defined(TESTING) && ! defined(NEED_128)
+//
+// eis128test [cases [seed]]
+//
+// Check the binary fixed-point code above against the decNumber code it
+// stands in for, over random operands: for each of ad2d ... dv3d and mvn,
+// compare the result digits and the OVR, TRUNC, ZERO and NEG indicators,
+// and for dv2d and dv3d the NQ > 63 divide check. Cases the binary code
+// hands back to decNumber are counted but not compared.
+//
+
+static uint64 eisTestRng;
+
+static uint64 eisTestRand (uint64 n)
+  {
+    // xorshift64*
+    eisTestRng ^= eisTestRng >> 12;
+    eisTestRng ^= eisTestRng << 25;
+    eisTestRng ^= eisTestRng >> 27;
+    return (eisTestRng * 0x2545F4914F6CDD1DULL) % n;
+  }
+
+// n digits; mostly few enough significant ones for dec128, with runs of
+// nines and zeros for the carries and rounding
+
+static void eisTestOperand (word9 * bcd, int n, int * sign)
+  {
+    int sig = (int) eisTestRand ((uint64) min (n, DEC128_DIGITS + 4) + 1);
+    uint64 fill = eisTestRand (8);
+    memset (bcd, 0, (size_t) n * sizeof (word9));
+    for (int i = n - sig; i < n; i ++)
+      bcd[i] = fill == 0 ? 9 : fill == 1 && i > n - sig ? 0 :
+               (word9) eisTestRand (10);
+    * sign = eisTestRand (2) ? -1 : 1;
+  }
+
+// The decNumber code of the instructions for fixed-point operands and
+// result; op is as for dec128Arith, '/' for dv2d and dv3d or 'm' for mvn.
+// The internal register overflow check of ad and sb is left out, as it
+// only applies to results of more than 63 digits.
+
+static void eisTestDecNumber (char op, const word9 * bcd1, int n1, int sc1,
+                              int sign1, const word9 * bcd2, int n2, int sc2,
+                              int sign2, int nout, int sf, bool R,
+                              uint8_t * out, bool * Ovr, bool * Trunc,
+                              bool * neg, bool * zero)
+  {
+    decContext set;
+    if (op == '*')
+      decContextDefaultDPS8Mul (& set);
+    else
+      decContextDefaultDPS8 (& set);
+    set.traps = 0;
+
+    decNumber _1, _2, _3;
+    decNumber * op1 = decBCD9ToNumber (bcd1, n1, sc1, & _1);
+    if (sign1 == -1)
+      op1->bits |= DECNEG;
+    decNumber * op3 = op1;
+    if (op == 'm')
+      {
+        if (decNumberIsZero (op1))
+          op1->exponent = 127;
+      }
+    else
+      {
+        decNumber * op2 = decBCD9ToNumber (bcd2, n2, sc2, & _2);
+        if (sign2 == -1)
+          op2->bits |= DECNEG;
+        switch (op)
+          {
+            case '+':
+              op3 = decNumberAdd (& _3, op1, op2, & set);
+              break;
+            case '-':
+              op3 = decNumberSubtract (& _3, op2, op1, & set);
+              break;
+            case '*':
+              op3 = decNumberMultiply (& _3, op1, op2, & set);
+              break;
+            default:
+              op3 = decNumberDivide (& _3, op2, op1, & set);
+              break;
+          }
+      }
+    formatDecimal (out, & set, op3, nout, CSLS, sf, R, Ovr, Trunc);
+    if (decNumberIsZero (op3))
+      op3->exponent = 127;
+    * neg = decNumberIsNegative (op3) && ! decNumberIsZero (op3);
+    * zero = decNumberIsZero (op3);
+  }
+
+// The NQ of dv2d and dv3d as their decNumber code finds it
+
+static int eisTestNQ (const word9 * bcd1, int n1, int sc1, const word9 * bcd2,
+                      int n2, int sc2, int sf)
+  {
+    decNumber _1, _2;
+    decNumber * op1 = decBCD9ToNumber (bcd1, n1, sc1, & _1);
+    decNumber * op2 = decBCD9ToNumber (bcd2, n2, sc2, & _2);
+    int clz1, clz2;
+    for (clz1 = 0; clz1 < op1->digits; clz1 ++)
+      if (bcd1[clz1] != 0)
+        break;
+    for (clz2 = 0; clz2 < op2->digits; clz2 ++)
+      if (bcd2[clz2] != 0)
+        break;
+    return (n2 - clz2 + 1) - (n1 - clz1) + (op2->exponent - op1->exponent - sf);
+  }
+
+static void eisTestShow (const char * tag, const word9 * bcd, int n, int sc,
+                         int sign)
+  {
+    char digits [64];
+    for (int i = 0; i < n; i ++)
+      digits[i] = (char) ('0' + bcd[i]);
+    digits[n] = 0;
+    sim_printf ("  %s %c%s sf %d\n", tag, sign == -1 ? '-' : '+', digits, - sc);
+  }
+
+static const struct
+  {
+    const char * name;
+    char op;
+    bool three;  // result descriptor of its own
+  } eisTests [] =
+  {
+    { "ad2d", '+', false }, { "ad3d", '+', true },
+    { "sb2d", '-', false }, { "sb3d", '-', true },
+    { "mp2d", '*', false }, { "mp3d", '*', true },
+    { "dv2d", '/', false }, { "dv3d", '/', true },
+    { "mvn",  'm', true },
+  };
+
+t_stat eis128_test (UNUSED int32 arg, const char * buf)
+  {
+    unsigned long cases = 100000;
+    unsigned long long seed = 1;
+    if (buf && * buf && sscanf (buf, "%lu %llu", & cases, & seed) < 1)
+      return SCPE_ARG;
+    eisTestRng = seed ? seed : 1;
+
+    for (uint t = 0; t < sizeof (eisTests) / sizeof (eisTests[0]); t ++)
+      {
+        char op = eisTests[t].op;
+        unsigned long binary = 0, differ = 0;
+        for (unsigned long c = 0; c < cases; c ++)
+          {
+            word9 bcd1 [64], bcd2 [64];
+            int sign1, sign2;
+            int n1 = 1 + (int) eisTestRand (62);
+            int n2 = 1 + (int) eisTestRand (62);
+            int sc1 = 32 - (int) eisTestRand (64);
+            int sc2 = 32 - (int) eisTestRand (64);
+            eisTestOperand (bcd1, n1, & sign1);
+            eisTestOperand (bcd2, n2, & sign2);
+            int nout = n2, sf = - sc2;
+            if (eisTests[t].three)
+              {
+                nout = 1 + (int) eisTestRand (62);
+                sf = 31 - (int) eisTestRand (64);
+              }
+            bool R = eisTestRand (2);
+
+            uint8_t out [256], refOut [256];
+            bool Ovr = false, Trunc = false, neg = false, zero = false;
+            bool refOvr = false, refTrunc = false, refNeg, refZero;
+            dec128 op1, op2;
+            bool ok = decBCD9ToDec128 (bcd1, n1, - sc1, sign1, & op1) &&
+                      decBCD9ToDec128 (bcd2, n2, - sc2, sign2, & op2);
+            if (op == '/')
+              {
+                int first;
+                for (first = 0; first < n1 && bcd1[first] == 0; first ++)
+                  ;
+                if (first == n1)
+                  continue;  // divide check
+                int refNQ = eisTestNQ (bcd1, n1, sc1, bcd2, n2, sc2, sf);
+                if (ok)
+                  {
+                    int NQ = dec128NQ (n1, EISclz (bcd1, n1), & op1,
+                                       n2, EISclz (bcd2, n2), & op2, sf);
+                    if ((NQ > 63) != (refNQ > 63))
+                      {
+                        if (differ ++ < 5)
+                          {
+                            sim_printf ("%s NQ %d, decNumber %d\n",
+                                        eisTests[t].name, NQ, refNQ);
+                            eisTestShow ("op1", bcd1, n1, sc1, sign1);
+                            eisTestShow ("op2", bcd2, n2, sc2, sign2);
+                          }
+                        continue;
+                      }
+                  }
+                if (refNQ > 63)
+                  continue;  // divide check
+                ok = ok && dec128Divide (& op1, & op2, nout, sf, R, out, & Ovr,
+                                         & Trunc, & neg, & zero);
+              }
+            else if (op == 'm')
+              ok = ok && dec128Move (& op1, nout, sf, R, out, & Ovr, & Trunc,
+                                     & neg, & zero);
+            else
+              ok = ok && dec128Arith (op, & op1, & op2, nout, sf, R, out,
+                                      & Ovr, & Trunc, & neg, & zero);
+            if (! ok)
+              continue;
+            binary ++;
+
+            eisTestDecNumber (op, bcd1, n1, sc1, sign1, bcd2, n2, sc2, sign2,
+                              nout, sf, R, refOut, & refOvr, & refTrunc,
+                              & refNeg, & refZero);
+            if (memcmp (out, refOut, (size_t) nout) == 0 && Ovr == refOvr &&
+                Trunc == refTrunc && neg == refNeg && zero == refZero)
+              continue;
+            if (differ ++ < 5)
+              {
+                sim_printf ("%s R %d nout %d sf %d\n", eisTests[t].name, R,
+                            nout, sf);
+                eisTestShow ("op1", bcd1, n1, sc1, sign1);
+                if (op != 'm')
+                  eisTestShow ("op2", bcd2, n2, sc2, sign2);
+                sim_printf ("  binary    %.*s OVR %d TRUNC %d NEG %d ZERO %d\n",
+                            nout, out, Ovr, Trunc, neg, zero);
+                sim_printf ("  decNumber %.*s OVR %d TRUNC %d NEG %d ZERO %d\n",
+                            nout, refOut, refOvr, refTrunc, refNeg, refZero);
+              }
+          }
+        sim_printf ("%-4s %lu cases, %lu in binary, %lu differ\n",
+                    eisTests[t].name, cases, binary, differ);
+      }
+    return SCPE_OK;
+  }
+#endif
+
 /*
  * Load decimal unit input buffer with sending string characters. Data is read
  * from main memory in unaligned units (not modulo 8 boundary) of Y-block8
@@ -7440,41 +8103,51 @@ void cmpn (void)
         doFault (FAULT_IPR, fst_ill_proc, "cmpn adjusted n2<1");
 
 
-    decContext set;
-    //decContextDefault(&set, DEC_INIT_BASE);         // initialize
-    decContextDefaultDPS8(&set);
+    int cSigned, cMag;
 
-    set.traps=0;
-    
-    decNumber _1, _2, _3;
-    
-    EISloadInputBufferNumeric (1);   // according to MF1
-    
-    decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
-    if (e->sign == -1)
-        op1->bits |= DECNEG;
-    if (e->S1 == CSFL)
-        op1->exponent = e->exponent;
-    
-    EISloadInputBufferNumeric (2);   // according to MF2
-    
-    decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
-    if (e->sign == -1)
-        op2->bits |= DECNEG;
-    if (e->S2 == CSFL)
-        op2->exponent = e->exponent;
-    
-    // signed-compare
-    decNumber *cmp = decNumberCompare(&_3, op1, op2, &set); // compare signed op1 :: op2
-    int cSigned = decNumberToInt32(cmp, &set);
-    
-    // take absolute value of operands
-    op1 = decNumberAbs(op1, op1, &set);
-    op2 = decNumberAbs(op2, op2, &set);
+#ifndef NEED_128
+    dec128 d1, d2;
+    if (! EISloadDec128 (1, n1, sc1, &d1) ||
+        ! EISloadDec128 (2, n2, sc2, &d2) ||
+        ! dec128Compare (&d1, &d2, &cSigned, &cMag))
+#endif
+    {
+        decContext set;
+        //decContextDefault(&set, DEC_INIT_BASE);         // initialize
+        decContextDefaultDPS8(&set);
+
+        set.traps=0;
+        
+        decNumber _1, _2, _3;
+        
+        EISloadInputBufferNumeric (1);   // according to MF1
+        
+        decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
+        if (e->sign == -1)
+            op1->bits |= DECNEG;
+        if (e->S1 == CSFL)
+            op1->exponent = e->exponent;
+        
+        EISloadInputBufferNumeric (2);   // according to MF2
+        
+        decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
+        if (e->sign == -1)
+            op2->bits |= DECNEG;
+        if (e->S2 == CSFL)
+            op2->exponent = e->exponent;
+        
+        // signed-compare
+        decNumber *cmp = decNumberCompare(&_3, op1, op2, &set); // compare signed op1 :: op2
+        cSigned = decNumberToInt32(cmp, &set);
+        
+        // take absolute value of operands
+        op1 = decNumberAbs(op1, op1, &set);
+        op2 = decNumberAbs(op2, op2, &set);
 
-    // magnitude-compare
-    decNumber *mcmp = decNumberCompare(&_3, op1, op2, &set); // compare signed op1 :: op2
-    int cMag = decNumberToInt32(mcmp, &set);
+        // magnitude-compare
+        decNumber *mcmp = decNumberCompare(&_3, op1, op2, &set); // compare signed op1 :: op2
+        cMag = decNumberToInt32(mcmp, &set);
+    }
     
     // Zero If C(Y-charn1) = C(Y-charn2), then ON; otherwise OFF
     // Negative If C(Y-charn1) > C(Y-charn2), then ON; otherwise OFF
@@ -7773,36 +8446,49 @@ void mvn (void)
     if (n2 < 1)
         doFault (FAULT_IPR, fst_ill_proc, "mvn adjusted n2<1");
 
-    decContext set;
-    decContextDefaultDPS8(&set);
-    set.traps=0;
-    
     decNumber _1;
+    decNumber * op1 = & _1;
+    bool Ovr = false, EOvr = false, Trunc = false;
+    uint8_t out [256];
+    char * res;
+    bool neg, zero;
+
+#ifndef NEED_128
+    if (e->S2 != CSFL &&
+        EISmove128 (n1, sc1, n2, e->SF2, R, out, & Ovr, & Trunc, & neg,
+                    & zero))
+        res = (char *) out;
+    else
+#endif
+    {
+        decContext set;
+        decContextDefaultDPS8(&set);
+        set.traps=0;
 
-    EISloadInputBufferNumeric (1);   // according to MF1
+        EISloadInputBufferNumeric (1);   // according to MF1
+        
+        op1 = decBCD9ToNumber (e->inBuffer, n1, sc1, &_1);
+        
+        if (e->sign == -1)
+            op1->bits |= DECNEG;
+        if (e->S1 == CSFL)
+            op1->exponent = e->exponent;
+        if (decNumberIsZero (op1))
+            op1->exponent = 127;
+       
+        if_sim_debug (DBG_CAC, & cpu_dev)
+        {
+            PRINTDEC ("mvn input (op1)", op1);
+        }
+
+        res = formatDecimal (out, & set, op1, n2, (int) e->S2, e->SF2, R,
+                             & Ovr, & Trunc);
+
+        neg = decNumberIsNegative (op1) && ! decNumberIsZero (op1);
+        zero = decNumberIsZero (op1);
+    }
     
-    decNumber *op1 = decBCD9ToNumber (e->inBuffer, n1, sc1, &_1);
-    
-    if (e->sign == -1)
-        op1->bits |= DECNEG;
-    if (e->S1 == CSFL)
-        op1->exponent = e->exponent;
-    if (decNumberIsZero (op1))
-        op1->exponent = 127;
-   
-    if_sim_debug (DBG_CAC, & cpu_dev)
-    {
-        PRINTDEC ("mvn input (op1)", op1);
-    }
-   
-    bool Ovr = false, EOvr = false, Trunc = false;
-    
-
-    uint8_t out [256];
-    char * res = formatDecimal (out, & set, op1, n2, (int) e->S2, e->SF2, R,
-                                & Ovr, & Trunc);
-    
-    sim_debug (DBG_CAC, & cpu_dev, "mvn res: '%s'\n", res);
+    sim_debug (DBG_CAC, & cpu_dev, "mvn res: '%s'\n", res);
     
     // now write to memory in proper format.....
 
@@ -7823,18 +8509,15 @@ void mvn (void)
                     if (e->P)
                         // special +
                         EISwrite49 (& e->ADDR2, & pos, (int) dstTN,
-                                   (decNumberIsNegative (op1) &&
-                                    ! decNumberIsZero(op1)) ? 015 : 013);
+                                   neg ? 015 : 013);
                     else
                         // default +
                         EISwrite49 (& e->ADDR2, & pos, (int) dstTN, 
-                                    (decNumberIsNegative (op1) &&
-                                     ! decNumberIsZero (op1)) ? 015 : 014);
+                                    neg ? 015 : 014);
                     break;
                 case CTN9:
                     EISwrite49 (& e->ADDR2, & pos, (int) dstTN,
-                                (decNumberIsNegative (op1) &&
-                                 ! decNumberIsZero (op1)) ? '-' : '+');
+                                neg ? '-' : '+');
                     break;
             }
             break;
@@ -7870,19 +8553,16 @@ void mvn (void)
                     if (e->P)
                         // special +
                         EISwrite49 (& e->ADDR2, & pos, (int) dstTN,
-                                    (decNumberIsNegative (op1) &&
-                                     ! decNumberIsZero(op1)) ? 015 :  013);
+                                    neg ? 015 :  013);
                     else
                         // default +
                         EISwrite49 (& e->ADDR2, & pos, (int) dstTN,
-                                    (decNumberIsNegative (op1) &&
-                                     ! decNumberIsZero (op1)) ? 015 :  014);
+                                    neg ? 015 :  014);
                     break;
             
                 case CTN9:
                     EISwrite49 (& e->ADDR2, & pos, (int) dstTN,
-                                (decNumberIsNegative (op1) &&
-                                 ! decNumberIsZero(op1)) ? '-' : '+');
+                                neg ? '-' : '+');
                     break;
             }
             break;
@@ -7924,8 +8604,8 @@ void mvn (void)
         }
     }
     
-sim_debug (DBG_CAC, & cpu_dev, "is neg %o\n", decNumberIsNegative(op1));
-sim_debug (DBG_CAC, & cpu_dev, "is zero %o\n", decNumberIsZero(op1));
+sim_debug (DBG_CAC, & cpu_dev, "is neg %o\n", neg);
+sim_debug (DBG_CAC, & cpu_dev, "is zero %o\n", zero);
 sim_debug (DBG_CAC, & cpu_dev, "R %o\n", R);
 sim_debug (DBG_CAC, & cpu_dev, "Trunc %o\n", Trunc);
 sim_debug (DBG_CAC, & cpu_dev, "TRUNC %o\n", TST_I_TRUNC);
@@ -7935,10 +8615,10 @@ sim_debug (DBG_CAC, & cpu_dev, "T %o\n", T);
 sim_debug (DBG_CAC, & cpu_dev, "EOvr %o\n", EOvr);
 sim_debug (DBG_CAC, & cpu_dev, "Ovr %o\n", Ovr);
     // set negative indicator if op3 < 0
-    SC_I_NEG (decNumberIsNegative(op1) && !decNumberIsZero(op1));
+    SC_I_NEG (neg);
 
     // set zero indicator if op3 == 0
-    SC_I_ZERO (decNumberIsZero(op1));
+    SC_I_ZERO (zero);
     
     // If the truncation condition exists without rounding, then ON; 
     // otherwise OFF
@@ -10257,77 +10937,93 @@ void ad2d (void)
         doFault (FAULT_IPR, fst_ill_proc, "ad2d adjusted n2<1");
     
 
-    decContext set;
-    //decContextDefault(&set, DEC_INIT_BASE);         // initialize
-    decContextDefaultDPS8(&set);
-    
-    set.traps=0;
-    
-    decNumber _1, _2, _3;
-    
-    EISloadInputBufferNumeric (1);   // according to MF1
-    
-    decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
-    if (e->sign == -1)
-        op1->bits |= DECNEG;
-    if (e->S1 == CSFL)
-        op1->exponent = e->exponent;
-    
-    EISloadInputBufferNumeric (2);   // according to MF2
+    decNumber _3;
+    decNumber *op3 = &_3;
+    bool Ovr = false, EOvr = false, Trunc = false;
+    uint8_t out [256];
+    char *res;
+    bool neg, zero;
 
-    decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
-    if (e->sign == -1)
-        op2->bits |= DECNEG;
-    if (e->S2 == CSFL)
-        op2->exponent = e->exponent;
-    
-    decNumber *op3 = decNumberAdd(&_3, op1, op2, &set);
-
-    // ISOLTS 846 07c, 10a, 11b internal register overflow - see ad3d
-    bool iOvr = 0;
-    if (op3->digits > 63) {
-        uint8_t pr[256];
-        // if sf<=0, trailing zeroes can't be shifted out
-        // if sf> 0, (some of) trailing zeroes can be shifted out 
-        int sf = e->S3==CSFL?op3->exponent:e->SF3;
-
-        int ctz = 0;
-        if (sf>0) {	// optimize: we don't care when sf>0
-            decNumberGetBCD(op3,pr);
-            for (int i=op3->digits-1;i>=0 && pr[i]==0;i--)
-                 ctz ++;
-        }
+#ifndef NEED_128
+    if (e->S2 != CSFL &&
+        EISarith128 ('+', n1, sc1, n2, sc2, n2, e->SF2, R, out, &Ovr, &Trunc,
+                     &neg, &zero))
+        res = (char *) out;
+    else
+#endif
+    {
+        decContext set;
+        //decContextDefault(&set, DEC_INIT_BASE);         // initialize
+        decContextDefaultDPS8(&set);
+        
+        set.traps=0;
+        
+        decNumber _1, _2;
+        
+        EISloadInputBufferNumeric (1);   // according to MF1
+        
+        decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
+        if (e->sign == -1)
+            op1->bits |= DECNEG;
+        if (e->S1 == CSFL)
+            op1->exponent = e->exponent;
+        
+        EISloadInputBufferNumeric (2);   // according to MF2
 
-        if (op3->digits - min(max(sf,0),ctz) > 63) {
+        decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
+        if (e->sign == -1)
+            op2->bits |= DECNEG;
+        if (e->S2 == CSFL)
+            op2->exponent = e->exponent;
+        
+        op3 = decNumberAdd(&_3, op1, op2, &set);
+
+        // ISOLTS 846 07c, 10a, 11b internal register overflow - see ad3d
+        bool iOvr = 0;
+        if (op3->digits > 63) {
+            uint8_t pr[256];
+            // if sf<=0, trailing zeroes can't be shifted out
+            // if sf> 0, (some of) trailing zeroes can be shifted out 
+            int sf = e->S3==CSFL?op3->exponent:e->SF3;
+
+            int ctz = 0;
+            if (sf>0) {	// optimize: we don't care when sf>0
+                decNumberGetBCD(op3,pr);
+                for (int i=op3->digits-1;i>=0 && pr[i]==0;i--)
+                     ctz ++;
+            }
 
-            enum rounding safeR = decContextGetRounding(&set);         // save rounding mode
-            int safe = set.digits;
-            decNumber tmp;
+            if (op3->digits - min(max(sf,0),ctz) > 63) {
 
-            // discard MS digits
-            decContextSetRounding(&set, DEC_ROUND_DOWN);     // Round towards 0 (truncation).
-            set.digits = op3->digits - min(max(sf,0),ctz) - 63;
-            decNumberPlus(&tmp, op3, &set);
-            set.digits = safe;
+                enum rounding safeR = decContextGetRounding(&set);         // save rounding mode
+                int safe = set.digits;
+                decNumber tmp;
 
-            decNumberSubtract(op3, op3, &tmp, &set); 
+                // discard MS digits
+                decContextSetRounding(&set, DEC_ROUND_DOWN);     // Round towards 0 (truncation).
+                set.digits = op3->digits - min(max(sf,0),ctz) - 63;
+                decNumberPlus(&tmp, op3, &set);
+                set.digits = safe;
 
-            //decNumberToString(op3,(char*)pr); sim_printf("discarded: %s\n",pr);
+                decNumberSubtract(op3, op3, &tmp, &set); 
 
-            decContextSetRounding(&set, safeR);
-            iOvr = 1;
+                //decNumberToString(op3,(char*)pr); sim_printf("discarded: %s\n",pr);
+
+                decContextSetRounding(&set, safeR);
+                iOvr = 1;
+            }
         }
-    }
 
-    bool Ovr = false, EOvr = false, Trunc = false;
+        res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
 
-    uint8_t out [256];
-    char *res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
+        Ovr |= iOvr;
 
-    Ovr |= iOvr;
+        if (decNumberIsZero(op3))
+            op3->exponent = 127;
 
-    if (decNumberIsZero(op3))
-        op3->exponent = 127;
+        neg = decNumberIsNegative(op3) && !decNumberIsZero(op3);
+        zero = decNumberIsZero(op3);
+    }
     
     //printf("%s\r\n", res);
     
@@ -10345,12 +11041,12 @@ void ad2d (void)
             {
                 case CTN4:
                     if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                     else
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                     break;
                 case CTN9:
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                     break;
             }
             break;
@@ -10380,12 +11076,12 @@ void ad2d (void)
             {
                 case CTN4:
                     if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                     else
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                     break;
                 case CTN9:
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                     break;
             }
             break;
@@ -10424,8 +11120,8 @@ void ad2d (void)
         }
     }
     
-    SC_I_NEG (decNumberIsNegative(op3) && !decNumberIsZero(op3));  // set negative indicator if op3 < 0
-    SC_I_ZERO (decNumberIsZero(op3));     // set zero indicator if op3 == 0
+    SC_I_NEG (neg);  // set negative indicator if op3 < 0
+    SC_I_ZERO (zero);     // set zero indicator if op3 == 0
     
     SC_I_TRUNC (!R && Trunc); // If the truncation condition exists without rounding, then ON; otherwise OFF
     
@@ -10630,83 +11326,99 @@ void ad3d (void)
         doFault (FAULT_IPR, fst_ill_proc, "ad3d adjusted n3<1");
     
 
-    decContext set;
-    //decContextDefault(&set, DEC_INIT_BASE);         // initialize
-    decContextDefaultDPS8(&set);
-    set.traps=0;
-    
-    decNumber _1, _2, _3;
-    
-    EISloadInputBufferNumeric (1);   // according to MF1
-    
-    decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
-    if (e->sign == -1)
-        op1->bits |= DECNEG;
-    if (e->S1 == CSFL)
-        op1->exponent = e->exponent;
-    
-    EISloadInputBufferNumeric (2);   // according to MF2
+    decNumber _3;
+    decNumber *op3 = &_3;
+    bool Ovr = false, EOvr = false, Trunc = false;
+    uint8_t out [256];
+    char *res;
+    bool neg, zero;
 
-    decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
-    if (e->sign == -1)
-        op2->bits |= DECNEG;
-    if (e->S2 == CSFL)
-        op2->exponent = e->exponent;
-
-    decNumber *op3 = decNumberAdd(&_3, op1, op2, &set);
-
-    // RJ78: significant digits in the result may be lost if:
-    // The difference between the scaling factors (exponents) of the source
-    // operands is large enough to cause the expected length of the intermediate
-    // result to exceed 63 digits after decimal point alignment of source operands, followed by addition.
-    // ISOLTS 846 07c, 10a, 11b internal register overflow
-    // trailing zeros are not counted towards the limit
-    // XXX it is not clear which digits are lost, but I suppose it should be the most significant. ISOLTS doesn't check for this
-    // XXX the algorithm should be similar/the same as dv3d NQ? It is to some extent already...
-    bool iOvr = 0;
-    if (op3->digits > 63) {
-        uint8_t pr[256];
-        // if sf<=0, trailing zeroes can't be shifted out
-        // if sf> 0, (some of) trailing zeroes can be shifted out 
-        int sf = e->S3==CSFL?op3->exponent:e->SF3;
-
-        int ctz = 0;
-        if (sf>0) {	// optimize: we don't care when sf>0
-            decNumberGetBCD(op3,pr);
-            for (int i=op3->digits-1;i>=0 && pr[i]==0;i--)
-                 ctz ++;
-        }
+#ifndef NEED_128
+    if (e->S3 != CSFL &&
+        EISarith128 ('+', n1, sc1, n2, sc2, n3, e->SF3, R, out, &Ovr, &Trunc,
+                     &neg, &zero))
+        res = (char *) out;
+    else
+#endif
+    {
+        decContext set;
+        //decContextDefault(&set, DEC_INIT_BASE);         // initialize
+        decContextDefaultDPS8(&set);
+        set.traps=0;
+        
+        decNumber _1, _2;
+        
+        EISloadInputBufferNumeric (1);   // according to MF1
+        
+        decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
+        if (e->sign == -1)
+            op1->bits |= DECNEG;
+        if (e->S1 == CSFL)
+            op1->exponent = e->exponent;
+        
+        EISloadInputBufferNumeric (2);   // according to MF2
+
+        decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
+        if (e->sign == -1)
+            op2->bits |= DECNEG;
+        if (e->S2 == CSFL)
+            op2->exponent = e->exponent;
+
+        op3 = decNumberAdd(&_3, op1, op2, &set);
+
+        // RJ78: significant digits in the result may be lost if:
+        // The difference between the scaling factors (exponents) of the source
+        // operands is large enough to cause the expected length of the intermediate
+        // result to exceed 63 digits after decimal point alignment of source operands, followed by addition.
+        // ISOLTS 846 07c, 10a, 11b internal register overflow
+        // trailing zeros are not counted towards the limit
+        // XXX it is not clear which digits are lost, but I suppose it should be the most significant. ISOLTS doesn't check for this
+        // XXX the algorithm should be similar/the same as dv3d NQ? It is to some extent already...
+        bool iOvr = 0;
+        if (op3->digits > 63) {
+            uint8_t pr[256];
+            // if sf<=0, trailing zeroes can't be shifted out
+            // if sf> 0, (some of) trailing zeroes can be shifted out 
+            int sf = e->S3==CSFL?op3->exponent:e->SF3;
+
+            int ctz = 0;
+            if (sf>0) {	// optimize: we don't care when sf>0
+                decNumberGetBCD(op3,pr);
+                for (int i=op3->digits-1;i>=0 && pr[i]==0;i--)
+                     ctz ++;
+            }
 
-        if (op3->digits - min(max(sf,0),ctz) > 63) {
+            if (op3->digits - min(max(sf,0),ctz) > 63) {
 
-            enum rounding safeR = decContextGetRounding(&set);         // save rounding mode
-            int safe = set.digits;
-            decNumber tmp;
+                enum rounding safeR = decContextGetRounding(&set);         // save rounding mode
+                int safe = set.digits;
+                decNumber tmp;
 
-            // discard MS digits
-            decContextSetRounding(&set, DEC_ROUND_DOWN);     // Round towards 0 (truncation).
-            set.digits = op3->digits - min(max(sf,0),ctz) - 63;
-            decNumberPlus(&tmp, op3, &set);
-            set.digits = safe;
+                // discard MS digits
+                decContextSetRounding(&set, DEC_ROUND_DOWN);     // Round towards 0 (truncation).
+                set.digits = op3->digits - min(max(sf,0),ctz) - 63;
+                decNumberPlus(&tmp, op3, &set);
+                set.digits = safe;
 
-            decNumberSubtract(op3, op3, &tmp, &set); 
+                decNumberSubtract(op3, op3, &tmp, &set); 
 
-            //decNumberToString(op3,(char*)pr); sim_printf("discarded: %s\n",pr);
+                //decNumberToString(op3,(char*)pr); sim_printf("discarded: %s\n",pr);
 
-            decContextSetRounding(&set, safeR);
-            iOvr = 1;
+                decContextSetRounding(&set, safeR);
+                iOvr = 1;
+            }
         }
-    }
 
-    bool Ovr = false, EOvr = false, Trunc = false;
-    
-    uint8_t out [256];
-    char *res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
+        res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
+
+        Ovr |= iOvr;
 
-    Ovr |= iOvr;
+        if (decNumberIsZero(op3))
+            op3->exponent = 127;
 
-    if (decNumberIsZero(op3))
-        op3->exponent = 127;
+        neg = decNumberIsNegative(op3) && !decNumberIsZero(op3);
+        zero = decNumberIsZero(op3);
+    }
     
     //printf("%s\r\n", res);
     
@@ -10724,12 +11436,12 @@ void ad3d (void)
             {
             case CTN4:
                 if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                 else
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                 break;
             case CTN9:
-                EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                 break;
             }
             break;
@@ -10759,12 +11471,12 @@ void ad3d (void)
             {
             case CTN4:
                 if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                 else
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                 break;
             case CTN9:
-                EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                 break;
             }
             break;
@@ -10804,8 +11516,8 @@ void ad3d (void)
         }
     }
     
-    SC_I_NEG (decNumberIsNegative(op3) && !decNumberIsZero(op3));  // set negative indicator if op3 < 0
-    SC_I_ZERO (decNumberIsZero(op3));     // set zero indicator if op3 == 0
+    SC_I_NEG (neg);  // set negative indicator if op3 < 0
+    SC_I_ZERO (zero);     // set zero indicator if op3 == 0
     
     SC_I_TRUNC (!R && Trunc); // If the truncation condition exists without rounding, then ON; otherwise OFF
     
@@ -10951,76 +11663,92 @@ void sb2d (void)
         doFault (FAULT_IPR, fst_ill_proc, "sb2d adjusted n2<1");
 
     
-    decContext set;
-    //decContextDefault(&set, DEC_INIT_BASE);         // initialize
-    decContextDefaultDPS8(&set);
-    set.traps=0;
-    
-    decNumber _1, _2, _3;
-    
-    EISloadInputBufferNumeric (1);   // according to MF1
-    
-    decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
-    if (e->sign == -1)
-        op1->bits |= DECNEG;
-    if (e->S1 == CSFL)
-        op1->exponent = e->exponent;
-    
-    EISloadInputBufferNumeric (2);   // according to MF2
+    decNumber _3;
+    decNumber *op3 = &_3;
+    bool Ovr = false, EOvr = false, Trunc = false;
+    uint8_t out [256];
+    char *res;
+    bool neg, zero;
 
-    decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
-    if (e->sign == -1)
-        op2->bits |= DECNEG;
-    if (e->S2 == CSFL)
-        op2->exponent = e->exponent;
-    
-    decNumber *op3 = decNumberSubtract(&_3, op2, op1, &set);
-
-    // ISOLTS 846 07c, 10a, 11b internal register overflow - see ad3d
-    bool iOvr = 0;
-    if (op3->digits > 63) {
-        uint8_t pr[256];
-        // if sf<=0, trailing zeroes can't be shifted out
-        // if sf> 0, (some of) trailing zeroes can be shifted out 
-        int sf = e->S3==CSFL?op3->exponent:e->SF3;
-
-        int ctz = 0;
-        if (sf>0) {	// optimize: we don't care when sf>0
-            decNumberGetBCD(op3,pr);
-            for (int i=op3->digits-1;i>=0 && pr[i]==0;i--)
-                 ctz ++;
-        }
+#ifndef NEED_128
+    if (e->S2 != CSFL &&
+        EISarith128 ('-', n1, sc1, n2, sc2, n2, e->SF2, R, out, &Ovr, &Trunc,
+                     &neg, &zero))
+        res = (char *) out;
+    else
+#endif
+    {
+        decContext set;
+        //decContextDefault(&set, DEC_INIT_BASE);         // initialize
+        decContextDefaultDPS8(&set);
+        set.traps=0;
+        
+        decNumber _1, _2;
+        
+        EISloadInputBufferNumeric (1);   // according to MF1
+        
+        decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
+        if (e->sign == -1)
+            op1->bits |= DECNEG;
+        if (e->S1 == CSFL)
+            op1->exponent = e->exponent;
+        
+        EISloadInputBufferNumeric (2);   // according to MF2
+
+        decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
+        if (e->sign == -1)
+            op2->bits |= DECNEG;
+        if (e->S2 == CSFL)
+            op2->exponent = e->exponent;
+        
+        op3 = decNumberSubtract(&_3, op2, op1, &set);
+
+        // ISOLTS 846 07c, 10a, 11b internal register overflow - see ad3d
+        bool iOvr = 0;
+        if (op3->digits > 63) {
+            uint8_t pr[256];
+            // if sf<=0, trailing zeroes can't be shifted out
+            // if sf> 0, (some of) trailing zeroes can be shifted out 
+            int sf = e->S3==CSFL?op3->exponent:e->SF3;
+
+            int ctz = 0;
+            if (sf>0) {	// optimize: we don't care when sf>0
+                decNumberGetBCD(op3,pr);
+                for (int i=op3->digits-1;i>=0 && pr[i]==0;i--)
+                     ctz ++;
+            }
 
-        if (op3->digits - min(max(sf,0),ctz) > 63) {
+            if (op3->digits - min(max(sf,0),ctz) > 63) {
 
-            enum rounding safeR = decContextGetRounding(&set);         // save rounding mode
-            int safe = set.digits;
-            decNumber tmp;
+                enum rounding safeR = decContextGetRounding(&set);         // save rounding mode
+                int safe = set.digits;
+                decNumber tmp;
 
-            // discard MS digits
-            decContextSetRounding(&set, DEC_ROUND_DOWN);     // Round towards 0 (truncation).
-            set.digits = op3->digits - min(max(sf,0),ctz) - 63;
-            decNumberPlus(&tmp, op3, &set);
-            set.digits = safe;
+                // discard MS digits
+                decContextSetRounding(&set, DEC_ROUND_DOWN);     // Round towards 0 (truncation).
+                set.digits = op3->digits - min(max(sf,0),ctz) - 63;
+                decNumberPlus(&tmp, op3, &set);
+                set.digits = safe;
 
-            decNumberSubtract(op3, op3, &tmp, &set); 
+                decNumberSubtract(op3, op3, &tmp, &set); 
 
-            //decNumberToString(op3,(char*)pr); sim_printf("discarded: %s\n",pr);
+                //decNumberToString(op3,(char*)pr); sim_printf("discarded: %s\n",pr);
 
-            decContextSetRounding(&set, safeR);
-            iOvr = 1;
+                decContextSetRounding(&set, safeR);
+                iOvr = 1;
+            }
         }
-    }
 
-    bool Ovr = false, EOvr = false, Trunc = false;
-    
-    uint8_t out [256];
-    char *res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
+        res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
 
-    Ovr |= iOvr;
-    
-    if (decNumberIsZero(op3))
-        op3->exponent = 127;
+        Ovr |= iOvr;
+        
+        if (decNumberIsZero(op3))
+            op3->exponent = 127;
+
+        neg = decNumberIsNegative(op3) && !decNumberIsZero(op3);
+        zero = decNumberIsZero(op3);
+    }
     
     //printf("%s\r\n", res);
     
@@ -11038,12 +11766,12 @@ void sb2d (void)
             {
                 case CTN4:
                     if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                     else
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                     break;
                 case CTN9:
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                     break;
             }
             break;
@@ -11073,12 +11801,12 @@ void sb2d (void)
             {
                 case CTN4:
                     if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                     else
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                     break;
                 case CTN9:
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                     break;
             }
             break;
@@ -11118,8 +11846,8 @@ void sb2d (void)
         }
     }
     
-    SC_I_NEG (decNumberIsNegative(op3) && !decNumberIsZero(op3));  // set negative indicator if op3 < 0
-    SC_I_ZERO (decNumberIsZero(op3));     // set zero indicator if op3 == 0
+    SC_I_NEG (neg);  // set negative indicator if op3 < 0
+    SC_I_ZERO (zero);     // set zero indicator if op3 == 0
     
     SC_I_TRUNC (!R && Trunc); // If the truncation condition exists without rounding, then ON; otherwise OFF
     
@@ -11283,77 +12011,93 @@ void sb3d (void)
         doFault (FAULT_IPR, fst_ill_proc, "sb3d adjusted n3<1");
     
 
-    decContext set;
-    //decContextDefault(&set, DEC_INIT_BASE);         // initialize
-    decContextDefaultDPS8(&set);
-    
-    set.traps=0;
-    
-    decNumber _1, _2, _3;
-    
-    EISloadInputBufferNumeric (1);   // according to MF1
-    
-    decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
-    if (e->sign == -1)
-        op1->bits |= DECNEG;
-    if (e->S1 == CSFL)
-        op1->exponent = e->exponent;
-    
-    EISloadInputBufferNumeric (2);   // according to MF2
+    decNumber _3;
+    decNumber *op3 = &_3;
+    bool Ovr = false, EOvr = false, Trunc = false;
+    uint8_t out [256];
+    char *res;
+    bool neg, zero;
 
-    decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
-    if (e->sign == -1)
-        op2->bits |= DECNEG;
-    if (e->S2 == CSFL)
-        op2->exponent = e->exponent;
-
-    decNumber *op3 = decNumberSubtract(&_3, op2, op1, &set);
-
-    // ISOLTS 846 07c, 10a, 11b internal register overflow - see ad3d
-    bool iOvr = 0;
-    if (op3->digits > 63) {
-        uint8_t pr[256];
-        // if sf<=0, trailing zeroes can't be shifted out
-        // if sf> 0, (some of) trailing zeroes can be shifted out 
-        int sf = e->S3==CSFL?op3->exponent:e->SF3;
-
-        int ctz = 0;
-        if (sf>0) {	// optimize: we don't care when sf>0
-            decNumberGetBCD(op3,pr);
-            for (int i=op3->digits-1;i>=0 && pr[i]==0;i--)
-                 ctz ++;
-        }
+#ifndef NEED_128
+    if (e->S3 != CSFL &&
+        EISarith128 ('-', n1, sc1, n2, sc2, n3, e->SF3, R, out, &Ovr, &Trunc,
+                     &neg, &zero))
+        res = (char *) out;
+    else
+#endif
+    {
+        decContext set;
+        //decContextDefault(&set, DEC_INIT_BASE);         // initialize
+        decContextDefaultDPS8(&set);
+        
+        set.traps=0;
+        
+        decNumber _1, _2;
+        
+        EISloadInputBufferNumeric (1);   // according to MF1
+        
+        decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
+        if (e->sign == -1)
+            op1->bits |= DECNEG;
+        if (e->S1 == CSFL)
+            op1->exponent = e->exponent;
+        
+        EISloadInputBufferNumeric (2);   // according to MF2
+
+        decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
+        if (e->sign == -1)
+            op2->bits |= DECNEG;
+        if (e->S2 == CSFL)
+            op2->exponent = e->exponent;
+
+        op3 = decNumberSubtract(&_3, op2, op1, &set);
+
+        // ISOLTS 846 07c, 10a, 11b internal register overflow - see ad3d
+        bool iOvr = 0;
+        if (op3->digits > 63) {
+            uint8_t pr[256];
+            // if sf<=0, trailing zeroes can't be shifted out
+            // if sf> 0, (some of) trailing zeroes can be shifted out 
+            int sf = e->S3==CSFL?op3->exponent:e->SF3;
+
+            int ctz = 0;
+            if (sf>0) {	// optimize: we don't care when sf>0
+                decNumberGetBCD(op3,pr);
+                for (int i=op3->digits-1;i>=0 && pr[i]==0;i--)
+                     ctz ++;
+            }
 
-        if (op3->digits - min(max(sf,0),ctz) > 63) {
+            if (op3->digits - min(max(sf,0),ctz) > 63) {
 
-            enum rounding safeR = decContextGetRounding(&set);         // save rounding mode
-            int safe = set.digits;
-            decNumber tmp;
+                enum rounding safeR = decContextGetRounding(&set);         // save rounding mode
+                int safe = set.digits;
+                decNumber tmp;
 
-            // discard MS digits
-            decContextSetRounding(&set, DEC_ROUND_DOWN);     // Round towards 0 (truncation).
-            set.digits = op3->digits - min(max(sf,0),ctz) - 63;
-            decNumberPlus(&tmp, op3, &set);
-            set.digits = safe;
+                // discard MS digits
+                decContextSetRounding(&set, DEC_ROUND_DOWN);     // Round towards 0 (truncation).
+                set.digits = op3->digits - min(max(sf,0),ctz) - 63;
+                decNumberPlus(&tmp, op3, &set);
+                set.digits = safe;
 
-            decNumberSubtract(op3, op3, &tmp, &set); 
+                decNumberSubtract(op3, op3, &tmp, &set); 
 
-            //decNumberToString(op3,(char*)pr); sim_printf("discarded: %s\n",pr);
+                //decNumberToString(op3,(char*)pr); sim_printf("discarded: %s\n",pr);
 
-            decContextSetRounding(&set, safeR);
-            iOvr = 1;
+                decContextSetRounding(&set, safeR);
+                iOvr = 1;
+            }
         }
-    }
-    
-    bool Ovr = false, EOvr = false, Trunc = false;
+        
+        res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
 
-    uint8_t out [256];
-    char *res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
+        Ovr |= iOvr;
+        
+        if (decNumberIsZero(op3))
+            op3->exponent = 127;
 
-    Ovr |= iOvr;
-    
-    if (decNumberIsZero(op3))
-        op3->exponent = 127;
+        neg = decNumberIsNegative(op3) && !decNumberIsZero(op3);
+        zero = decNumberIsZero(op3);
+    }
     
     // now write to memory in proper format.....
     
@@ -11369,12 +12113,12 @@ void sb3d (void)
         {
             case CTN4:
                 if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                 else
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                 break;
             case CTN9:
-                EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                 break;
         }
             break;
@@ -11404,12 +12148,12 @@ void sb3d (void)
             {
                 case CTN4:
                     if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                     else
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                     break;
                 case CTN9:
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                     break;
             }
             break;
@@ -11449,8 +12193,8 @@ void sb3d (void)
         }
     }
     
-    SC_I_NEG (decNumberIsNegative(op3) && !decNumberIsZero(op3));  // set negative indicator if op3 < 0
-    SC_I_ZERO (decNumberIsZero(op3));     // set zero indicator if op3 == 0
+    SC_I_NEG (neg);  // set negative indicator if op3 < 0
+    SC_I_ZERO (zero);     // set zero indicator if op3 == 0
     
     SC_I_TRUNC (!R && Trunc); // If the truncation condition exists without rounding, then ON; otherwise OFF
     
@@ -11592,38 +12336,54 @@ void mp2d (void)
         doFault (FAULT_IPR, fst_ill_proc, "mp2d adjusted n2<1");
     
 
-    decContext set;
-    decContextDefaultDPS8Mul(&set); // 126 digits for multiply
-    
-    set.traps=0;
-    
-    decNumber _1, _2, _3;
-    
-    EISloadInputBufferNumeric (1);   // according to MF1
-    
-    decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
-    if (e->sign == -1)
-        op1->bits |= DECNEG;
-    if (e->S1 == CSFL)
-        op1->exponent = e->exponent;
-    
-    EISloadInputBufferNumeric (2);   // according to MF2
-
-    decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
-    if (e->sign == -1)
-        op2->bits |= DECNEG;
-    if (e->S2 == CSFL)
-        op2->exponent = e->exponent;
-    
-    decNumber *op3 = decNumberMultiply(&_3, op1, op2, &set);
-    
+    decNumber _3;
+    decNumber *op3 = &_3;
     bool Ovr = false, EOvr = false, Trunc = false;
-    
     uint8_t out [256];
-    char *res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
-    
-    if (decNumberIsZero(op3))
-        op3->exponent = 127;
+    char *res;
+    bool neg, zero;
+
+#ifndef NEED_128
+    if (e->S2 != CSFL &&
+        EISarith128 ('*', n1, sc1, n2, sc2, n2, e->SF2, R, out, &Ovr, &Trunc,
+                     &neg, &zero))
+        res = (char *) out;
+    else
+#endif
+    {
+        decContext set;
+        decContextDefaultDPS8Mul(&set); // 126 digits for multiply
+        
+        set.traps=0;
+        
+        decNumber _1, _2;
+        
+        EISloadInputBufferNumeric (1);   // according to MF1
+        
+        decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
+        if (e->sign == -1)
+            op1->bits |= DECNEG;
+        if (e->S1 == CSFL)
+            op1->exponent = e->exponent;
+        
+        EISloadInputBufferNumeric (2);   // according to MF2
+
+        decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
+        if (e->sign == -1)
+            op2->bits |= DECNEG;
+        if (e->S2 == CSFL)
+            op2->exponent = e->exponent;
+        
+        op3 = decNumberMultiply(&_3, op1, op2, &set);
+        
+        res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
+        
+        if (decNumberIsZero(op3))
+            op3->exponent = 127;
+
+        neg = decNumberIsNegative(op3) && !decNumberIsZero(op3);
+        zero = decNumberIsZero(op3);
+    }
     
     // now write to memory in proper format.....
     
@@ -11639,12 +12399,12 @@ void mp2d (void)
         {
             case CTN4:
                 if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                 else
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                 break;
             case CTN9:
-                EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                 break;
         }
             break;
@@ -11674,12 +12434,12 @@ void mp2d (void)
         {
             case CTN4:
                 if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                 else
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                 break;
             case CTN9:
-                EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                 break;
         }
             break;
@@ -11719,8 +12479,8 @@ void mp2d (void)
         }
     }
     
-    SC_I_NEG (decNumberIsNegative(op3) && !decNumberIsZero(op3));  // set negative indicator if op3 < 0
-    SC_I_ZERO (decNumberIsZero(op3));     // set zero indicator if op3 == 0
+    SC_I_NEG (neg);  // set negative indicator if op3 < 0
+    SC_I_ZERO (zero);     // set zero indicator if op3 == 0
     
     SC_I_TRUNC (!R && Trunc); // If the truncation condition exists without rounding, then ON; otherwise OFF
     
@@ -11884,32 +12644,47 @@ void mp3d (void)
         doFault (FAULT_IPR, fst_ill_proc, "mp3d adjusted n3<1");
 
 
-    decContext set;
-    //decContextDefault(&set, DEC_INIT_BASE);         // initialize
-    decContextDefaultDPS8Mul(&set);	// 126 digits for multiply
+    decNumber _3;
+    decNumber *op3 = &_3;
+    bool Ovr = false, EOvr = false, Trunc = false;
+    uint8_t out [256];
+    char *res;
+    bool neg, zero;
 
-    set.traps=0;
-    
-    decNumber _1, _2, _3;
-    
-    EISloadInputBufferNumeric (1);   // according to MF1
-    
-    decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
-    if (e->sign == -1)
-        op1->bits |= DECNEG;
-    if (e->S1 == CSFL)
-        op1->exponent = e->exponent;
-    
-    EISloadInputBufferNumeric (2);   // according to MF2
+#ifndef NEED_128
+    if (e->S3 != CSFL &&
+        EISarith128 ('*', n1, sc1, n2, sc2, n3, e->SF3, R, out, &Ovr, &Trunc,
+                     &neg, &zero))
+        res = (char *) out;
+    else
+#endif
+    {
+        decContext set;
+        //decContextDefault(&set, DEC_INIT_BASE);         // initialize
+        decContextDefaultDPS8Mul(&set);	// 126 digits for multiply
 
-    decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
-    if (e->sign == -1)
-        op2->bits |= DECNEG;
-    if (e->S2 == CSFL)
-        op2->exponent = e->exponent;
-    
-    decNumber *op3 = decNumberMultiply(&_3, op1, op2, &set);
-    
+        set.traps=0;
+        
+        decNumber _1, _2;
+        
+        EISloadInputBufferNumeric (1);   // according to MF1
+        
+        decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
+        if (e->sign == -1)
+            op1->bits |= DECNEG;
+        if (e->S1 == CSFL)
+            op1->exponent = e->exponent;
+        
+        EISloadInputBufferNumeric (2);   // according to MF2
+
+        decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
+        if (e->sign == -1)
+            op2->bits |= DECNEG;
+        if (e->S2 == CSFL)
+            op2->exponent = e->exponent;
+        
+        op3 = decNumberMultiply(&_3, op1, op2, &set);
+        
 //    char c1[1024];
 //    char c2[1024];
 //    char c3[1024];
@@ -11920,14 +12695,15 @@ void mp3d (void)
 //    sim_printf("c2:%s\n", c2);
 //    decNumberToString(op3, c3);
 //    sim_printf("c3:%s\n", c3);
-    
-    bool Ovr = false, EOvr = false, Trunc = false;
-    
-    uint8_t out [256];
-    char *res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
-    
-    if (decNumberIsZero(op3))
-        op3->exponent = 127;
+        
+        res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
+        
+        if (decNumberIsZero(op3))
+            op3->exponent = 127;
+
+        neg = decNumberIsNegative(op3) && !decNumberIsZero(op3);
+        zero = decNumberIsZero(op3);
+    }
     
     // now write to memory in proper format.....
     
@@ -11946,12 +12722,12 @@ void mp3d (void)
                           // = 1, then the 13(8) plus sign character is placed
                           // appropriately if the result of the operation is
                           // positive.
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                 else
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN,  (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN,  neg ? 015 :  014);  // default +
                 break;
             case CTN9:
-                EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                 break;
             }
             break;
@@ -11981,12 +12757,12 @@ void mp3d (void)
             {
                 case CTN4:
                     if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                     else
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                     break;
                 case CTN9:
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                     break;
             }
             break;
@@ -12025,8 +12801,8 @@ void mp3d (void)
         }
     }
     
-    SC_I_NEG (decNumberIsNegative(op3) && !decNumberIsZero(op3));  // set negative indicator if op3 < 0
-    SC_I_ZERO (decNumberIsZero(op3));     // set zero indicator if op3 == 0
+    SC_I_NEG (neg);  // set negative indicator if op3 < 0
+    SC_I_ZERO (zero);     // set zero indicator if op3 == 0
     
     SC_I_TRUNC (!R && Trunc); // If the truncation condition exists without rounding, then ON; otherwise OFF
     
@@ -12931,160 +13707,176 @@ void dv2d (void)
         doFault (FAULT_IPR, fst_ill_proc, "dv2d adjusted n2<1");
 
 
-    decContext set;
-    decContextDefaultDPS8(&set);
-
-    set.traps=0;
-    
-    decNumber _1, _2, _3;
-    
-    EISloadInputBufferNumeric (1);   // according to MF1
-    
-    decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);    // divisor
-    if (e->sign == -1)
-        op1->bits |= DECNEG;
-    if (e->S1 == CSFL)
-        op1->exponent = e->exponent;
+    decNumber _3;
+    decNumber *op3 = &_3;
+    bool Ovr = false, EOvr = false, Trunc = false;
+    uint8_t out [256];
+    char *res;
+    bool neg, zero;
 
-    // check for divide by 0!
-    if (decNumberIsZero(op1))
+#ifndef NEED_128
+    if (e->S2 != CSFL &&
+        EISdivide128 (n1, sc1, n2, sc2, n2, e->SF2, R, "dv2d division by 0",
+                      "dv2d NQ>63", out, &Ovr, &Trunc, &neg, &zero))
+        res = (char *) out;
+    else
+#endif
     {
-        doFault(FAULT_DIV, fst_zero, "dv2d division by 0");
-    }
+        decContext set;
+        decContextDefaultDPS8(&set);
 
-    word9   inBufferop1 [64];
-    memcpy (inBufferop1,e->inBuffer,64); // save for clz1 calculation later
-    
-    EISloadInputBufferNumeric (2);   // according to MF2
-    
-    decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);    // dividend
-    if (e->sign == -1)
-        op2->bits |= DECNEG;
-    if (e->S2 == CSFL)
-        op2->exponent = e->exponent;
-    
-    int NQ;
-    if (e->S2 == CSFL)
-    {
-        NQ = n2;
-    } 
-    else 
-    {
-        // count leading zeroes
-        // TODO optimize - can these be somehow extracted from decNumbers?
-        int clz1, clz2, i;
-        for (i=0; i < op1->digits; i++)
-            if (inBufferop1[i]!=0)
-                break;
-        clz1 = i;
-        for (i=0; i < op2->digits; i++)
-            if (e->inBuffer[i]!=0) // this still holds op2 digits
-                break;
-        clz2 = i;
-        sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d: clz1 %d clz2 %d\n",clz1,clz2);
+        set.traps=0;
+        
+        decNumber _1, _2;
+        
+        EISloadInputBufferNumeric (1);   // according to MF1
+        
+        decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);    // divisor
+        if (e->sign == -1)
+            op1->bits |= DECNEG;
+        if (e->S1 == CSFL)
+            op1->exponent = e->exponent;
+
+        // check for divide by 0!
+        if (decNumberIsZero(op1))
+        {
+            doFault(FAULT_DIV, fst_zero, "dv2d division by 0");
+        }
 
-        // XXX are clz also valid for CSFL dividend / divisor? probably yes
-        // XXX seems that exponents and scale factors are used interchangeably here ? (RJ78)
-        NQ = (n2-clz2+1) - (n1-clz1) + (-(e->S1==CSFL?op1->exponent:(int)e->SF1));
+        word9   inBufferop1 [64];
+        memcpy (inBufferop1,e->inBuffer,64); // save for clz1 calculation later
+        
+        EISloadInputBufferNumeric (2);   // according to MF2
+        
+        decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);    // dividend
+        if (e->sign == -1)
+            op2->bits |= DECNEG;
+        if (e->S2 == CSFL)
+            op2->exponent = e->exponent;
+        
+        int NQ;
+        if (e->S2 == CSFL)
+        {
+            NQ = n2;
+        } 
+        else 
+        {
+            // count leading zeroes
+            // TODO optimize - can these be somehow extracted from decNumbers?
+            int clz1, clz2, i;
+            for (i=0; i < op1->digits; i++)
+                if (inBufferop1[i]!=0)
+                    break;
+            clz1 = i;
+            for (i=0; i < op2->digits; i++)
+                if (e->inBuffer[i]!=0) // this still holds op2 digits
+                    break;
+            clz2 = i;
+            sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d: clz1 %d clz2 %d\n",clz1,clz2);
+
+            // XXX are clz also valid for CSFL dividend / divisor? probably yes
+            // XXX seems that exponents and scale factors are used interchangeably here ? (RJ78)
+            NQ = (n2-clz2+1) - (n1-clz1) + (-(e->S1==CSFL?op1->exponent:(int)e->SF1));
 
 sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %d E1 %d E2 %d SF2 %d NQ %d\n",e->S1,e->S2,e->N1,e->N2,clz1,clz2,op1->exponent,op2->exponent,e->SF2,NQ);
-    }
-    if (NQ > 63)
-        doFault(FAULT_DIV, fst_zero, "dv2d NQ>63");
-    // Note: NQ is currently unused apart from this FAULT_DIV check. decNumber produces more digits than required, but they are then rounded/truncated
-
-    // Yes, they're switched. op1=divisor
-    decNumber *op3 = decNumberDivide(&_3, op2, op1, &set); 
-    // Note DPS88 and DPS9000 are different when NQ <= 0
-    // This is a flaw in the DPS8/70 hardware which was corrected in later models
-    // ISOLTS-817 05b
-
-    PRINTDEC("op2", op2);
-    PRINTDEC("op1", op1);
-    PRINTDEC("op3", op3);
-    
-    // let's check division results to see for anomalous conditions
-    if (
-        (set.status & DEC_Division_undefined) ||    // 0/0 will become NaN
-        (set.status & DEC_Invalid_operation) ||
-        (set.status & DEC_Division_by_zero)
-        ) { sim_debug (DBG_TRACEEXT, & cpu_dev, "oops! dv2d anomalous results"); }	// divide by zero has already been checked before
+        }
+        if (NQ > 63)
+            doFault(FAULT_DIV, fst_zero, "dv2d NQ>63");
+        // Note: NQ is currently unused apart from this FAULT_DIV check. decNumber produces more digits than required, but they are then rounded/truncated
 
-    if (e->S2 == CSFL)
-    {
-        // justify CSFL left
+        // Yes, they're switched. op1=divisor
+        op3 = decNumberDivide(&_3, op2, op1, &set); 
+        // Note DPS88 and DPS9000 are different when NQ <= 0
         // This is a flaw in the DPS8/70 hardware which was corrected in later models
-        // Note DPS88 and DPS9000 are different
-        // ISOLTS-817 06c,06e
+        // ISOLTS-817 05b
 
-        decNumber _sf;
-
-        if (n2 - op3->digits > 0)
+        PRINTDEC("op2", op2);
+        PRINTDEC("op1", op1);
+        PRINTDEC("op3", op3);
+        
+        // let's check division results to see for anomalous conditions
+        if (
+            (set.status & DEC_Division_undefined) ||    // 0/0 will become NaN
+            (set.status & DEC_Invalid_operation) ||
+            (set.status & DEC_Division_by_zero)
+            ) { sim_debug (DBG_TRACEEXT, & cpu_dev, "oops! dv2d anomalous results"); }	// divide by zero has already been checked before
+
+        if (e->S2 == CSFL)
         {
-            decNumberFromInt32(&_sf, op3->exponent - (n2 - op3->digits));
-            PRINTDEC("Value 1", op3)
-            PRINTDEC("Value sf", &_sf)
-            op3 = decNumberRescale(op3, op3, &_sf, &set);
-            PRINTDEC("Value 2", op3)
-        }
-    }
-    
-    bool Ovr = false, EOvr = false, Trunc = false;
-    uint8_t out[256];
-    
-    // CSFL: If the divisor is greater than the dividend after operand
-    // alignment, the leading zero digit produced is counted and the effective
-    // precision of the result is reduced by one.
-    // This is a flaw in the DPS8/70 hardware which was corrected in later models
-    // Note DPS88 and DPS9000 are different
-    //
-    // "greater after operand alignment" means scale until most-significant digits are nonzero, then compare magnitudes ignoring exponents
-    // This passes ISOLTS-817 06e, ET 458,461,483,486
-    char *res;
-    if (e->S2 == CSFL) {
-        decNumber _1a;
-        decNumber _2a;
-        decNumber _sf;
-        if (op1->digits >= op2->digits) {
-            // scale op2
-            decNumberCopy(&_1a, op1);
-            decNumberFromInt32(&_sf, op1->digits - op2->digits);
-            decNumberShift(&_2a, op2, &_sf, &set);
-        } else if (op1->digits < op2->digits) {
-            // scale op1
-            decNumberFromInt32(&_sf, op2->digits - op1->digits);
-            decNumberShift(&_1a, op1, &_sf, &set);
-            decNumberCopy(&_2a, op2);
+            // justify CSFL left
+            // This is a flaw in the DPS8/70 hardware which was corrected in later models
+            // Note DPS88 and DPS9000 are different
+            // ISOLTS-817 06c,06e
+
+            decNumber _sf;
+
+            if (n2 - op3->digits > 0)
+            {
+                decNumberFromInt32(&_sf, op3->exponent - (n2 - op3->digits));
+                PRINTDEC("Value 1", op3)
+                PRINTDEC("Value sf", &_sf)
+                op3 = decNumberRescale(op3, op3, &_sf, &set);
+                PRINTDEC("Value 2", op3)
+            }
         }
-        _1a.exponent = 0;
-        _2a.exponent = 0;
-
-        PRINTDEC("dv2d: op1a", &_1a);
-        PRINTDEC("dv2d: op2a", &_2a);
-        sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d: exp1 %d exp2 %d digits op1 %d op2 %d op1a %d op2a %d\n",op1->exponent,op2->exponent,op1->digits,op2->digits,_1a.digits,_2a.digits);
-
-        if (decCompareMAG(&_1a, &_2a, &set) > 0) {
-            // shorten the result field to get proper rounding
-            res = formatDecimal(out, &set, op3, n2 -1, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
-
-            // prepend zero digit
-            // ET 458,483 float=float/float, ET 461,486 float=fixed/fixed
-            for (int i = n2; i > 0; i--) // incl.zero terminator
-                 res[i] = res[i-1];
-            res[0] = '0';
-            sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d: addzero n2 %d %s exp %d\n",n2,res,op3->exponent);
+        
+        
+        // CSFL: If the divisor is greater than the dividend after operand
+        // alignment, the leading zero digit produced is counted and the effective
+        // precision of the result is reduced by one.
+        // This is a flaw in the DPS8/70 hardware which was corrected in later models
+        // Note DPS88 and DPS9000 are different
+        //
+        // "greater after operand alignment" means scale until most-significant digits are nonzero, then compare magnitudes ignoring exponents
+        // This passes ISOLTS-817 06e, ET 458,461,483,486
+        if (e->S2 == CSFL) {
+            decNumber _1a;
+            decNumber _2a;
+            decNumber _sf;
+            if (op1->digits >= op2->digits) {
+                // scale op2
+                decNumberCopy(&_1a, op1);
+                decNumberFromInt32(&_sf, op1->digits - op2->digits);
+                decNumberShift(&_2a, op2, &_sf, &set);
+            } else if (op1->digits < op2->digits) {
+                // scale op1
+                decNumberFromInt32(&_sf, op2->digits - op1->digits);
+                decNumberShift(&_1a, op1, &_sf, &set);
+                decNumberCopy(&_2a, op2);
+            }
+            _1a.exponent = 0;
+            _2a.exponent = 0;
+
+            PRINTDEC("dv2d: op1a", &_1a);
+            PRINTDEC("dv2d: op2a", &_2a);
+            sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d: exp1 %d exp2 %d digits op1 %d op2 %d op1a %d op2a %d\n",op1->exponent,op2->exponent,op1->digits,op2->digits,_1a.digits,_2a.digits);
+
+            if (decCompareMAG(&_1a, &_2a, &set) > 0) {
+                // shorten the result field to get proper rounding
+                res = formatDecimal(out, &set, op3, n2 -1, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
+
+                // prepend zero digit
+                // ET 458,483 float=float/float, ET 461,486 float=fixed/fixed
+                for (int i = n2; i > 0; i--) // incl.zero terminator
+                     res[i] = res[i-1];
+                res[0] = '0';
+                sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d: addzero n2 %d %s exp %d\n",n2,res,op3->exponent);
+            } else {
+                // full n2 digits are retured
+                res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
+            }
         } else {
-            // full n2 digits are retured
+            // same as all other decimal instructions
             res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
         }
-    } else {
-        // same as all other decimal instructions
-        res = formatDecimal(out, &set, op3, n2, (int) e->S2, e->SF2, R, &Ovr, &Trunc);
+        
+        if (decNumberIsZero(op3))
+            op3->exponent = 127;
+
+        neg = decNumberIsNegative(op3) && !decNumberIsZero(op3);
+        zero = decNumberIsZero(op3);
     }
     
-    if (decNumberIsZero(op3))
-        op3->exponent = 127;
-    
     // now write to memory in proper format.....
     
     int pos = (int) dstCN;
@@ -13098,12 +13890,12 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
             {
                 case CTN4:
                     if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                     else
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                     break;
                 case CTN9:
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                     break;
             }
             break;
@@ -13133,12 +13925,12 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
             {
                 case CTN4:
                     if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                     else
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                     break;
                 case CTN9:
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                     break;
             }
             break;
@@ -13177,8 +13969,8 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv2d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
         }
     }
     
-    SC_I_NEG (decNumberIsNegative(op3) && !decNumberIsZero(op3));  // set negative indicator if op3 < 0
-    SC_I_ZERO (decNumberIsZero(op3));     // set zero indicator if op3 == 0
+    SC_I_NEG (neg);  // set negative indicator if op3 < 0
+    SC_I_ZERO (zero);     // set zero indicator if op3 == 0
     
     //SC_I_TRUNC (!R && Trunc); // no truncation flag for divide
     
@@ -13343,177 +14135,193 @@ void dv3d (void)
         doFault (FAULT_IPR, fst_ill_proc, "dv3d adjusted n3<1");
 
 
-    decContext set;
-    decContextDefaultDPS8(&set);
-    
-    set.traps=0;
-    
-    decNumber _1, _2, _3;
-    
-    EISloadInputBufferNumeric (1);   // according to MF1
-    
-    decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
-    //PRINTDEC("op1", op1);
-    if (e->sign == -1)
-        op1->bits |= DECNEG;
-    if (e->S1 == CSFL)
-        op1->exponent = e->exponent;
+    decNumber _3;
+    decNumber *op3 = &_3;
+    bool Ovr = false, EOvr = false, Trunc = false;
+    uint8_t out [256];
+    char *res;
+    bool neg, zero;
 
-    // check for divide by 0!
-    if (decNumberIsZero(op1))
+#ifndef NEED_128
+    if (e->S3 != CSFL &&
+        EISdivide128 (n1, sc1, n2, sc2, n3, e->SF3, R, "dv3d division by 0",
+                      "dv3d NQ>63", out, &Ovr, &Trunc, &neg, &zero))
+        res = (char *) out;
+    else
+#endif
     {
-        doFault(FAULT_DIV, fst_zero, "dv3d division by 0");
-    }
-
-    word9   inBufferop1 [64];
-    memcpy (inBufferop1,e->inBuffer,64); // save for clz1 calculation later
-    
-    EISloadInputBufferNumeric (2);   // according to MF2
+        decContext set;
+        decContextDefaultDPS8(&set);
+        
+        set.traps=0;
+        
+        decNumber _1, _2;
+        
+        EISloadInputBufferNumeric (1);   // according to MF1
+        
+        decNumber *op1 = decBCD9ToNumber(e->inBuffer, n1, sc1, &_1);
+        //PRINTDEC("op1", op1);
+        if (e->sign == -1)
+            op1->bits |= DECNEG;
+        if (e->S1 == CSFL)
+            op1->exponent = e->exponent;
+
+        // check for divide by 0!
+        if (decNumberIsZero(op1))
+        {
+            doFault(FAULT_DIV, fst_zero, "dv3d division by 0");
+        }
 
-    decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
-    if (e->sign == -1)
-        op2->bits |= DECNEG;
-    if (e->S2 == CSFL)
-        op2->exponent = e->exponent;
-
-
-    // The number of required quotient digits, NQ, is determined before
-    // division begins as follows:
-    //  1) Floating-point quotient
-    //      NQ = N3
-    //  2) Fixed-point quotient
-    //    NQ = (N2-LZ2+1) - (N1-LZ1) + (E2-E1-SF3)
-    //    ￼where: Nn = given operand field length
-    //        LZn = leading zero count for operand n
-    //        En = exponent of operand n
-    //        SF3 = scaling factor of quotient
-    // 3) Rounding
-    //    If rounding is specified (R = 1), then one extra quotient digit is
-    //    produced.
-    // Note: rule 3 is already handled by formatDecimal rounding
-    // Nn doesn't represent full field length, but length without sign and exponent (RJ78/DH03 seems like)
-
-    int NQ;
-    if (e->S3 == CSFL)
-    {
-        NQ = n3;
-    } 
-    else 
-    {
-        // count leading zeroes
-        // TODO optimize - can these be somehow extracted from decNumbers?
-        int clz1, clz2, i;
-        for (i=0; i < op1->digits; i++)
-            if (inBufferop1[i]!=0)
-                break;
-        clz1 = i;
-        for (i=0; i < op2->digits; i++)
-            if (e->inBuffer[i]!=0) // this still holds op2 digits
-                break;
-        clz2 = i;
-        sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d: clz1 %d clz2 %d\n",clz1,clz2);
+        word9   inBufferop1 [64];
+        memcpy (inBufferop1,e->inBuffer,64); // save for clz1 calculation later
+        
+        EISloadInputBufferNumeric (2);   // according to MF2
+
+        decNumber *op2 = decBCD9ToNumber(e->inBuffer, n2, sc2, &_2);
+        if (e->sign == -1)
+            op2->bits |= DECNEG;
+        if (e->S2 == CSFL)
+            op2->exponent = e->exponent;
+
+
+        // The number of required quotient digits, NQ, is determined before
+        // division begins as follows:
+        //  1) Floating-point quotient
+        //      NQ = N3
+        //  2) Fixed-point quotient
+        //    NQ = (N2-LZ2+1) - (N1-LZ1) + (E2-E1-SF3)
+        //    ￼where: Nn = given operand field length
+        //        LZn = leading zero count for operand n
+        //        En = exponent of operand n
+        //        SF3 = scaling factor of quotient
+        // 3) Rounding
+        //    If rounding is specified (R = 1), then one extra quotient digit is
+        //    produced.
+        // Note: rule 3 is already handled by formatDecimal rounding
+        // Nn doesn't represent full field length, but length without sign and exponent (RJ78/DH03 seems like)
+
+        int NQ;
+        if (e->S3 == CSFL)
+        {
+            NQ = n3;
+        } 
+        else 
+        {
+            // count leading zeroes
+            // TODO optimize - can these be somehow extracted from decNumbers?
+            int clz1, clz2, i;
+            for (i=0; i < op1->digits; i++)
+                if (inBufferop1[i]!=0)
+                    break;
+            clz1 = i;
+            for (i=0; i < op2->digits; i++)
+                if (e->inBuffer[i]!=0) // this still holds op2 digits
+                    break;
+            clz2 = i;
+            sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d: clz1 %d clz2 %d\n",clz1,clz2);
 
-        // XXX are clz also valid for CSFL dividend / divisor? probably yes
-        // XXX seems that exponents and scale factors are used interchangeably here ? (RJ78)
-        NQ = (n2-clz2+1) - (n1-clz1) + ((e->S2==CSFL?op2->exponent:(int)e->SF2)-(e->S1==CSFL?op1->exponent:(int)e->SF1)-(int)e->SF3);
+            // XXX are clz also valid for CSFL dividend / divisor? probably yes
+            // XXX seems that exponents and scale factors are used interchangeably here ? (RJ78)
+            NQ = (n2-clz2+1) - (n1-clz1) + ((e->S2==CSFL?op2->exponent:(int)e->SF2)-(e->S1==CSFL?op1->exponent:(int)e->SF1)-(int)e->SF3);
 
 sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %d E1 %d E2 %d SF3 %d NQ %d\n",e->S1,e->S2,e->N1,e->N2,clz1,clz2,op1->exponent,op2->exponent,e->SF3,NQ);
-    }
-    if (NQ > 63)
-        doFault(FAULT_DIV, fst_zero, "dv3d NQ>63");
-    // Note: NQ is currently unused apart from this FAULT_DIV check. decNumber produces more digits than required, but they are then rounded/truncated
-
-    // Yes, they're switched. op1=divisor
-    decNumber *op3 = decNumberDivide(&_3, op2, op1, &set); 
-    // Note DPS88 and DPS9000 are different when NQ <= 0
-    // This is a flaw in the DPS8/70 hardware which was corrected in later models
-    // ISOLTS-817 05b
-
-    PRINTDEC("op2", op2);
-    PRINTDEC("op1", op1);
-    PRINTDEC("op3", op3);
-    
-    // let's check division results to see for anomalous conditions
-    if (
-        (set.status & DEC_Division_undefined) ||    // 0/0 will become NaN
-        (set.status & DEC_Invalid_operation) ||
-        (set.status & DEC_Division_by_zero)
-        ) { sim_debug (DBG_TRACEEXT, & cpu_dev, "oops! dv3d anomalous results"); }	// divide by zero has already been checked before
+        }
+        if (NQ > 63)
+            doFault(FAULT_DIV, fst_zero, "dv3d NQ>63");
+        // Note: NQ is currently unused apart from this FAULT_DIV check. decNumber produces more digits than required, but they are then rounded/truncated
 
-    if (e->S3 == CSFL)
-    {
-        // justify CSFL left
+        // Yes, they're switched. op1=divisor
+        op3 = decNumberDivide(&_3, op2, op1, &set); 
+        // Note DPS88 and DPS9000 are different when NQ <= 0
         // This is a flaw in the DPS8/70 hardware which was corrected in later models
-        // Note DPS88 and DPS9000 are different
-        // ISOLTS-817 06c,06e
+        // ISOLTS-817 05b
 
-        decNumber _sf;
-
-        if (n3 - op3->digits > 0)
+        PRINTDEC("op2", op2);
+        PRINTDEC("op1", op1);
+        PRINTDEC("op3", op3);
+        
+        // let's check division results to see for anomalous conditions
+        if (
+            (set.status & DEC_Division_undefined) ||    // 0/0 will become NaN
+            (set.status & DEC_Invalid_operation) ||
+            (set.status & DEC_Division_by_zero)
+            ) { sim_debug (DBG_TRACEEXT, & cpu_dev, "oops! dv3d anomalous results"); }	// divide by zero has already been checked before
+
+        if (e->S3 == CSFL)
         {
-            decNumberFromInt32(&_sf, op3->exponent - (n3 - op3->digits));
-            PRINTDEC("Value 1", op3)
-            PRINTDEC("Value sf", &_sf)
-            op3 = decNumberRescale(op3, op3, &_sf, &set);
-            PRINTDEC("Value 2", op3)
-        }
-    }
+            // justify CSFL left
+            // This is a flaw in the DPS8/70 hardware which was corrected in later models
+            // Note DPS88 and DPS9000 are different
+            // ISOLTS-817 06c,06e
 
-    bool Ovr = false, EOvr = false, Trunc = false;
-    uint8_t out[256];
+            decNumber _sf;
 
-    // CSFL: If the divisor is greater than the dividend after operand
-    // alignment, the leading zero digit produced is counted and the effective
-    // precision of the result is reduced by one.
-    // This is a flaw in the DPS8/70 hardware which was corrected in later models
-    // Note DPS88 and DPS9000 are different
-    //
-    // "greater after operand alignment" means scale until most-significant digits are nonzero, then compare magnitudes ignoring exponents
-    // This passes ISOLTS-817 06e, ET 458,461,483,486
-    char *res;
-    if (e->S3 == CSFL) {
-        decNumber _1a;
-        decNumber _2a;
-        decNumber _sf;
-        if (op1->digits >= op2->digits) {
-            // scale op2
-            decNumberCopy(&_1a, op1);
-            decNumberFromInt32(&_sf, op1->digits - op2->digits);
-            decNumberShift(&_2a, op2, &_sf, &set);
-        } else if (op1->digits < op2->digits) {
-            // scale op1
-            decNumberFromInt32(&_sf, op2->digits - op1->digits);
-            decNumberShift(&_1a, op1, &_sf, &set);
-            decNumberCopy(&_2a, op2);
+            if (n3 - op3->digits > 0)
+            {
+                decNumberFromInt32(&_sf, op3->exponent - (n3 - op3->digits));
+                PRINTDEC("Value 1", op3)
+                PRINTDEC("Value sf", &_sf)
+                op3 = decNumberRescale(op3, op3, &_sf, &set);
+                PRINTDEC("Value 2", op3)
+            }
         }
-        _1a.exponent = 0;
-        _2a.exponent = 0;
-
-        PRINTDEC("dv3d: op1a", &_1a);
-        PRINTDEC("dv3d: op2a", &_2a);
-        sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d: exp1 %d exp2 %d digits op1 %d op2 %d op1a %d op2a %d\n",op1->exponent,op2->exponent,op1->digits,op2->digits,_1a.digits,_2a.digits);
-
-        if (decCompareMAG(&_1a, &_2a, &set) > 0) {
-            // shorten the result field to get proper rounding
-            res = formatDecimal(out, &set, op3, n3 -1, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
-
-            // prepend zero digit
-            // ET 458,483 float=float/float, ET 461,486 float=fixed/fixed
-            for (int i = n3; i > 0; i--) // incl.zero terminator
-                 res[i] = res[i-1];
-            res[0] = '0';
-            sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d: addzero n3 %d %s exp %d\n",n3,res,op3->exponent);
+
+
+        // CSFL: If the divisor is greater than the dividend after operand
+        // alignment, the leading zero digit produced is counted and the effective
+        // precision of the result is reduced by one.
+        // This is a flaw in the DPS8/70 hardware which was corrected in later models
+        // Note DPS88 and DPS9000 are different
+        //
+        // "greater after operand alignment" means scale until most-significant digits are nonzero, then compare magnitudes ignoring exponents
+        // This passes ISOLTS-817 06e, ET 458,461,483,486
+        if (e->S3 == CSFL) {
+            decNumber _1a;
+            decNumber _2a;
+            decNumber _sf;
+            if (op1->digits >= op2->digits) {
+                // scale op2
+                decNumberCopy(&_1a, op1);
+                decNumberFromInt32(&_sf, op1->digits - op2->digits);
+                decNumberShift(&_2a, op2, &_sf, &set);
+            } else if (op1->digits < op2->digits) {
+                // scale op1
+                decNumberFromInt32(&_sf, op2->digits - op1->digits);
+                decNumberShift(&_1a, op1, &_sf, &set);
+                decNumberCopy(&_2a, op2);
+            }
+            _1a.exponent = 0;
+            _2a.exponent = 0;
+
+            PRINTDEC("dv3d: op1a", &_1a);
+            PRINTDEC("dv3d: op2a", &_2a);
+            sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d: exp1 %d exp2 %d digits op1 %d op2 %d op1a %d op2a %d\n",op1->exponent,op2->exponent,op1->digits,op2->digits,_1a.digits,_2a.digits);
+
+            if (decCompareMAG(&_1a, &_2a, &set) > 0) {
+                // shorten the result field to get proper rounding
+                res = formatDecimal(out, &set, op3, n3 -1, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
+
+                // prepend zero digit
+                // ET 458,483 float=float/float, ET 461,486 float=fixed/fixed
+                for (int i = n3; i > 0; i--) // incl.zero terminator
+                     res[i] = res[i-1];
+                res[0] = '0';
+                sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d: addzero n3 %d %s exp %d\n",n3,res,op3->exponent);
+            } else {
+                // full n3 digits are retured
+                res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
+            }
         } else {
-            // full n3 digits are retured
+            // same as all other decimal instructions
             res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
         }
-    } else {
-        // same as all other decimal instructions
-        res = formatDecimal(out, &set, op3, n3, (int) e->S3, e->SF3, R, &Ovr, &Trunc);
+        
+        if (decNumberIsZero(op3))
+            op3->exponent = 127;
+
+        neg = decNumberIsNegative(op3) && !decNumberIsZero(op3);
+        zero = decNumberIsZero(op3);
     }
-    
-    if (decNumberIsZero(op3))
-        op3->exponent = 127;
 
     //printf("%s\r\n", res);
     
@@ -13530,12 +14338,12 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
             {
                 case CTN4:
                     if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                     else
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                     break;
                 case CTN9:
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                     break;
             }
             break;
@@ -13565,12 +14373,12 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
             {
                 case CTN4:
                     if (e->P) //If TN2 and S2 specify a 4-bit signed number and P = 1, then the 13(8) plus sign character is placed appropriately if the result of the operation is positive.
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  013);  // special +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  013);  // special +
                     else
-                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? 015 :  014);  // default +
+                        EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? 015 :  014);  // default +
                     break;
                 case CTN9:
-                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, (decNumberIsNegative(op3) && !decNumberIsZero(op3)) ? '-' : '+');
+                    EISwrite49(&e->ADDR3, &pos, (int) dstTN, neg ? '-' : '+');
                 break;
             }
             break;
@@ -13609,8 +14417,8 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "dv3d S1 %d S2 %d N1 %d N2 %d clz1 %d clz2 %
         }
     }
     
-    SC_I_NEG (decNumberIsNegative(op3) && !decNumberIsZero(op3));  // set negative indicator if op3 < 0
-    SC_I_ZERO (decNumberIsZero(op3));     // set zero indicator if op3 == 0
+    SC_I_NEG (neg);  // set negative indicator if op3 < 0
+    SC_I_ZERO (zero);     // set zero indicator if op3 == 0
     
     // SC_I_TRUNC(!R && Trunc); // no truncation flag for divide
 
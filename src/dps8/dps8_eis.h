@@ -55,3 +55,6 @@ void mp2d (void);
 void mp3d (void);
 void dv2d (void);
 void dv3d (void);
+#if defined(TESTING) && ! defined(NEED_128)
+t_stat eis128_test (int32 arg, const char * buf);
+#endif
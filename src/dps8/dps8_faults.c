@@ -32,6 +32,7 @@
 #include "dps8_append.h"
 #include "dps8_ins.h"
 #include "dps8_utils.h"
+#include "dps8_btrace.h"
 #if defined(THREADZ) || defined(LOCKLESS)
 #include "threadz.h"
 #endif
@@ -352,9 +353,12 @@ const _fault_subtype fst_cmd_lprpn = (_fault_subtype) {.fault_cmd_subtype=flt_cm
 const _fault_subtype fst_cmd_ctl = (_fault_subtype) {.fault_cmd_subtype=flt_cmd_not_control};
 const _fault_subtype fst_onc_nem = (_fault_subtype) {.fault_onc_subtype=flt_onc_nem};
 #endif 
-// CANFAULT 
-void doFault (_fault faultNumber, _fault_subtype subFault, 
-              const char * faultMsg)
+// Everything doFault does except the unwind: the fault is recorded and
+// the CPU is left in FAULT_cycle. The caller must return to the CPU loop
+// without changing any more state.
+
+void setupFault (_fault faultNumber, _fault_subtype subFault, 
+                 const char * faultMsg)
   {
 #ifdef LOOPTRC
 if (faultNumber == FAULT_TRO)
@@ -667,7 +671,7 @@ sim_debug (DBG_FAULT, & cpu_dev, "cycle %u ndes %u fn %u v %u\n", cpu.cycle, cpu
                 sim_printf("\nCycles = %"PRId64"\n", cpu.cycleCnt);
                 sim_printf("\nInstructions = %"PRId64"\n", cpu.instrCnt);
                 //stop_reason = STOP_FLT_CASCADE;
-                longjmp (cpu.jmpMain, JMP_STOP);
+                cpu_longjmp (cpu.jmpMain, JMP_STOP);
               }
 #endif
 #endif
@@ -687,13 +691,26 @@ sim_debug (DBG_FAULT, & cpu_dev, "cycle %u ndes %u fn %u v %u\n", cpu.cycle, cpu
     // If doInstruction faults, the instruction cycle counter doesn't get 
     // bumped.
     if (cpu . cycle == EXEC_cycle)
-      cpu.instrCnt ++;
+      {
+        cpu.instrCnt ++;
+#ifdef BTRACE
+        if (cpu.btrace)
+          btrace_fault (faultNumber);
+#endif
+      }
 
     cpu . cycle = FAULT_cycle;
     sim_debug (DBG_CYCLE, & cpu_dev, "Setting cycle to FAULT_cycle\n");
-    longjmp (cpu.jmpMain, JMP_REENTRY);
 }
 
+// CANFAULT 
+void doFault (_fault faultNumber, _fault_subtype subFault, 
+              const char * faultMsg)
+  {
+    setupFault (faultNumber, subFault, faultMsg);
+    cpu_longjmp (cpu.jmpMain, JMP_REENTRY);
+  }
+
 #ifdef L68
 void do_FFV_fault (uint fault_number, const char * fault_msg)
   {
@@ -807,7 +824,7 @@ void do_FFV_fault (uint fault_number, const char * fault_msg)
                 sim_printf("\nCycles = %"PRId64"\n", cpu.cycleCnt);
                 sim_printf("\nInstructions = %"PRId64"\n", cpu.instrCnt);
                 //stop_reason = STOP_FLT_CASCADE;
-                longjmp (cpu.jmpMain, JMP_STOP);
+                cpu_longjmp (cpu.jmpMain, JMP_STOP);
               }
 #endif
 #endif
@@ -819,7 +836,7 @@ void do_FFV_fault (uint fault_number, const char * fault_msg)
           }
         cpu.cycle = FAULT_cycle;
         sim_debug (DBG_CYCLE, & cpu_dev, "Setting cycle to FAULT_cycle\n");
-        longjmp (cpu.jmpMain, JMP_REENTRY);
+        cpu_longjmp (cpu.jmpMain, JMP_REENTRY);
       }
     cpu.bTroubleFaultCycle = false;
     
@@ -830,7 +847,7 @@ void do_FFV_fault (uint fault_number, const char * fault_msg)
 
     cpu.is_FFV = true;
     cpu.cycle = FAULT_cycle;
-    longjmp (cpu.jmpMain, JMP_REENTRY);
+    cpu_longjmp (cpu.jmpMain, JMP_REENTRY);
 }
 #endif
 
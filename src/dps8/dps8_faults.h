@@ -116,6 +116,8 @@ extern const _fault_subtype fst_onc_nem;
  
 void doFault (_fault faultNumber, _fault_subtype faultSubtype, 
               const char * faultMsg) NO_RETURN;
+void setupFault (_fault faultNumber, _fault_subtype faultSubtype, 
+                 const char * faultMsg);
 void dlyDoFault (_fault faultNumber, _fault_subtype subFault, 
                 const char * faultMsg);
 bool bG7PendingNoTRO (void);
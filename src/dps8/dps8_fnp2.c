@@ -79,6 +79,7 @@
 #include "fnptelnet.h"
 #include "fnpuv.h"
 #include "dps8_utils.h"
+#include "dps8_snap.h"
 #include "utlist.h"
 #include "uthash.h"
 
@@ -277,6 +278,61 @@ void fnpInit(void)
     fnp3270Init ();
   }
 
+// Machine snapshot. The libuv handles and buffered input belong to this
+// emulator's connections and are kept as they are; a line that was
+// connected when the snapshot was taken and is not now is reported to
+// Multics as hung up. The 3270 controller holds only connection state
+// and is not saved.
+
+void fnp_snap (struct snap_s * s)
+  {
+    static struct fnpUnitData_s was_unit;
+    for (uint i = 0; i < N_FNP_UNITS_MAX; i ++)
+      {
+        struct fnpUnitData_s * fudp = & fnpData.fnpUnitData[i];
+        if (! snap_restoring (s))
+          {
+            snap_io (s, "fnp", fudp, sizeof (* fudp));
+            continue;
+          }
+        if (! snap_io (s, "fnp", & was_unit, sizeof (was_unit)))
+          continue;
+        for (uint lineno = 0; lineno < MAX_LINES; lineno ++)
+          {
+            struct t_line * linep = & fudp->MState.line[lineno];
+            struct t_line * wasp = & was_unit.MState.line[lineno];
+            bool was_connected = wasp->line_client != NULL;
+            wasp->line_client = linep->line_client;
+            wasp->inBuffer = linep->inBuffer;
+            wasp->inSize = linep->inSize;
+            wasp->inUsed = linep->inUsed;
+            memcpy (& wasp->doConnect, & linep->doConnect,
+                    sizeof (linep->doConnect));
+            memcpy (& wasp->server, & linep->server, sizeof (linep->server));
+            wasp->port = linep->port;
+#ifdef TUN
+            wasp->is_tun = linep->is_tun;
+            wasp->tun_fd = linep->tun_fd;
+            wasp->in_frame = linep->in_frame;
+            memcpy (wasp->frame, linep->frame, sizeof (linep->frame));
+            wasp->frameLen = linep->frameLen;
+#endif
+            if (was_connected && ! wasp->line_client)
+              {
+#ifdef DISC_DELAY
+                wasp->line_disconnected = DISC_DELAY;
+#else
+                wasp->line_disconnected = true;
+#endif
+                wasp->listen = false;
+              }
+          }
+        memcpy (fudp, & was_unit, sizeof (* fudp));
+        for (uint lineno = 0; lineno < MAX_LINES; lineno ++)
+          fnp_line_ready (& fudp->MState.line[lineno]);
+      }
+  }
+
 static t_stat fnpReset (UNUSED DEVICE * dptr)
   {
 #if 0
@@ -1145,16 +1201,106 @@ static void fnpProcessBuffer (struct t_line * linep)
        }
   }
 
+//
+// Ready lists
+//
+// fnpProcessEvent looks only at the lines in its FNP's ready set. Code
+// that sets one of a line's pending request flags or gives it input
+// calls fnp_line_ready; fnpProcessEvent takes a line out of the set
+// before looking at it and puts it back if anything is still pending.
+// The set is updated atomically, as the channel commands may run on an
+// IOM thread.
+//
+
+static void mark_ready (struct t_line * linep)
+  {
+    ptrdiff_t off = (char *) linep - (char *) fnpData.fnpUnitData;
+    uint fnp_unit_idx = (uint) (off / (ptrdiff_t) sizeof (struct fnpUnitData_s));
+    struct fnpUnitData_s * fudp = & fnpData.fnpUnitData[fnp_unit_idx];
+    uint lineno = (uint) (linep - fudp->MState.line);
+    __atomic_fetch_or (& fudp->ready[lineno / 64], 1llu << (lineno % 64),
+                       __ATOMIC_SEQ_CST);
+  }
+
+// Also asks for an immediate pass rather than waiting for the next tick
+
+void fnp_line_ready (struct t_line * linep)
+  {
+    mark_ready (linep);
+    ev_poll_kick ();
+  }
+
+static bool line_pending (struct t_line * linep)
+  {
+    return linep->inBuffer ||
+           linep->send_output ||
+           linep->acu_dial_failure ||
+           linep->accept_new_terminal ||
+           linep->ack_echnego_init ||
+           linep->ack_echnego_stop ||
+           linep->line_disconnected ||
+           linep->wru_timeout ||
+           linep->accept_input ||
+           linep->line_break ||
+           linep->sendLineStatus;
+  }
+
+// The first ready line at or after lineno, or MAX_LINES
+
+static uint next_ready (struct fnpUnitData_s * fudp, uint lineno)
+  {
+    while (lineno < MAX_LINES)
+      {
+        uint64 w = __atomic_load_n (& fudp->ready[lineno / 64],
+                                    __ATOMIC_SEQ_CST);
+        w &= ~0llu << (lineno % 64);
+        if (w)
+          {
+            lineno = (lineno & ~63u) + (uint) __builtin_ctzll (w);
+            return lineno < MAX_LINES ? lineno : MAX_LINES;
+          }
+        lineno = (lineno & ~63u) + 64;
+      }
+    return MAX_LINES;
+  }
+
+// A delay that only a tick counts down
+
+static bool line_ticking (struct t_line * linep)
+  {
+#ifdef DISC_DELAY
+    if (linep->line_disconnected > 1)
+      return true;
+#endif
+    return linep->send_output > 0 || linep->accept_input > 1;
+  }
+
+// Put lineno back in the ready set if it still has work; return the
+// next ready line. Sets * ticking if the line is counting a delay.
+
+static uint requeue_next (struct fnpUnitData_s * fudp, uint lineno,
+                          bool * ticking)
+  {
+    struct t_line * linep = & fudp->MState.line[lineno];
+    if (line_pending (linep))
+      mark_ready (linep);
+    if (line_ticking (linep))
+      * ticking = true;
+    return next_ready (fudp, lineno + 1);
+  }
+
 static void fnpProcessBuffers (void)
   {
     uint numunits = (uint) fnp_dev.numunits;
     for (uint fnp_unit_idx = 0; fnp_unit_idx < numunits; fnp_unit_idx ++)
       {
-        if (! fnpData.fnpUnitData[fnp_unit_idx].fnpIsRunning)
+        struct fnpUnitData_s * fudp = & fnpData.fnpUnitData[fnp_unit_idx];
+        if (! fudp->fnpIsRunning)
           continue;
-        for (uint lineno = 0; lineno < MAX_LINES; lineno ++)
+        for (uint lineno = next_ready (fudp, 0); lineno < MAX_LINES;
+             lineno = next_ready (fudp, lineno + 1))
           {
-            struct t_line * linep = & fnpData.fnpUnitData[fnp_unit_idx].MState.line[lineno];
+            struct t_line * linep = & fudp->MState.line[lineno];
 
             // If an accept_input request is posted, then buffer is busy.
             if (linep->accept_input)
@@ -1207,6 +1353,7 @@ sim_printf ("set_3270_write_complete\r\n");
 #endif
     //fnpData.ibm3270ctlr[ASSUME0].stations[p->stationNo].write_complete = true;
     fnpData.ibm3270ctlr[ASSUME0].write_complete = true;
+    ev_poll_kick ();
   }
 
 static void send_3270_msg (uint ctlr_no, unsigned char * msg, size_t len, bool brk)
@@ -1239,6 +1386,7 @@ sim_printf ("\r\n");
     linep->force_accept_input = true;
     linep->accept_input = 1;
     linep->input_break = brk ? 1 : 0;
+    fnp_line_ready (linep);
   }
 
 const unsigned char addr_map [ADDR_MAP_ENTRIES] = 
@@ -1342,6 +1490,7 @@ sim_printf ("I think data starts %02hhx\r\n", linep->buffer[0]);
         linep->force_accept_input = true;
         linep->accept_input = 1;
         linep->nPos = sz;
+        fnp_line_ready (linep);
       }
     else
       {
@@ -1349,7 +1498,10 @@ sim_printf ("I think data starts %02hhx\r\n", linep->buffer[0]);
       }
   }
 
-static void fnp_process_3270_event (void)
+// Returns true while the poll is counting down or a station's input is
+// waiting for the line buffer
+
+static bool fnp_process_3270_event (bool tick)
   {
     uint fnpno = fnpData.ibm3270ctlr[ASSUME0].fnpno;
     uint lineno = fnpData.ibm3270ctlr[ASSUME0].lineno;
@@ -1360,7 +1512,7 @@ static void fnp_process_3270_event (void)
     if (fnpData.ibm3270ctlr[ASSUME0].sending_stn_in_buffer)
       {
         send_stn_in_buffer ();
-        return;
+        return fnpData.ibm3270ctlr[ASSUME0].sending_stn_in_buffer;
       }
 
     if (fnpData.ibm3270ctlr[ASSUME0].write_complete)
@@ -1369,15 +1521,18 @@ static void fnp_process_3270_event (void)
         linep->lineStatus0 = 6llu << 18; // IBM3270_WRITE_COMPLETE
         linep->lineStatus1 = 0;
         linep->sendLineStatus = true;
+        fnp_line_ready (linep);
       }
 
 // Polling events
 
     if (! fnpData.du3270_poll)
-     return;
+     return false;
+    if (! tick)
+      return true;
     fnpData.du3270_poll --;
     if (fnpData.du3270_poll)
-      return;
+      return true;
     struct ibm3270ctlr_s * ctlrp = & fnpData.ibm3270ctlr[ASSUME0];
 
 #ifdef FNP2_DEBUG
@@ -1421,14 +1576,20 @@ static void fnp_process_3270_event (void)
 sim_printf("Specific poll\r\n");
 #endif
       }
+    return ctlrp->sending_stn_in_buffer;
   }
 
 //
-// Called @ 100Hz to process FNP background events
+// Called when a line is made ready (fnp_line_ready), with tick clear, and
+// every sys_poll_interval ms, with tick set, while one of the send_output,
+// accept_input and disconnect delays or the 3270 poll is counting ticks.
+// Returns true if one still is.
 //
 
-void fnpProcessEvent (void)
+bool fnpProcessEvent (bool tick)
   {
+    bool need_tick = false;
+
     // Run the libuv event loop once.
     // Handles tcp connections, drops, read data, write data done.
     fnpuvProcessEvent ();
@@ -1442,19 +1603,25 @@ void fnpProcessEvent (void)
     uint numunits = (uint) fnp_dev.numunits;
     for (uint fnp_unit_idx = 0; fnp_unit_idx < numunits; fnp_unit_idx ++)
       {
-        if (! fnpData.fnpUnitData[fnp_unit_idx].fnpIsRunning)
+        struct fnpUnitData_s * fudp = & fnpData.fnpUnitData[fnp_unit_idx];
+        if (! fudp->fnpIsRunning)
           continue;
         int mbx = findMbx (fnp_unit_idx);
         if (mbx == -1)
           continue;
+        // The requests of all the lines go to Multics with one interrupt
         bool need_intr = false;
-        for (int lineno = 0; lineno < MAX_LINES; lineno ++)
+        for (uint ulineno = next_ready (fudp, 0); ulineno < MAX_LINES;
+             ulineno = requeue_next (fudp, ulineno, & need_tick))
           {
-            struct t_line * linep = & fnpData.fnpUnitData[fnp_unit_idx].MState.line[lineno];
+            int lineno = (int) ulineno;
+            struct t_line * linep = & fudp->MState.line[lineno];
+            __atomic_fetch_and (& fudp->ready[ulineno / 64],
+                                ~(1llu << (ulineno % 64)), __ATOMIC_SEQ_CST);
 
 #ifdef DISC_DELAY
             // Disconnect pending?
-            if (linep -> line_disconnected > 1)
+            if (tick && linep -> line_disconnected > 1)
               {
                 // Buffer not empty?
                 if (linep->inBuffer && linep->inUsed < linep->inSize)
@@ -1476,9 +1643,9 @@ void fnpProcessEvent (void)
 
             // Need to send a 'send_output' command to CS?
 
-            bool do_send_output = linep->send_output == 1;
+            bool do_send_output = tick && linep->send_output == 1;
 
-            if (linep -> send_output > 0)
+            if (tick && linep -> send_output > 0)
                 linep->send_output --;
 
             if (do_send_output) 
@@ -1626,8 +1793,10 @@ sim_printf ("input_in_mailbox\n");
                           }
 #endif
                       }
+                    linep->accept_input --;
                   }
-                linep->accept_input --;
+                else if (tick)
+                  linep->accept_input --;
               } // accept_input
 
             // Need to send a 'line_break' command to CS?
@@ -1659,7 +1828,10 @@ sim_printf ("input_in_mailbox\n");
 
             mbx = findMbx (fnp_unit_idx);
             if (mbx == -1)
-              break;
+              {
+                requeue_next (fudp, ulineno, & need_tick);
+                break;
+              }
           } // for lineno
 
         // If any of the mailboxes had a command posted.
@@ -1674,8 +1846,11 @@ sim_printf ("input_in_mailbox\n");
 
 #ifdef TUN
     fnpTUNProcessEvent ();
+    need_tick = true;
 #endif
-    fnp_process_3270_event ();
+    if (fnp_process_3270_event (tick))
+      need_tick = true;
+    return need_tick;
   }
 
 static t_stat fnpShowNUnits (UNUSED FILE * st, UNUSED UNIT * uptr, 
@@ -2501,6 +2676,7 @@ void processLineInput (uv_tcp_t * client, unsigned char * buf, ssize_t nread)
       }
 
 done:;
+    fnp_line_ready (linep);
     // Prevent further reading until this buffer is consumed
     fnpuv_read_stop (client);
   }
@@ -2830,6 +3006,7 @@ associate:;
       fnpData.fnpUnitData[fnp_unit_idx].MState.line[lineno].lineType = 1; /* LINE_ASCII */
     fnpData.fnpUnitData[fnp_unit_idx].MState.line[lineno].accept_new_terminal = true;
     reset_line (& fnpData.fnpUnitData[fnp_unit_idx].MState.line[lineno]);
+    fnp_line_ready (& fnpData.fnpUnitData[fnp_unit_idx].MState.line[lineno]);
     ltnRaw (p->telnetp);
   }
 
@@ -216,6 +216,9 @@ struct fnpUnitData_s
     bool lineWaiting [4]; // If set, fnpMBXlineno is waiting for the mailbox to be marked clear.
     int fnpMBXlineno [4]; // Which HSLA line is using the mbx
     char ipcName [MAX_DEV_NAME_LEN];
+    // Lines that may have a request pending or input to process; see
+    // fnp_line_ready
+    uint64 ready [(MAX_LINES + 63) / 64];
 
     t_MState MState;
   };
@@ -331,9 +334,12 @@ struct fw_entry_s
 extern struct fw_entry_s fw_entries [N_FW_ENTRIES];
 
 void fnpInit(void);
+struct snap_s;
+void fnp_snap (struct snap_s * s);
 int lookupFnpsIomUnitNumber (int fnpUnitNum);
 int lookupFnpLink (int fnpUnitNum);
-void fnpProcessEvent (void); 
+bool fnpProcessEvent (bool tick); 
+void fnp_line_ready (struct t_line * linep);
 t_stat diaCommand (int fnpUnitNum, char *arg3);
 void fnpToCpuQueueMsg (int fnpUnitNum, char * msg);
 int fnp_iom_cmd (uint iomUnitIdx, uint chan);
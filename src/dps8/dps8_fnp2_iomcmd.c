@@ -41,46 +41,15 @@
 #ifdef FNPDBG
 static inline void fnp_core_read_n (word24 addr, word36 *data, uint n, UNUSED const char * ctx)
   {
-#ifdef THREADZ
-    lock_mem_rd ();
-#endif
     for (uint i = 0; i < n; i ++)
 #ifdef SCUMEM
       iom_core_read (addr, data, ctx);
 #else
       data [i] = M [addr + i] & DMASK;
-#endif
-#ifdef THREADZ
-    unlock_mem ();
 #endif
   }
 #endif
 
-#ifdef THREADZ
-static inline void l_putbits36_1 (vol word36 * x, uint p, word1 val)
-{
-    const int n = 1;
-    int shift = 36 - (int) p - (int) n;
-    if (shift < 0 || shift > 35) {
-        sim_printf ("l_putbits36_1: bad args (%012"PRIo64",pos=%d)\n", *x, p);
-        return;
-    }
-    word36 mask = ~ (~0U<<n);  // n low bits on
-    word36 smask = mask << (unsigned) shift;  // shift 1s to proper position; result 0*1{n}0*
-    // caller may provide val that is too big, e.g., a word with all bits
-    // set to one, so we mask val
-#ifdef THREADZ
-    lock_mem_wr ();
-#endif
-    * x = (* x & ~ smask) | (((word36) val & mask) << shift);
-#ifdef THREADZ
-    unlock_mem ();
-#endif
-}
-#else
-#define l_putbits36_1 putbits36_1
-#endif
-
 //
 // As mailbox messages are processed, decoded data are stashed here
 ///
@@ -173,6 +142,7 @@ static int wcd (struct decoded_t *decoded_p)
             linep -> line_disconnected = true;
 #endif
             linep -> listen = false;
+            fnp_line_ready (linep);
             if (linep->line_client)
               {
                 close_connection ((uv_stream_t *) linep->line_client);
@@ -594,6 +564,7 @@ static int wcd (struct decoded_t *decoded_p)
             linep->echnego_on = false;
             // Post a ack echnego stop to MCS
             linep->ack_echnego_stop = true;
+            fnp_line_ready (linep);
           }
           break;
 
@@ -615,6 +586,7 @@ static int wcd (struct decoded_t *decoded_p)
 
             // Post a ack echnego init to MCS
             linep->ack_echnego_init = true;
+            fnp_line_ready (linep);
           }
           break;
 
@@ -731,6 +703,7 @@ static int wcd (struct decoded_t *decoded_p)
                     // XXX ignored
                     //linep -> send_output = true;
                     linep -> send_output = SEND_OUTPUT_DELAY;
+                    fnp_line_ready (linep);
                   }
                   break;
 
@@ -749,6 +722,8 @@ static int wcd (struct decoded_t *decoded_p)
                     uint bufsz = getbits36_18 (command_data[0], 18);
                     linep->listen = !! flag;
                     linep->inputBufferSize = bufsz;
+                    // A connection may be waiting for Multics to listen
+                    fnp_line_ready (linep);
 
                     if (linep->service == service_undefined)
                       linep->service = service_login;
@@ -786,6 +761,7 @@ static int wcd (struct decoded_t *decoded_p)
                   {
                     sim_debug (DBG_TRACE, & fnp_dev, "[%u]        alter_parameters wru\n", decoded_p->slot_no);
                     linep -> wru_timeout = true;
+                    fnp_line_ready (linep);
                   }
                   break;
 
@@ -1262,6 +1238,7 @@ static int wtx (struct decoded_t *decoded_p)
 #else
     decoded_p->fudp->MState.line[decoded_p->slot_no].send_output = SEND_OUTPUT_DELAY;
 #endif
+    fnp_line_ready (& decoded_p->fudp->MState.line[decoded_p->slot_no]);
     return 0;
   }
 
@@ -1346,8 +1323,8 @@ sim_printf ("']\n");
 
     word36 v;
     iom_direct_data_service (decoded_p->iom_unit, decoded_p->chan_num,  decoded_p->fsmbx+INP_COMMAND_DATA, &v, direct_load);
-    l_putbits36_1 (& v, 16, output_chain_present);
-    l_putbits36_1 (& v, 17, linep->input_break ? 1 : 0);
+    putbits36_1 (& v, 16, output_chain_present);
+    putbits36_1 (& v, 17, linep->input_break ? 1 : 0);
     iom_direct_data_service (decoded_p->iom_unit, decoded_p->chan_num,  decoded_p->fsmbx+INP_COMMAND_DATA, &v, direct_store);
 
     // Mark the line as ready to receive more data
@@ -1507,6 +1484,7 @@ static int interruptL66_FNP_to_CS (struct decoded_t *decoded_p)
 // For some reason the CS ack of accept_new_terminal is not being seen, causing the line to wedge.
 // Since a terminal accepted command always follows, clear the wedge here
                     decoded_p->fudp->MState.line[decoded_p->slot_no].waitForMbxDone = false;
+                    fnp_line_ready (& decoded_p->fudp->MState.line[decoded_p->slot_no]);
                   }
                   break;
 
@@ -1524,6 +1502,7 @@ sim_printf ("reject_request_temp\r\n");
                     //sim_printf ("fnp reject_request_temp\n");
                     // Retry in one second;
                     decoded_p->fudp->MState.line[decoded_p->slot_no].accept_input = 100;
+                    fnp_line_ready (& decoded_p->fudp->MState.line[decoded_p->slot_no]);
                   }
                   break;
 
@@ -1632,6 +1611,8 @@ sim_printf ("clearing wait; was %d\n", linep->waitForMbxDone);
 #endif
             linep->waitForMbxDone = false;
           }
+        // Lines may be waiting for a mailbox or for this one to be done
+        ev_poll_kick ();
 #ifdef FNPDBG
 sim_printf ("  %d %d %d %d\n", decoded_p->fudp->fnpMBXinUse [0], decoded_p->fudp->fnpMBXinUse [1], decoded_p->fudp->fnpMBXinUse [2], decoded_p->fudp->fnpMBXinUse [3]);
 #endif
@@ -1755,6 +1736,7 @@ sim_printf ("3270 controller found at unit %u line %u\r\n", devUnitIdx, lineno);
                 if (fnpData.fnpUnitData[devUnitIdx].MState.line[lineno].lineType == 0) /* LINE_NONE */
                   fnpData.fnpUnitData[devUnitIdx].MState.line[lineno].lineType = 7; /* LINE_BSC */
                 fnpData.fnpUnitData[devUnitIdx].MState.line[lineno].accept_new_terminal = true;
+                fnp_line_ready (& fnpData.fnpUnitData[devUnitIdx].MState.line[lineno]);
               }
           }
       }
@@ -36,7 +36,19 @@
 
 // new Read/Write stuff ...
 
-void Read (word18 address, word36 * result, processor_cycle_type cyctyp)
+// Read, Read2, Write and Write2 return true if the appending unit set up a
+// directed fault instead of unwinding (only while cpu.apu.df_return is
+// set); the caller must then return straight to the CPU loop.
+
+static inline bool df_taken (void)
+  {
+    if (! cpu.apu.df_taken)
+      return false;
+    cpu.apu.df_taken = false;
+    return true;
+  }
+
+bool Read (word18 address, word36 * result, processor_cycle_type cyctyp)
   {
     cpu.TPR.CA = cpu.iefpFinalAddress = address;
     bool isBAR = get_bar_mode ();
@@ -68,7 +80,7 @@ void Read (word18 address, word36 * result, processor_cycle_type cyctyp)
                            "Read (Actual) Read:       bar address=%08o  "
                            "readData=%012"PRIo64"\n", address, *result);
                 HDBGMRead (cpu.iefpFinalAddress, * result);
-                return;
+                return false;
               }
             else 
               {
@@ -86,7 +98,7 @@ void Read (word18 address, word36 * result, processor_cycle_type cyctyp)
                            "Read (Actual) Read:       abs address=%08o  "
                            "readData=%012"PRIo64"\n", address, *result);
                 HDBGMRead (address, * result);
-                return;
+                return false;
               }
           }
 
@@ -99,17 +111,21 @@ B29:;
 		cpu.TPR.TSR = cpu.PPR.PSR;
 		cpu.TPR.TRR = cpu.PPR.PRR;
                 cpu.iefpFinalAddress = do_append_cycle (cyctyp, result, 1);
+                if (df_taken ())
+                  return true;
                 sim_debug (DBG_APPENDING | DBG_FINAL, & cpu_dev, 
                            "Read (Actual) Read:  bar iefpFinalAddress=%08o  "
                            "readData=%012"PRIo64"\n",
                            cpu.iefpFinalAddress, * result);
                 HDBGMRead (cpu.iefpFinalAddress, * result);
 
-                return;
+                return false;
               }
             else 
               {
                 cpu.iefpFinalAddress = do_append_cycle (cyctyp, result, 1);
+                if (df_taken ())
+                  return true;
                 // XXX Don't trace Multics idle loop
                 if (cpu.PPR.PSR != 061 && cpu.PPR.IC != 0307)
                   {
@@ -120,13 +136,13 @@ B29:;
                     HDBGMRead (cpu.iefpFinalAddress, * result);
                   }
               }
-            return;
+            return false;
           }
       }
-    return ;//SCPE_UNK;
+    return false;//SCPE_UNK;
   }
 
-void Read2 (word18 address, word36 * result, processor_cycle_type cyctyp)
+bool Read2 (word18 address, word36 * result, processor_cycle_type cyctyp)
   {
     cpu.TPR.CA = cpu.iefpFinalAddress = address;
 
@@ -162,7 +178,7 @@ void Read2 (word18 address, word36 * result, processor_cycle_type cyctyp)
                   }
                 HDBGMRead (cpu.iefpFinalAddress, * result);
                 HDBGMRead (cpu.iefpFinalAddress+1, * (result+1));
-                return;
+                return false;
               }
             else
               {
@@ -179,7 +195,7 @@ void Read2 (word18 address, word36 * result, processor_cycle_type cyctyp)
                   }
                 HDBGMRead (cpu.iefpFinalAddress, * result);
                 HDBGMRead (cpu.iefpFinalAddress+1, * (result+1));
-                return;
+                return false;
               }
           }
 
@@ -192,6 +208,8 @@ B29:;
 		cpu.TPR.TSR = cpu.PPR.PSR;
 		cpu.TPR.TRR = cpu.PPR.PRR;
                 cpu.iefpFinalAddress = do_append_cycle (cyctyp, result, 2);
+                if (df_taken ())
+                  return true;
                 if_sim_debug (DBG_APPENDING | DBG_FINAL, & cpu_dev)
                   {
                     for (uint i = 0; i < 2; i ++)
@@ -202,11 +220,13 @@ B29:;
                   }
                 HDBGMRead (cpu.iefpFinalAddress, * result);
                 HDBGMRead (cpu.iefpFinalAddress+1, * (result+1));
-                return;
+                return false;
               }
             else
               {
                 cpu.iefpFinalAddress = do_append_cycle (cyctyp, result, 2);
+                if (df_taken ())
+                  return true;
                 if_sim_debug (DBG_APPENDING | DBG_FINAL, & cpu_dev)
                   {
                     for (uint i = 0; i < 2; i ++)
@@ -218,10 +238,10 @@ B29:;
                 HDBGMRead (cpu.iefpFinalAddress, * result);
                 HDBGMRead (cpu.iefpFinalAddress+1, * (result+1));
               }
-            return;
+            return false;
           }
       }
-    return ;//SCPE_UNK;
+    return false;//SCPE_UNK;
   }
 
 void Read8 (word18 address, word36 * result, bool isAR)
@@ -454,7 +474,7 @@ B29:;
     return ;//SCPE_UNK;
   }
 
-void Write (word18 address, word36 data, processor_cycle_type cyctyp)
+bool Write (word18 address, word36 data, processor_cycle_type cyctyp)
  {
     cpu.TPR.CA = cpu.iefpFinalAddress = address;
 
@@ -485,7 +505,7 @@ void Write (word18 address, word36 data, processor_cycle_type cyctyp)
                            "Write(Actual) Write:      bar address=%08o "
                            "writeData=%012"PRIo64"\n", address, data);
                 HDBGMWrite (cpu.iefpFinalAddress, data);
-                return;
+                return false;
               }
             else
               {
@@ -504,7 +524,7 @@ void Write (word18 address, word36 data, processor_cycle_type cyctyp)
                            "writeData=%012"PRIo64"\n", 
                            address, data);
                 HDBGMWrite (address, data);
-                return;
+                return false;
               }
           }
 
@@ -517,31 +537,35 @@ B29:
 		cpu.TPR.TSR = cpu.PPR.PSR;
 		cpu.TPR.TRR = cpu.PPR.PRR;
                 cpu.iefpFinalAddress = do_append_cycle (cyctyp, & data, 1);
+                if (df_taken ())
+                  return true;
                 sim_debug (DBG_APPENDING | DBG_FINAL, & cpu_dev,
                            "Write(Actual) Write: bar iefpFinalAddress=%08o "
                            "writeData=%012"PRIo64"\n",
                            cpu.iefpFinalAddress, data);
                 HDBGMWrite (cpu.iefpFinalAddress, data);
-                return;
+                return false;
               } 
             else 
               {
                 cpu.iefpFinalAddress = do_append_cycle (cyctyp, & data, 1);
+                if (df_taken ())
+                  return true;
                 sim_debug (DBG_APPENDING | DBG_FINAL, & cpu_dev,
                            "Write(Actual) Write: iefpFinalAddress=%08o "
                            "writeData=%012"PRIo64"\n",
                            cpu.iefpFinalAddress, data);
                 HDBGMWrite (cpu.iefpFinalAddress, data);
-                return;
+                return false;
               }
           }
       }
     
-    return ;//SCPE_UNK;
+    return false;//SCPE_UNK;
   }
 
 
-void Write2 (word18 address, word36 * data, processor_cycle_type cyctyp)
+bool Write2 (word18 address, word36 * data, processor_cycle_type cyctyp)
   {
     cpu.TPR.CA = cpu.iefpFinalAddress = address;
     bool isBAR = get_bar_mode ();
@@ -591,6 +615,8 @@ B29:
 		cpu.TPR.TSR = cpu.PPR.PSR;
 		cpu.TPR.TRR = cpu.PPR.PRR;
                 cpu.iefpFinalAddress = do_append_cycle (cyctyp, data, 2);
+                if (df_taken ())
+                  return true;
                 sim_debug (DBG_APPENDING | DBG_FINAL, & cpu_dev,
                            "Write2 (Actual) Write: bar iefpFinalAddress=%08o "
                            "writeData=%012"PRIo64" %012"PRIo64"\n", 
@@ -601,6 +627,8 @@ B29:
             else
               {
                 cpu.iefpFinalAddress = do_append_cycle (cyctyp, data, 2);
+                if (df_taken ())
+                  return true;
                 sim_debug (DBG_APPENDING | DBG_FINAL, & cpu_dev,
                            "Write2 (Actual) Write: iefpFinalAddress=%08o "
                            "writeData=%012"PRIo64" %012"PRIo64"\n", 
@@ -611,7 +639,7 @@ B29:
           }
           break;
       }
-    return ;//SCPE_UNK;
+    return false;//SCPE_UNK;
   }
 
 #ifdef CWO
@@ -39,6 +39,8 @@
 #include "dps8_decimal.h"
 #include "dps8_iefp.h"
 #include "dps8_utils.h"
+#include "dps8_prof.h"
+#include "dps8_btrace.h"
 
 #if defined(THREADZ) || defined(LOCKLESS)
 #include "threadz.h"
@@ -74,8 +76,10 @@ void elapsedtime (void)
   }
 #endif
 
+// Returns true if the store took a page or segment fault, which has been
+// set up for the CPU loop
 // CANFAULT
-static void writeOperands (void)
+static bool writeOperands (void)
 {
     char buf [256];
     CPT (cpt2U, 0); // write operands
@@ -143,16 +147,16 @@ static void writeOperands (void)
         // Restore the CA; Read/Write() updates it.
         //cpu.TPR.CA = indwordAddress;
         cpu.TPR.CA = cpu.ou.character_address;
-        return;
+        return false;
       } // IT
 
-    write_operand (cpu.TPR.CA, OPERAND_STORE);
-
-    return;
+    return write_operand (cpu.TPR.CA, OPERAND_STORE) == CONT_FAULT;
 }
 
+// Returns true if the fetch took a page or segment fault, which has been
+// set up for the CPU loop
 // CANFAULT
-static void readOperands (void)
+static bool readOperands (void)
 {
     char buf [256];
     CPT (cpt2U, 3); // read operands
@@ -182,7 +186,7 @@ static void readOperands (void)
         SETHI (cpu.CY, cpu.TPR.CA);
         sim_debug (DBG_ADDRMOD, & cpu_dev,
                    "%s DU CY=%012"PRIo64"\n", __func__, cpu.CY);
-        return;
+        return false;
       }
 
 //
@@ -195,7 +199,7 @@ static void readOperands (void)
         SETLO (cpu.CY, cpu.TPR.CA);
         sim_debug (DBG_ADDRMOD, & cpu_dev,
                    "%s DL CY=%012"PRIo64"\n", __func__, cpu.CY);
-        return;
+        return false;
       }
 
 //
@@ -226,16 +230,14 @@ static void readOperands (void)
 
         // Restore the CA; Read/Write() updates it.
         cpu.TPR.CA = cpu.ou.character_address;
-        return;
+        return false;
       } // IT
 
 #ifdef LOCKLESS
-    read_operand (cpu.TPR.CA, ((i->info->flags & RMW) == RMW) ? OPERAND_RMW : OPERAND_READ);
+    return read_operand (cpu.TPR.CA, ((i->info->flags & RMW) == RMW) ? OPERAND_RMW : OPERAND_READ) == CONT_FAULT;
 #else
-    read_operand (cpu.TPR.CA, OPERAND_READ);
+    return read_operand (cpu.TPR.CA, OPERAND_READ) == CONT_FAULT;
 #endif
-
-    return;
   }
 
 static void read_tra_op (void)
@@ -1074,9 +1076,10 @@ t_stat display_the_matrix (UNUSED int32 arg, UNUSED const char * buf)
 #endif
 
 
-// fetch instrcution at address
+// fetch instrcution at address; returns true if the fetch took a page or
+// segment fault, which has been set up for the CPU loop
 // CANFAULT
-void fetchInstruction (word18 addr)
+bool fetchInstruction (word18 addr)
 {
     CPT (cpt2U, 9); // fetchInstruction
 
@@ -1100,12 +1103,17 @@ void fetchInstruction (word18 addr)
         if (cpu.cu.repeat_first)
           {
             CPT (cpt2U, 11); // fetch rpt even
+	    cpu.apu.df_return = true;
 	    if (addr & 1)
-	      Read (addr, & cpu.cu.IWB, INSTRUCTION_FETCH);
+	      {
+	        if (Read (addr, & cpu.cu.IWB, INSTRUCTION_FETCH))
+	          goto faulted;
+	      }
 	    else
 	      {
 		word36 tmp[2];
-		Read2 (addr, tmp, INSTRUCTION_FETCH);
+		if (Read2 (addr, tmp, INSTRUCTION_FETCH))
+		  goto faulted;
 		cpu.cu.IWB = tmp[0];
 		cpu.cu.IRODD = tmp[1];
 	      }
@@ -1119,19 +1127,28 @@ void fetchInstruction (word18 addr)
 // If we are fetching an odd instruction, copy it to IRODD as
 // if that was where we got it from.
         //Read (addr, & cpu.cu.IWB, INSTRUCTION_FETCH);
+        cpu.apu.df_return = true;
         if ((cpu.PPR.IC & 1) == 0) // Even
           {
             word36 tmp[2];
-            Read2 (addr, tmp, INSTRUCTION_FETCH);
+            if (Read2 (addr, tmp, INSTRUCTION_FETCH))
+              goto faulted;
             cpu.cu.IWB = tmp[0];
             cpu.cu.IRODD = tmp[1];
           }
         else // Odd
           {
-            Read (addr, & cpu.cu.IWB, INSTRUCTION_FETCH);
+            if (Read (addr, & cpu.cu.IWB, INSTRUCTION_FETCH))
+              goto faulted;
             cpu.cu.IRODD = cpu.cu.IWB; 
           }
       }
+    cpu.apu.df_return = false;
+    return false;
+
+faulted:
+    cpu.apu.df_return = false;
+    return true;
 }
 
 #ifdef TESTING
@@ -1261,6 +1278,51 @@ force:;
   }
 #endif
 
+#ifdef THREADED_DISPATCH
+// Dispatch validation trace: one line of register state per executed
+// instruction. Running the same workload with 'set cpu config=dispatch=table'
+// and '=switch' and diffing the two traces checks the table dispatch against
+// the switch.
+
+static FILE * dispatch_trace = NULL;
+
+static void dispatch_trace_instruction (t_stat ret)
+  {
+    fprintf (dispatch_trace,
+             "%c %05o:%06o %012"PRIo64" %d A %012"PRIo64" Q %012"PRIo64" "
+             "E %03o X %06o %06o %06o %06o %06o %06o %06o %06o IR %06o "
+             "CA %06o CY %012"PRIo64"\n",
+             'A' + current_running_cpu_idx, cpu.PPR.PSR, cpu.PPR.IC,
+             IWB_IRODD, ret, cpu.rA, cpu.rQ, cpu.rE,
+             cpu.rX[0], cpu.rX[1], cpu.rX[2], cpu.rX[3],
+             cpu.rX[4], cpu.rX[5], cpu.rX[6], cpu.rX[7],
+             cpu.cu.IR, cpu.TPR.CA, cpu.CY);
+  }
+
+t_stat set_dispatch_trace (int32 arg, const char * buf)
+  {
+    if (dispatch_trace)
+      {
+        fclose (dispatch_trace);
+        dispatch_trace = NULL;
+      }
+    if (! arg)
+      return SCPE_OK;
+    if (! buf || ! * buf)
+      {
+        sim_warn ("dispatch_trace: missing file name\n");
+        return SCPE_ARG;
+      }
+    dispatch_trace = fopen (buf, "w");
+    if (! dispatch_trace)
+      {
+        sim_warn ("dispatch_trace: can't open %s: %s\n", buf, strerror (errno));
+        return SCPE_OPENERR;
+      }
+    return SCPE_OK;
+  }
+#endif
+
 bool chkOVF (void)
   {
     if (cpu.cu.rpt || cpu.cu.rd || cpu.cu.rl)
@@ -1348,7 +1410,7 @@ t_stat executeInstruction (void)
 ///
 
     DCDstruct * ci = & cpu.currentInstruction;
-    decode_instruction (IWB_IRODD, ci);
+    decode_instruction_cached (IWB_IRODD, ci);
     //cpu.isb29 = ci->b29;
     //ISB29 = ci->b29;
     const struct opcode_s *info = ci->info;
@@ -1383,6 +1445,16 @@ t_stat executeInstruction (void)
 #define likely(x) __builtin_expect ((x), 1)
 #define unlikely(x) __builtin_expect ((x), 0)
 
+#ifdef PROFILER
+    if (unlikely (cpu.prof_flags))
+      prof_record (opcode | (opcodeX ? 01000u : 0u));
+#endif
+
+#ifdef BTRACE
+    if (unlikely (cpu.btrace))
+      btrace_begin ();
+#endif
+
 //sim_debug (DBG_TRACEEXT, & cpu_dev, "isb29 %o\n", ci->b29);
     if (ci->b29)
       ci->address = SIGNEXT15_18 (ci->address & MASK15);
@@ -1944,8 +2016,13 @@ sim_printf ("XXX this had b29 of 0; it may be necessary to clear TSN_VALID[0]\n"
 #else
 	    // append cycles updates cpu.PPR.IC to TPR.CA
 	    word18 saveIC = cpu.PPR.IC;
-            Read (cpu.PPR.IC + 1 + n, & cpu.currentEISinstruction.op[n],
-                  INSTRUCTION_FETCH);
+            cpu.apu.df_return = true;
+            bool faulted = Read (cpu.PPR.IC + 1 + n,
+                                 & cpu.currentEISinstruction.op[n],
+                                 INSTRUCTION_FETCH);
+            cpu.apu.df_return = false;
+            if (faulted)
+              return CONT_FAULT;
 	    cpu.PPR.IC = saveIC;
             //Read (cpu.PPR.IC + 1 + n, & cpu.currentEISinstruction.op[n],
             //      APU_DATA_READ);
@@ -2084,7 +2161,8 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "executeInstruction not EIS sets XSF to %o\n
         if (READOP (ci))
           {
             CPT (cpt2L, 2); // Read operands
-            readOperands ();
+            if (readOperands ())
+              return CONT_FAULT;
 #ifdef LOCKLESS
 	    cpu.rmw_address = cpu.iefpFinalAddress;
 #endif
@@ -2122,7 +2200,8 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "executeInstruction not EIS sets XSF to %o\n
           {
             do_caf ();
             cpu.iefpFinalAddress = cpu.TPR.CA;
-            readOperands ();
+            if (readOperands ())
+              return CONT_FAULT;
           }
 #endif
         PNL (cpu.IWRAddr = 0);
@@ -2138,6 +2217,10 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "executeInstruction not EIS sets XSF to %o\n
 ///
 
     t_stat ret = doInstruction ();
+#ifdef THREADED_DISPATCH
+    if (unlikely (dispatch_trace != NULL))
+      dispatch_trace_instruction (ret);
+#endif
 
 ///
 /// executeInstruction: Write operand
@@ -2164,10 +2247,11 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "executeInstruction not EIS sets XSF to %o\n
 		sim_warn("executeInstruction: write addr changed %o %d\n", cpu.iefpFinalAddress, cpu.rmw_address);
 	      core_write_unlock (cpu.iefpFinalAddress, cpu.CY, __func__);
          }
-	else
-	  writeOperands ();
+	else if (writeOperands ())
+	  return CONT_FAULT;
 #else
-        writeOperands ();
+        if (writeOperands ())
+          return CONT_FAULT;
 #endif
       }
 
@@ -2441,6 +2525,11 @@ sim_debug (DBG_TRACEEXT, & cpu_dev, "executeInstruction not EIS sets XSF to %o\n
 
     cpu.instrCnt ++;
 
+#ifdef BTRACE
+    if (unlikely (cpu.btrace))
+      btrace_end ();
+#endif
+
     if_sim_debug (DBG_REGDUMP, & cpu_dev)
     {
         char buf [256];
@@ -2561,6 +2650,13 @@ static t_stat doInstruction (void)
 #define x0(n) (n)
 #define x1(n) (n|01000)
 
+// Label each case so that it can be the target of the dispatch table
+#ifdef THREADED_DISPATCH
+#define OPLABEL(x, n) L_##x##_##n:
+#else
+#define OPLABEL(x, n)
+#endif
+
     //t_stat ret =  i->opcodeX ? DoEISInstruction () : DoBasicInstruction ();
     uint32 opcode10 = i->opcode10;
 
@@ -2607,6 +2703,575 @@ static t_stat doInstruction (void)
 #endif
 #endif // PANEL
 
+#ifdef THREADED_DISPATCH
+// Jump straight to the case label for the opcode, bypassing the switch's
+// range check and compare chain. Opcodes not in the table (unimplemented,
+// or added to the switch but not here) go through the switch itself, which
+// stays the reference implementation and can be selected at run time with
+// 'set cpu config=dispatch=switch'.
+
+    static const void * const dispatch_table [1024] =
+      {
+        [0 ... 01777] = && dispatch_switch,
+        [x0 (0350)] = && L_x0_0350,
+        [x1 (0351)] = && L_x1_0351,
+        [x0 (0352)] = && L_x0_0352,
+        [x1 (0353)] = && L_x1_0353,
+        [x0 (0370)] = && L_x0_0370,
+        [x1 (0371)] = && L_x1_0371,
+        [x0 (0372)] = && L_x0_0372,
+        [x1 (0373)] = && L_x1_0373,
+        [x0 (0250)] = && L_x0_0250,
+        [x1 (0251)] = && L_x1_0251,
+        [x0 (0252)] = && L_x0_0252,
+        [x1 (0253)] = && L_x1_0253,
+        [x0 (0650)] = && L_x0_0650,
+        [x1 (0651)] = && L_x1_0651,
+        [x0 (0652)] = && L_x0_0652,
+        [x1 (0653)] = && L_x1_0653,
+        [x0 (0235)] = && L_x0_0235,
+        [x0 (0710)] = && L_x0_0710,
+        [x0 (0236)] = && L_x0_0236,
+        [x0 (0600)] = && L_x0_0600,
+        [x0 (0601)] = && L_x0_0601,
+        [x0 (0756)] = && L_x0_0756,
+        [x0 (0116)] = && L_x0_0116,
+        [x0 (0377)] = && L_x0_0377,
+        [x0 (0755)] = && L_x0_0755,
+        [x0 (0760)] = && L_x0_0760,
+        [x0 (0761)] = && L_x0_0761,
+        [x0 (0762)] = && L_x0_0762,
+        [x0 (0763)] = && L_x0_0763,
+        [x0 (0764)] = && L_x0_0764,
+        [x0 (0765)] = && L_x0_0765,
+        [x0 (0766)] = && L_x0_0766,
+        [x0 (0767)] = && L_x0_0767,
+        [x0 (0620)] = && L_x0_0620,
+        [x0 (0621)] = && L_x0_0621,
+        [x0 (0622)] = && L_x0_0622,
+        [x0 (0623)] = && L_x0_0623,
+        [x0 (0624)] = && L_x0_0624,
+        [x0 (0625)] = && L_x0_0625,
+        [x0 (0626)] = && L_x0_0626,
+        [x0 (0627)] = && L_x0_0627,
+        [x0 (0700)] = && L_x0_0700,
+        [x0 (0701)] = && L_x0_0701,
+        [x0 (0702)] = && L_x0_0702,
+        [x0 (0703)] = && L_x0_0703,
+        [x0 (0704)] = && L_x0_0704,
+        [x0 (0705)] = && L_x0_0705,
+        [x0 (0706)] = && L_x0_0706,
+        [x0 (0707)] = && L_x0_0707,
+        [x0 (0450)] = && L_x0_0450,
+        [x1 (0350)] = && L_x1_0350,
+        [x0 (0351)] = && L_x0_0351,
+        [x1 (0352)] = && L_x1_0352,
+        [x0 (0353)] = && L_x0_0353,
+        [x1 (0370)] = && L_x1_0370,
+        [x0 (0371)] = && L_x0_0371,
+        [x1 (0372)] = && L_x1_0372,
+        [x0 (0373)] = && L_x0_0373,
+        [x0 (0115)] = && L_x0_0115,
+        [x0 (0054)] = && L_x0_0054,
+        [x0 (0315)] = && L_x0_0315,
+        [x0 (0237)] = && L_x0_0237,
+        [x1 (0605)] = && L_x1_0605,
+        [x0 (0720)] = && L_x0_0720,
+        [x0 (0721)] = && L_x0_0721,
+        [x0 (0722)] = && L_x0_0722,
+        [x0 (0723)] = && L_x0_0723,
+        [x0 (0724)] = && L_x0_0724,
+        [x0 (0725)] = && L_x0_0725,
+        [x0 (0726)] = && L_x0_0726,
+        [x0 (0727)] = && L_x0_0727,
+        [x0 (0757)] = && L_x0_0757,
+        [x0 (0270)] = && L_x0_0270,
+        [x0 (0271)] = && L_x0_0271,
+        [x0 (0272)] = && L_x0_0272,
+        [x0 (0273)] = && L_x0_0273,
+        [x0 (0670)] = && L_x0_0670,
+        [x0 (0671)] = && L_x0_0671,
+        [x0 (0672)] = && L_x0_0672,
+        [x0 (0673)] = && L_x0_0673,
+        [x0 (0735)] = && L_x0_0735,
+        [x0 (0610)] = && L_x0_0610,
+        [x0 (0604)] = && L_x0_0604,
+        [x0 (0740)] = && L_x0_0740,
+        [x0 (0741)] = && L_x0_0741,
+        [x0 (0742)] = && L_x0_0742,
+        [x0 (0743)] = && L_x0_0743,
+        [x0 (0744)] = && L_x0_0744,
+        [x0 (0745)] = && L_x0_0745,
+        [x0 (0746)] = && L_x0_0746,
+        [x0 (0747)] = && L_x0_0747,
+        [x0 (0634)] = && L_x0_0634,
+        [x0 (0677)] = && L_x0_0677,
+        [x0 (0275)] = && L_x0_0275,
+        [x0 (0076)] = && L_x0_0076,
+        [x1 (0604)] = && L_x1_0604,
+        [x1 (0250)] = && L_x1_0250,
+        [x0 (0251)] = && L_x0_0251,
+        [x1 (0252)] = && L_x1_0252,
+        [x0 (0253)] = && L_x0_0253,
+        [x1 (0650)] = && L_x1_0650,
+        [x0 (0651)] = && L_x0_0651,
+        [x1 (0652)] = && L_x1_0652,
+        [x0 (0653)] = && L_x0_0653,
+        [x0 (0375)] = && L_x0_0375,
+        [x0 (0431)] = && L_x0_0431,
+        [x0 (0213)] = && L_x0_0213,
+        [x0 (0736)] = && L_x0_0736,
+        [x0 (0754)] = && L_x0_0754,
+        [x0 (0635)] = && L_x0_0635,
+        [x0 (0636)] = && L_x0_0636,
+        [x0 (0335)] = && L_x0_0335,
+        [x0 (0336)] = && L_x0_0336,
+        [x0 (0320)] = && L_x0_0320,
+        [x0 (0321)] = && L_x0_0321,
+        [x0 (0322)] = && L_x0_0322,
+        [x0 (0323)] = && L_x0_0323,
+        [x0 (0324)] = && L_x0_0324,
+        [x0 (0325)] = && L_x0_0325,
+        [x0 (0326)] = && L_x0_0326,
+        [x0 (0327)] = && L_x0_0327,
+        [x0 (0337)] = && L_x0_0337,
+        [x0 (0034)] = && L_x0_0034,
+        [x0 (0032)] = && L_x0_0032,
+        [x0 (0220)] = && L_x0_0220,
+        [x0 (0221)] = && L_x0_0221,
+        [x0 (0222)] = && L_x0_0222,
+        [x0 (0223)] = && L_x0_0223,
+        [x0 (0224)] = && L_x0_0224,
+        [x0 (0225)] = && L_x0_0225,
+        [x0 (0226)] = && L_x0_0226,
+        [x0 (0227)] = && L_x0_0227,
+        [x0 (0073)] = && L_x0_0073,
+        [x0 (0753)] = && L_x0_0753,
+        [x0 (0354)] = && L_x0_0354,
+        [x0 (0654)] = && L_x0_0654,
+        [x0 (0551)] = && L_x0_0551,
+        [x0 (0552)] = && L_x0_0552,
+        [x0 (0554)] = && L_x0_0554,
+        [x0 (0750)] = && L_x0_0750,
+        [x0 (0751)] = && L_x0_0751,
+        [x0 (0752)] = && L_x0_0752,
+        [x0 (0357)] = && L_x0_0357,
+        [x0 (0454)] = && L_x0_0454,
+        [x0 (0440)] = && L_x0_0440,
+        [x0 (0441)] = && L_x0_0441,
+        [x0 (0442)] = && L_x0_0442,
+        [x0 (0443)] = && L_x0_0443,
+        [x0 (0444)] = && L_x0_0444,
+        [x0 (0445)] = && L_x0_0445,
+        [x0 (0446)] = && L_x0_0446,
+        [x0 (0447)] = && L_x0_0447,
+        [x0 (0775)] = && L_x0_0775,
+        [x0 (0771)] = && L_x0_0771,
+        [x0 (0731)] = && L_x0_0731,
+        [x0 (0777)] = && L_x0_0777,
+        [x0 (0737)] = && L_x0_0737,
+        [x0 (0773)] = && L_x0_0773,
+        [x0 (0733)] = && L_x0_0733,
+        [x0 (0776)] = && L_x0_0776,
+        [x0 (0772)] = && L_x0_0772,
+        [x0 (0732)] = && L_x0_0732,
+        [x0 (0075)] = && L_x0_0075,
+        [x0 (0077)] = && L_x0_0077,
+        [x0 (0033)] = && L_x0_0033,
+        [x0 (0037)] = && L_x0_0037,
+        [x0 (0035)] = && L_x0_0035,
+        [x0 (0036)] = && L_x0_0036,
+        [x0 (0020)] = && L_x0_0020,
+        [x0 (0021)] = && L_x0_0021,
+        [x0 (0022)] = && L_x0_0022,
+        [x0 (0023)] = && L_x0_0023,
+        [x0 (0024)] = && L_x0_0024,
+        [x0 (0025)] = && L_x0_0025,
+        [x0 (0026)] = && L_x0_0026,
+        [x0 (0027)] = && L_x0_0027,
+        [x0 (0060)] = && L_x0_0060,
+        [x0 (0061)] = && L_x0_0061,
+        [x0 (0062)] = && L_x0_0062,
+        [x0 (0063)] = && L_x0_0063,
+        [x0 (0064)] = && L_x0_0064,
+        [x0 (0065)] = && L_x0_0065,
+        [x0 (0066)] = && L_x0_0066,
+        [x0 (0067)] = && L_x0_0067,
+        [x0 (0055)] = && L_x0_0055,
+        [x0 (0056)] = && L_x0_0056,
+        [x0 (0040)] = && L_x0_0040,
+        [x0 (0041)] = && L_x0_0041,
+        [x0 (0042)] = && L_x0_0042,
+        [x0 (0043)] = && L_x0_0043,
+        [x0 (0044)] = && L_x0_0044,
+        [x0 (0045)] = && L_x0_0045,
+        [x0 (0046)] = && L_x0_0046,
+        [x0 (0047)] = && L_x0_0047,
+        [x0 (0071)] = && L_x0_0071,
+        [x0 (0072)] = && L_x0_0072,
+        [x0 (0175)] = && L_x0_0175,
+        [x0 (0177)] = && L_x0_0177,
+        [x0 (0135)] = && L_x0_0135,
+        [x0 (0137)] = && L_x0_0137,
+        [x0 (0136)] = && L_x0_0136,
+        [x0 (0120)] = && L_x0_0120,
+        [x0 (0121)] = && L_x0_0121,
+        [x0 (0122)] = && L_x0_0122,
+        [x0 (0123)] = && L_x0_0123,
+        [x0 (0124)] = && L_x0_0124,
+        [x0 (0125)] = && L_x0_0125,
+        [x0 (0126)] = && L_x0_0126,
+        [x0 (0127)] = && L_x0_0127,
+        [x0 (0176)] = && L_x0_0176,
+        [x0 (0160)] = && L_x0_0160,
+        [x0 (0161)] = && L_x0_0161,
+        [x0 (0162)] = && L_x0_0162,
+        [x0 (0163)] = && L_x0_0163,
+        [x0 (0164)] = && L_x0_0164,
+        [x0 (0165)] = && L_x0_0165,
+        [x0 (0166)] = && L_x0_0166,
+        [x0 (0167)] = && L_x0_0167,
+        [x0 (0155)] = && L_x0_0155,
+        [x0 (0156)] = && L_x0_0156,
+        [x0 (0140)] = && L_x0_0140,
+        [x0 (0141)] = && L_x0_0141,
+        [x0 (0142)] = && L_x0_0142,
+        [x0 (0143)] = && L_x0_0143,
+        [x0 (0144)] = && L_x0_0144,
+        [x0 (0145)] = && L_x0_0145,
+        [x0 (0146)] = && L_x0_0146,
+        [x0 (0147)] = && L_x0_0147,
+        [x0 (0171)] = && L_x0_0171,
+        [x0 (0172)] = && L_x0_0172,
+        [x0 (0401)] = && L_x0_0401,
+        [x0 (0402)] = && L_x0_0402,
+        [x0 (0506)] = && L_x0_0506,
+        [x0 (0507)] = && L_x0_0507,
+        [x0 (0531)] = && L_x0_0531,
+        [x0 (0533)] = && L_x0_0533,
+        [x0 (0405)] = && L_x0_0405,
+        [x0 (0211)] = && L_x0_0211,
+        [x0 (0117)] = && L_x0_0117,
+        [x0 (0100)] = && L_x0_0100,
+        [x0 (0101)] = && L_x0_0101,
+        [x0 (0102)] = && L_x0_0102,
+        [x0 (0103)] = && L_x0_0103,
+        [x0 (0104)] = && L_x0_0104,
+        [x0 (0105)] = && L_x0_0105,
+        [x0 (0106)] = && L_x0_0106,
+        [x0 (0107)] = && L_x0_0107,
+        [x0 (0111)] = && L_x0_0111,
+        [x0 (0234)] = && L_x0_0234,
+        [x0 (0214)] = && L_x0_0214,
+        [x0 (0376)] = && L_x0_0376,
+        [x0 (0355)] = && L_x0_0355,
+        [x0 (0356)] = && L_x0_0356,
+        [x0 (0340)] = && L_x0_0340,
+        [x0 (0341)] = && L_x0_0341,
+        [x0 (0342)] = && L_x0_0342,
+        [x0 (0343)] = && L_x0_0343,
+        [x0 (0344)] = && L_x0_0344,
+        [x0 (0345)] = && L_x0_0345,
+        [x0 (0346)] = && L_x0_0346,
+        [x0 (0347)] = && L_x0_0347,
+        [x0 (0360)] = && L_x0_0360,
+        [x0 (0361)] = && L_x0_0361,
+        [x0 (0362)] = && L_x0_0362,
+        [x0 (0363)] = && L_x0_0363,
+        [x0 (0364)] = && L_x0_0364,
+        [x0 (0365)] = && L_x0_0365,
+        [x0 (0366)] = && L_x0_0366,
+        [x0 (0367)] = && L_x0_0367,
+        [x0 (0277)] = && L_x0_0277,
+        [x0 (0276)] = && L_x0_0276,
+        [x0 (0255)] = && L_x0_0255,
+        [x0 (0256)] = && L_x0_0256,
+        [x0 (0240)] = && L_x0_0240,
+        [x0 (0241)] = && L_x0_0241,
+        [x0 (0242)] = && L_x0_0242,
+        [x0 (0243)] = && L_x0_0243,
+        [x0 (0244)] = && L_x0_0244,
+        [x0 (0245)] = && L_x0_0245,
+        [x0 (0246)] = && L_x0_0246,
+        [x0 (0247)] = && L_x0_0247,
+        [x0 (0260)] = && L_x0_0260,
+        [x0 (0261)] = && L_x0_0261,
+        [x0 (0262)] = && L_x0_0262,
+        [x0 (0263)] = && L_x0_0263,
+        [x0 (0264)] = && L_x0_0264,
+        [x0 (0265)] = && L_x0_0265,
+        [x0 (0266)] = && L_x0_0266,
+        [x0 (0267)] = && L_x0_0267,
+        [x0 (0675)] = && L_x0_0675,
+        [x0 (0676)] = && L_x0_0676,
+        [x0 (0655)] = && L_x0_0655,
+        [x0 (0656)] = && L_x0_0656,
+        [x0 (0640)] = && L_x0_0640,
+        [x0 (0641)] = && L_x0_0641,
+        [x0 (0642)] = && L_x0_0642,
+        [x0 (0643)] = && L_x0_0643,
+        [x0 (0644)] = && L_x0_0644,
+        [x0 (0645)] = && L_x0_0645,
+        [x0 (0646)] = && L_x0_0646,
+        [x0 (0647)] = && L_x0_0647,
+        [x0 (0660)] = && L_x0_0660,
+        [x0 (0661)] = && L_x0_0661,
+        [x0 (0662)] = && L_x0_0662,
+        [x0 (0663)] = && L_x0_0663,
+        [x0 (0664)] = && L_x0_0664,
+        [x0 (0665)] = && L_x0_0665,
+        [x0 (0666)] = && L_x0_0666,
+        [x0 (0667)] = && L_x0_0667,
+        [x0 (0317)] = && L_x0_0317,
+        [x0 (0316)] = && L_x0_0316,
+        [x0 (0300)] = && L_x0_0300,
+        [x0 (0301)] = && L_x0_0301,
+        [x0 (0302)] = && L_x0_0302,
+        [x0 (0303)] = && L_x0_0303,
+        [x0 (0304)] = && L_x0_0304,
+        [x0 (0305)] = && L_x0_0305,
+        [x0 (0306)] = && L_x0_0306,
+        [x0 (0307)] = && L_x0_0307,
+        [x0 (0215)] = && L_x0_0215,
+        [x0 (0217)] = && L_x0_0217,
+        [x0 (0216)] = && L_x0_0216,
+        [x0 (0200)] = && L_x0_0200,
+        [x0 (0201)] = && L_x0_0201,
+        [x0 (0202)] = && L_x0_0202,
+        [x0 (0203)] = && L_x0_0203,
+        [x0 (0204)] = && L_x0_0204,
+        [x0 (0205)] = && L_x0_0205,
+        [x0 (0206)] = && L_x0_0206,
+        [x0 (0207)] = && L_x0_0207,
+        [x0 (0433)] = && L_x0_0433,
+        [x0 (0457)] = && L_x0_0457,
+        [x0 (0472)] = && L_x0_0472,
+        [x0 (0455)] = && L_x0_0455,
+        [x0 (0470)] = && L_x0_0470,
+        [x0 (0477)] = && L_x0_0477,
+        [x0 (0437)] = && L_x0_0437,
+        [x0 (0475)] = && L_x0_0475,
+        [x0 (0435)] = && L_x0_0435,
+        [x0 (0577)] = && L_x0_0577,
+        [x0 (0537)] = && L_x0_0537,
+        [x0 (0575)] = && L_x0_0575,
+        [x0 (0535)] = && L_x0_0535,
+        [x0 (0463)] = && L_x0_0463,
+        [x0 (0423)] = && L_x0_0423,
+        [x0 (0461)] = && L_x0_0461,
+        [x0 (0421)] = && L_x0_0421,
+        [x0 (0527)] = && L_x0_0527,
+        [x0 (0567)] = && L_x0_0567,
+        [x0 (0525)] = && L_x0_0525,
+        [x0 (0565)] = && L_x0_0565,
+        [x0 (0513)] = && L_x0_0513,
+        [x0 (0573)] = && L_x0_0573,
+        [x0 (0473)] = && L_x0_0473,
+        [x0 (0471)] = && L_x0_0471,
+        [x0 (0427)] = && L_x0_0427,
+        [x0 (0517)] = && L_x0_0517,
+        [x0 (0425)] = && L_x0_0425,
+        [x0 (0515)] = && L_x0_0515,
+        [x0 (0415)] = && L_x0_0415,
+        [x0 (0430)] = && L_x0_0430,
+        [x0 (0411)] = && L_x0_0411,
+        [x0 (0456)] = && L_x0_0456,
+        [x0 (0713)] = && L_x0_0713,
+        [x0 (0630)] = && L_x0_0630,
+        [x0 (0614)] = && L_x0_0614,
+        [x0 (0615)] = && L_x0_0615,
+        [x0 (0602)] = && L_x0_0602,
+        [x0 (0617)] = && L_x0_0617,
+        [x0 (0605)] = && L_x0_0605,
+        [x0 (0603)] = && L_x0_0603,
+        [x1 (0601)] = && L_x1_0601,
+        [x1 (0600)] = && L_x1_0600,
+        [x0 (0715)] = && L_x0_0715,
+        [x0 (0607)] = && L_x0_0607,
+        [x1 (0606)] = && L_x1_0606,
+        [x0 (0311)] = && L_x0_0311,
+        [x1 (0310)] = && L_x1_0310,
+        [x0 (0313)] = && L_x0_0313,
+        [x1 (0312)] = && L_x1_0312,
+        [x0 (0331)] = && L_x0_0331,
+        [x1 (0330)] = && L_x1_0330,
+        [x0 (0333)] = && L_x0_0333,
+        [x1 (0332)] = && L_x1_0332,
+        [x0 (0310)] = && L_x0_0310,
+        [x1 (0311)] = && L_x1_0311,
+        [x0 (0312)] = && L_x0_0312,
+        [x1 (0313)] = && L_x1_0313,
+        [x0 (0330)] = && L_x0_0330,
+        [x1 (0331)] = && L_x1_0331,
+        [x0 (0332)] = && L_x0_0332,
+        [x1 (0333)] = && L_x1_0333,
+        [x0 (0173)] = && L_x0_0173,
+        [x0 (0254)] = && L_x0_0254,
+        [x0 (0540)] = && L_x0_0540,
+        [x0 (0541)] = && L_x0_0541,
+        [x0 (0542)] = && L_x0_0542,
+        [x0 (0543)] = && L_x0_0543,
+        [x0 (0544)] = && L_x0_0544,
+        [x0 (0545)] = && L_x0_0545,
+        [x0 (0546)] = && L_x0_0546,
+        [x0 (0547)] = && L_x0_0547,
+        [x0 (0050)] = && L_x0_0050,
+        [x0 (0051)] = && L_x0_0051,
+        [x0 (0052)] = && L_x0_0052,
+        [x0 (0053)] = && L_x0_0053,
+        [x0 (0150)] = && L_x0_0150,
+        [x0 (0151)] = && L_x0_0151,
+        [x0 (0152)] = && L_x0_0152,
+        [x0 (0153)] = && L_x0_0153,
+        [x0 (0633)] = && L_x0_0633,
+        [x0 (0002)] = && L_x0_0002,
+        [x0 (0716)] = && L_x0_0716,
+        [x0 (0717)] = && L_x0_0717,
+        [x0 (0001)] = && L_x0_0001,
+        [x0 (0004)] = && L_x0_0004,
+        [x0 (0005)] = && L_x0_0005,
+        [x0 (0007)] = && L_x0_0007,
+        [x0 (0011)] = && L_x0_0011,
+        [x0 (0012)] = && L_x0_0012,
+        [x0 (0013)] = && L_x0_0013,
+        [x0 (0560)] = && L_x0_0560,
+        [x0 (0500)] = && L_x0_0500,
+        [x0 (0520)] = && L_x0_0520,
+        [x1 (0754)] = && L_x1_0754,
+        [x0 (0550)] = && L_x0_0550,
+        [x0 (0505)] = && L_x0_0505,
+        [x0 (0774)] = && L_x0_0774,
+        [x0 (0230)] = && L_x0_0230,
+        [x0 (0674)] = && L_x0_0674,
+        [x0 (0232)] = && L_x0_0232,
+        [x0 (0637)] = && L_x0_0637,
+        [x1 (0257)] = && L_x1_0257,
+        [x1 (0173)] = && L_x1_0173,
+        [x1 (0774)] = && L_x1_0774,
+        [x0 (0257)] = && L_x0_0257,
+        [x1 (0232)] = && L_x1_0232,
+        [x0 (0613)] = && L_x0_0613,
+        [x0 (0452)] = && L_x0_0452,
+        [x0 (0657)] = && L_x0_0657,
+        [x0 (0154)] = && L_x0_0154,
+        [x1 (0557)] = && L_x1_0557,
+        [x1 (0154)] = && L_x1_0154,
+        [x0 (0557)] = && L_x0_0557,
+        [x1 (0254)] = && L_x1_0254,
+        [x1 (0532)] = && L_x1_0532,
+        [x0 (0532)] = && L_x0_0532,
+        [x0 (0233)] = && L_x0_0233,
+        [x0 (0413)] = && L_x0_0413,
+        [x0 (0231)] = && L_x0_0231,
+        [x0 (0015)] = && L_x0_0015,
+        [x0 (0553)] = && L_x0_0553,
+        [x0 (0451)] = && L_x0_0451,
+        [x0 (0057)] = && L_x0_0057,
+        [x0 (0212)] = && L_x0_0212,
+        [x0 (0616)] = && L_x0_0616,
+        [x1 (0560)] = && L_x1_0560,
+        [x1 (0561)] = && L_x1_0561,
+        [x1 (0562)] = && L_x1_0562,
+        [x1 (0563)] = && L_x1_0563,
+        [x1 (0564)] = && L_x1_0564,
+        [x1 (0565)] = && L_x1_0565,
+        [x1 (0566)] = && L_x1_0566,
+        [x1 (0567)] = && L_x1_0567,
+        [x1 (0760)] = && L_x1_0760,
+        [x1 (0761)] = && L_x1_0761,
+        [x1 (0762)] = && L_x1_0762,
+        [x1 (0763)] = && L_x1_0763,
+        [x1 (0764)] = && L_x1_0764,
+        [x1 (0765)] = && L_x1_0765,
+        [x1 (0766)] = && L_x1_0766,
+        [x1 (0767)] = && L_x1_0767,
+        [x1 (0463)] = && L_x1_0463,
+        [x1 (0467)] = && L_x1_0467,
+        [x1 (0660)] = && L_x1_0660,
+        [x1 (0661)] = && L_x1_0661,
+        [x1 (0662)] = && L_x1_0662,
+        [x1 (0663)] = && L_x1_0663,
+        [x1 (0664)] = && L_x1_0664,
+        [x1 (0665)] = && L_x1_0665,
+        [x1 (0666)] = && L_x1_0666,
+        [x1 (0667)] = && L_x1_0667,
+        [x1 (0540)] = && L_x1_0540,
+        [x1 (0541)] = && L_x1_0541,
+        [x1 (0542)] = && L_x1_0542,
+        [x1 (0543)] = && L_x1_0543,
+        [x1 (0544)] = && L_x1_0544,
+        [x1 (0545)] = && L_x1_0545,
+        [x1 (0546)] = && L_x1_0546,
+        [x1 (0547)] = && L_x1_0547,
+        [x1 (0640)] = && L_x1_0640,
+        [x1 (0641)] = && L_x1_0641,
+        [x1 (0642)] = && L_x1_0642,
+        [x1 (0643)] = && L_x1_0643,
+        [x1 (0644)] = && L_x1_0644,
+        [x1 (0645)] = && L_x1_0645,
+        [x1 (0646)] = && L_x1_0646,
+        [x1 (0647)] = && L_x1_0647,
+        [x1 (0740)] = && L_x1_0740,
+        [x1 (0741)] = && L_x1_0741,
+        [x1 (0742)] = && L_x1_0742,
+        [x1 (0743)] = && L_x1_0743,
+        [x1 (0744)] = && L_x1_0744,
+        [x1 (0745)] = && L_x1_0745,
+        [x1 (0746)] = && L_x1_0746,
+        [x1 (0747)] = && L_x1_0747,
+        [x1 (0443)] = && L_x1_0443,
+        [x1 (0447)] = && L_x1_0447,
+        [x1 (0502)] = && L_x1_0502,
+        [x1 (0501)] = && L_x1_0501,
+        [x1 (0500)] = && L_x1_0500,
+        [x1 (0503)] = && L_x1_0503,
+        [x1 (0507)] = && L_x1_0507,
+        [x1 (0522)] = && L_x1_0522,
+        [x1 (0521)] = && L_x1_0521,
+        [x1 (0520)] = && L_x1_0520,
+        [x1 (0523)] = && L_x1_0523,
+        [x1 (0527)] = && L_x1_0527,
+        [x1 (0106)] = && L_x1_0106,
+        [x1 (0120)] = && L_x1_0120,
+        [x1 (0121)] = && L_x1_0121,
+        [x1 (0124)] = && L_x1_0124,
+        [x1 (0125)] = && L_x1_0125,
+        [x1 (0164)] = && L_x1_0164,
+        [x1 (0165)] = && L_x1_0165,
+        [x1 (0100)] = && L_x1_0100,
+        [x1 (0101)] = && L_x1_0101,
+        [x1 (0020)] = && L_x1_0020,
+        [x1 (0160)] = && L_x1_0160,
+        [x1 (0303)] = && L_x1_0303,
+        [x1 (0300)] = && L_x1_0300,
+        [x1 (0024)] = && L_x1_0024,
+        [x1 (0060)] = && L_x1_0060,
+        [x1 (0061)] = && L_x1_0061,
+        [x1 (0066)] = && L_x1_0066,
+        [x1 (0064)] = && L_x1_0064,
+        [x1 (0065)] = && L_x1_0065,
+        [x1 (0301)] = && L_x1_0301,
+        [x1 (0305)] = && L_x1_0305,
+        [x1 (0202)] = && L_x1_0202,
+        [x1 (0222)] = && L_x1_0222,
+        [x1 (0203)] = && L_x1_0203,
+        [x1 (0223)] = && L_x1_0223,
+        [x1 (0206)] = && L_x1_0206,
+        [x1 (0226)] = && L_x1_0226,
+        [x1 (0207)] = && L_x1_0207,
+        [x1 (0227)] = && L_x1_0227,
+#ifdef TESTING
+#if EMULATOR_ONLY
+        [x1 (0420)] = && L_x1_0420,
+#endif
+#endif
+      };
+
+    if (likely (! cpu.switches.dispatch_switch))
+      goto * dispatch_table [opcode10];
+dispatch_switch:
+#endif
+
     switch (opcode10)
       {
 
@@ -2855,14 +3520,14 @@ static t_stat doInstruction (void)
 //                   1: ret
 //                   1: drl
 
-        case x0 (0350):  // epp0
-        case x1 (0351):  // epp1
-        case x0 (0352):  // epp2
-        case x1 (0353):  // epp3
-        case x0 (0370):  // epp4
-        case x1 (0371):  // epp5
-        case x0 (0372):  // epp6
-        case x1 (0373):  // epp7
+        case x0 (0350): OPLABEL (x0, 0350)  // epp0
+        case x1 (0351): OPLABEL (x1, 0351)  // epp1
+        case x0 (0352): OPLABEL (x0, 0352)  // epp2
+        case x1 (0353): OPLABEL (x1, 0353)  // epp3
+        case x0 (0370): OPLABEL (x0, 0370)  // epp4
+        case x1 (0371): OPLABEL (x1, 0371)  // epp5
+        case x0 (0372): OPLABEL (x0, 0372)  // epp6
+        case x1 (0373): OPLABEL (x1, 0373)  // epp7
           // For n = 0, 1, ..., or 7 as determined by operation code
           //   C(TPR.TRR) -> C(PRn.RNR)
           //   C(TPR.TSR) -> C(PRn.SNR)
@@ -2888,14 +3553,14 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0250):  // spri0
-        case x1 (0251):  // spri1
-        case x0 (0252):  // spri2
-        case x1 (0253):  // spri3
-        case x0 (0650):  // spri4
-        case x1 (0651):  // spri5
-        case x0 (0652):  // spri6
-        case x1 (0653):  // spri7
+        case x0 (0250): OPLABEL (x0, 0250)  // spri0
+        case x1 (0251): OPLABEL (x1, 0251)  // spri1
+        case x0 (0252): OPLABEL (x0, 0252)  // spri2
+        case x1 (0253): OPLABEL (x1, 0253)  // spri3
+        case x0 (0650): OPLABEL (x0, 0650)  // spri4
+        case x1 (0651): OPLABEL (x1, 0651)  // spri5
+        case x0 (0652): OPLABEL (x0, 0652)  // spri6
+        case x1 (0653): OPLABEL (x1, 0653)  // spri7
 
           // For n = 0, 1, ..., or 7 as determined by operation code
           //  000 -> C(Y-pair)0,2
@@ -2928,28 +3593,28 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0235):  // lda
+        case x0 (0235): OPLABEL (x0, 0235)  // lda
           cpu.rA = cpu.CY;
           HDBGRegA ();
           SC_I_ZERO (cpu.rA == 0);
           SC_I_NEG (cpu.rA & SIGN36);
           break;
 
-        case x0 (0710):  // tra
+        case x0 (0710): OPLABEL (x0, 0710)  // tra
           // C(TPR.CA) -> C(PPR.IC)
           // C(TPR.TSR) -> C(PPR.PSR)
           do_caf ();
           read_tra_op ();
           return CONT_TRA;
 
-        case x0 (0236):  // ldq
+        case x0 (0236): OPLABEL (x0, 0236)  // ldq
           cpu.rQ = cpu.CY;
           HDBGRegQ ();
           SC_I_ZERO (cpu.rQ == 0);
           SC_I_NEG (cpu.rQ & SIGN36);
           break;
 
-        case x0 (0600):  // tze
+        case x0 (0600): OPLABEL (x0, 0600)  // tze
           // If zero indicator ON then
           //   C(TPR.CA) -> C(PPR.IC)
           //   C(TPR.TSR) -> C(PPR.PSR)
@@ -2962,7 +3627,7 @@ static t_stat doInstruction (void)
             }
           break;
 
-        case x0 (0601):  // tnz
+        case x0 (0601): OPLABEL (x0, 0601)  // tnz
           // If zero indicator OFF then
           //     C(TPR.CA) -> C(PPR.IC)
           //     C(TPR.TSR) -> C(PPR.PSR)
@@ -2974,17 +3639,17 @@ static t_stat doInstruction (void)
             }
           break;
 
-        case x0 (0756): // stq
+        case x0 (0756): OPLABEL (x0, 0756) // stq
           cpu.CY = cpu.rQ;
           HDBGRegQ ();
           break;
 
-        case x0 (0116):  // cmpq
+        case x0 (0116): OPLABEL (x0, 0116)  // cmpq
           // C(Q) :: C(Y)
           cmp36 (cpu.rQ, cpu.CY, &cpu.cu.IR);
           break;
 
-        case x0 (0377):  //< anaq
+        case x0 (0377): OPLABEL (x0, 0377)  //< anaq
           // C(AQ)i & C(Y-pair)i -> C(AQ)i for i = (0, 1, ..., 71)
           {
               word72 tmp72 = YPAIRTO72 (cpu.Ypair);
@@ -3008,20 +3673,20 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0755):  // sta
+        case x0 (0755): OPLABEL (x0, 0755)  // sta
           cpu.CY = cpu.rA;
           HDBGRegA ();
           break;
 
                          // lprpn
-        case x0 (0760):  // lprp0
-        case x0 (0761):  // lprp1
-        case x0 (0762):  // lprp2
-        case x0 (0763):  // lprp3
-        case x0 (0764):  // lprp4
-        case x0 (0765):  // lprp5
-        case x0 (0766):  // lprp6
-        case x0 (0767):  // lprp7
+        case x0 (0760): OPLABEL (x0, 0760)  // lprp0
+        case x0 (0761): OPLABEL (x0, 0761)  // lprp1
+        case x0 (0762): OPLABEL (x0, 0762)  // lprp2
+        case x0 (0763): OPLABEL (x0, 0763)  // lprp3
+        case x0 (0764): OPLABEL (x0, 0764)  // lprp4
+        case x0 (0765): OPLABEL (x0, 0765)  // lprp5
+        case x0 (0766): OPLABEL (x0, 0766)  // lprp6
+        case x0 (0767): OPLABEL (x0, 0767)  // lprp7
           // For n = 0, 1, ..., or 7 as determined by operation code
           //  C(TPR.TRR) -> C(PRn.RNR)
           //  If C(Y)0,1 != 11, then
@@ -3092,14 +3757,14 @@ static t_stat doInstruction (void)
           break;
 
                          // eaxn
-        case x0 (0620):  // eax0
-        case x0 (0621):  // eax1
-        case x0 (0622):  // eax2
-        case x0 (0623):  // eax3
-        case x0 (0624):  // eax4
-        case x0 (0625):  // eax5
-        case x0 (0626):  // eax6
-        case x0 (0627):  // eax7
+        case x0 (0620): OPLABEL (x0, 0620)  // eax0
+        case x0 (0621): OPLABEL (x0, 0621)  // eax1
+        case x0 (0622): OPLABEL (x0, 0622)  // eax2
+        case x0 (0623): OPLABEL (x0, 0623)  // eax3
+        case x0 (0624): OPLABEL (x0, 0624)  // eax4
+        case x0 (0625): OPLABEL (x0, 0625)  // eax5
+        case x0 (0626): OPLABEL (x0, 0626)  // eax6
+        case x0 (0627): OPLABEL (x0, 0627)  // eax7
           {
             uint32 n = opcode10 & 07;  // get n
             cpu.rX[n] = cpu.TPR.CA;
@@ -3112,14 +3777,14 @@ static t_stat doInstruction (void)
           break;
 
                          // tsxn
-        case x0 (0700):  // tsx0
-        case x0 (0701):  // tsx1
-        case x0 (0702):  // tsx2
-        case x0 (0703):  // tsx3
-        case x0 (0704):  // tsx4
-        case x0 (0705):  // tsx5
-        case x0 (0706):  // tsx6
-        case x0 (0707):  // tsx7
+        case x0 (0700): OPLABEL (x0, 0700)  // tsx0
+        case x0 (0701): OPLABEL (x0, 0701)  // tsx1
+        case x0 (0702): OPLABEL (x0, 0702)  // tsx2
+        case x0 (0703): OPLABEL (x0, 0703)  // tsx3
+        case x0 (0704): OPLABEL (x0, 0704)  // tsx4
+        case x0 (0705): OPLABEL (x0, 0705)  // tsx5
+        case x0 (0706): OPLABEL (x0, 0706)  // tsx6
+        case x0 (0707): OPLABEL (x0, 0707)  // tsx7
           // For n = 0, 1, ..., or 7 as determined by operation code
           //   C(PPR.IC) + 1 -> C(Xn)
           // C(TPR.CA) -> C(PPR.IC)
@@ -3134,19 +3799,19 @@ static t_stat doInstruction (void)
           }
           return CONT_TRA;
 
-        case x0 (0450): // stz
+        case x0 (0450): OPLABEL (x0, 0450) // stz
           cpu.CY = 0;
           break;
 
                          // epbpn
-        case x1 (0350):  // epbp0
-        case x0 (0351):  // epbp1
-        case x1 (0352):  // epbp2
-        case x0 (0353):  // epbp3
-        case x1 (0370):  // epbp4
-        case x0 (0371):  // epbp5
-        case x1 (0372):  // epbp6
-        case x0 (0373):  // epbp7
+        case x1 (0350): OPLABEL (x1, 0350)  // epbp0
+        case x0 (0351): OPLABEL (x0, 0351)  // epbp1
+        case x1 (0352): OPLABEL (x1, 0352)  // epbp2
+        case x0 (0353): OPLABEL (x0, 0353)  // epbp3
+        case x1 (0370): OPLABEL (x1, 0370)  // epbp4
+        case x0 (0371): OPLABEL (x0, 0371)  // epbp5
+        case x1 (0372): OPLABEL (x1, 0372)  // epbp6
+        case x0 (0373): OPLABEL (x0, 0373)  // epbp7
           // For n = 0, 1, ..., or 7 as determined by operation code
           //  C(TPR.TRR) -> C(PRn.RNR)
           //  C(TPR.TSR) -> C(PRn.SNR)
@@ -3172,12 +3837,12 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0115):  // cmpa
+        case x0 (0115): OPLABEL (x0, 0115)  // cmpa
           // C(A) :: C(Y)
           cmp36 (cpu.rA, cpu.CY, &cpu.cu.IR);
           break;
 
-        case x0 (0054):   // aos
+        case x0 (0054): OPLABEL (x0, 0054)   // aos
           {
             // C(Y)+1->C(Y)
 
@@ -3195,7 +3860,7 @@ static t_stat doInstruction (void)
           break;
 
 
-        case x0 (0315):  // cana
+        case x0 (0315): OPLABEL (x0, 0315)  // cana
           // C(Z)i = C(A)i & C(Y)i for i = (0, 1, ..., 35)
           {
             word36 trZ = cpu.rA & cpu.CY;
@@ -3206,7 +3871,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0237):  // ldaq
+        case x0 (0237): OPLABEL (x0, 0237)  // ldaq
           cpu.rA = cpu.Ypair[0];
           HDBGRegA ();
           cpu.rQ = cpu.Ypair[1];
@@ -3215,7 +3880,7 @@ static t_stat doInstruction (void)
           SC_I_NEG (cpu.rA & SIGN36);
           break;
 
-        case x1 (0605):  // tpnz
+        case x1 (0605): OPLABEL (x1, 0605)  // tpnz
             // If negative and zero indicators are OFF then
             //  C(TPR.CA) -> C(PPR.IC)
             //  C(TPR.TSR) -> C(PPR.PSR)
@@ -3228,14 +3893,14 @@ static t_stat doInstruction (void)
             break;
 
                          // lxln
-        case x0 (0720):  // lxl0
-        case x0 (0721):  // lxl1
-        case x0 (0722):  // lxl2
-        case x0 (0723):  // lxl3
-        case x0 (0724):  // lxl4
-        case x0 (0725):  // lxl5
-        case x0 (0726):  // lxl6
-        case x0 (0727):  // lxl7
+        case x0 (0720): OPLABEL (x0, 0720)  // lxl0
+        case x0 (0721): OPLABEL (x0, 0721)  // lxl1
+        case x0 (0722): OPLABEL (x0, 0722)  // lxl2
+        case x0 (0723): OPLABEL (x0, 0723)  // lxl3
+        case x0 (0724): OPLABEL (x0, 0724)  // lxl4
+        case x0 (0725): OPLABEL (x0, 0725)  // lxl5
+        case x0 (0726): OPLABEL (x0, 0726)  // lxl6
+        case x0 (0727): OPLABEL (x0, 0727)  // lxl7
           {
             uint32 n = opcode10 & 07;  // get n
             cpu.rX[n] = GETLO (cpu.CY);
@@ -3245,20 +3910,20 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0757):  // staq
+        case x0 (0757): OPLABEL (x0, 0757)  // staq
           cpu.Ypair[0] = cpu.rA;
           cpu.Ypair[1] = cpu.rQ;
           break;
 
                          // tspn
-        case x0 (0270):  // tsp0
-        case x0 (0271):  // tsp1
-        case x0 (0272):  // tsp2
-        case x0 (0273):  // tsp3
-        case x0 (0670):  // tsp4
-        case x0 (0671):  // tsp5
-        case x0 (0672):  // tsp6
-        case x0 (0673):  // tsp7
+        case x0 (0270): OPLABEL (x0, 0270)  // tsp0
+        case x0 (0271): OPLABEL (x0, 0271)  // tsp1
+        case x0 (0272): OPLABEL (x0, 0272)  // tsp2
+        case x0 (0273): OPLABEL (x0, 0273)  // tsp3
+        case x0 (0670): OPLABEL (x0, 0670)  // tsp4
+        case x0 (0671): OPLABEL (x0, 0671)  // tsp5
+        case x0 (0672): OPLABEL (x0, 0672)  // tsp6
+        case x0 (0673): OPLABEL (x0, 0673)  // tsp7
           // For n = 0, 1, ..., or 7 as determined by operation code
           //  C(PPR.PRR) -> C(PRn.RNR)
           //  C(PPR.PSR) -> C(PRn.SNR)
@@ -3282,7 +3947,7 @@ static t_stat doInstruction (void)
           }
           return CONT_TRA;
 
-        case x0 (0735):  // als
+        case x0 (0735): OPLABEL (x0, 0735)  // als
           {
             word36 tmp36 = cpu.TPR.CA & 0177;   // CY bits 11-17
 
@@ -3303,7 +3968,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0610):  // rtcd
+        case x0 (0610): OPLABEL (x0, 0610)  // rtcd
           // If an access violation fault occurs when fetching the SDW for
           // the Y-pair, the C(PPR.PSR) and C(PPR.PRR) are not altered.
 
@@ -3314,7 +3979,7 @@ static t_stat doInstruction (void)
             
           return CONT_RET;
 
-        case x0 (0604):  // tmi
+        case x0 (0604): OPLABEL (x0, 0604)  // tmi
           // If negative indicator ON then
           //  C(TPR.CA) -> C(PPR.IC)
           //  C(TPR.TSR) -> C(PPR.PSR)
@@ -3327,14 +3992,14 @@ static t_stat doInstruction (void)
           break;
 
                          // stxn
-        case x0 (0740):  // stx0
-        case x0 (0741):  // stx1
-        case x0 (0742):  // stx2
-        case x0 (0743):  // stx3
-        case x0 (0744):  // stx4
-        case x0 (0745):  // stx5
-        case x0 (0746):  // stx6
-        case x0 (0747):  // stx7
+        case x0 (0740): OPLABEL (x0, 0740)  // stx0
+        case x0 (0741): OPLABEL (x0, 0741)  // stx1
+        case x0 (0742): OPLABEL (x0, 0742)  // stx2
+        case x0 (0743): OPLABEL (x0, 0743)  // stx3
+        case x0 (0744): OPLABEL (x0, 0744)  // stx4
+        case x0 (0745): OPLABEL (x0, 0745)  // stx5
+        case x0 (0746): OPLABEL (x0, 0746)  // stx6
+        case x0 (0747): OPLABEL (x0, 0747)  // stx7
           {
             uint32 n = opcode10 & 07;  // get n
             //SETHI (cpu.CY, cpu.rX[n]);
@@ -3347,7 +4012,7 @@ static t_stat doInstruction (void)
 #endif
           break;
 
-        case x0 (0634):  // ldi
+        case x0 (0634): OPLABEL (x0, 0634)  // ldi
           {
             CPTUR (cptUseIR);
             // C(Y)18,31 -> C(IR)
@@ -3422,7 +4087,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0677):  // eraq
+        case x0 (0677): OPLABEL (x0, 0677)  // eraq
           // C(AQ)i XOR C(Y-pair)i -> C(AQ)i for i = (0, 1, ..., 71)
           {
             word72 tmp72 = YPAIRTO72 (cpu.Ypair);
@@ -3447,7 +4112,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0275):  // ora
+        case x0 (0275): OPLABEL (x0, 0275)  // ora
           // C(A)i | C(Y)i -> C(A)i for i = (0, 1, ..., 35)
           cpu.rA = cpu.rA | cpu.CY;
           cpu.rA &= DMASK;
@@ -3457,7 +4122,7 @@ static t_stat doInstruction (void)
           SC_I_NEG (cpu.rA & SIGN36);
           break;
 
-        case x0 (0076):   // adq
+        case x0 (0076): OPLABEL (x0, 0076)   // adq
           {
 #ifdef L68
             cpu.ou.cycle |= ou_GOS;
@@ -3470,7 +4135,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x1 (0604):  // tmoz
+        case x1 (0604): OPLABEL (x1, 0604)  // tmoz
             // If negative or zero indicator ON then
             // C(TPR.CA) -> C(PPR.IC)
             // C(TPR.TSR) -> C(PPR.PSR)
@@ -3483,14 +4148,14 @@ static t_stat doInstruction (void)
             break;
 
 
-        case x1 (0250):  // spbp0
-        case x0 (0251):  // spbp1
-        case x1 (0252):  // spbp2
-        case x0 (0253):  // spbp3
-        case x1 (0650):  // spbp4
-        case x0 (0651):  // spbp5
-        case x1 (0652):  // spbp6
-        case x0 (0653):  // spbp7
+        case x1 (0250): OPLABEL (x1, 0250)  // spbp0
+        case x0 (0251): OPLABEL (x0, 0251)  // spbp1
+        case x1 (0252): OPLABEL (x1, 0252)  // spbp2
+        case x0 (0253): OPLABEL (x0, 0253)  // spbp3
+        case x1 (0650): OPLABEL (x1, 0650)  // spbp4
+        case x0 (0651): OPLABEL (x0, 0651)  // spbp5
+        case x1 (0652): OPLABEL (x1, 0652)  // spbp6
+        case x0 (0653): OPLABEL (x0, 0653)  // spbp7
             // For n = 0, 1, ..., or 7 as determined by operation code
             //  C(PRn.SNR) -> C(Y-pair)3,17
             //  C(PRn.RNR) -> C(Y-pair)18,20
@@ -3516,7 +4181,7 @@ static t_stat doInstruction (void)
             }
             break;
 
-        case x0 (0375):  // ana
+        case x0 (0375): OPLABEL (x0, 0375)  // ana
           // C(A)i & C(Y)i -> C(A)i for i = (0, 1, ..., 35)
           cpu.rA = cpu.rA & cpu.CY;
           cpu.rA &= DMASK;
@@ -3525,7 +4190,7 @@ static t_stat doInstruction (void)
           SC_I_NEG (cpu.rA & SIGN36);
           break;
 
-        case x0 (0431):  // fld
+        case x0 (0431): OPLABEL (x0, 0431)  // fld
           // C(Y)0,7 -> C(E)
           // C(Y)8,35 -> C(AQ)0,27
           // 00...0 -> C(AQ)30,71
@@ -3544,7 +4209,7 @@ static t_stat doInstruction (void)
           SC_I_NEG (cpu.rA & SIGN36);
           break;
 
-        case x0 (0213):  // epaq
+        case x0 (0213): OPLABEL (x0, 0213)  // epaq
           // 000 -> C(AQ)0,2
           // C(TPR.TSR) -> C(AQ)3,17
           // 00...0 -> C(AQ)18,32
@@ -3566,7 +4231,7 @@ static t_stat doInstruction (void)
 
           break;
 
-        case x0 (0736):  // qls
+        case x0 (0736): OPLABEL (x0, 0736)  // qls
           // Shift C(Q) left the number of positions given in
           // C(TPR.CA)11,17; fill vacated positions with zeros.
           {
@@ -3588,7 +4253,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0754): // sti
+        case x0 (0754): OPLABEL (x0, 0754) // sti
 
           // C(IR) -> C(Y)18,31
           // 00...0 -> C(Y)32,35
@@ -3623,7 +4288,7 @@ static t_stat doInstruction (void)
 
         /// Fixed-Point Data Movement Load
 
-        case x0 (0635):  // eaa
+        case x0 (0635): OPLABEL (x0, 0635)  // eaa
           cpu.rA = 0;
           SETHI (cpu.rA, cpu.TPR.CA);
           HDBGRegA ();
@@ -3632,7 +4297,7 @@ static t_stat doInstruction (void)
 
           break;
 
-        case x0 (0636):  // eaq
+        case x0 (0636): OPLABEL (x0, 0636)  // eaq
           cpu.rQ = 0;
           SETHI (cpu.rQ, cpu.TPR.CA);
           HDBGRegQ ();
@@ -3652,7 +4317,7 @@ static t_stat doInstruction (void)
 //        case x0 (0626):  // eax6
 //        case x0 (0627):  // eax7
 
-        case x0 (0335):  // lca
+        case x0 (0335): OPLABEL (x0, 0335)  // lca
           {
             bool ovf;
             cpu.rA = compl36 (cpu.CY, & cpu.cu.IR, & ovf);
@@ -3661,7 +4326,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0336):  // lcq
+        case x0 (0336): OPLABEL (x0, 0336)  // lcq
           {
             bool ovf;
             cpu.rQ = compl36 (cpu.CY, & cpu.cu.IR, & ovf);
@@ -3671,14 +4336,14 @@ static t_stat doInstruction (void)
           break;
 
                          // lcxn
-        case x0 (0320):  // lcx0
-        case x0 (0321):  // lcx1
-        case x0 (0322):  // lcx2
-        case x0 (0323):  // lcx3
-        case x0 (0324):  // lcx4
-        case x0 (0325):  // lcx5
-        case x0 (0326):  // lcx6
-        case x0 (0327):  // lcx7
+        case x0 (0320): OPLABEL (x0, 0320)  // lcx0
+        case x0 (0321): OPLABEL (x0, 0321)  // lcx1
+        case x0 (0322): OPLABEL (x0, 0322)  // lcx2
+        case x0 (0323): OPLABEL (x0, 0323)  // lcx3
+        case x0 (0324): OPLABEL (x0, 0324)  // lcx4
+        case x0 (0325): OPLABEL (x0, 0325)  // lcx5
+        case x0 (0326): OPLABEL (x0, 0326)  // lcx6
+        case x0 (0327): OPLABEL (x0, 0327)  // lcx7
           {
             bool ovf;
             uint32 n = opcode10 & 07;  // get n
@@ -3688,7 +4353,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0337):  // lcaq
+        case x0 (0337): OPLABEL (x0, 0337)  // lcaq
           {
             // The lcaq instruction changes the number to its negative while
             // moving it from Y-pair to AQ. The operation is executed by
@@ -3738,7 +4403,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //        case x0 (0235):  // lda
 
-        case x0 (0034): // ldac
+        case x0 (0034): OPLABEL (x0, 0034) // ldac
           cpu.rA = cpu.CY;
           HDBGRegA ();
           SC_I_ZERO (cpu.rA == 0);
@@ -3758,7 +4423,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //         case x0 (0236):  // ldq
 
-        case x0 (0032): // ldqc
+        case x0 (0032): OPLABEL (x0, 0032) // ldqc
           cpu.rQ = cpu.CY;
           HDBGRegQ ();
           SC_I_ZERO (cpu.rQ == 0);
@@ -3770,14 +4435,14 @@ static t_stat doInstruction (void)
           break;
 
                          // ldxn
-        case x0 (0220):  // ldx0
-        case x0 (0221):  // ldx1
-        case x0 (0222):  // ldx2
-        case x0 (0223):  // ldx3
-        case x0 (0224):  // ldx4
-        case x0 (0225):  // ldx5
-        case x0 (0226):  // ldx6
-        case x0 (0227):  // ldx7
+        case x0 (0220): OPLABEL (x0, 0220)  // ldx0
+        case x0 (0221): OPLABEL (x0, 0221)  // ldx1
+        case x0 (0222): OPLABEL (x0, 0222)  // ldx2
+        case x0 (0223): OPLABEL (x0, 0223)  // ldx3
+        case x0 (0224): OPLABEL (x0, 0224)  // ldx4
+        case x0 (0225): OPLABEL (x0, 0225)  // ldx5
+        case x0 (0226): OPLABEL (x0, 0226)  // ldx6
+        case x0 (0227): OPLABEL (x0, 0227)  // ldx7
           {
             uint32 n = opcode10 & 07;  // get n
             cpu.rX[n] = GETHI (cpu.CY);
@@ -3787,7 +4452,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0073):   // lreg
+        case x0 (0073): OPLABEL (x0, 0073)   // lreg
           CPTUR (cptUseE);
 #ifdef L68
           cpu.ou.cycle |= ou_GOS;
@@ -3841,7 +4506,7 @@ static t_stat doInstruction (void)
 
         /// Fixed-Point Data Movement Store
 
-        case x0 (0753):  // sreg
+        case x0 (0753): OPLABEL (x0, 0753)  // sreg
           CPTUR (cptUseE);
           CPTUR (cptUseRALR);
           // clear block (changed to memset() per DJ request)
@@ -3889,7 +4554,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //        case x0 (0755):  // sta
 
-        case x0 (0354):  // stac
+        case x0 (0354): OPLABEL (x0, 0354)  // stac
           if (cpu.CY == 0)
             {
               SET_I_ZERO;
@@ -3902,7 +4567,7 @@ static t_stat doInstruction (void)
 #endif
           break;
 
-        case x0 (0654):  // stacq
+        case x0 (0654): OPLABEL (x0, 0654)  // stacq
           if (cpu.CY == cpu.rQ)
             {
               cpu.CY = cpu.rA;
@@ -3918,7 +4583,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //        case x0 (0757):  // staq
 
-        case x0 (0551):  // stba
+        case x0 (0551): OPLABEL (x0, 0551)  // stba
           // 9-bit bytes of C(A) -> corresponding bytes of C(Y), the byte
           // positions affected being specified in the TAG field.
           //copyBytes ((i->tag >> 2) & 0xf, cpu.rA, &cpu.CY);
@@ -3935,7 +4600,7 @@ static t_stat doInstruction (void)
 #endif
           break;
 
-        case x0 (0552):  // stbq
+        case x0 (0552): OPLABEL (x0, 0552)  // stbq
           // 9-bit bytes of C(Q) -> corresponding bytes of C(Y), the byte
           // positions affected being specified in the TAG field.
           //copyBytes ((i->tag >> 2) & 0xf, cpu.rQ, &cpu.CY);
@@ -3952,7 +4617,7 @@ static t_stat doInstruction (void)
 #endif
           break;
 
-        case x0 (0554):  // stc1
+        case x0 (0554): OPLABEL (x0, 0554)  // stc1
           // "C(Y)25 reflects the state of the tally runout indicator
           // prior to modification.
           SETHI (cpu.CY, (cpu.PPR.IC + 1) & MASK18);
@@ -3967,7 +4632,7 @@ static t_stat doInstruction (void)
           SCF (i->stiTally, cpu.CY, I_TALLY);
           break;
 
-        case x0 (0750):  // stc2
+        case x0 (0750): OPLABEL (x0, 0750)  // stc2
           // AL-39 doesn't specify if the low half is set to zero,
           // set to IR, or left unchanged
           // RJ78 specifies unchanged
@@ -3980,7 +4645,7 @@ static t_stat doInstruction (void)
 #endif
           break;
 
-        case x0 (0751): // stca
+        case x0 (0751): OPLABEL (x0, 0751) // stca
           // Characters of C(A) -> corresponding characters of C(Y),
           // the character positions affected being specified in the TAG
           // field.
@@ -4000,7 +4665,7 @@ static t_stat doInstruction (void)
 #endif
           break;
 
-        case x0 (0752): // stcq
+        case x0 (0752): OPLABEL (x0, 0752) // stcq
           // Characters of C(Q) -> corresponding characters of C(Y), the
           // character positions affected being specified in the TAG field.
           //copyChars (i->tag, cpu.rQ, &cpu.CY);
@@ -4019,7 +4684,7 @@ static t_stat doInstruction (void)
 #endif
           break;
 
-        case x0 (0357): //< stcd
+        case x0 (0357): OPLABEL (x0, 0357) //< stcd
           // C(PPR) -> C(Y-pair) as follows:
 
           //  000 -> C(Y-pair)0,2
@@ -4065,7 +4730,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //         case x0 (0756): // stq
 
-        case x0 (0454):  // stt
+        case x0 (0454): OPLABEL (x0, 0454)  // stt
           CPTUR (cptUseTR);
 #ifdef ISOLTS
           if (current_running_cpu_idx)
@@ -4093,14 +4758,14 @@ static t_stat doInstruction (void)
 //        case x0 (0450): // stz
 
                          // sxln
-        case x0 (0440):  // sxl0
-        case x0 (0441):  // sxl1
-        case x0 (0442):  // sxl2
-        case x0 (0443):  // sxl3
-        case x0 (0444):  // sxl4
-        case x0 (0445):  // sxl5
-        case x0 (0446):  // sxl6
-        case x0 (0447):  // sxl7
+        case x0 (0440): OPLABEL (x0, 0440)  // sxl0
+        case x0 (0441): OPLABEL (x0, 0441)  // sxl1
+        case x0 (0442): OPLABEL (x0, 0442)  // sxl2
+        case x0 (0443): OPLABEL (x0, 0443)  // sxl3
+        case x0 (0444): OPLABEL (x0, 0444)  // sxl4
+        case x0 (0445): OPLABEL (x0, 0445)  // sxl5
+        case x0 (0446): OPLABEL (x0, 0446)  // sxl6
+        case x0 (0447): OPLABEL (x0, 0447)  // sxl7
           //SETLO (cpu.CY, cpu.rX[opcode10 & 07]);
           cpu.CY = cpu.rX[opcode10 & 07];
           cpu.zone = 0000000777777;
@@ -4109,7 +4774,7 @@ static t_stat doInstruction (void)
 
         /// Fixed-Point Data Movement Shift
 
-        case x0 (0775):  // alr
+        case x0 (0775): OPLABEL (x0, 0775)  // alr
           {
               word36 tmp36 = cpu.TPR.CA & 0177;   // CY bits 11-17
               for (uint j = 0 ; j < tmp36 ; j++)
@@ -4130,7 +4795,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //        case x0 (0735):  // als
 
-        case x0 (0771):  // arl
+        case x0 (0771): OPLABEL (x0, 0771)  // arl
           // Shift C(A) right the number of positions given in
           // C(TPR.CA)11,17; filling vacated positions with zeros.
           {
@@ -4146,7 +4811,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0731):  // ars
+        case x0 (0731): OPLABEL (x0, 0731)  // ars
           {
             // Shift C(A) right the number of positions given in
             // C(TPR.CA)11,17; filling vacated positions with initial C(A)0.
@@ -4169,7 +4834,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0777):  // llr
+        case x0 (0777): OPLABEL (x0, 0777)  // llr
           // Shift C(AQ) left by the number of positions given in
           // C(TPR.CA)11,17; entering each bit leaving AQ0 into AQ71.
 
@@ -4201,7 +4866,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0737):  // lls
+        case x0 (0737): OPLABEL (x0, 0737)  // lls
           {
             // Shift C(AQ) left the number of positions given in
             // C(TPR.CA)11,17; filling vacated positions with zeros.
@@ -4234,7 +4899,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0773):  // lrl
+        case x0 (0773): OPLABEL (x0, 0773)  // lrl
           // Shift C(AQ) right the number of positions given in
           // C(TPR.CA)11,17; filling vacated positions with zeros.
           {
@@ -4261,7 +4926,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0733):  // lrs
+        case x0 (0733): OPLABEL (x0, 0733)  // lrs
           {
             // Shift C(AQ) right the number of positions given in
             // C(TPR.CA)11,17; filling vacated positions with initial C(AQ)0.
@@ -4293,7 +4958,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0776):  // qlr
+        case x0 (0776): OPLABEL (x0, 0776)  // qlr
           // Shift C(Q) left the number of positions given in
           // C(TPR.CA)11,17; entering each bit leaving Q0 into Q35.
           {
@@ -4316,7 +4981,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //        case x0 (0736):  // qls
 
-        case x0 (0772):  // qrl
+        case x0 (0772): OPLABEL (x0, 0772)  // qrl
           // Shift C(Q) right the number of positions specified by
           // Y11,17; fill vacated positions with zeros.
           {
@@ -4333,7 +4998,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0732):  // qrs
+        case x0 (0732): OPLABEL (x0, 0732)  // qrs
           {
             // Shift C(Q) right the number of positions given in
             // C(TPR.CA)11,17; filling vacated positions with initial C(Q)0.
@@ -4357,7 +5022,7 @@ static t_stat doInstruction (void)
 
         /// Fixed-Point Addition
 
-        case x0 (0075):  // ada
+        case x0 (0075): OPLABEL (x0, 0075)  // ada
           {
             // C(A) + C(Y) -> C(A)
             // Modifications: All
@@ -4381,7 +5046,7 @@ static t_stat doInstruction (void)
 #endif
           break;
 
-        case x0 (0077):   // adaq
+        case x0 (0077): OPLABEL (x0, 0077)   // adaq
           {
             // C(AQ) + C(Y-pair) -> C(AQ)
 #ifdef L68
@@ -4398,7 +5063,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0033):   // adl
+        case x0 (0033): OPLABEL (x0, 0033)   // adl
           {
             // C(AQ) + C(Y) sign extended -> C(AQ)
 #ifdef L68
@@ -4417,7 +5082,7 @@ static t_stat doInstruction (void)
           break;
 
 
-        case x0 (0037):   // adlaq
+        case x0 (0037): OPLABEL (x0, 0037)   // adlaq
           {
             // The adlaq instruction is identical to the adaq instruction with
             // the exception that the overflow indicator is not affected by the
@@ -4437,7 +5102,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0035):   // adla
+        case x0 (0035): OPLABEL (x0, 0035)   // adla
           {
 #ifdef L68
             cpu.ou.cycle |= ou_GOS;
@@ -4453,7 +5118,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0036):   // adlq
+        case x0 (0036): OPLABEL (x0, 0036)   // adlq
           {
             // The adlq instruction is identical to the adq instruction with
             // the exception that the overflow indicator is not affected by the
@@ -4470,14 +5135,14 @@ static t_stat doInstruction (void)
           break;
 
                           // adlxn
-        case x0 (0020):   // adlx0
-        case x0 (0021):   // adlx1
-        case x0 (0022):   // adlx2
-        case x0 (0023):   // adlx3
-        case x0 (0024):   // adlx4
-        case x0 (0025):   // adlx5
-        case x0 (0026):   // adlx6
-        case x0 (0027):   // adlx7
+        case x0 (0020): OPLABEL (x0, 0020)   // adlx0
+        case x0 (0021): OPLABEL (x0, 0021)   // adlx1
+        case x0 (0022): OPLABEL (x0, 0022)   // adlx2
+        case x0 (0023): OPLABEL (x0, 0023)   // adlx3
+        case x0 (0024): OPLABEL (x0, 0024)   // adlx4
+        case x0 (0025): OPLABEL (x0, 0025)   // adlx5
+        case x0 (0026): OPLABEL (x0, 0026)   // adlx6
+        case x0 (0027): OPLABEL (x0, 0027)   // adlx7
           {
 #ifdef L68
             cpu.ou.cycle |= ou_GOS;
@@ -4494,14 +5159,14 @@ static t_stat doInstruction (void)
 //        case x0 (0076):   // adq
 
                           // adxn
-        case x0 (0060):   // adx0
-        case x0 (0061):   // adx1
-        case x0 (0062):   // adx2
-        case x0 (0063):   // adx3
-        case x0 (0064):   // adx4
-        case x0 (0065):   // adx5
-        case x0 (0066):   // adx6
-        case x0 (0067):   // adx7
+        case x0 (0060): OPLABEL (x0, 0060)   // adx0
+        case x0 (0061): OPLABEL (x0, 0061)   // adx1
+        case x0 (0062): OPLABEL (x0, 0062)   // adx2
+        case x0 (0063): OPLABEL (x0, 0063)   // adx3
+        case x0 (0064): OPLABEL (x0, 0064)   // adx4
+        case x0 (0065): OPLABEL (x0, 0065)   // adx5
+        case x0 (0066): OPLABEL (x0, 0066)   // adx6
+        case x0 (0067): OPLABEL (x0, 0067)   // adx7
           {
 #ifdef L68
             cpu.ou.cycle |= ou_GOS;
@@ -4519,7 +5184,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //        case x0 (0054):   // aos
 
-        case x0 (0055):   // asa
+        case x0 (0055): OPLABEL (x0, 0055)   // asa
           {
             // C(A) + C(Y) -> C(Y)
 
@@ -4537,7 +5202,7 @@ static t_stat doInstruction (void)
 #endif
           break;
 
-        case x0 (0056):   // asq
+        case x0 (0056): OPLABEL (x0, 0056)   // asq
           {
             // C(Q) + C(Y) -> C(Y)
 #ifdef L68
@@ -4553,14 +5218,14 @@ static t_stat doInstruction (void)
           break;
 
                           // asxn
-        case x0 (0040):   // asx0
-        case x0 (0041):   // asx1
-        case x0 (0042):   // asx2
-        case x0 (0043):   // asx3
-        case x0 (0044):   // asx4
-        case x0 (0045):   // asx5
-        case x0 (0046):   // asx6
-        case x0 (0047):   // asx7
+        case x0 (0040): OPLABEL (x0, 0040)   // asx0
+        case x0 (0041): OPLABEL (x0, 0041)   // asx1
+        case x0 (0042): OPLABEL (x0, 0042)   // asx2
+        case x0 (0043): OPLABEL (x0, 0043)   // asx3
+        case x0 (0044): OPLABEL (x0, 0044)   // asx4
+        case x0 (0045): OPLABEL (x0, 0045)   // asx5
+        case x0 (0046): OPLABEL (x0, 0046)   // asx6
+        case x0 (0047): OPLABEL (x0, 0047)   // asx7
           {
             // For n = 0, 1, ..., or 7 as determined by operation code
             //    C(Xn) + C(Y)0,17 -> C(Y)0,17
@@ -4579,7 +5244,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0071):   // awca
+        case x0 (0071): OPLABEL (x0, 0071)   // awca
           {
             // If carry indicator OFF, then C(A) + C(Y) -> C(A)
             // If carry indicator ON, then C(A) + C(Y) + 1 -> C(A)
@@ -4595,7 +5260,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0072):   // awcq
+        case x0 (0072): OPLABEL (x0, 0072)   // awcq
           {
             // If carry indicator OFF, then C(Q) + C(Y) -> C(Q)
             // If carry indicator ON, then C(Q) + C(Y) + 1 -> C(Q)
@@ -4613,7 +5278,7 @@ static t_stat doInstruction (void)
 
         /// Fixed-Point Subtraction
 
-        case x0 (0175):  // sba
+        case x0 (0175): OPLABEL (x0, 0175)  // sba
           {
             // C(A) - C(Y) -> C(A)
 
@@ -4627,7 +5292,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0177):  // sbaq
+        case x0 (0177): OPLABEL (x0, 0177)  // sbaq
           {
             // C(AQ) - C(Y-pair) -> C(AQ)
 #ifdef L68
@@ -4645,7 +5310,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0135):  // sbla
+        case x0 (0135): OPLABEL (x0, 0135)  // sbla
           {
             // C(A) - C(Y) -> C(A) logical
 
@@ -4658,7 +5323,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0137):  // sblaq
+        case x0 (0137): OPLABEL (x0, 0137)  // sblaq
           {
             // The sblaq instruction is identical to the sbaq instruction with
             // the exception that the overflow indicator is not affected by the
@@ -4680,7 +5345,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0136):  // sblq
+        case x0 (0136): OPLABEL (x0, 0136)  // sblq
           {
             // C(Q) - C(Y) -> C(Q)
 #ifdef L68
@@ -4693,14 +5358,14 @@ static t_stat doInstruction (void)
           break;
 
                          // sblxn
-        case x0 (0120):  // sblx0
-        case x0 (0121):  // sblx1
-        case x0 (0122):  // sblx2
-        case x0 (0123):  // sblx3
-        case x0 (0124):  // sblx4
-        case x0 (0125):  // sblx5
-        case x0 (0126):  // sblx6
-        case x0 (0127):  // sblx7
+        case x0 (0120): OPLABEL (x0, 0120)  // sblx0
+        case x0 (0121): OPLABEL (x0, 0121)  // sblx1
+        case x0 (0122): OPLABEL (x0, 0122)  // sblx2
+        case x0 (0123): OPLABEL (x0, 0123)  // sblx3
+        case x0 (0124): OPLABEL (x0, 0124)  // sblx4
+        case x0 (0125): OPLABEL (x0, 0125)  // sblx5
+        case x0 (0126): OPLABEL (x0, 0126)  // sblx6
+        case x0 (0127): OPLABEL (x0, 0127)  // sblx7
           {
             // For n = 0, 1, ..., or 7 as determined by operation code
             // C(Xn) - C(Y)0,17 -> C(Xn)
@@ -4716,7 +5381,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0176):  // sbq
+        case x0 (0176): OPLABEL (x0, 0176)  // sbq
           {
             // C(Q) - C(Y) -> C(Q)
 #ifdef L68
@@ -4730,14 +5395,14 @@ static t_stat doInstruction (void)
           break;
 
                          // sbxn
-        case x0 (0160):  // sbx0
-        case x0 (0161):  // sbx1
-        case x0 (0162):  // sbx2
-        case x0 (0163):  // sbx3
-        case x0 (0164):  // sbx4
-        case x0 (0165):  // sbx5
-        case x0 (0166):  // sbx6
-        case x0 (0167):  // sbx7
+        case x0 (0160): OPLABEL (x0, 0160)  // sbx0
+        case x0 (0161): OPLABEL (x0, 0161)  // sbx1
+        case x0 (0162): OPLABEL (x0, 0162)  // sbx2
+        case x0 (0163): OPLABEL (x0, 0163)  // sbx3
+        case x0 (0164): OPLABEL (x0, 0164)  // sbx4
+        case x0 (0165): OPLABEL (x0, 0165)  // sbx5
+        case x0 (0166): OPLABEL (x0, 0166)  // sbx6
+        case x0 (0167): OPLABEL (x0, 0167)  // sbx7
           {
             // For n = 0, 1, ..., or 7 as determined by operation code
             // C(Xn) - C(Y)0,17 -> C(Xn)
@@ -4754,7 +5419,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0155):  // ssa
+        case x0 (0155): OPLABEL (x0, 0155)  // ssa
           {
             // C(A) - C(Y) -> C(Y)
 
@@ -4770,7 +5435,7 @@ static t_stat doInstruction (void)
 #endif
           break;
 
-        case x0 (0156):  // ssq
+        case x0 (0156): OPLABEL (x0, 0156)  // ssq
           {
             // C(Q) - C(Y) -> C(Y)
 
@@ -4787,14 +5452,14 @@ static t_stat doInstruction (void)
           break;
 
                          // ssxn
-        case x0 (0140):  // ssx0
-        case x0 (0141):  // ssx1
-        case x0 (0142):  // ssx2
-        case x0 (0143):  // ssx3
-        case x0 (0144):  // ssx4
-        case x0 (0145):  // ssx5
-        case x0 (0146):  // ssx6
-        case x0 (0147):  // ssx7
+        case x0 (0140): OPLABEL (x0, 0140)  // ssx0
+        case x0 (0141): OPLABEL (x0, 0141)  // ssx1
+        case x0 (0142): OPLABEL (x0, 0142)  // ssx2
+        case x0 (0143): OPLABEL (x0, 0143)  // ssx3
+        case x0 (0144): OPLABEL (x0, 0144)  // ssx4
+        case x0 (0145): OPLABEL (x0, 0145)  // ssx5
+        case x0 (0146): OPLABEL (x0, 0146)  // ssx6
+        case x0 (0147): OPLABEL (x0, 0147)  // ssx7
           {
             // For uint32 n = 0, 1, ..., or 7 as determined by operation code
             // C(Xn) - C(Y)0,17 -> C(Y)0,17
@@ -4815,7 +5480,7 @@ static t_stat doInstruction (void)
           break;
 
 
-        case x0 (0171):  // swca
+        case x0 (0171): OPLABEL (x0, 0171)  // swca
           {
             // If carry indicator ON, then C(A)- C(Y) -> C(A)
             // If carry indicator OFF, then C(A) - C(Y) - 1 -> C(A)
@@ -4831,7 +5496,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0172):  // swcq
+        case x0 (0172): OPLABEL (x0, 0172)  // swcq
           {
             // If carry indicator ON, then C(Q) - C(Y) -> C(Q)
             // If carry indicator OFF, then C(Q) - C(Y) - 1 -> C(Q)
@@ -4849,7 +5514,7 @@ static t_stat doInstruction (void)
 
         /// Fixed-Point Multiplication
 
-        case x0 (0401):  // mpf
+        case x0 (0401): OPLABEL (x0, 0401)  // mpf
           {
             // C(A) * C(Y) -> C(AQ), left adjusted
             //
@@ -4892,7 +5557,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0402):  // mpy
+        case x0 (0402): OPLABEL (x0, 0402)  // mpy
           // C(Q) * C(Y) -> C(AQ), right adjusted
 
           {
@@ -4924,7 +5589,7 @@ static t_stat doInstruction (void)
 
         /// Fixed-Point Division
 
-        case x0 (0506):  // div
+        case x0 (0506): OPLABEL (x0, 0506)  // div
           // C(Q) / (Y) integer quotient -> C(Q), integer remainder -> C(A)
           //
           // A 36-bit integer dividend (including sign) is divided by a
@@ -5052,7 +5717,7 @@ static t_stat doInstruction (void)
 
           break;
 
-        case x0 (0507):  // dvf
+        case x0 (0507): OPLABEL (x0, 0507)  // dvf
           // C(AQ) / (Y)
           //  fractional quotient -> C(A)
           //  fractional remainder -> C(Q)
@@ -5075,7 +5740,7 @@ static t_stat doInstruction (void)
 
         /// Fixed-Point Negate
 
-        case x0 (0531):  // neg
+        case x0 (0531): OPLABEL (x0, 0531)  // neg
           // -C(A) -> C(A) if C(A) != 0
 
           cpu.rA &= DMASK;
@@ -5096,7 +5761,7 @@ static t_stat doInstruction (void)
 
           break;
 
-        case x0 (0533):  // negl
+        case x0 (0533): OPLABEL (x0, 0533)  // negl
           // -C(AQ) -> C(AQ) if C(AQ) != 0
           {
             cpu.rA &= DMASK;
@@ -5130,7 +5795,7 @@ static t_stat doInstruction (void)
 
         /// Fixed-Point Comparison
 
-        case x0 (0405):  // cmg
+        case x0 (0405): OPLABEL (x0, 0405)  // cmg
           // | C(A) | :: | C(Y) |
           // Zero:     If | C(A) | = | C(Y) | , then ON; otherwise OFF
           // Negative: If | C(A) | < | C(Y) | , then ON; otherwise OFF
@@ -5152,7 +5817,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0211):  // cmk
+        case x0 (0211): OPLABEL (x0, 0211)  // cmk
           // For i = 0, 1, ..., 35
           // C(Z)i = ~C(Q)i & ( C(A)i XOR C(Y)i )
 
@@ -5194,7 +5859,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //        case x0 (0115):  // cmpa
 
-        case x0 (0117):  // cmpaq
+        case x0 (0117): OPLABEL (x0, 0117)  // cmpaq
           // C(AQ) :: C(Y-pair)
           {
             word72 tmp72 = YPAIRTO72 (cpu.Ypair);
@@ -5212,14 +5877,14 @@ static t_stat doInstruction (void)
 //         case x0 (0116):  // cmpq
 
                          // cmpxn
-        case x0 (0100):  // cmpx0
-        case x0 (0101):  // cmpx1
-        case x0 (0102):  // cmpx2
-        case x0 (0103):  // cmpx3
-        case x0 (0104):  // cmpx4
-        case x0 (0105):  // cmpx5
-        case x0 (0106):  // cmpx6
-        case x0 (0107):  // cmpx7
+        case x0 (0100): OPLABEL (x0, 0100)  // cmpx0
+        case x0 (0101): OPLABEL (x0, 0101)  // cmpx1
+        case x0 (0102): OPLABEL (x0, 0102)  // cmpx2
+        case x0 (0103): OPLABEL (x0, 0103)  // cmpx3
+        case x0 (0104): OPLABEL (x0, 0104)  // cmpx4
+        case x0 (0105): OPLABEL (x0, 0105)  // cmpx5
+        case x0 (0106): OPLABEL (x0, 0106)  // cmpx6
+        case x0 (0107): OPLABEL (x0, 0107)  // cmpx7
           // For n = 0, 1, ..., or 7 as determined by operation code
           // C(Xn) :: C(Y)0,17
           {
@@ -5228,7 +5893,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0111):  // cwl
+        case x0 (0111): OPLABEL (x0, 0111)  // cwl
           // C(Y) :: closed interval [C(A);C(Q)]
           /**
            * The cwl instruction tests the value of C(Y) to determine if it
@@ -5242,14 +5907,14 @@ static t_stat doInstruction (void)
 
         /// Fixed-Point Miscellaneous
 
-        case x0 (0234):  // szn
+        case x0 (0234): OPLABEL (x0, 0234)  // szn
           // Set indicators according to C(Y)
           cpu.CY &= DMASK;
           SC_I_ZERO (cpu.CY == 0);
           SC_I_NEG (cpu.CY & SIGN36);
           break;
 
-        case x0 (0214):  // sznc
+        case x0 (0214): OPLABEL (x0, 0214)  // sznc
           // Set indicators according to C(Y)
           cpu.CY &= DMASK;
           SC_I_ZERO (cpu.CY == 0);
@@ -5271,7 +5936,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //        case x0 (0377):  //< anaq
 
-        case x0 (0376):  // anq
+        case x0 (0376): OPLABEL (x0, 0376)  // anq
           // C(Q)i & C(Y)i -> C(Q)i for i = (0, 1, ..., 35)
           cpu.rQ = cpu.rQ & cpu.CY;
           cpu.rQ &= DMASK;
@@ -5281,7 +5946,7 @@ static t_stat doInstruction (void)
           SC_I_NEG (cpu.rQ & SIGN36);
           break;
 
-        case x0 (0355):  // ansa
+        case x0 (0355): OPLABEL (x0, 0355)  // ansa
           // C(A)i & C(Y)i -> C(Y)i for i = (0, 1, ..., 35)
           {
             cpu.CY = cpu.rA & cpu.CY;
@@ -5296,7 +5961,7 @@ static t_stat doInstruction (void)
 #endif
           break;
 
-        case x0 (0356):  // ansq
+        case x0 (0356): OPLABEL (x0, 0356)  // ansq
           // C(Q)i & C(Y)i -> C(Y)i for i = (0, 1, ..., 35)
           {
               cpu.CY = cpu.rQ & cpu.CY;
@@ -5311,14 +5976,14 @@ static t_stat doInstruction (void)
           break;
 
                          // ansxn
-        case x0 (0340):  // ansx0
-        case x0 (0341):  // ansx1
-        case x0 (0342):  // ansx2
-        case x0 (0343):  // ansx3
-        case x0 (0344):  // ansx4
-        case x0 (0345):  // ansx5
-        case x0 (0346):  // ansx6
-        case x0 (0347):  // ansx7
+        case x0 (0340): OPLABEL (x0, 0340)  // ansx0
+        case x0 (0341): OPLABEL (x0, 0341)  // ansx1
+        case x0 (0342): OPLABEL (x0, 0342)  // ansx2
+        case x0 (0343): OPLABEL (x0, 0343)  // ansx3
+        case x0 (0344): OPLABEL (x0, 0344)  // ansx4
+        case x0 (0345): OPLABEL (x0, 0345)  // ansx5
+        case x0 (0346): OPLABEL (x0, 0346)  // ansx6
+        case x0 (0347): OPLABEL (x0, 0347)  // ansx7
           // For n = 0, 1, ..., or 7 as determined by operation code
           // C(Xn)i & C(Y)i -> C(Y)i for i = (0, 1, ..., 17)
           {
@@ -5338,14 +6003,14 @@ static t_stat doInstruction (void)
           break;
 
                          // anxn
-        case x0 (0360):  // anx0
-        case x0 (0361):  // anx1
-        case x0 (0362):  // anx2
-        case x0 (0363):  // anx3
-        case x0 (0364):  // anx4
-        case x0 (0365):  // anx5
-        case x0 (0366):  // anx6
-        case x0 (0367):  // anx7
+        case x0 (0360): OPLABEL (x0, 0360)  // anx0
+        case x0 (0361): OPLABEL (x0, 0361)  // anx1
+        case x0 (0362): OPLABEL (x0, 0362)  // anx2
+        case x0 (0363): OPLABEL (x0, 0363)  // anx3
+        case x0 (0364): OPLABEL (x0, 0364)  // anx4
+        case x0 (0365): OPLABEL (x0, 0365)  // anx5
+        case x0 (0366): OPLABEL (x0, 0366)  // anx6
+        case x0 (0367): OPLABEL (x0, 0367)  // anx7
           // For n = 0, 1, ..., or 7 as determined by operation code
           // C(Xn)i & C(Y)i -> C(Xn)i for i = (0, 1, ..., 17)
           {
@@ -5364,7 +6029,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //        case x0 (0275):  // ora
 
-        case x0 (0277):  // oraq
+        case x0 (0277): OPLABEL (x0, 0277)  // oraq
           // C(AQ)i | C(Y-pair)i -> C(AQ)i for i = (0, 1, ..., 71)
           {
               word72 tmp72 = YPAIRTO72 (cpu.Ypair);
@@ -5388,7 +6053,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0276):  // orq
+        case x0 (0276): OPLABEL (x0, 0276)  // orq
           // C(Q)i | C(Y)i -> C(Q)i for i = (0, 1, ..., 35)
           cpu.rQ = cpu.rQ | cpu.CY;
           cpu.rQ &= DMASK;
@@ -5399,7 +6064,7 @@ static t_stat doInstruction (void)
 
           break;
 
-        case x0 (0255):  // orsa
+        case x0 (0255): OPLABEL (x0, 0255)  // orsa
           // C(A)i | C(Y)i -> C(Y)i for i = (0, 1, ..., 35)
           cpu.CY = cpu.rA | cpu.CY;
           cpu.CY &= DMASK;
@@ -5411,7 +6076,7 @@ static t_stat doInstruction (void)
 #endif
           break;
 
-        case x0 (0256):  // orsq
+        case x0 (0256): OPLABEL (x0, 0256)  // orsq
           // C(Q)i | C(Y)i -> C(Y)i for i = (0, 1, ..., 35)
 
           cpu.CY = cpu.rQ | cpu.CY;
@@ -5425,14 +6090,14 @@ static t_stat doInstruction (void)
           break;
 
                          // orsxn
-        case x0 (0240):  // orsx0
-        case x0 (0241):  // orsx1
-        case x0 (0242):  // orsx2
-        case x0 (0243):  // orsx3
-        case x0 (0244):  // orsx4
-        case x0 (0245):  // orsx5
-        case x0 (0246):  // orsx6
-        case x0 (0247):  // orsx7
+        case x0 (0240): OPLABEL (x0, 0240)  // orsx0
+        case x0 (0241): OPLABEL (x0, 0241)  // orsx1
+        case x0 (0242): OPLABEL (x0, 0242)  // orsx2
+        case x0 (0243): OPLABEL (x0, 0243)  // orsx3
+        case x0 (0244): OPLABEL (x0, 0244)  // orsx4
+        case x0 (0245): OPLABEL (x0, 0245)  // orsx5
+        case x0 (0246): OPLABEL (x0, 0246)  // orsx6
+        case x0 (0247): OPLABEL (x0, 0247)  // orsx7
           // For n = 0, 1, ..., or 7 as determined by operation code
           // C(Xn)i | C(Y)i -> C(Y)i for i = (0, 1, ..., 17)
           {
@@ -5452,14 +6117,14 @@ static t_stat doInstruction (void)
           break;
 
                          // orxn
-        case x0 (0260):  // orx0
-        case x0 (0261):  // orx1
-        case x0 (0262):  // orx2
-        case x0 (0263):  // orx3
-        case x0 (0264):  // orx4
-        case x0 (0265):  // orx5
-        case x0 (0266):  // orx6
-        case x0 (0267):  // orx7
+        case x0 (0260): OPLABEL (x0, 0260)  // orx0
+        case x0 (0261): OPLABEL (x0, 0261)  // orx1
+        case x0 (0262): OPLABEL (x0, 0262)  // orx2
+        case x0 (0263): OPLABEL (x0, 0263)  // orx3
+        case x0 (0264): OPLABEL (x0, 0264)  // orx4
+        case x0 (0265): OPLABEL (x0, 0265)  // orx5
+        case x0 (0266): OPLABEL (x0, 0266)  // orx6
+        case x0 (0267): OPLABEL (x0, 0267)  // orx7
           // For n = 0, 1, ..., or 7 as determined by operation code
           // C(Xn)i | C(Y)i -> C(Xn)i for i = (0, 1, ..., 17)
           {
@@ -5475,7 +6140,7 @@ static t_stat doInstruction (void)
 
         /// Boolean Exclusive Or
 
-        case x0 (0675):  // era
+        case x0 (0675): OPLABEL (x0, 0675)  // era
           // C(A)i XOR C(Y)i -> C(A)i for i = (0, 1, ..., 35)
           cpu.rA = cpu.rA ^ cpu.CY;
           cpu.rA &= DMASK;
@@ -5489,7 +6154,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //        case x0 (0677):  // eraq
 
-        case x0 (0676):  // erq
+        case x0 (0676): OPLABEL (x0, 0676)  // erq
           // C(Q)i XOR C(Y)i -> C(Q)i for i = (0, 1, ..., 35)
           cpu.rQ = cpu.rQ ^ cpu.CY;
           cpu.rQ &= DMASK;
@@ -5498,7 +6163,7 @@ static t_stat doInstruction (void)
           SC_I_NEG (cpu.rQ & SIGN36);
           break;
 
-        case x0 (0655):  // ersa
+        case x0 (0655): OPLABEL (x0, 0655)  // ersa
           // C(A)i XOR C(Y)i -> C(Y)i for i = (0, 1, ..., 35)
 
           cpu.CY = cpu.rA ^ cpu.CY;
@@ -5511,7 +6176,7 @@ static t_stat doInstruction (void)
 #endif
           break;
 
-        case x0 (0656):  // ersq
+        case x0 (0656): OPLABEL (x0, 0656)  // ersq
           // C(Q)i XOR C(Y)i -> C(Y)i for i = (0, 1, ..., 35)
 
           cpu.CY = cpu.rQ ^ cpu.CY;
@@ -5526,14 +6191,14 @@ static t_stat doInstruction (void)
           break;
 
                           // ersxn
-        case x0 (0640):   // ersx0
-        case x0 (0641):   // ersx1
-        case x0 (0642):   // ersx2
-        case x0 (0643):   // ersx3
-        case x0 (0644):   // ersx4
-        case x0 (0645):   // ersx5
-        case x0 (0646):   // ersx6
-        case x0 (0647):   // ersx7
+        case x0 (0640): OPLABEL (x0, 0640)   // ersx0
+        case x0 (0641): OPLABEL (x0, 0641)   // ersx1
+        case x0 (0642): OPLABEL (x0, 0642)   // ersx2
+        case x0 (0643): OPLABEL (x0, 0643)   // ersx3
+        case x0 (0644): OPLABEL (x0, 0644)   // ersx4
+        case x0 (0645): OPLABEL (x0, 0645)   // ersx5
+        case x0 (0646): OPLABEL (x0, 0646)   // ersx6
+        case x0 (0647): OPLABEL (x0, 0647)   // ersx7
           // For n = 0, 1, ..., or 7 as determined by operation code
           // C(Xn)i XOR C(Y)i -> C(Y)i for i = (0, 1, ..., 17)
           {
@@ -5553,14 +6218,14 @@ static t_stat doInstruction (void)
           break;
 
                          // erxn
-        case x0 (0660):  // erx0
-        case x0 (0661):  // erx1
-        case x0 (0662):  // erx2
-        case x0 (0663):  // erx3
-        case x0 (0664):  // erx4
-        case x0 (0665):  // erx5
-        case x0 (0666):  // erx6 !!!! Beware !!!!
-        case x0 (0667):  // erx7
+        case x0 (0660): OPLABEL (x0, 0660)  // erx0
+        case x0 (0661): OPLABEL (x0, 0661)  // erx1
+        case x0 (0662): OPLABEL (x0, 0662)  // erx2
+        case x0 (0663): OPLABEL (x0, 0663)  // erx3
+        case x0 (0664): OPLABEL (x0, 0664)  // erx4
+        case x0 (0665): OPLABEL (x0, 0665)  // erx5
+        case x0 (0666): OPLABEL (x0, 0666)  // erx6 !!!! Beware !!!!
+        case x0 (0667): OPLABEL (x0, 0667)  // erx7
           // For n = 0, 1, ..., or 7 as determined by operation code
           // C(Xn)i XOR C(Y)i -> C(Xn)i for i = (0, 1, ..., 17)
           {
@@ -5579,7 +6244,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //        case x0 (0315):  // cana
 
-        case x0 (0317):  // canaq
+        case x0 (0317): OPLABEL (x0, 0317)  // canaq
           // C(Z)i = C(AQ)i & C(Y-pair)i for i = (0, 1, ..., 71)
           {
             word72 tmp72 = YPAIRTO72 (cpu.Ypair);
@@ -5600,7 +6265,7 @@ static t_stat doInstruction (void)
           }
             break;
 
-        case x0 (0316):  // canq
+        case x0 (0316): OPLABEL (x0, 0316)  // canq
           // C(Z)i = C(Q)i & C(Y)i for i = (0, 1, ..., 35)
           {
             word36 trZ = cpu.rQ & cpu.CY;
@@ -5612,14 +6277,14 @@ static t_stat doInstruction (void)
           break;
 
                          // canxn
-        case x0 (0300):  // canx0
-        case x0 (0301):  // canx1
-        case x0 (0302):  // canx2
-        case x0 (0303):  // canx3
-        case x0 (0304):  // canx4
-        case x0 (0305):  // canx5
-        case x0 (0306):  // canx6
-        case x0 (0307):  // canx7
+        case x0 (0300): OPLABEL (x0, 0300)  // canx0
+        case x0 (0301): OPLABEL (x0, 0301)  // canx1
+        case x0 (0302): OPLABEL (x0, 0302)  // canx2
+        case x0 (0303): OPLABEL (x0, 0303)  // canx3
+        case x0 (0304): OPLABEL (x0, 0304)  // canx4
+        case x0 (0305): OPLABEL (x0, 0305)  // canx5
+        case x0 (0306): OPLABEL (x0, 0306)  // canx6
+        case x0 (0307): OPLABEL (x0, 0307)  // canx7
           // For n = 0, 1, ..., or 7 as determined by operation code
           // C(Z)i = C(Xn)i & C(Y)i for i = (0, 1, ..., 17)
           {
@@ -5638,7 +6303,7 @@ static t_stat doInstruction (void)
 
         /// Boolean Comparative Not
 
-        case x0 (0215):  // cnaa
+        case x0 (0215): OPLABEL (x0, 0215)  // cnaa
           // C(Z)i = C(A)i & ~C(Y)i for i = (0, 1, ..., 35)
           {
             word36 trZ = cpu.rA & ~cpu.CY;
@@ -5649,7 +6314,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0217):  // cnaaq
+        case x0 (0217): OPLABEL (x0, 0217)  // cnaaq
           // C(Z)i = C (AQ)i & ~C(Y-pair)i for i = (0, 1, ..., 71)
           {
             word72 tmp72 = YPAIRTO72 (cpu.Ypair);   //
@@ -5671,7 +6336,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0216):  // cnaq
+        case x0 (0216): OPLABEL (x0, 0216)  // cnaq
           // C(Z)i = C(Q)i & ~C(Y)i for i = (0, 1, ..., 35)
           {
             word36 trZ = cpu.rQ & ~cpu.CY;
@@ -5682,14 +6347,14 @@ static t_stat doInstruction (void)
           break;
 
                          // cnaxn
-        case x0 (0200):  // cnax0
-        case x0 (0201):  // cnax1
-        case x0 (0202):  // cnax2
-        case x0 (0203):  // cnax3
-        case x0 (0204):  // cnax4
-        case x0 (0205):  // cnax5
-        case x0 (0206):  // cnax6
-        case x0 (0207):  // cnax7
+        case x0 (0200): OPLABEL (x0, 0200)  // cnax0
+        case x0 (0201): OPLABEL (x0, 0201)  // cnax1
+        case x0 (0202): OPLABEL (x0, 0202)  // cnax2
+        case x0 (0203): OPLABEL (x0, 0203)  // cnax3
+        case x0 (0204): OPLABEL (x0, 0204)  // cnax4
+        case x0 (0205): OPLABEL (x0, 0205)  // cnax5
+        case x0 (0206): OPLABEL (x0, 0206)  // cnax6
+        case x0 (0207): OPLABEL (x0, 0207)  // cnax7
           // C(Z)i = C(Xn)i & ~C(Y)i for i = (0, 1, ..., 17)
           {
             uint32 n = opcode10 & 07;  // get n
@@ -5705,7 +6370,7 @@ static t_stat doInstruction (void)
 
         /// Floating-Point Data Movement Load
 
-        case x0 (0433):  // dfld
+        case x0 (0433): OPLABEL (x0, 0433)  // dfld
           // C(Y-pair)0,7 -> C(E)
           // C(Y-pair)8,71 -> C(AQ)0,63
           // 00...0 -> C(AQ)64,71
@@ -5731,7 +6396,7 @@ static t_stat doInstruction (void)
 
         /// Floating-Point Data Movement Store
 
-        case x0 (0457):  // dfst
+        case x0 (0457): OPLABEL (x0, 0457)  // dfst
           // C(E) -> C(Y-pair)0,7
           // C(AQ)0,63 -> C(Y-pair)8,71
 
@@ -5743,12 +6408,12 @@ static t_stat doInstruction (void)
 
           break;
 
-        case x0 (0472):  // dfstr
+        case x0 (0472): OPLABEL (x0, 0472)  // dfstr
 
           dfstr (cpu.Ypair);
           break;
 
-        case x0 (0455):  // fst
+        case x0 (0455): OPLABEL (x0, 0455)  // fst
           // C(E) -> C(Y)0,7
           // C(A)0,27 -> C(Y)8,35
           CPTUR (cptUseE);
@@ -5757,7 +6422,7 @@ static t_stat doInstruction (void)
           cpu.CY = ((word36)cpu.rE << 28) | (((cpu.rA >> 8) & 01777777777LL));
           break;
 
-        case x0 (0470):  // fstr
+        case x0 (0470): OPLABEL (x0, 0470)  // fstr
           // The fstr instruction performs a true round and normalization on
           // C(EAQ) as it is stored.
 
@@ -5787,7 +6452,7 @@ static t_stat doInstruction (void)
 
         /// Floating-Point Addition
 
-        case x0 (0477):  // dfad
+        case x0 (0477): OPLABEL (x0, 0477)  // dfad
           // The dfad instruction may be thought of as a dufa instruction
           // followed by a fno instruction.
 
@@ -5798,11 +6463,11 @@ static t_stat doInstruction (void)
           HDBGRegQ ();
           break;
 
-        case x0 (0437):  // dufa
+        case x0 (0437): OPLABEL (x0, 0437)  // dufa
           dufa (false);
           break;
 
-        case x0 (0475):  // fad
+        case x0 (0475): OPLABEL (x0, 0475)  // fad
           // The fad instruction may be thought of a an ufa instruction
           // followed by a fno instruction.
           // (Heh, heh. We'll see....)
@@ -5815,7 +6480,7 @@ static t_stat doInstruction (void)
 
           break;
 
-        case x0 (0435):  // ufa
+        case x0 (0435): OPLABEL (x0, 0435)  // ufa
             // C(EAQ) + C(Y) -> C(EAQ)
 
           ufa (false);
@@ -5823,7 +6488,7 @@ static t_stat doInstruction (void)
 
         /// Floating-Point Subtraction
 
-        case x0 (0577):  // dfsb
+        case x0 (0577): OPLABEL (x0, 0577)  // dfsb
           // The dfsb instruction is identical to the dfad instruction with
           // the exception that the twos complement of the mantissa of the
           // operand from main memory is used.
@@ -5835,11 +6500,11 @@ static t_stat doInstruction (void)
           HDBGRegQ ();
           break;
 
-        case x0 (0537):  // dufs
+        case x0 (0537): OPLABEL (x0, 0537)  // dufs
           dufa (true);
           break;
 
-        case x0 (0575):  // fsb
+        case x0 (0575): OPLABEL (x0, 0575)  // fsb
           // The fsb instruction may be thought of as an ufs instruction
           // followed by a fno instruction.
           CPTUR (cptUseE);
@@ -5850,14 +6515,14 @@ static t_stat doInstruction (void)
 
           break;
 
-        case x0 (0535):  // ufs
+        case x0 (0535): OPLABEL (x0, 0535)  // ufs
           // C(EAQ) - C(Y) -> C(EAQ)
           ufa (true);
           break;
 
         /// Floating-Point Multiplication
 
-        case x0 (0463):  // dfmp
+        case x0 (0463): OPLABEL (x0, 0463)  // dfmp
           // The dfmp instruction may be thought of as a dufm instruction
           // followed by a fno instruction.
 
@@ -5868,12 +6533,12 @@ static t_stat doInstruction (void)
           HDBGRegQ ();
           break;
 
-        case x0 (0423):  // dufm
+        case x0 (0423): OPLABEL (x0, 0423)  // dufm
 
           dufm ();
           break;
 
-        case x0 (0461):  // fmp
+        case x0 (0461): OPLABEL (x0, 0461)  // fmp
           // The fmp instruction may be thought of as a ufm instruction
           // followed by a fno instruction.
 
@@ -5885,30 +6550,30 @@ static t_stat doInstruction (void)
 
           break;
 
-        case x0 (0421):  // ufm
+        case x0 (0421): OPLABEL (x0, 0421)  // ufm
           // C(EAQ)* C(Y) -> C(EAQ)
           ufm ();
           break;
 
         /// Floating-Point Division
 
-        case x0 (0527):  // dfdi
+        case x0 (0527): OPLABEL (x0, 0527)  // dfdi
 
           dfdi ();
           break;
 
-        case x0 (0567):  // dfdv
+        case x0 (0567): OPLABEL (x0, 0567)  // dfdv
 
           dfdv ();
           break;
 
-        case x0 (0525):  // fdi
+        case x0 (0525): OPLABEL (x0, 0525)  // fdi
           // C(Y) / C(EAQ) -> C(EA)
 
           fdi ();
           break;
 
-        case x0 (0565):  // fdv
+        case x0 (0565): OPLABEL (x0, 0565)  // fdv
           // C(EAQ) /C(Y) -> C(EA)
           // 00...0 -> C(Q)
           fdv ();
@@ -5916,14 +6581,14 @@ static t_stat doInstruction (void)
 
         /// Floating-Point Negation
 
-        case x0 (0513):  // fneg
+        case x0 (0513): OPLABEL (x0, 0513)  // fneg
           // -C(EAQ) normalized -> C(EAQ)
           fneg ();
           break;
 
         /// Floating-Point Normalize
 
-        case x0 (0573):  // fno
+        case x0 (0573): OPLABEL (x0, 0573)  // fno
           // The fno instruction normalizes the number in C(EAQ) if C(AQ)
           // != 0 and the overflow indicator is OFF.
           //
@@ -5946,14 +6611,14 @@ static t_stat doInstruction (void)
 
         /// Floating-Point Round
 
-        case x0 (0473):  // dfrd
+        case x0 (0473): OPLABEL (x0, 0473)  // dfrd
           // C(EAQ) rounded to 64 bits -> C(EAQ)
           // 0 -> C(AQ)64,71 (See notes in dps8_math.c on dfrd())
 
           dfrd ();
           break;
 
-        case x0 (0471):  // frd
+        case x0 (0471): OPLABEL (x0, 0471)  // frd
           // C(EAQ) rounded to 28 bits -> C(EAQ)
           // 0 -> C(AQ)28,71 (See notes in dps8_math.c on frd())
 
@@ -5962,28 +6627,28 @@ static t_stat doInstruction (void)
 
         /// Floating-Point Compare
 
-        case x0 (0427):  // dfcmg
+        case x0 (0427): OPLABEL (x0, 0427)  // dfcmg
           // C(E) :: C(Y-pair)0,7
           // | C(AQ)0,63 | :: | C(Y-pair)8,71 |
 
           dfcmg ();
           break;
 
-        case x0 (0517):  // dfcmp
+        case x0 (0517): OPLABEL (x0, 0517)  // dfcmp
           // C(E) :: C(Y-pair)0,7
           // C(AQ)0,63 :: C(Y-pair)8,71
 
           dfcmp ();
           break;
 
-        case x0 (0425):  // fcmg
+        case x0 (0425): OPLABEL (x0, 0425)  // fcmg
           // C(E) :: C(Y)0,7
           // | C(AQ)0,27 | :: | C(Y)8,35 |
 
           fcmg ();
           break;
 
-        case x0 (0515):  // fcmp
+        case x0 (0515): OPLABEL (x0, 0515)  // fcmp
           // C(E) :: C(Y)0,7
           // C(AQ)0,27 :: C(Y)8,35
 
@@ -5992,7 +6657,7 @@ static t_stat doInstruction (void)
 
         /// Floating-Point Miscellaneous
 
-        case x0 (0415):  // ade
+        case x0 (0415): OPLABEL (x0, 0415)  // ade
           // C(E) + C(Y)0,7 -> C(E)
           {
             CPTUR (cptUseE);
@@ -6020,7 +6685,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0430):  // fszn
+        case x0 (0430): OPLABEL (x0, 0430)  // fszn
 
           // Zero: If C(Y)8,35 = 0, then ON; otherwise OFF
           // Negative: If C(Y)8 = 1, then ON; otherwise OFF
@@ -6030,7 +6695,7 @@ static t_stat doInstruction (void)
 
           break;
 
-        case x0 (0411):  // lde
+        case x0 (0411): OPLABEL (x0, 0411)  // lde
           // C(Y)0,7 -> C(E)
 
           CPTUR (cptUseE);
@@ -6040,7 +6705,7 @@ static t_stat doInstruction (void)
 
           break;
 
-        case x0 (0456):  // ste
+        case x0 (0456): OPLABEL (x0, 0456)  // ste
           // C(E) -> C(Y)0,7
           // 00...0 -> C(Y)8,17
 
@@ -6054,7 +6719,7 @@ static t_stat doInstruction (void)
 
         /// TRANSFER INSTRUCTIONS
 
-        case x0 (0713):  // call6
+        case x0 (0713): OPLABEL (x0, 0713)  // call6
 
           CPTUR (cptUsePRn + 7);
 
@@ -6066,7 +6731,7 @@ static t_stat doInstruction (void)
           return CONT_TRA;
 
 
-        case x0 (0630):  // ret
+        case x0 (0630): OPLABEL (x0, 0630)  // ret
           {
             // Parity mask: If C(Y)27 = 1, and the processor is in absolute or
             // mask privileged mode, then ON; otherwise OFF. This indicator is
@@ -6130,7 +6795,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //        case x0 (0610):  // rtcd
 
-        case x0 (0614):  // teo
+        case x0 (0614): OPLABEL (x0, 0614)  // teo
           // If exponent overflow indicator ON then
           //  C(TPR.CA) -> C(PPR.IC)
           //  C(TPR.TSR) -> C(PPR.PSR)
@@ -6144,7 +6809,7 @@ static t_stat doInstruction (void)
             }
           break;
 
-        case x0 (0615):  // teu
+        case x0 (0615): OPLABEL (x0, 0615)  // teu
           // If exponent underflow indicator ON then
           //  C(TPR.CA) -> C(PPR.IC)
           //  C(TPR.TSR) -> C(PPR.PSR)
@@ -6164,7 +6829,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //        case x1 (0604):  // tmoz
 
-        case x0 (0602):  // tnc
+        case x0 (0602): OPLABEL (x0, 0602)  // tnc
           // If carry indicator OFF then
           //   C(TPR.CA) -> C(PPR.IC)
           //   C(TPR.TSR) -> C(PPR.PSR)
@@ -6179,7 +6844,7 @@ static t_stat doInstruction (void)
 // Optimized to the top of the loop
 //         case x0 (0601):  // tnz
 
-        case x0 (0617):  // tov
+        case x0 (0617): OPLABEL (x0, 0617)  // tov
           // If overflow indicator ON then
           //   C(TPR.CA) -> C(PPR.IC)
           //   C(TPR.TSR) -> C(PPR.PSR)
@@ -6192,7 +6857,7 @@ static t_stat doInstruction (void)
             }
           break;
 
-        case x0 (0605):  // tpl
+        case x0 (0605): OPLABEL (x0, 0605)  // tpl
           // If negative indicator OFF, then
           //   C(TPR.CA) -> C(PPR.IC)
           //   C(TPR.TSR) -> C(PPR.PSR)
@@ -6211,7 +6876,7 @@ static t_stat doInstruction (void)
 //        case x0 (0710):  // tra
 
 
-        case x0 (0603):  // trc
+        case x0 (0603): OPLABEL (x0, 0603)  // trc
           //  If carry indicator ON then
           //    C(TPR.CA) -> C(PPR.IC)
           //    C(TPR.TSR) -> C(PPR.PSR)
@@ -6223,7 +6888,7 @@ static t_stat doInstruction (void)
             }
           break;
 
-        case x1 (0601):  // trtf
+        case x1 (0601): OPLABEL (x1, 0601)  // trtf
             // If truncation indicator OFF then
             //  C(TPR.CA) -> C(PPR.IC)
             //  C(TPR.TSR) -> C(PPR.PSR)
@@ -6235,7 +6900,7 @@ static t_stat doInstruction (void)
             }
             break;
 
-        case x1 (0600):  // trtn
+        case x1 (0600): OPLABEL (x1, 0600)  // trtn
             // If truncation indicator ON then
             //  C(TPR.CA) -> C(PPR.IC)
             //  C(TPR.TSR) -> C(PPR.PSR)
@@ -6259,7 +6924,7 @@ static t_stat doInstruction (void)
 //        case x0 (0672):  // tsp6
 //        case x0 (0673):  // tsp7
 
-        case x0 (0715):  // tss
+        case x0 (0715): OPLABEL (x0, 0715)  // tss
           CPTUR (cptUseBAR);
           do_caf ();
 	  if (get_bar_mode ())
@@ -6283,7 +6948,7 @@ static t_stat doInstruction (void)
 //        case x0 (0706):  // tsx6
 //        case x0 (0707):  // tsx7
 
-        case x0 (0607):  // ttf
+        case x0 (0607): OPLABEL (x0, 0607)  // ttf
           // If tally runout indicator OFF then
           //   C(TPR.CA) -> C(PPR.IC)
           //  C(TPR.TSR) -> C(PPR.PSR)
@@ -6296,7 +6961,7 @@ static t_stat doInstruction (void)
             }
           break;
 
-        case x1 (0606):  // ttn
+        case x1 (0606): OPLABEL (x1, 0606)  // ttn
             // If tally runout indicator ON then
             //  C(TPR.CA) -> C(PPR.IC)
             //  C(TPR.TSR) -> C(PPR.PSR)
@@ -6318,56 +6983,56 @@ static t_stat doInstruction (void)
 
                          // easpn
 
-        case x0 (0311):  // easp0
+        case x0 (0311): OPLABEL (x0, 0311)  // easp0
           // C(TPR.CA) -> C(PRn.SNR)
           CPTUR (cptUsePRn + 0);
           cpu.PR[0].SNR = cpu.TPR.CA & MASK15;
           HDBGRegPR (0);
           break;
 
-        case x1 (0310):  // easp1
+        case x1 (0310): OPLABEL (x1, 0310)  // easp1
           // C(TPR.CA) -> C(PRn.SNR)
           CPTUR (cptUsePRn + 1);
           cpu.PR[1].SNR = cpu.TPR.CA & MASK15;
           HDBGRegPR (1);
           break;
 
-        case x0 (0313):  // easp2
+        case x0 (0313): OPLABEL (x0, 0313)  // easp2
           // C(TPR.CA) -> C(PRn.SNR)
           CPTUR (cptUsePRn + 2);
           cpu.PR[2].SNR = cpu.TPR.CA & MASK15;
           HDBGRegPR (2);
           break;
 
-        case x1 (0312):  // easp3
+        case x1 (0312): OPLABEL (x1, 0312)  // easp3
           // C(TPR.CA) -> C(PRn.SNR)
           CPTUR (cptUsePRn + 3);
           cpu.PR[3].SNR = cpu.TPR.CA & MASK15;
           HDBGRegPR (3);
           break;
 
-        case x0 (0331):  // easp4
+        case x0 (0331): OPLABEL (x0, 0331)  // easp4
           // C(TPR.CA) -> C(PRn.SNR)
           CPTUR (cptUsePRn + 4);
           cpu.PR[4].SNR = cpu.TPR.CA & MASK15;
           HDBGRegPR (4);
           break;
 
-        case x1 (0330):  // easp5
+        case x1 (0330): OPLABEL (x1, 0330)  // easp5
           // C(TPR.CA) -> C(PRn.SNR)
           CPTUR (cptUsePRn + 5);
           cpu.PR[5].SNR = cpu.TPR.CA & MASK15;
           HDBGRegPR (5);
           break;
 
-        case x0 (0333):  // easp6
+        case x0 (0333): OPLABEL (x0, 0333)  // easp6
           // C(TPR.CA) -> C(PRn.SNR)
           CPTUR (cptUsePRn + 6);
           cpu.PR[6].SNR = cpu.TPR.CA & MASK15;
           HDBGRegPR (6);
           break;
 
-        case x1 (0332):  // easp7
+        case x1 (0332): OPLABEL (x1, 0332)  // easp7
           // C(TPR.CA) -> C(PRn.SNR)
           CPTUR (cptUsePRn + 7);
           cpu.PR[7].SNR = cpu.TPR.CA & MASK15;
@@ -6376,7 +7041,7 @@ static t_stat doInstruction (void)
 
                          // eawpn
 
-        case x0 (0310):  // eawp0
+        case x0 (0310): OPLABEL (x0, 0310)  // eawp0
           // For n = 0, 1, ..., or 7 as determined by operation code
           //  C(TPR.CA) -> C(PRn.WORDNO)
           //  C(TPR.TBR) -> C(PRn.BITNO)
@@ -6386,7 +7051,7 @@ static t_stat doInstruction (void)
           HDBGRegPR (0);
           break;
 
-        case x1 (0311):  // eawp1
+        case x1 (0311): OPLABEL (x1, 0311)  // eawp1
           // For n = 0, 1, ..., or 7 as determined by operation code
           //  C(TPR.CA) -> C(PRn.WORDNO)
           //  C(TPR.TBR) -> C(PRn.BITNO)
@@ -6396,7 +7061,7 @@ static t_stat doInstruction (void)
           HDBGRegPR (1);
           break;
 
-        case x0 (0312):  // eawp2
+        case x0 (0312): OPLABEL (x0, 0312)  // eawp2
           // For n = 0, 1, ..., or 7 as determined by operation code
           //  C(TPR.CA) -> C(PRn.WORDNO)
           //  C(TPR.TBR) -> C(PRn.BITNO)
@@ -6406,7 +7071,7 @@ static t_stat doInstruction (void)
           HDBGRegPR (2);
           break;
 
-        case x1 (0313):  // eawp3
+        case x1 (0313): OPLABEL (x1, 0313)  // eawp3
           // For n = 0, 1, ..., or 7 as determined by operation code
           //  C(TPR.CA) -> C(PRn.WORDNO)
           //  C(TPR.TBR) -> C(PRn.BITNO)
@@ -6416,7 +7081,7 @@ static t_stat doInstruction (void)
           HDBGRegPR (3);
           break;
 
-        case x0 (0330):  // eawp4
+        case x0 (0330): OPLABEL (x0, 0330)  // eawp4
           // For n = 0, 1, ..., or 7 as determined by operation code
           //  C(TPR.CA) -> C(PRn.WORDNO)
           //  C(TPR.TBR) -> C(PRn.BITNO)
@@ -6426,7 +7091,7 @@ static t_stat doInstruction (void)
           HDBGRegPR (4);
           break;
 
-        case x1 (0331):  // eawp5
+        case x1 (0331): OPLABEL (x1, 0331)  // eawp5
           // For n = 0, 1, ..., or 7 as determined by operation code
           //  C(TPR.CA) -> C(PRn.WORDNO)
           //  C(TPR.TBR) -> C(PRn.BITNO)
@@ -6436,7 +7101,7 @@ static t_stat doInstruction (void)
           HDBGRegPR (5);
           break;
 
-        case x0 (0332):  // eawp6
+        case x0 (0332): OPLABEL (x0, 0332)  // eawp6
           // For n = 0, 1, ..., or 7 as determined by operation code
           //  C(TPR.CA) -> C(PRn.WORDNO)
           //  C(TPR.TBR) -> C(PRn.BITNO)
@@ -6446,7 +7111,7 @@ static t_stat doInstruction (void)
           HDBGRegPR (6);
           break;
 
-        case x1 (0333):  // eawp7
+        case x1 (0333): OPLABEL (x1, 0333)  // eawp7
           // For n = 0, 1, ..., or 7 as determined by operation code
           //  C(TPR.CA) -> C(PRn.WORDNO)
           //  C(TPR.TBR) -> C(PRn.BITNO)
@@ -6476,7 +7141,7 @@ static t_stat doInstruction (void)
 //        case x0 (0376):  // epp6
 //        case x1 (0373):  // epp7
 
-        case x0 (0173):  // lpri
+        case x0 (0173): OPLABEL (x0, 0173)  // lpri
           // For n = 0, 1, ..., 7
           //  Y-pair = Y-block16 + 2n
           //  Maximum of C(Y-pair)18,20; C(SDW.R1); C(TPR.TRR) -> C(PRn.RNR)
@@ -6537,7 +7202,7 @@ static t_stat doInstruction (void)
 //        case x1 (0652):  // spbp6
 //        case x0 (0653):  // spbp7
 
-        case x0 (0254):  // spri
+        case x0 (0254): OPLABEL (x0, 0254)  // spri
           // For n = 0, 1, ..., 7
           //  Y-pair = Y-block16 + 2n
 
@@ -6576,14 +7241,14 @@ static t_stat doInstruction (void)
 //        case x1 (0257):  // spri7
 
                          // sprpn
-        case x0 (0540):  // sprp0
-        case x0 (0541):  // sprp1
-        case x0 (0542):  // sprp2
-        case x0 (0543):  // sprp3
-        case x0 (0544):  // sprp4
-        case x0 (0545):  // sprp5
-        case x0 (0546):  // sprp6
-        case x0 (0547):  // sprp7
+        case x0 (0540): OPLABEL (x0, 0540)  // sprp0
+        case x0 (0541): OPLABEL (x0, 0541)  // sprp1
+        case x0 (0542): OPLABEL (x0, 0542)  // sprp2
+        case x0 (0543): OPLABEL (x0, 0543)  // sprp3
+        case x0 (0544): OPLABEL (x0, 0544)  // sprp4
+        case x0 (0545): OPLABEL (x0, 0545)  // sprp5
+        case x0 (0546): OPLABEL (x0, 0546)  // sprp6
+        case x0 (0547): OPLABEL (x0, 0547)  // sprp7
           // For n = 0, 1, ..., or 7 as determined by operation code
           //  C(PRn.BITNO) -> C(Y)0,5
           //  C(PRn.SNR)3,14 -> C(Y)6,17
@@ -6610,10 +7275,10 @@ static t_stat doInstruction (void)
         /// Pointer Register Address Arithmetic
 
                           // adwpn
-        case x0 (0050):   // adwp0
-        case x0 (0051):   // adwp1
-        case x0 (0052):   // adwp2
-        case x0 (0053):   // adwp3
+        case x0 (0050): OPLABEL (x0, 0050)   // adwp0
+        case x0 (0051): OPLABEL (x0, 0051)   // adwp1
+        case x0 (0052): OPLABEL (x0, 0052)   // adwp2
+        case x0 (0053): OPLABEL (x0, 0053)   // adwp3
           // For n = 0, 1, ..., or 7 as determined by operation code
           //   C(Y)0,17 + C(PRn.WORDNO) -> C(PRn.WORDNO)
           //   00...0 -> C(PRn.BITNO)
@@ -6627,10 +7292,10 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0150):   // adwp4
-        case x0 (0151):   // adwp5
-        case x0 (0152):   // adwp6
-        case x0 (0153):   // adwp7
+        case x0 (0150): OPLABEL (x0, 0150)   // adwp4
+        case x0 (0151): OPLABEL (x0, 0151)   // adwp5
+        case x0 (0152): OPLABEL (x0, 0152)   // adwp6
+        case x0 (0153): OPLABEL (x0, 0153)   // adwp7
           // For n = 0, 1, ..., or 7 as determined by operation code
           //   C(Y)0,17 + C(PRn.WORDNO) -> C(PRn.WORDNO)
           //   00...0 -> C(PRn.BITNO)
@@ -6651,7 +7316,7 @@ static t_stat doInstruction (void)
 
         /// MISCELLANEOUS INSTRUCTIONS
 
-        case x0 (0633):  // rccl
+        case x0 (0633): OPLABEL (x0, 0633)  // rccl
           // 00...0 -> C(AQ)0,19
           // C(calendar clock) -> C(AQ)20,71
           {
@@ -6717,7 +7382,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0002):   // drl
+        case x0 (0002): OPLABEL (x0, 0002)   // drl
           // Causes a fault which fetches and executes, in absolute mode, the
           // instruction pair at main memory location C+(14)8. The value of C
           // is obtained from the FAULT VECTOR switches on the processor
@@ -6729,7 +7394,7 @@ static t_stat doInstruction (void)
             }
           doFault (FAULT_DRL, fst_zero, "drl");
 
-        case x0 (0716):  // xec
+        case x0 (0716): OPLABEL (x0, 0716)  // xec
           cpu.cu.xde = 1;
           cpu.cu.xdo = 0;
 // XXX NB. This used to be done in executeInstruction post-execution
@@ -6738,7 +7403,7 @@ static t_stat doInstruction (void)
           cpu.cu.IWB = cpu.CY;
           return CONT_XEC;
 
-        case x0 (0717):  // xed
+        case x0 (0717): OPLABEL (x0, 0717)  // xed
           // The xed instruction itself does not affect any indicator.
           // However, the execution of the instruction pair from C(Y-pair)
           // may affect indicators.
@@ -6783,7 +7448,7 @@ static t_stat doInstruction (void)
           cpu.cu.IRODD = cpu.Ypair[1];
           return CONT_XEC;
 
-        case x0 (0001):   // mme
+        case x0 (0001): OPLABEL (x0, 0001)   // mme
 #ifdef TESTING
           if (sim_deb_mme_cntdwn > 0)
             sim_deb_mme_cntdwn --;
@@ -6797,39 +7462,39 @@ static t_stat doInstruction (void)
           // configuration panel.
           doFault (FAULT_MME, fst_zero, "Master Mode Entry (mme)");
 
-        case x0 (0004):   // mme2
+        case x0 (0004): OPLABEL (x0, 0004)   // mme2
           // Causes a fault that fetches and executes, in absolute mode, the
           // instruction pair at main memory location C+(52)8. The value of C
           // is obtained from the FAULT VECTOR switches on the processor
           // configuration panel.
           doFault (FAULT_MME2, fst_zero, "Master Mode Entry 2 (mme2)");
 
-        case x0 (0005):   // mme3
+        case x0 (0005): OPLABEL (x0, 0005)   // mme3
           // Causes a fault that fetches and executes, in absolute mode, the
           // instruction pair at main memory location C+(54)8. The value of C
           // is obtained from the FAULT VECTOR switches on the processor
           // configuration panel.
           doFault (FAULT_MME3, fst_zero, "Master Mode Entry 3 (mme3)");
 
-        case x0 (0007):   // mme4
+        case x0 (0007): OPLABEL (x0, 0007)   // mme4
           // Causes a fault that fetches and executes, in absolute mode, the
           // instruction pair at main memory location C+(56)8. The value of C
           // is obtained from the FAULT VECTOR switches on the processor
           // configuration panel.
           doFault (FAULT_MME4, fst_zero, "Master Mode Entry 4 (mme4)");
 
-        case x0 (0011):   // nop
+        case x0 (0011): OPLABEL (x0, 0011)   // nop
           break;
 
-        case x0 (0012):   // puls1
+        case x0 (0012): OPLABEL (x0, 0012)   // puls1
           break;
 
-        case x0 (0013):   // puls2
+        case x0 (0013): OPLABEL (x0, 0013)   // puls2
           break;
 
         /// Repeat
 
-        case x0 (0560):  // rpd
+        case x0 (0560): OPLABEL (x0, 0560)  // rpd
           {
             if ((cpu.PPR.IC & 1) == 0)
               doFault (FAULT_IPR, fst_ill_proc, "rpd odd");
@@ -6846,7 +7511,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0500):  // rpl
+        case x0 (0500): OPLABEL (x0, 0500)  // rpl
           {
             uint c = (i->address >> 7) & 1;
             cpu.cu.delta = i->tag;
@@ -6860,7 +7525,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0520):  // rpt
+        case x0 (0520): OPLABEL (x0, 0520)  // rpt
           {
             uint c = (i->address >> 7) & 1;
             cpu.cu.delta = i->tag;
@@ -6876,7 +7541,7 @@ static t_stat doInstruction (void)
 
         /// Ring Alarm Register
 
-        case x1 (0754):  // sra
+        case x1 (0754): OPLABEL (x1, 0754)  // sra
             // 00...0 -> C(Y)0,32
             // C(RALR) -> C(Y)33,35
 
@@ -6887,7 +7552,7 @@ static t_stat doInstruction (void)
 
         /// Store Base Address Register
 
-        case x0 (0550):  // sbar
+        case x0 (0550): OPLABEL (x0, 0550)  // sbar
           // C(BAR) -> C(Y) 0,17
           CPTUR (cptUseBAR);
           //SETHI (cpu.CY, (cpu.BAR.BASE << 9) | cpu.BAR.BOUND);
@@ -6902,7 +7567,7 @@ static t_stat doInstruction (void)
 
         /// Translation
 
-        case x0 (0505):  // bcd
+        case x0 (0505): OPLABEL (x0, 0505)  // bcd
           // Shift C(A) left three positions
           // | C(A) | / C(Y) -> 4-bit quotient
           // C(A) - C(Y) * quotient -> remainder
@@ -6945,7 +7610,7 @@ static t_stat doInstruction (void)
           }
           break;
 
-        case x0 (0774):  // gtb
+        case x0 (0774): OPLABEL (x0, 0774)  // gtb
           // C(A)0 -> C(A)0
           // C(A)i XOR C(A)i-1 -> C(A)i for i = 1, 2, ..., 35
           {
@@ -6969,7 +7634,7 @@ static t_stat doInstruction (void)
 
         /// REGISTER LOAD
 
-        case x0 (0230):  // lbar
+        case x0 (0230): OPLABEL (x0, 0230)  // lbar
           // C(Y)0,17 -> C(BAR)
           CPTUR (cptUseBAR);
           // BAR.BASE is upper 9-bits (0-8)
@@ -6982,7 +7647,7 @@ static t_stat doInstruction (void)
 
         /// Privileged - Register Load
 
-        case x0 (0674):  // lcpr
+        case x0 (0674): OPLABEL (x0, 0674)  // lcpr
           // DPS8M interpratation
           switch (i->tag)
             {
@@ -7169,11 +7834,11 @@ static t_stat doInstruction (void)
             }
             break;
 
-        case x0 (0232):  // ldbr
+        case x0 (0232): OPLABEL (x0, 0232)  // ldbr
           do_ldbr (cpu.Ypair);
           break;
 
-        case x0 (0637):  // ldt
+        case x0 (0637): OPLABEL (x0, 0637)  // ldt
           CPTUR (cptUseTR);
           cpu.rTR = (cpu.CY >> 9) & MASK27;
           cpu.rTRticks = 0;
@@ -7194,7 +7859,7 @@ elapsedtime ();
           clearTROFault ();
           break;
 
-        case x1 (0257):  // lptp
+        case x1 (0257): OPLABEL (x1, 0257)  // lptp
 #ifdef DPS8M
           break;
 #endif
@@ -7219,7 +7884,7 @@ elapsedtime ();
           break;
 #endif
 
-        case x1 (0173):  // lptr
+        case x1 (0173): OPLABEL (x1, 0173)  // lptr
 #ifdef DPS8M
           break;
 #endif
@@ -7241,7 +7906,7 @@ elapsedtime ();
           break;
 #endif
 
-        case x1 (0774):  // lra
+        case x1 (0774): OPLABEL (x1, 0774)  // lra
             CPTUR (cptUseRALR);
             cpu.rRALR = cpu.CY & MASK3;
             sim_debug (DBG_TRACEEXT, & cpu_dev, "RALR set to %o\n", cpu.rRALR);
@@ -7254,7 +7919,7 @@ elapsedtime ();
 #endif
             break;
 
-        case x0 (0257):  // lsdp
+        case x0 (0257): OPLABEL (x0, 0257)  // lsdp
 #ifdef DPS8M
           break;
 #endif
@@ -7276,7 +7941,7 @@ elapsedtime ();
           break;
 #endif
 
-        case x1 (0232):  // lsdr
+        case x1 (0232): OPLABEL (x1, 0232)  // lsdr
 #ifdef DPS8M
           break;
 #endif
@@ -7314,12 +7979,12 @@ elapsedtime ();
           break;
 #endif
 
-        case x0 (0613):  // rcu
+        case x0 (0613): OPLABEL (x0, 0613)  // rcu
           doRCU (); // never returns
 
         /// Privileged - Register Store
 
-        case x0 (0452):  // scpr
+        case x0 (0452): OPLABEL (x0, 0452)  // scpr
           {
             uint tag = (i->tag) & MASK6;
             switch (tag)
@@ -7516,7 +8181,7 @@ elapsedtime ();
           }
           break;
 
-        case x0 (0657):  // scu
+        case x0 (0657): OPLABEL (x0, 0657)  // scu
           // AL-39 defines the behaivor of SCU during fault/interrupt
           // processing, but not otherwise.
           // The T&D tape uses SCU during normal processing, and apparently
@@ -7540,7 +8205,7 @@ elapsedtime ();
             }
           break;
 
-        case x0 (0154):  // sdbr
+        case x0 (0154): OPLABEL (x0, 0154)  // sdbr
           {
             CPTUR (cptUseDSBR);
             // C(DSBR.ADDR) -> C(Y-pair) 0,23
@@ -7558,7 +8223,7 @@ elapsedtime ();
           }
           break;
 
-        case x1 (0557):  // sptp
+        case x1 (0557): OPLABEL (x1, 0557)  // sptp
           {
 // XXX AL39 The associative memory is ignored (forced to "no match") during address
 // preparation.
@@ -7640,7 +8305,7 @@ elapsedtime ();
           }
           break;
 
-        case x1 (0154):  // sptr
+        case x1 (0154): OPLABEL (x1, 0154)  // sptr
           {
 // XXX The associative memory is ignored (forced to "no match") during address
 // preparation.
@@ -7686,7 +8351,7 @@ elapsedtime ();
           }
           break;
 
-        case x0 (0557):  // ssdp
+        case x0 (0557): OPLABEL (x0, 0557)  // ssdp
           {
             // XXX AL39: The associative memory is ignored (forced to "no match")
             // during address preparation.
@@ -7751,7 +8416,7 @@ elapsedtime ();
           }
           break;
 
-        case x1 (0254):  // ssdr
+        case x1 (0254): OPLABEL (x1, 0254)  // ssdr
           {
 // XXX AL39: The associative memory is ignored (forced to "no match") during
 // address preparation.
@@ -7839,8 +8504,11 @@ elapsedtime ();
 
         /// Privileged - Clear Associative Memory
 
-        case x1 (0532):  // camp
+        case x1 (0532): OPLABEL (x1, 0532)  // camp
           {
+#ifdef APU_TLB
+            apu_tlb_flush ();
+#endif
             // C(TPR.CA) 16,17 control disabling or enabling the associative
             // memory.
             // This may be done to either or both halves.
@@ -7895,8 +8563,11 @@ elapsedtime ();
           }
           break;
 
-        case x0 (0532):  // cams
+        case x0 (0532): OPLABEL (x0, 0532)  // cams
           {
+#ifdef APU_TLB
+            apu_tlb_flush ();
+#endif
             // The full/empty bit of each SDWAM register is set to zero and the
             // LRU counters are initialized. The remainder of the contents of
             // the registers are unchanged. If the associative memory is
@@ -7954,7 +8625,7 @@ elapsedtime ();
 
         /// Privileged - Configuration and Status
 
-        case x0 (0233):  // rmcm
+        case x0 (0233): OPLABEL (x0, 0233)  // rmcm
           {
             // C(TPR.CA)0,2 (C(TPR.CA)1,2 for the DPS 8M processor)
             // specify which processor port (i.e., which system
@@ -7985,7 +8656,7 @@ elapsedtime ();
           }
           break;
 
-        case x0 (0413):  // rscr
+        case x0 (0413): OPLABEL (x0, 0413)  // rscr
           {
             // For the rscr instruction, the first 2 (DPS8M) or 3 (L68) bits of
             // the addr field of the instruction are used to specify which SCU.
@@ -8064,7 +8735,7 @@ elapsedtime ();
           }
           break;
 
-        case x0 (0231):  // rsw
+        case x0 (0231): OPLABEL (x0, 0231)  // rsw
           {
 #ifdef DPS8M
             //if (i->tag == TD_DL)
@@ -8530,7 +9201,7 @@ elapsedtime ();
 
         /// Privileged - System Control
 
-        case x0 (0015):  // cioc
+        case x0 (0015): OPLABEL (x0, 0015)  // cioc
           {
             // cioc The system controller addressed by Y (i.e., contains
             // the word at Y) sends a connect signal to the port specified
@@ -8572,7 +9243,7 @@ elapsedtime ();
           }
           break;
 
-        case x0 (0553):  // smcm
+        case x0 (0553): OPLABEL (x0, 0553)  // smcm
           {
             // C(TPR.CA)0,2 (C(TPR.CA)1,2 for the DPS 8M processor)
             // specify which processor port (i.e., which system
@@ -8598,7 +9269,7 @@ elapsedtime ();
           }
           break;
 
-        case x0 (0451):  // smic
+        case x0 (0451): OPLABEL (x0, 0451)  // smic
           {
             // For the smic instruction, the first 2 or 3 bits of the addr
             // field of the instruction are used to specify which SCU.
@@ -8641,7 +9312,7 @@ elapsedtime ();
           }
           break;
 
-        case x0 (0057):  // sscr
+        case x0 (0057): OPLABEL (x0, 0057)  // sscr
           {
             //uint cpu_port_num = (cpu.TPR.CA >> 15) & 03;
             // Looking at privileged_mode_ut.alm, shift 10 bits...
@@ -8676,7 +9347,7 @@ elapsedtime ();
 
         // Privileged - Miscellaneous
 
-        case x0 (0212):  // absa
+        case x0 (0212): OPLABEL (x0, 0212)  // absa
           {
             word36 result;
             int rc = doABSA (& result);
@@ -8689,7 +9360,7 @@ elapsedtime ();
           }
           break;
 
-        case x0 (0616):  // dis
+        case x0 (0616): OPLABEL (x0, 0616)  // dis
 
           if (! cpu.switches.dis_enable)
             {
@@ -8712,7 +9383,7 @@ elapsedtime ();
                           " no events in queue\n", cpu.PPR.IC);
               sim_printf ("\nCycles = %"PRId64"\n", cpu.cycleCnt);
               sim_printf ("\nInstructions = %"PRId64"\n", cpu.cycleCnt);
-              longjmp (cpu.jmpMain, JMP_STOP);
+              cpu_longjmp (cpu.jmpMain, JMP_STOP);
             }
 
 // Multics/BCE halt
@@ -8722,8 +9393,10 @@ elapsedtime ();
                 sim_debug (DBG_MSG, & cpu_dev, "BCE DIS causes CPU halt\n");
 #ifdef LOCKLESS
                 bce_dis_called = true;
+                // Wake the main thread to stop the simulation
+                ev_poll_kick ();
 #endif // LOCKLESS
-                longjmp (cpu.jmpMain, JMP_STOP);
+                cpu_longjmp (cpu.jmpMain, JMP_STOP);
               }
 
 #if 0
@@ -8740,7 +9413,7 @@ elapsedtime ();
               {
                 sim_printf ("[%lld] pxss:delete_me DIS causes CPU halt\n", cpu.cycleCnt);
                 sim_debug (DBG_MSG, & cpu_dev, "pxss:delete_me DIS causes CPU halt\n");
-                longjmp (cpu.jmpMain, JMP_STOP);
+                cpu_longjmp (cpu.jmpMain, JMP_STOP);
                 //stopCPUThread ();
               }
 #endif
@@ -8750,7 +9423,7 @@ elapsedtime ();
               {
                 sim_printf ("[%lld] sys_trouble$die DIS causes CPU halt\n", cpu.cycleCnt);
                 sim_debug (DBG_MSG, & cpu_dev, "sys_trouble$die DIS causes CPU halt\n");
-                //longjmp (cpu.jmpMain, JMP_STOP);
+                //cpu_longjmp (cpu.jmpMain, JMP_STOP);
                 cpu.isRunning = false;
               }
 #endif
@@ -8762,7 +9435,7 @@ elapsedtime ();
 #if 1
                 setCPURun (current_running_cpu_idx, false);
 #else
-                longjmp (cpu.jmpMain, JMP_STOP);
+                cpu_longjmp (cpu.jmpMain, JMP_STOP);
 #endif
               }
 #endif
@@ -8842,14 +9515,14 @@ elapsedtime ();
         /// EIS - Address Register Load
 
                          // aarn
-        case x1 (0560):  // aar0
-        case x1 (0561):  // aar1
-        case x1 (0562):  // aar2
-        case x1 (0563):  // aar3
-        case x1 (0564):  // aar4
-        case x1 (0565):  // aar5
-        case x1 (0566):  // aar6
-        case x1 (0567):  // aar7
+        case x1 (0560): OPLABEL (x1, 0560)  // aar0
+        case x1 (0561): OPLABEL (x1, 0561)  // aar1
+        case x1 (0562): OPLABEL (x1, 0562)  // aar2
+        case x1 (0563): OPLABEL (x1, 0563)  // aar3
+        case x1 (0564): OPLABEL (x1, 0564)  // aar4
+        case x1 (0565): OPLABEL (x1, 0565)  // aar5
+        case x1 (0566): OPLABEL (x1, 0566)  // aar6
+        case x1 (0567): OPLABEL (x1, 0567)  // aar7
           {
             // For n = 0, 1, ..., or 7 as determined by operation code
             PNL (L68_ (DU_CYCLE_DDU_LDEA;))
@@ -8943,14 +9616,14 @@ elapsedtime ();
 
         // Load Address Register n
                         // larn
-        case x1 (0760): // lar0
-        case x1 (0761): // lar1
-        case x1 (0762): // lar2
-        case x1 (0763): // lar3
-        case x1 (0764): // lar4
-        case x1 (0765): // lar5
-        case x1 (0766): // lar6
-        case x1 (0767): // lar7
+        case x1 (0760): OPLABEL (x1, 0760) // lar0
+        case x1 (0761): OPLABEL (x1, 0761) // lar1
+        case x1 (0762): OPLABEL (x1, 0762) // lar2
+        case x1 (0763): OPLABEL (x1, 0763) // lar3
+        case x1 (0764): OPLABEL (x1, 0764) // lar4
+        case x1 (0765): OPLABEL (x1, 0765) // lar5
+        case x1 (0766): OPLABEL (x1, 0766) // lar6
+        case x1 (0767): OPLABEL (x1, 0767) // lar7
           {
             // For n = 0, 1, ..., or 7 as determined by operation code
             //    C(Y)0,23 -> C(ARn)
@@ -8968,7 +9641,7 @@ elapsedtime ();
 
         // lareg - Load Address Registers
 
-        case x1 (0463):  // lareg
+        case x1 (0463): OPLABEL (x1, 0463)  // lareg
           PNL (L68_ (DU_CYCLE_DDU_LDEA;))
 
           for (uint32 n = 0 ; n < 8 ; n += 1)
@@ -8984,21 +9657,21 @@ elapsedtime ();
 
         // lpl - Load Pointers and Lengths
 
-        case x1 (0467):  // lpl
+        case x1 (0467): OPLABEL (x1, 0467)  // lpl
           PNL (L68_ (DU_CYCLE_DDU_LDEA;))
           words2du (cpu.Yblock8);
           break;
 
         // narn -  (G'Kar?) Numeric Descriptor to Address Register n
                         // narn
-        case x1 (0660): // nar0
-        case x1 (0661): // nar1
-        case x1 (0662): // nar2
-        case x1 (0663): // nar3
-        case x1 (0664): // nar4
-        case x1 (0665): // nar5
-        case x1 (0666): // nar6 beware!!!! :-)
-        case x1 (0667): // nar7
+        case x1 (0660): OPLABEL (x1, 0660) // nar0
+        case x1 (0661): OPLABEL (x1, 0661) // nar1
+        case x1 (0662): OPLABEL (x1, 0662) // nar2
+        case x1 (0663): OPLABEL (x1, 0663) // nar3
+        case x1 (0664): OPLABEL (x1, 0664) // nar4
+        case x1 (0665): OPLABEL (x1, 0665) // nar5
+        case x1 (0666): OPLABEL (x1, 0666) // nar6 beware!!!! :-)
+        case x1 (0667): OPLABEL (x1, 0667) // nar7
           {
             // For n = 0, 1, ..., or 7 as determined by operation code
             PNL (L68_ (DU_CYCLE_DDU_LDEA;))
@@ -9067,14 +9740,14 @@ elapsedtime ();
         // aran Address Register n to Alphanumeric Descriptor
 
                         // aarn
-        case x1 (0540): // aar0
-        case x1 (0541): // aar1
-        case x1 (0542): // aar2
-        case x1 (0543): // aar3
-        case x1 (0544): // aar4
-        case x1 (0545): // aar5
-        case x1 (0546): // aar6
-        case x1 (0547): // aar7
+        case x1 (0540): OPLABEL (x1, 0540) // aar0
+        case x1 (0541): OPLABEL (x1, 0541) // aar1
+        case x1 (0542): OPLABEL (x1, 0542) // aar2
+        case x1 (0543): OPLABEL (x1, 0543) // aar3
+        case x1 (0544): OPLABEL (x1, 0544) // aar4
+        case x1 (0545): OPLABEL (x1, 0545) // aar5
+        case x1 (0546): OPLABEL (x1, 0546) // aar6
+        case x1 (0547): OPLABEL (x1, 0547) // aar7
             {
                 // The alphanumeric descriptor is fetched from Y and C(Y)21,22
                 // (TA field) is examined to determine the data type described.
@@ -9138,14 +9811,14 @@ elapsedtime ();
         // arnn Address Register n to Numeric Descriptor 
 
                         // aarn
-        case x1 (0640): // aar0
-        case x1 (0641): // aar1
-        case x1 (0642): // aar2
-        case x1 (0643): // aar3
-        case x1 (0644): // aar4
-        case x1 (0645): // aar5
-        case x1 (0646): // aar6
-        case x1 (0647): // aar7
+        case x1 (0640): OPLABEL (x1, 0640) // aar0
+        case x1 (0641): OPLABEL (x1, 0641) // aar1
+        case x1 (0642): OPLABEL (x1, 0642) // aar2
+        case x1 (0643): OPLABEL (x1, 0643) // aar3
+        case x1 (0644): OPLABEL (x1, 0644) // aar4
+        case x1 (0645): OPLABEL (x1, 0645) // aar5
+        case x1 (0646): OPLABEL (x1, 0646) // aar6
+        case x1 (0647): OPLABEL (x1, 0647) // aar7
             {
                 PNL (L68_ (DU_CYCLE_DDU_STEA;))
                 uint32 n = opcode10 & 07;  // get register #
@@ -9188,14 +9861,14 @@ elapsedtime ();
         // sarn Store Address Register n
 
                         // sarn
-        case x1 (0740): // sar0
-        case x1 (0741): // sar1
-        case x1 (0742): // sar2
-        case x1 (0743): // sar3
-        case x1 (0744): // sar4
-        case x1 (0745): // sar5
-        case x1 (0746): // sar6
-        case x1 (0747): // sar7
+        case x1 (0740): OPLABEL (x1, 0740) // sar0
+        case x1 (0741): OPLABEL (x1, 0741) // sar1
+        case x1 (0742): OPLABEL (x1, 0742) // sar2
+        case x1 (0743): OPLABEL (x1, 0743) // sar3
+        case x1 (0744): OPLABEL (x1, 0744) // sar4
+        case x1 (0745): OPLABEL (x1, 0745) // sar5
+        case x1 (0746): OPLABEL (x1, 0746) // sar6
+        case x1 (0747): OPLABEL (x1, 0747) // sar7
             //For n = 0, 1, ..., or 7 as determined by operation code
             //  C(ARn) -> C(Y)0,23
             //  C(Y)24,35 -> unchanged
@@ -9218,7 +9891,7 @@ elapsedtime ();
 
         // sareg Store Address Registers 
 
-        case x1 (0443):  // sareg
+        case x1 (0443): OPLABEL (x1, 0443)  // sareg
             // a:AL39/ar1 According to ISOLTS ps805, the BITNO data is stored
             // in BITNO format, not CHAR/BITNO.
             PNL (L68_ (DU_CYCLE_DDU_STEA;))
@@ -9236,7 +9909,7 @@ elapsedtime ();
 
         // spl Store Pointers and Lengths
 
-        case x1 (0447):  // spl
+        case x1 (0447): OPLABEL (x1, 0447)  // spl
             PNL (L68_ (DU_CYCLE_DDU_STEA;))
             du2words (cpu.Yblock8);
           break;
@@ -9245,154 +9918,154 @@ elapsedtime ();
 
         // a4bd Add 4-bit Displacement to Address Register 5
 
-        case x1 (0502):  // a4bd
+        case x1 (0502): OPLABEL (x1, 0502)  // a4bd
           asxbd (4, false);
           break;
 
         // a6bd Add 6-bit Displacement to Address Register
 
-        case x1 (0501):  // a6bd
+        case x1 (0501): OPLABEL (x1, 0501)  // a6bd
           asxbd (6, false);
           break;
 
         // a9bd Add 9-bit Displacement to Address Register 
 
-        case x1 (0500):  // a9bd
+        case x1 (0500): OPLABEL (x1, 0500)  // a9bd
           asxbd (9, false);
           break;
 
         // abd Add Bit Displacement to Address Register 
 
-        case x1 (0503):  // abd
+        case x1 (0503): OPLABEL (x1, 0503)  // abd
           asxbd (1, false);
           break;
 
         // awd Add Word Displacement to Address Register
 
-        case x1 (0507):  // awd
+        case x1 (0507): OPLABEL (x1, 0507)  // awd
           asxbd (36, false);
           break;
 
         // s4bd Subtract 4-bit Displacement from Address Register
 
-        case x1 (0522):  // s4bd
+        case x1 (0522): OPLABEL (x1, 0522)  // s4bd
           asxbd (4, true);
           break;
 
         // s6bd Subtract 6-bit Displacement from Address Register
 
-        case x1 (0521):  // s6bd
+        case x1 (0521): OPLABEL (x1, 0521)  // s6bd
           asxbd (6, true);
           break;
 
         // s9bd Subtract 9-bit Displacement from Address Register
 
-        case x1 (0520):  // s9bd
+        case x1 (0520): OPLABEL (x1, 0520)  // s9bd
           asxbd (9, true);
           break;
 
         // sbd Subtract Bit Displacement from Address Register
 
-        case x1 (0523):  // sbd
+        case x1 (0523): OPLABEL (x1, 0523)  // sbd
           asxbd (1, true);
           break;
 
         // swd Subtract Word Displacement from Address Register
 
-        case x1 (0527):  // swd
+        case x1 (0527): OPLABEL (x1, 0527)  // swd
           asxbd (36, true);
           break;
 
         /// EIS = Alphanumeric Compare
 
-        case x1 (0106):  // cmpc
+        case x1 (0106): OPLABEL (x1, 0106)  // cmpc
           cmpc ();
           break;
 
-        case x1 (0120):  // scd
+        case x1 (0120): OPLABEL (x1, 0120)  // scd
           scd ();
           break;
 
-        case x1 (0121):  // scdr
+        case x1 (0121): OPLABEL (x1, 0121)  // scdr
           scdr ();
           break;
 
-        case x1 (0124):  // scm
+        case x1 (0124): OPLABEL (x1, 0124)  // scm
           scm ();
           break;
 
-        case x1 (0125):  // scmr
+        case x1 (0125): OPLABEL (x1, 0125)  // scmr
           scmr ();
           break;
 
-        case x1 (0164):  // tct
+        case x1 (0164): OPLABEL (x1, 0164)  // tct
           tct ();
           break;
 
-        case x1 (0165):  // tctr
+        case x1 (0165): OPLABEL (x1, 0165)  // tctr
           tctr ();
           break;
 
         /// EIS - Alphanumeric Move
 
-        case x1 (0100):  // mlr
+        case x1 (0100): OPLABEL (x1, 0100)  // mlr
           mlr ();
           break;
 
-        case x1 (0101):  // mrl
+        case x1 (0101): OPLABEL (x1, 0101)  // mrl
           mrl ();
           break;
 
-        case x1 (0020):  // mve
+        case x1 (0020): OPLABEL (x1, 0020)  // mve
           mve ();
           break;
 
-        case x1 (0160):  // mvt
+        case x1 (0160): OPLABEL (x1, 0160)  // mvt
           mvt ();
           break;
 
         /// EIS - Numeric Compare
 
-        case x1 (0303):  // cmpn
+        case x1 (0303): OPLABEL (x1, 0303)  // cmpn
           cmpn ();
           break;
 
         /// EIS - Numeric Move
 
-        case x1 (0300):  // mvn
+        case x1 (0300): OPLABEL (x1, 0300)  // mvn
           mvn ();
           break;
 
-        case x1 (0024):   // mvne
+        case x1 (0024): OPLABEL (x1, 0024)   // mvne
           mvne ();
           break;
 
         /// EIS - Bit String Combine
 
-        case x1 (0060):   // csl
+        case x1 (0060): OPLABEL (x1, 0060)   // csl
           csl ();
           break;
 
-        case x1 (0061):   // csr
+        case x1 (0061): OPLABEL (x1, 0061)   // csr
           csr ();
           break;
 
         /// EIS - Bit String Compare
 
-        case x1 (0066):   // cmpb
+        case x1 (0066): OPLABEL (x1, 0066)   // cmpb
           cmpb ();
           break;
 
         /// EIS - Bit String Set Indicators
 
-        case x1 (0064):   // sztl
+        case x1 (0064): OPLABEL (x1, 0064)   // sztl
           // The execution of this instruction is identical to the Combine
           // Bit Strings Left (csl) instruction except that C(BOLR)m is
           // not placed into C(Y-bit2)i-1.
           sztl ();
           break;
 
-        case x1 (0065):   // sztr
+        case x1 (0065): OPLABEL (x1, 0065)   // sztr
           // The execution of this instruction is identical to the Combine
           // Bit Strings Left (csr) instruction except that C(BOLR)m is
           // not placed into C(Y-bit2)i-1.
@@ -9401,58 +10074,58 @@ elapsedtime ();
 
         /// EIS -- Data Conversion
 
-        case x1 (0301):  // btd
+        case x1 (0301): OPLABEL (x1, 0301)  // btd
           btd ();
           break;
 
-        case x1 (0305):  // dtb
+        case x1 (0305): OPLABEL (x1, 0305)  // dtb
           dtb ();
           break;
 
         /// EIS - Decimal Addition
 
-        case x1 (0202):  // ad2d
+        case x1 (0202): OPLABEL (x1, 0202)  // ad2d
             ad2d ();
             break;
 
-        case x1 (0222):  // ad3d
+        case x1 (0222): OPLABEL (x1, 0222)  // ad3d
             ad3d ();
             break;
 
         /// EIS - Decimal Subtraction
 
-        case x1 (0203):  // sb2d
+        case x1 (0203): OPLABEL (x1, 0203)  // sb2d
             sb2d ();
             break;
 
-        case x1 (0223):  // sb3d
+        case x1 (0223): OPLABEL (x1, 0223)  // sb3d
             sb3d ();
             break;
 
         /// EIS - Decimal Multiplication
 
-        case x1 (0206):  // mp2d
+        case x1 (0206): OPLABEL (x1, 0206)  // mp2d
             mp2d ();
             break;
 
-        case x1 (0226):  // mp3d
+        case x1 (0226): OPLABEL (x1, 0226)  // mp3d
             mp3d ();
             break;
 
         /// EIS - Decimal Division
 
-        case x1 (0207):  // dv2d
+        case x1 (0207): OPLABEL (x1, 0207)  // dv2d
             dv2d ();
             break;
 
-        case x1 (0227):  // dv3d
+        case x1 (0227): OPLABEL (x1, 0227)  // dv3d
             dv3d ();
             break;
 
 #ifdef TESTING
 #if EMULATOR_ONLY
 
-        case x1 (0420):  // emcall instruction Custom, for an emulator call for
+        case x1 (0420): OPLABEL (x1, 0420)  // emcall instruction Custom, for an emulator call for
                     //  simh stuff ...
         {
             int ret = emCall ();
@@ -9744,7 +10417,7 @@ elapsedtime ();
     if (getbits36_1  (cpu.Yblock8[1], 35) == 0) // cpu.cu.FLT_INT is interrupt, not fault
       {
         sim_debug (DBG_FAULT, & cpu_dev, "RCU interrupt return\n");
-        longjmp (cpu.jmpMain, JMP_REFETCH);
+        cpu_longjmp (cpu.jmpMain, JMP_REFETCH);
       }
 
     // Resync the append unit
@@ -9823,7 +10496,7 @@ elapsedtime ();
         // machine doesn't become confused.
         cpu.cu.rfi = 0;
         sim_debug (DBG_FAULT, & cpu_dev, "RCU FIF REFETCH return\n");
-        longjmp (cpu.jmpMain, JMP_REFETCH);
+        cpu_longjmp (cpu.jmpMain, JMP_REFETCH);
       }
 
 // RFI means 'refetch this instruction'
@@ -9835,7 +10508,7 @@ elapsedtime ();
 // trouble faults.
 // Without clearing rfi, ISOLTS pm776-08i LUFs.
         cpu.cu.rfi = 0;
-        longjmp (cpu.jmpMain, JMP_REFETCH);
+        cpu_longjmp (cpu.jmpMain, JMP_REFETCH);
       }
 
 // The debug command uses MME2 to implement breakpoints, but it is not
@@ -9852,7 +10525,7 @@ elapsedtime ();
 //sim_printf ("MME2 restart\n");
         sim_debug (DBG_FAULT, & cpu_dev, "RCU MME2 restart return\n");
         cpu.cu.rfi = 0;
-        longjmp (cpu.jmpMain, JMP_RESTART);
+        cpu_longjmp (cpu.jmpMain, JMP_RESTART);
       }
 #else
     if (cpu.cu.rfi || // S/W asked for the instruction to be started
@@ -9867,7 +10540,7 @@ elapsedtime ();
 
         cpu.cu.rfi = 0;
         sim_debug (DBG_FAULT, & cpu_dev, "RCU rfi/FIF REFETCH return\n");
-        longjmp (cpu.jmpMain, JMP_REFETCH);
+        cpu_longjmp (cpu.jmpMain, JMP_REFETCH);
       }
 
 // It seems obvious that MMEx should do a JMP_SYNC_FAULT_RETURN, but doing
@@ -9879,7 +10552,7 @@ elapsedtime ();
 //sim_printf ("MME2 restart\n");
         sim_debug (DBG_FAULT, & cpu_dev, "RCU MME2 restart return\n");
         cpu.cu.rfi = 1;
-        longjmp (cpu.jmpMain, JMP_RESTART);
+        cpu_longjmp (cpu.jmpMain, JMP_RESTART);
       }
 #endif
 
@@ -9912,7 +10585,7 @@ elapsedtime ();
       {
         sim_debug (DBG_FAULT, & cpu_dev, "RCU sync fault return\n");
         cpu.cu.rfi = 0;
-        longjmp (cpu.jmpMain, JMP_SYNC_FAULT_RETURN);
+        cpu_longjmp (cpu.jmpMain, JMP_SYNC_FAULT_RETURN);
       }
 #else
     if (fi_addr == FAULT_MME ||
@@ -9926,7 +10599,7 @@ elapsedtime ();
       {
         sim_debug (DBG_FAULT, & cpu_dev, "RCU MMEx sync fault return\n");
         cpu.cu.rfi = 0;
-        longjmp (cpu.jmpMain, JMP_SYNC_FAULT_RETURN);
+        cpu_longjmp (cpu.jmpMain, JMP_SYNC_FAULT_RETURN);
       }
 #endif
 
@@ -9940,7 +10613,7 @@ elapsedtime ();
       {
         cpu.cu.rfi = 1;
         sim_debug (DBG_FAULT, & cpu_dev, "RCU LUF RESTART return\n");
-        longjmp (cpu.jmpMain, JMP_RESTART);
+        cpu_longjmp (cpu.jmpMain, JMP_RESTART);
       }
 
     if (fi_addr == FAULT_DF0 ||
@@ -9957,7 +10630,7 @@ elapsedtime ();
         // If the fault occurred during fetch, handled above.
         cpu.cu.rfi = 1;
         sim_debug (DBG_FAULT, & cpu_dev, "RCU ACV RESTART return\n");
-        longjmp (cpu.jmpMain, JMP_RESTART);
+        cpu_longjmp (cpu.jmpMain, JMP_RESTART);
       }
     sim_printf ("doRCU dies with unhandled fault number %d\n", fi_addr);
     doFault (FAULT_TRB,
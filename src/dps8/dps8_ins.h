@@ -18,9 +18,12 @@ void initializeTheMatrix (void);
 void addToTheMatrix (uint32 opcode, bool opcodeX, bool a, word6 tag);
 t_stat display_the_matrix (int32 arg, const char * buf);
 #endif
+#ifdef THREADED_DISPATCH
+t_stat set_dispatch_trace (int32 arg, const char * buf);
+#endif
 t_stat prepareComputedAddress (void);   // new
 void cu_safe_restore(void);
-void fetchInstruction(word18 addr);
+bool fetchInstruction(word18 addr);
 t_stat executeInstruction (void);
 void doRCU (void) NO_RETURN;
 void traceInstruction (uint flag);
@@ -223,6 +223,7 @@
 #include "dps8_console.h"
 #include "dps8_fnp2.h"
 #include "dps8_utils.h"
+#include "dps8_snap.h"
 #if defined(THREADZ) || defined(LOCKLESS)
 #include "threadz.h"
 #endif
@@ -416,17 +417,7 @@ void iom_core_read (uint iom_unit_idx, word24 addr, word36 *data, UNUSED const c
     word24 offset;
     int scuUnitNum = query_IOM_SCU_bank_map (iom_unit_idx, addr, & offset);
     uint scu_unit_idx = cables->iom_to_scu[iom_unit_idx][scuUnitNum].scu_unit_idx;
-#ifdef THREADZ
-#ifdef lockread
-    lock_mem_rd ();
-#endif
-#endif
     *data = scu[scu_unit_idx].M[offset] & DMASK;
-#ifdef THREADZ
-#ifdef lockread
-    unlock_mem ();
-#endif
-#endif
   }
 
 void iom_core_read2 (uint iom_unit_idx, word24 addr, word36 *even, word36 *odd, UNUSED const char * ctx)
@@ -434,18 +425,8 @@ void iom_core_read2 (uint iom_unit_idx, word24 addr, word36 *even, word36 *odd,
     word24 offset;
     int scuUnitNum = query_IOM_SCU_bank_map (iom_unit_idx, addr & PAEVEN, & offset);
     uint scu_unit_idx = cables->iom_to_scu[iom_unit_idx][scuUnitNum].scu_unit_idx;
-#ifdef THREADZ
-#ifdef lockread
-    lock_mem_rd ();
-#endif
-#endif
     * even = scu[scu_unit_idx].M[offset ++] & DMASK;
     * odd  = scu[scu_unit_idx].M[offset   ] & DMASK;
-#ifdef THREADZ
-#ifdef lockread
-      unlock_mem ();
-#endif
-#endif
   }
 
 void iom_core_write (uint iom_unit_idx, word24 addr, word36 data, UNUSED const char * ctx)
@@ -453,17 +434,7 @@ void iom_core_write (uint iom_unit_idx, word24 addr, word36 data, UNUSED const c
     word24 offset;
     int scuUnitNum = query_IOM_SCU_bank_map (iom_unit_idx, addr, & offset);
     uint scu_unit_idx = cables->iom_to_scu[iom_unit_idx][scuUnitNum].scu_unit_idx;
-#ifdef THREADZ
-#ifdef lockread
-    lock_mem_wr ();
-#endif
-#endif
     scu[scu_unit_idx].M[offset] = data & DMASK;
-#ifdef THREADZ
-#ifdef lockread
-    unlock_mem ();
-#endif
-#endif
   }
 
 void iom_core_write2 (uint iom_unit_idx, word24 addr, word36 even, word36 odd, UNUSED const char * ctx)
@@ -471,50 +442,37 @@ void iom_core_write2 (uint iom_unit_idx, word24 addr, word36 even, word36 odd, U
     word24 offset;
     int scuUnitNum = query_IOM_SCU_bank_map (iom_unit_idx, addr & PAEVEN, & offset);
     uint scu_unit_idx = cables->iom_to_scu[iom_unit_idx][scuUnitNum].scu_unit_idx;
-#ifdef THREADZ
-#ifdef lockread
-    lock_mem_wr ();
-#endif
-#endif
     scu[scu_unit_idx].M[offset ++] = even & DMASK;
     scu[scu_unit_idx].M[offset   ] = odd & DMASK;
-#ifdef THREADZ
-#ifdef lockread
-      unlock_mem ();
-#endif
-#endif
+  }
+
+void iom_core_readN (uint iom_unit_idx, word24 addr, word36 * data, uint n, UNUSED const char * ctx)
+  {
+    for (uint i = 0; i < n; i ++)
+      iom_core_read (iom_unit_idx, addr + i, data + i, ctx);
+  }
+
+void iom_core_writeN (uint iom_unit_idx, word24 addr, word36 * data, uint n, UNUSED const char * ctx)
+  {
+    for (uint i = 0; i < n; i ++)
+      iom_core_write (iom_unit_idx, addr + i, data [i], ctx);
   }
 
 #else // SCUMEM
 
 void iom_core_read (UNUSED uint iom_unit_idx, word24 addr, word36 *data, UNUSED const char * ctx)
   {
-#ifdef THREADZ
-#ifdef lockread
-    lock_mem_rd ();
-#endif
-#endif
 #ifdef LOCKLESS
     word36 v;
     LOAD_ACQ_CORE_WORD(v, addr);
     * data = v & DMASK;
 #else
     * data = M[addr] & DMASK;
-#endif
-#ifdef THREADZ
-#ifdef lockread
-    unlock_mem ();
-#endif
 #endif
   }
 
 void iom_core_read2 (UNUSED uint iom_unit_idx, word24 addr, word36 *even, word36 *odd, UNUSED const char * ctx)
   {
-#ifdef THREADZ
-#ifdef lockread
-    lock_mem_rd ();
-#endif
-#endif
 #ifdef LOCKLESS
     word36 v;
     LOAD_ACQ_CORE_WORD(v, addr);
@@ -525,41 +483,22 @@ void iom_core_read2 (UNUSED uint iom_unit_idx, word24 addr, word36 *even, word36
 #else
     * even = M[addr ++] & DMASK;
     * odd =  M[addr]    & DMASK;
-#endif
-#ifdef THREADZ
-#ifdef lockread
-    unlock_mem ();
-#endif
 #endif
   }
 
 void iom_core_write (UNUSED uint iom_unit_idx, word24 addr, word36 data, UNUSED const char * ctx)
   {
-#ifdef THREADZ
-#ifdef lockread
-    lock_mem_wr ();
-#endif
-#endif
 #ifdef LOCKLESS
     LOCK_CORE_WORD(addr);
     STORE_REL_CORE_WORD(addr, data);
 #else
     M[addr] = data & DMASK;
-#endif
-#ifdef THREADZ
-#ifdef lockread
-    unlock_mem ();
-#endif
+    MEM_INIT (addr);
 #endif
   }
 
 void iom_core_write2 (UNUSED uint iom_unit_idx, word24 addr, word36 even, word36 odd, UNUSED const char * ctx)
   {
-#ifdef THREADZ
-#ifdef lockread
-    lock_mem_wr ();
-#endif
-#endif
 #ifdef LOCKLESS
     LOCK_CORE_WORD(addr);
     STORE_REL_CORE_WORD(addr, even);
@@ -567,13 +506,45 @@ void iom_core_write2 (UNUSED uint iom_unit_idx, word24 addr, word36 even, word36
     LOCK_CORE_WORD(addr);
     STORE_REL_CORE_WORD(addr, odd);
 #else
+    MEM_INIT (addr);
     M[addr ++] = even;
     M[addr] =    odd;
+    MEM_INIT (addr);
 #endif
-#ifdef THREADZ
-#ifdef lockread
-    unlock_mem ();
+  }
+
+// The caller guarantees that [addr, addr + n) does not wrap.
+
+void iom_core_readN (UNUSED uint iom_unit_idx, word24 addr, word36 * data, uint n, UNUSED const char * ctx)
+  {
+#ifdef LOCKLESS
+    for (uint i = 0; i < n; i ++)
+      {
+        word36 v;
+        LOAD_ACQ_CORE_WORD(v, addr + i);
+        data [i] = v & DMASK;
+      }
+#else
+    for (uint i = 0; i < n; i ++)
+      data [i] = M[addr + i] & DMASK;
 #endif
+  }
+
+void iom_core_writeN (UNUSED uint iom_unit_idx, word24 addr, word36 * data, uint n, UNUSED const char * ctx)
+  {
+#ifdef LOCKLESS
+    for (uint i = 0; i < n; i ++)
+      {
+        word24 a = addr + i;
+        LOCK_CORE_WORD(a);
+        STORE_REL_CORE_WORD(a, data [i]);
+      }
+#else
+    for (uint i = 0; i < n; i ++)
+      {
+        M[addr + i] = data [i] & DMASK;
+        MEM_INIT (addr + i);
+      }
 #endif
   }
 #endif
@@ -597,6 +568,7 @@ void iom_core_write_unlock (UNUSED uint iom_unit_idx, word24 addr, word36 data,
     STORE_REL_CORE_WORD(addr, data);
 #else
     M[addr] = data & DMASK;
+    MEM_INIT (addr);
 #endif
   }
 
@@ -1580,9 +1552,6 @@ static int status_service (uint iom_unit_idx, uint chan, bool marker)
     iom_chan_data_t * p = & iom_chan_data[iom_unit_idx][chan];
     // See page 33 and AN87 for format of y-pair of status info
     
-#ifdef THREADZ
-    lock_mem_wr ();
-#endif
 
     // BUG: much of the following is not tracked
     
@@ -1705,9 +1674,6 @@ static int status_service (uint iom_unit_idx, uint chan, bool marker)
       }
 
     iom_core_write_unlock (iom_unit_idx, scwAddr, scw, __func__);
-#ifdef THREADZ
-    unlock_mem ();
-#endif
 
     // BUG: update SCW in core
     return 0;
@@ -1755,6 +1721,9 @@ static void fetch_DDSPTW (uint iom_unit_idx, int chan, word18 addr)
     iom_chan_data_t * p = & iom_chan_data[iom_unit_idx][chan];
     word24 pgte = build_DDSPTW_address (p -> PCW_PAGE_TABLE_PTR, 
                                       (addr >> 10) & MASK8);
+    if (pgte == p -> PTW_DCW_addr)
+      return;
+    p -> PTW_DCW_addr = pgte;
     iom_core_read (iom_unit_idx, pgte, (word36 *) & p -> PTW_DCW, __func__);
     if ((p -> PTW_DCW & 0740000777747) != 04llu)
       sim_warn ("%s: chan %d addr %#o ptw %012"PRIo64"\n",
@@ -1792,6 +1761,9 @@ static void fetch_IDSPTW (uint iom_unit_idx, int chan, word18 addr)
     word24 pgte = build_IDSPTW_address (p -> PCW_PAGE_TABLE_PTR, 
                                       p -> SEG, 
                                       (addr >> 10) & MASK8);
+    if (pgte == p -> PTW_DCW_addr)
+      return;
+    p -> PTW_DCW_addr = pgte;
     iom_core_read (iom_unit_idx, pgte, (word36 *) & p -> PTW_DCW, __func__);
     if ((p -> PTW_DCW & 0740000777747) != 04llu)
       sim_warn ("%s: chan %d addr %#o ptw %012"PRIo64"\n",
@@ -1829,12 +1801,39 @@ static void fetch_LPWPTW (uint iom_unit_idx, uint chan)
     word24 addr = build_LPWPTW_address (p -> PCW_PAGE_TABLE_PTR, 
                                       p -> SEG,
                                       (p -> LPW_DCW_PTR >> 10) & MASK8);
+    if (addr == p -> PTW_LPW_addr)
+      return;
+    p -> PTW_LPW_addr = addr;
     iom_core_read (iom_unit_idx, addr, (word36 *) & p -> PTW_LPW, __func__);
     if ((p -> PTW_LPW & 0740000777747) != 04llu)
       sim_warn ("%s: chan %d addr %#o ptw %012"PRIo64"\n",
                 __func__, chan, addr, p -> PTW_LPW);
   }
 
+// Forget the cached PTWs and prefetched DCWs; done at each connect, as
+// the PCW may name a different page table.
+
+static void iom_chan_flush (uint iom_unit_idx, uint chan)
+  {
+    iom_chan_data_t * p = & iom_chan_data[iom_unit_idx][chan];
+    p -> PTW_DCW_addr = IOM_NO_PTW;
+    p -> PTW_LPW_addr = IOM_NO_PTW;
+    p -> dcw_buf_cnt = 0;
+  }
+
+// The channel has stored [addr, addr + n); drop anything cached from there.
+
+static void iom_chan_stored (iom_chan_data_t * p, word24 addr, uint n)
+  {
+    if (p -> dcw_buf_cnt && addr < p -> dcw_buf_addr + p -> dcw_buf_cnt &&
+        p -> dcw_buf_addr < addr + n)
+      p -> dcw_buf_cnt = 0;
+    if (p -> PTW_DCW_addr - addr < n)
+      p -> PTW_DCW_addr = IOM_NO_PTW;
+    if (p -> PTW_LPW_addr - addr < n)
+      p -> PTW_LPW_addr = IOM_NO_PTW;
+  }
+
 // 'write' means periperal write; i.e. the peripheral is writing to core after
 // reading media.
 
@@ -1869,13 +1868,17 @@ void iom_direct_data_service (uint iom_unit_idx, uint chan, word24 daddr, word36
       }
 
     if (op == direct_store)
-      iom_core_write (iom_unit_idx, daddr, * data, __func__);
+      {
+        iom_core_write (iom_unit_idx, daddr, * data, __func__);
+        iom_chan_stored (p, daddr, 1);
+      }
     else if (op == direct_load)
       iom_core_read (iom_unit_idx, daddr, data, __func__);
     else if (op == direct_read_clear)
       {
         iom_core_read_lock (iom_unit_idx, daddr, data, __func__);
         iom_core_write_unlock (iom_unit_idx, daddr, 0, __func__);
+        iom_chan_stored (p, daddr, 1);
       }
 #ifdef THREADZ
     // Force mailbox and dma data to be up-to-date 
@@ -1913,70 +1916,60 @@ void iom_indirect_data_service (uint iom_unit_idx, uint chan, word36 * data,
       }
     p -> tallyResidue = (word12) tally;
 
-    if (write)
+    // Move the data in runs that do not cross a page (paged mode) or the
+    // 256K wrap (unpaged), so that the PTW is fetched once per page and the
+    // words of each run go through iom_core_readN/iom_core_writeN.
+
+    uint c = write ? * cnt : 0;
+    while (p -> tallyResidue)
       {
-        uint c = * cnt;
-        while (p -> tallyResidue)
+        if (write && c == 0)
+          break; // read buffer exhausted; returns w/tallyResidue != 0
+
+        uint run = p -> tallyResidue;
+        if (write && run > c)
+          run = c;
+        word24 addr;
+        if (p -> PCW_63_PTP && p -> PCW_64_PGE)
           {
-            if (c == 0)
-              break; // read buffer exhausted; returns w/tallyResidue != 0
-   
-            if (p -> PCW_63_PTP && p -> PCW_64_PGE)
-              {
-                fetch_IDSPTW (iom_unit_idx, (int) chan, daddr);
-                word24 addr = ((word24) (getbits36_14 (p -> PTW_DCW, 4) << 10)) | (daddr & MASK10);
-                iom_core_write (iom_unit_idx, addr, * data, __func__);
-//sim_printf (" %o %08o %08o %012"PRIo64" %012"PRIo64"\n", p -> SEG, daddr, addr, * data, p -> PTW_DCW);
-              }
-            else
-              {
-                if (daddr > MASK18) // 256K overflow
-                  {
-                    sim_warn ("%s 256K ovf\n", __func__); // XXX
-                    daddr &= MASK18;
-                  }
-// If PTP is not set, we are in cm1e or cm2e. Both are 'EXT DCW', so
-// we can elide the mode check here.
-                uint daddr2 = daddr | (uint) p -> ADDR_EXT << 18;
-                iom_core_write (iom_unit_idx, daddr2, * data, __func__);
-              }
-            daddr ++;
-            data ++;
-            p -> tallyResidue --;
-            c --;
+            fetch_IDSPTW (iom_unit_idx, (int) chan, daddr);
+            addr = ((word24) (getbits36_14 (p -> PTW_DCW, 4) << 10)) | (daddr & MASK10);
+            uint left = 1024u - (daddr & MASK10);
+            if (run > left)
+              run = left;
           }
-      }
-    else // read
-      {
-        uint c = 0;
-        while (p -> tallyResidue)
+        else
           {
-            if (p -> PCW_63_PTP  && p -> PCW_64_PGE)
+// XXX assuming DCW_ABS
+            if (daddr > MASK18) // 256K overflow
               {
-                fetch_IDSPTW (iom_unit_idx, (int) chan, daddr);
-                word24 addr = ((word24) (getbits36_14 (p -> PTW_DCW, 4) << 10)) | (daddr & MASK10);
-                iom_core_read (iom_unit_idx, addr, data, __func__);
+                sim_warn ("%s 256K ovf\n", __func__); // XXX
+                daddr &= MASK18;
               }
-            else
-              {
-// XXX assuming DCW_ABS
-                if (daddr > MASK18) // 256K overflow
-                  {
-                    sim_warn ("%s 256K ovf\n", __func__); // XXX
-                    daddr &= MASK18;
-                  }
+            uint left = MASK18 + 1u - daddr;
+            if (run > left)
+              run = left;
 // If PTP is not set, we are in cm1e or cm2e. Both are 'EXT DCW', so
 // we can elide the mode check here.
-                uint daddr2 = daddr | (uint) p -> ADDR_EXT << 18;
-                iom_core_read (iom_unit_idx, daddr2, data, __func__);
-              }
-            daddr ++;
-            p -> tallyResidue --;
-            data ++;
-            c ++;
+            addr = daddr | (uint) p -> ADDR_EXT << 18;
+          }
+        if (write)
+          {
+            iom_core_writeN (iom_unit_idx, addr, data, run, __func__);
+            iom_chan_stored (p, addr, run);
+            c -= run;
+          }
+        else
+          {
+            iom_core_readN (iom_unit_idx, addr, data, run, __func__);
+            c += run;
           }
-        * cnt = c;
+        daddr += run;
+        data += run;
+        p -> tallyResidue = (word12) (p -> tallyResidue - run);
       }
+    if (! write)
+      * cnt = c;
 #ifdef THREADZ
     // Force mailbox and dma data to be up-to-date 
     fence ();
@@ -2290,6 +2283,56 @@ static void fetch_and_parse_PCW (uint iom_unit_idx, uint chan)
                p -> PCW_64_PGE, p -> PCW_PAGE_TABLE_PTR);
   }
  
+// Does the DCW end the segment of the list that can be fetched ahead; an
+// IOTD ends the list, a TDCW sends it elsewhere, and software may rework
+// the list while the device runs an IDCW's command.
+
+static bool dcw_ends_run (word36 dcw)
+  {
+    if (getbits36_3 (dcw, 18) == 07) // IDCW
+      return true;
+    word2 type = getbits36_2 (dcw, 22);
+    return type == 0 || type == 2;
+  }
+
+// Fetch the DCW at addr into p -> DCW. On a miss, the list is read
+// ahead from addr to the end of the segment and no further, bounded by
+// 'left', the words from addr to the end of its page or 256K block, and
+// by the LPW tally.
+
+static void fetch_DCW (uint iom_unit_idx, uint chan, word24 addr, uint left)
+  {
+    iom_chan_data_t * p =  & iom_chan_data[iom_unit_idx][chan];
+
+    uint i = addr - p -> dcw_buf_addr;
+    if (i < p -> dcw_buf_cnt)
+      {
+        p -> DCW = p -> dcw_buf[i];
+        return;
+      }
+
+    // LPW 21 (NC): the DCW pointer does not move; read the word each time.
+    if (p -> LPW_21_NC)
+      {
+        iom_core_read (iom_unit_idx, addr, (word36 *) & p -> DCW, __func__);
+        return;
+      }
+
+    uint n = left < IOM_DCW_PREFETCH ? left : IOM_DCW_PREFETCH;
+    if (p -> LPW_22_TAL && p -> LPW_TALLY && n > p -> LPW_TALLY)
+      n = p -> LPW_TALLY;
+    for (i = 0; i < n; )
+      {
+        iom_core_read (iom_unit_idx, addr + i, (word36 *) & p -> dcw_buf[i],
+                       __func__);
+        if (dcw_ends_run (p -> dcw_buf[i ++]))
+          break;
+      }
+    p -> dcw_buf_addr = addr;
+    p -> dcw_buf_cnt = i;
+    p -> DCW = p -> dcw_buf[0];
+  }
+
 static void fetch_and_parse_DCW (uint iom_unit_idx, uint chan, UNUSED bool read_only)
   {
     iom_chan_data_t * p =  & iom_chan_data[iom_unit_idx][chan];
@@ -2329,7 +2372,7 @@ sim_warn ("unhandled fetch_and_parse_DCW\n");
         case cm1:
         case cm1e:
           {
-            iom_core_read (iom_unit_idx, addr, (word36 *) & p -> DCW, __func__);
+            fetch_DCW (iom_unit_idx, chan, addr, 01000000u - addr);
           }
           break;
 
@@ -2339,7 +2382,8 @@ sim_warn ("unhandled fetch_and_parse_DCW\n");
 // LPXW_BOUND is mod 2; ie. val is * 2
             //addr |= ((word24) p -> LPWX_BOUND << 18);
             addr += ((word24) p -> LPWX_BOUND << 1);
-            iom_core_read (iom_unit_idx, addr, (word36 *) & p -> DCW, __func__);
+            fetch_DCW (iom_unit_idx, chan, addr,
+                       01000000u - (p -> LPW_DCW_PTR & MASK18));
           }
           break;
 
@@ -2358,7 +2402,8 @@ sim_warn ("unhandled fetch_and_parse_DCW\n");
             // Calculate effective address
             // PTW 4-17 || LPW 8-17
             word24 addr_ = ((word24) (getbits36_14 (p -> PTW_LPW, 4) << 10)) | ((p -> LPW_DCW_PTR) & MASK10);
-            iom_core_read (iom_unit_idx, addr_, (word36 *) & p -> DCW, __func__);
+            fetch_DCW (iom_unit_idx, chan, addr_,
+                       1024u - (p -> LPW_DCW_PTR & MASK10));
           }
           break;
       }
@@ -2367,6 +2412,14 @@ sim_warn ("unhandled fetch_and_parse_DCW\n");
                __func__, chan, p -> DCW);
     unpack_DCW (iom_unit_idx, chan);
 
+    // Software may change the page tables along with the list; the
+    // PTWs are refetched after each IDCW or TDCW.
+    if (p -> DCW_18_20_CP == 07 || p -> DDCW_22_23_TYPE == 02)
+      {
+        p -> PTW_DCW_addr = IOM_NO_PTW;
+        p -> PTW_LPW_addr = IOM_NO_PTW;
+      }
+
     if (p -> DCW_18_20_CP == 07)
       sim_debug (DBG_DEBUG, & iom_dev,
                  "%s: chan %d idcw: dev_cmd %#o dev_code %#o ae %#o ec %d control %#o chan_cmd %#o data %#o\n",
@@ -2398,9 +2451,6 @@ int send_general_interrupt (uint iom_unit_idx, uint chan, enum iomImwPics pic)
 #ifdef IO_FENCE
     fence ();
 #endif
-#ifdef THREADZ
-    lock_mem_wr ();
-#endif
 
     uint imw_addr;
     uint chan_group = chan < 32 ? 1 : 0;
@@ -2439,9 +2489,6 @@ int send_general_interrupt (uint iom_unit_idx, uint chan, enum iomImwPics pic)
                "%s: IMW at %#o now %012"PRIo64"\n", __func__, imw_addr, imw);
     iom_core_write_unlock (iom_unit_idx, imw_addr, imw, __func__);
     
-#ifdef THREADZ
-    unlock_mem ();
-#endif
 
 #ifdef THREADZ
     // Force mailbox and dma data to be up-to-date 
@@ -2455,9 +2502,6 @@ static void iom_fault (uint iom_unit_idx, uint chan, UNUSED const char * who,
                       iomFaultServiceRequest req,
                       iomSysFaults_t signal)
   {
-#ifdef THREADZ
-    lock_mem_wr ();
-#endif
     sim_warn ("iom_fault %s\n", who);
 
     // iom_chan_data_t * p = & iom_chan_data[iom_unit_idx][chan];
@@ -2523,9 +2567,6 @@ static void iom_fault (uint iom_unit_idx, uint chan, UNUSED const char * who,
     iom_core_write_unlock (iom_unit_idx, chanloc + IOM_MBX_DCW, dcw, __func__);
 
     send_general_interrupt (iom_unit_idx, IOM_SYSTEM_FAULT_CHAN, imwSystemFaultPic);
-#ifdef THREADZ
-    unlock_mem ();
-#endif
   }
 
 // 0 ok
@@ -2962,6 +3003,7 @@ static int do_payload_chan (uint iom_unit_idx, uint chan)
     p->isPCW = true;
 
     p->masked = !!p->PCW_21_MSK;
+    iom_chan_flush (iom_unit_idx, chan);
     struct iom_to_ctlr_s * d = & cables->iom_to_ctlr[iom_unit_idx][chan];
 
 // A device command of 051 in the PCW is only meaningful to the operator console;
@@ -3145,6 +3187,303 @@ done:;
     return 0;
   }
 
+#ifdef IOM_ASYNC
+// Asynchronous channel engine
+//
+// The connect channel runs on the CPU that did the CIOC, holding only its
+// IOM's connect lock. Each PCW it takes is posted to the payload channel's
+// mailbox (iom_chan_mbx) and the channel is pushed onto iom_runq; a small
+// pool of worker threads runs the payload channels and sends the terminate
+// interrupts. The CPU never waits for a device.
+//
+// A channel is on the queue or being run at most once (queued), so the
+// queue can not fill. A connect for a channel that is already queued only
+// replaces the mailbox PCW; the worker that has the channel keeps taking
+// PCWs until the mailbox stays empty, so a channel's connects run in order
+// and on one worker at a time.
+//
+// A payload runs holding its controller's lock, so the channels of one
+// controller run one at a time and different controllers run in parallel.
+// Device code that uses libuv takes the libuv lock itself, around the libuv
+// work, as it does for IO_THREADZ. Lock order is controller, then libuv.
+// The socket and card reader event passes take their controller locks
+// under the libuv lock; that is safe because the socket and unit record
+// handlers never take the libuv lock.
+
+#define IOM_WORKERS 2
+// N_IOM_UNITS_MAX * MAX_CHANNELS, rounded up to a power of two
+#define IOM_RUNQ_SIZE 256
+
+// Bounded multi-producer, multi-consumer ring; each slot's sequence
+// number says whether it is free for the producer or full for the
+// consumer at the current lap.
+
+static struct
+  {
+    uint seq;
+    uint id;
+  } iom_runq [IOM_RUNQ_SIZE];
+static uint iom_runq_head, iom_runq_tail;
+
+typedef struct
+  {
+    pthread_mutex_t lock;  // held only to post or take a PCW
+    bool queued;           // on iom_runq or being run
+    bool pending;          // holds a PCW the worker hasn't taken
+    word36 PCW1;
+    word36 DCW;
+    word18 PCW_PAGE_TABLE_PTR;
+    word6 PCW_AE;
+    word1 PCW_63_PTP;
+    word1 PCW_64_PGE;
+    word1 PCW_65_AUX;
+    word1 PCW_21_MSK;
+  } iom_chan_mbx_t;
+
+static iom_chan_mbx_t iom_chan_mbx [N_IOM_UNITS_MAX] [MAX_CHANNELS];
+
+static pthread_mutex_t iom_connect_lock [N_IOM_UNITS_MAX];
+
+// Indexed by controller type and unit; N_SKC_UNITS_MAX is the most units
+// of any controller type.
+static pthread_mutex_t ctlr_lock [CTLR_T_SKC + 1] [N_SKC_UNITS_MAX];
+
+static uint iom_idle;  // workers waiting on iom_idle_cond
+static uint iom_nqueued;  // channels queued or running
+static pthread_mutex_t iom_idle_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t iom_idle_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t iom_drain_cond = PTHREAD_COND_INITIALIZER;
+
+void lock_ctlr (uint ctlr_type, uint ctlr_unit_idx)
+  {
+    lock_ptr (& ctlr_lock [ctlr_type] [ctlr_unit_idx]);
+  }
+
+void unlock_ctlr (uint ctlr_type, uint ctlr_unit_idx)
+  {
+    unlock_ptr (& ctlr_lock [ctlr_type] [ctlr_unit_idx]);
+  }
+
+static bool iom_runq_push (uint id)
+  {
+    uint pos = __atomic_load_n (& iom_runq_tail, __ATOMIC_RELAXED);
+    for (;;)
+      {
+        uint seq = __atomic_load_n (& iom_runq [pos % IOM_RUNQ_SIZE].seq,
+                                    __ATOMIC_ACQUIRE);
+        int dif = (int) (seq - pos);
+        if (dif == 0)
+          {
+            if (__atomic_compare_exchange_n (& iom_runq_tail, & pos, pos + 1,
+                                             true, __ATOMIC_RELAXED,
+                                             __ATOMIC_RELAXED))
+              break;
+          }
+        else if (dif < 0)
+          return false; // full
+        else
+          pos = __atomic_load_n (& iom_runq_tail, __ATOMIC_RELAXED);
+      }
+    iom_runq [pos % IOM_RUNQ_SIZE].id = id;
+    __atomic_store_n (& iom_runq [pos % IOM_RUNQ_SIZE].seq, pos + 1,
+                      __ATOMIC_RELEASE);
+    return true;
+  }
+
+static bool iom_runq_pop (uint * id)
+  {
+    uint pos = __atomic_load_n (& iom_runq_head, __ATOMIC_RELAXED);
+    for (;;)
+      {
+        uint seq = __atomic_load_n (& iom_runq [pos % IOM_RUNQ_SIZE].seq,
+                                    __ATOMIC_ACQUIRE);
+        int dif = (int) (seq - (pos + 1));
+        if (dif == 0)
+          {
+            if (__atomic_compare_exchange_n (& iom_runq_head, & pos, pos + 1,
+                                             true, __ATOMIC_RELAXED,
+                                             __ATOMIC_RELAXED))
+              break;
+          }
+        else if (dif < 0)
+          return false; // empty
+        else
+          pos = __atomic_load_n (& iom_runq_head, __ATOMIC_RELAXED);
+      }
+    * id = iom_runq [pos % IOM_RUNQ_SIZE].id;
+    __atomic_store_n (& iom_runq [pos % IOM_RUNQ_SIZE].seq,
+                      pos + IOM_RUNQ_SIZE, __ATOMIC_RELEASE);
+    return true;
+  }
+
+// Move the mailbox PCW into the channel. Returns false, and takes the
+// channel off the queue, if there is none.
+
+static bool iom_mbx_take (uint iom_unit_idx, uint chan)
+  {
+    iom_chan_data_t * q = & iom_chan_data [iom_unit_idx] [chan];
+    iom_chan_mbx_t * m = & iom_chan_mbx [iom_unit_idx] [chan];
+
+    lock_ptr (& m -> lock);
+    if (! m -> pending)
+      {
+        m -> queued = false;
+        unlock_ptr (& m -> lock);
+        if (__atomic_sub_fetch (& iom_nqueued, 1, __ATOMIC_SEQ_CST) == 0)
+          {
+            pthread_mutex_lock (& iom_idle_lock);
+            pthread_cond_broadcast (& iom_drain_cond);
+            pthread_mutex_unlock (& iom_idle_lock);
+          }
+        return false;
+      }
+    q -> PCW1 =               m -> PCW1;
+    q -> PCW_CHAN =           (word6) chan;
+    q -> PCW_AE =             m -> PCW_AE;
+    q -> PCW_PAGE_TABLE_PTR = m -> PCW_PAGE_TABLE_PTR;
+    q -> PCW_63_PTP =         m -> PCW_63_PTP;
+    q -> PCW_64_PGE =         m -> PCW_64_PGE;
+    q -> PCW_65_AUX =         m -> PCW_65_AUX;
+    q -> PCW_21_MSK =         m -> PCW_21_MSK;
+    q -> DCW =                m -> DCW;
+    m -> pending = false;
+    unlock_ptr (& m -> lock);
+
+    q -> masked = q -> PCW_21_MSK;
+    if (q -> masked)
+      {
+        if (q -> in_use)
+          sim_warn ("%s: chan %d masked while in use\n", __func__, chan);
+        q -> in_use = false;
+        q -> start  = false;
+      }
+    else
+      {
+        if (q -> in_use)
+          sim_warn ("%s: chan %d connect while in use\n", __func__, chan);
+        q -> in_use = true;
+        q -> start  = true;
+      }
+    return true;
+  }
+
+// Run a queued channel until its mailbox stays empty.
+
+static void iom_async_run (uint id)
+  {
+    uint iom_unit_idx = id / MAX_CHANNELS;
+    uint chan = id % MAX_CHANNELS;
+    iom_chan_data_t * q = & iom_chan_data [iom_unit_idx] [chan];
+    struct iom_to_ctlr_s * ctlrp = & cables->iom_to_ctlr [iom_unit_idx] [chan];
+
+    lock_ctlr (ctlrp -> ctlr_type, ctlrp -> ctlr_unit_idx);
+    while (iom_mbx_take (iom_unit_idx, chan))
+      {
+        while (q -> start)
+          {
+            q -> start = false;
+            do_payload_chan (iom_unit_idx, chan);
+          }
+      }
+    unlock_ctlr (ctlrp -> ctlr_type, ctlrp -> ctlr_unit_idx);
+  }
+
+static void * iom_worker_main (UNUSED void * arg)
+  {
+// Set CPU context to allow sim_debug to work
+
+    set_cpu_idx (0);
+    setSignals ();
+    for (;;)
+      {
+        uint id;
+        if (! iom_runq_pop (& id))
+          {
+            pthread_mutex_lock (& iom_idle_lock);
+            __atomic_add_fetch (& iom_idle, 1, __ATOMIC_SEQ_CST);
+            __atomic_thread_fence (__ATOMIC_SEQ_CST);
+            while (! iom_runq_pop (& id))
+              pthread_cond_wait (& iom_idle_cond, & iom_idle_lock);
+            __atomic_sub_fetch (& iom_idle, 1, __ATOMIC_SEQ_CST);
+            pthread_mutex_unlock (& iom_idle_lock);
+          }
+        iom_async_run (id);
+      }
+    return NULL;
+  }
+
+// The workers are started by the first connect, once cpus is set up.
+
+static void iom_async_init (void)
+  {
+    for (uint i = 0; i < IOM_RUNQ_SIZE; i ++)
+      iom_runq [i] . seq = i;
+    for (uint i = 0; i < IOM_WORKERS; i ++)
+      {
+        pthread_t thread;
+        int rc = pthread_create (& thread, NULL, iom_worker_main, NULL);
+        if (rc)
+          sim_fatal ("%s: pthread_create %d\n", __func__, rc);
+        pthread_detach (thread);
+      }
+  }
+
+// Post the connect channel's PCW to its payload channel and queue the
+// channel for the workers if it isn't queued already.
+
+static void iom_async_connect (uint iom_unit_idx, iom_chan_data_t * p)
+  {
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    pthread_once (& once, iom_async_init);
+
+    uint chan = p -> PCW_CHAN;
+    iom_chan_mbx_t * m = & iom_chan_mbx [iom_unit_idx] [chan];
+
+    lock_ptr (& m -> lock);
+    m -> PCW1 =               p -> PCW1;
+    m -> PCW_AE =             p -> PCW_AE;
+    m -> PCW_PAGE_TABLE_PTR = p -> PCW_PAGE_TABLE_PTR;
+    m -> PCW_63_PTP =         p -> PCW_63_PTP;
+    m -> PCW_64_PGE =         p -> PCW_64_PGE;
+    m -> PCW_65_AUX =         p -> PCW_65_AUX;
+    m -> PCW_21_MSK =         p -> PCW_21_MSK;
+    m -> DCW =                p -> DCW;
+    m -> pending = true;
+    bool queued = m -> queued;
+    m -> queued = true;
+    unlock_ptr (& m -> lock);
+    if (queued)
+      return;
+
+    __atomic_add_fetch (& iom_nqueued, 1, __ATOMIC_SEQ_CST);
+    uint id = iom_unit_idx * MAX_CHANNELS + chan;
+    if (! iom_runq_push (id))
+      {
+        // Can't happen; run it here rather than lose it
+        sim_warn ("%s: run queue full\n", __func__);
+        iom_async_run (id);
+        return;
+      }
+    __atomic_thread_fence (__ATOMIC_SEQ_CST);
+    if (__atomic_load_n (& iom_idle, __ATOMIC_SEQ_CST))
+      {
+        pthread_mutex_lock (& iom_idle_lock);
+        pthread_cond_signal (& iom_idle_cond);
+        pthread_mutex_unlock (& iom_idle_lock);
+      }
+  }
+
+// Wait for the workers to finish every queued connect.
+
+static void iom_async_drain (void)
+  {
+    pthread_mutex_lock (& iom_idle_lock);
+    while (__atomic_load_n (& iom_nqueued, __ATOMIC_SEQ_CST))
+      pthread_cond_wait (& iom_drain_cond, & iom_idle_lock);
+    pthread_mutex_unlock (& iom_idle_lock);
+  }
+#endif
+
 // do_connect_chan ()
 //
 // Process the "connect channel".  This is what the IOM does when it
@@ -3172,6 +3511,7 @@ static int do_connect_chan (uint iom_unit_idx)
 int loops = 0;
     iom_chan_data_t * p = & iom_chan_data[iom_unit_idx][IOM_CONNECT_CHAN];
     p -> lsFirst = true;
+    iom_chan_flush (iom_unit_idx, IOM_CONNECT_CHAN);
     bool ptro, send, uff;
     do
       {
@@ -3194,6 +3534,10 @@ int loops = 0;
           {
             // Copy the PCW's DCW to the payload channel
 loops ++;
+#ifdef IOM_ASYNC
+            // The payload channel may be running; its worker takes the PCW
+            iom_async_connect (iom_unit_idx, p);
+#else
             iom_chan_data_t * q = & iom_chan_data[iom_unit_idx][p -> PCW_CHAN];
 
             q -> PCW0 =               q -> PCW0;
@@ -3233,6 +3577,7 @@ loops ++;
 #endif
 #endif
               }
+#endif // IOM_ASYNC
           }
       } while (! ptro);
 if (loops > 1) sim_printf ("%d loops\r\n", loops);
@@ -3272,9 +3617,6 @@ int send_special_interrupt (uint iom_unit_idx, uint chan, uint devCode,
     if (iom_chan_data [iom_unit_idx] [chan] . masked)
       return(0);
     
-#ifdef THREADZ
-    lock_mem_wr ();
-#endif
 #ifdef LOCKLESS
     lock_iom();
 #endif
@@ -3317,9 +3659,6 @@ int send_special_interrupt (uint iom_unit_idx, uint chan, uint devCode,
       dcw = scw; // reset to beginning of queue
     iom_core_write_unlock (iom_unit_idx, chanloc + IOM_MBX_DCW, dcw, __func__);
 
-#ifdef THREADZ
-    unlock_mem ();
-#endif
 #ifdef LOCKLESS
     unlock_iom();
 #endif
@@ -3362,7 +3701,14 @@ void iom_interrupt (uint scu_unit_idx, uint iom_unit_idx)
     setIOMInterrupt (iom_unit_idx);
     iomDoneWait (iom_unit_idx);
 #else
+#ifdef IOM_ASYNC
+    // Serializes this IOM's connect channel only; the payloads run elsewhere
+    lock_ptr (& iom_connect_lock [iom_unit_idx]);
+#endif
     int ret = do_connect_chan (iom_unit_idx);
+#ifdef IOM_ASYNC
+    unlock_ptr (& iom_connect_lock [iom_unit_idx]);
+#endif
 
     sim_debug (DBG_DEBUG, & iom_dev,
                "%s: IOM %c finished; do_connect_chan returned %d.\n",
@@ -3431,6 +3777,35 @@ void * iom_thread_main (void * arg)
 void iom_init (void)
   {
     sim_debug (DBG_INFO, & iom_dev, "%s: running.\n", __func__);
+#ifdef IOM_ASYNC
+    for (uint i = 0; i < N_IOM_UNITS_MAX; i ++)
+      {
+        pthread_mutex_init (& iom_connect_lock [i], NULL);
+        for (uint j = 0; j < MAX_CHANNELS; j ++)
+          pthread_mutex_init (& iom_chan_mbx [i] [j] . lock, NULL);
+      }
+    for (uint i = 0; i <= CTLR_T_SKC; i ++)
+      for (uint j = 0; j < N_SKC_UNITS_MAX; j ++)
+        pthread_mutex_init (& ctlr_lock [i] [j], NULL);
+#endif
+  }
+
+// Finish every connect posted to the payload channels, so that no worker
+// stores into memory or interrupts while a snapshot is saved or restored.
+
+void iom_quiesce (void)
+  {
+#ifdef IOM_ASYNC
+    iom_async_drain ();
+#endif
+  }
+
+// Machine snapshot; the caller has quiesced the IOMs (iom_quiesce).
+
+void iom_snap (struct snap_s * s)
+  {
+    snap_io (s, "iomunit", iom_unit_data, sizeof (iom_unit_data));
+    snap_io (s, "iomchan", (void *) iom_chan_data, sizeof (iom_chan_data));
   }
 
 t_stat boot2 (UNUSED int32 arg, UNUSED const char * buf)
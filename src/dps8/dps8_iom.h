@@ -165,8 +165,22 @@ typedef volatile struct
     word36 PTW_LPW;  // pg B6.
 
 // pg b11 defines two PTW flags to indicate the validity of the
-// PTW_DCW and PTW_LPW; it is simpler to simply always fetch 
-// the PTWs on demand.
+// PTW_DCW and PTW_LPW. The PTWs are fetched on demand and kept until
+// the next IDCW, TDCW or connect; PTW_DCW_addr and PTW_LPW_addr are the
+// core addresses they came from, or IOM_NO_PTW.
+
+#define IOM_NO_PTW (~0u)
+    uint PTW_DCW_addr;
+    uint PTW_LPW_addr;
+
+// DCW list prefetch: the segment of the list starting at core address
+// dcw_buf_addr, up to and including the first IDCW, IOTD or TDCW.
+// Dropped at the next connect or when the channel stores into it.
+
+#define IOM_DCW_PREFETCH 16
+    word36 dcw_buf [IOM_DCW_PREFETCH];
+    uint dcw_buf_addr;
+    uint dcw_buf_cnt;
 
 //  flag
     //chanMode_t chanMode;
@@ -324,6 +338,9 @@ void iom_direct_data_service (uint iom_unit_idx, uint chan, word24 daddr, word36
 void iom_indirect_data_service (uint iom_unit_idx, uint chan, word36 * data,
                              uint * cnt, bool write);
 void iom_init (void);
+struct snap_s;
+void iom_quiesce (void);
+void iom_snap (struct snap_s * s);
 int send_marker_interrupt (uint iom_unit_idx, int chan);
 #ifdef PANEL
 void do_boot (void);
@@ -332,6 +349,11 @@ void do_boot (void);
 void * iom_thread_main (void * arg);
 void * chan_thread_main (void * arg);
 #endif
+#ifdef IOM_ASYNC
+// Held by a worker while it runs a payload for the controller
+void lock_ctlr (uint ctlr_type, uint ctlr_unit_idx);
+void unlock_ctlr (uint ctlr_type, uint ctlr_unit_idx);
+#endif
 #ifdef SCUMEM
 int query_IOM_SCU_bank_map (uint iom_unit_idx, word24 addr, word24 * offset);
 #endif
@@ -340,6 +362,8 @@ void iom_core_read (uint iom_unit_idx, word24 addr, word36 *data, UNUSED const c
 void iom_core_read2 (uint iom_unit_idx, word24 addr, word36 *even, word36 *odd, UNUSED const char * ctx);
 void iom_core_write (uint iom_unit_idx, word24 addr, word36 data, UNUSED const char * ctx);
 void iom_core_write2 (uint iom_unit_idx, word24 addr, word36 even, word36 odd, UNUSED const char * ctx);
+void iom_core_readN (uint iom_unit_idx, word24 addr, word36 * data, uint n, UNUSED const char * ctx);
+void iom_core_writeN (uint iom_unit_idx, word24 addr, word36 * data, uint n, UNUSED const char * ctx);
 #ifdef LOCKLESS
 void iom_core_read_lock (uint iom_unit_idx, word24 addr, word36 *data, UNUSED const char * ctx);
 void iom_core_write_unlock (uint iom_unit_idx, word24 addr, word36 data, UNUSED const char * ctx);
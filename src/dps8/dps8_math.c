@@ -539,7 +539,9 @@ void ufa (bool sub)
     cpu.ou.cycle |= ou_GOE;   
 #endif
     int shift_count = -1;
+#ifdef NEED_128
     word1 allones = 1;
+#endif
     word1 notallzeros = 0;
     //word1 last = 0;
     if (e1 == e2)
@@ -575,16 +577,7 @@ void ufa (bool sub)
         m1 = and_128 (m1, MASK72);
         e3 = e2;
 #else
-        bool sign = m1 & SIGN72;   // mantissa negative?
-        for(int n = 0 ; n < shift_count ; n += 1)
-        {
-            //last = m1 & 1;
-            allones &= m1 & 1;
-            notallzeros |= m1 & 1;
-            m1 >>= 1;
-            if (sign)
-                m1 |= SIGN72;
-        }
+        m1 = shiftRight72 (m1, shift_count, & notallzeros);
         
 #ifdef HEX_MODE
         if (m1 == MASK72 && notallzeros == 1 && shift_count * (int) shift_amt > 71)
@@ -626,16 +619,7 @@ void ufa (bool sub)
         m2 = and_128 (m2, MASK72);
         e3 = e1;
 #else
-        bool sign = m2 & SIGN72;   // mantissa negative?
-        for(int n = 0 ; n < shift_count ; n += 1)
-        {
-            //last = m2 & 1;
-            allones &= m2 & 1;
-            notallzeros |= m2 & 1;
-            m2 >>= 1;
-            if (sign)
-                m2 |= SIGN72;
-        }
+        m2 = shiftRight72 (m2, shift_count, & notallzeros);
 #ifdef HEX_MODE
         if (m2 == MASK72 && notallzeros == 1 && shift_count * (int) shift_amt > 71)
           m2 = 0;
@@ -940,13 +924,9 @@ void fno (word8 * E, word36 * A, word36 * Q)
             m = and_128 (m, MASK71);
             m = or_128 (m, SIGN72);
 #else
-            while ((m & HEX_NORM) == HEX_NORM) 
-              {
-//if (m == 0) // XXX: necessary??
-//    break;
-                m <<= 4;
-                e -= 1;
-              }
+            int n = normalizeShift72 (m, 4);
+            m <<= 4 * n;
+            e -= n;
             m &= MASK71;
             m |= SIGN72;
 #endif
@@ -967,13 +947,9 @@ void fno (word8 * E, word36 * A, word36 * Q)
 #else
             // Positive
             // Until bits 1-4 != 0
-            // Termination guarantee: m is known to be non-zero; a non-zero
-            // bit will eventually be shifted into bits 1-4.
-            while ((m & HEX_NORM) == 0)
-              {
-                m <<= 4;
-                e -= 1;
-              }
+            int n = normalizeShift72 (m, 4);
+            m <<= 4 * n;
+            e -= n;
             m &= MASK71;
 #endif
           }
@@ -994,13 +970,9 @@ void fno (word8 * E, word36 * A, word36 * Q)
         if (s)
           m = or_128 (m, SIGN72);
 #else
-        while (s  == !! (m & BIT71)) // until C(AQ)0 != C(AQ)1?
-        {
-            m <<= 1;
-            e -= 1;
-            //if (m == 0) // XXX: necessary??
-            //    break;
-        }
+        int n = normalizeShift72 (m, 1); // until C(AQ)0 != C(AQ)1
+        m <<= n;
+        e -= n;
 
         m &= MASK71;
         
@@ -1023,13 +995,9 @@ void fno (word8 * E, word36 * A, word36 * Q)
     if (s)
       m = or_128 (m, SIGN72);
 #else
-    while (s  == !! (m & BIT71)) // until C(AQ)0 != C(AQ)1?
-    {
-        m <<= 1;
-        e -= 1;
-        //if (m == 0) // XXX: necessary??
-        //    break;
-    }
+    int n = normalizeShift72 (m, 1); // until C(AQ)0 != C(AQ)1
+    m <<= n;
+    e -= n;
 
     m &= MASK71;
         
@@ -1574,17 +1542,17 @@ static void fdvX(bool bInvert)
         e1 += 1;
     }
 #else
-    while (m1 >= m2) // DH02 (equivalent but perhaps clearer description):
-                     // dividend exponent C(E) increased accordingly until | C(AQ)0,71 | < | C(Y)8,35 with zero fill |
+    // DH02 (equivalent but perhaps clearer description):
+    // dividend exponent C(E) increased accordingly until | C(AQ)0,71 | < | C(Y)8,35 with zero fill |
     // We have already taken the absolute value so just shift it
-    {
 #ifdef HEX_MODE
-        m1 >>= shift_amt;
+    int n = divideShift72 (m1, m2, shift_amt);
+    m1 >>= (uint) n * shift_amt;
 #else
-        m1 >>= 1;
+    int n = divideShift72 (m1, m2, 1);
+    m1 >>= n;
 #endif
-        e1 += 1;
-    }
+    e1 += n;
 #endif
 
     int e3 = e1 - e2;
@@ -1923,28 +1891,19 @@ void fcmp(void)
 #else
         shift_count = abs(e2 - e1);
 #endif
-        // mantissa negative?
 #ifdef NEED_128
+        // mantissa negative?
         bool s = isnonzero_128 (and_128 (m1, SIGN72));
-#else
-        bool s = (m1 & SIGN72) != (word72)0;
-#endif
-        for(int n = 0; n < shift_count; n += 1)
+        for(int n = 0 ; n < shift_count ; n += 1)
           {
-#ifdef NEED_128
             notallzeros |= m1.l & 1;
             m1 = rshift_128 (m1, 1);
-#else
-            notallzeros |= m1 & 1;
-            m1 >>= 1;
-#endif
             if (s)
-#ifdef NEED_128
               m1 = or_128 (m1, SIGN72);
+          }
 #else
-              m1 |= SIGN72;
+        m1 = shiftRight72 (m1, shift_count, & notallzeros);
 #endif
-          }
 #ifdef NEED_128
 #ifdef HEX_MODE
         if (iseq_128 (m1, MASK72) && notallzeros == 1 && shift_count * (int) shift_amt > 71)
@@ -1976,28 +1935,19 @@ void fcmp(void)
 #else
         shift_count = abs(e1 - e2);
 #endif
-        // mantissa negative?
 #ifdef NEED_128
+        // mantissa negative?
         bool s = isnonzero_128 (and_128 (m2, SIGN72));
-#else
-        bool s = (m2 & SIGN72) != (word72)0;
-#endif
         for(int n = 0 ; n < shift_count ; n += 1)
           {
-#ifdef NEED_128
             notallzeros |= m2.l & 1;
             m2 = rshift_128 (m2, 1);
-#else
-            notallzeros |= m2 & 1;
-            m2 >>= 1;
-#endif
             if (s)
-#ifdef NEED_128
               m2 = or_128 (m2, SIGN72);
+          }
 #else
-              m2 |= SIGN72;
+        m2 = shiftRight72 (m2, shift_count, & notallzeros);
 #endif
-          }
 #ifdef NEED_128
 #ifdef HEX_MODE
         if (iseq_128 (m2, MASK72) && notallzeros == 1 && shift_count * (int) shift_amt > 71)
@@ -2106,25 +2056,16 @@ void fcmg ()
 #endif
 #ifdef NEED_128
         bool s = isnonzero_128 (and_128 (m1, SIGN72));
-#else
-        bool s = (m1 & SIGN72) != (word72)0;    ///< save sign bit
-#endif
         for(int n = 0 ; n < shift_count ; n += 1)
           {
-#ifdef NEED_128
             notallzeros |= m1.l & 1;
             m1 = rshift_128 (m1, 1);
-#else
-            notallzeros |= m1 & 1;
-            m1 >>= 1;
-#endif
             if (s)
-#ifdef NEED_128
               m1 = or_128 (m1, SIGN72);
+          }
 #else
-              m1 |= SIGN72;
+        m1 = shiftRight72 (m1, shift_count, & notallzeros);
 #endif
-          }
 
 #ifdef NEED_128
 #ifdef HEX_MODE
@@ -2160,25 +2101,16 @@ void fcmg ()
 #endif
 #ifdef NEED_128
         bool s = isnonzero_128 (and_128 (m2, SIGN72));
-#else
-        bool s = (m2 & SIGN72) != (word72)0;    ///< save sign bit
-#endif
         for(int n = 0 ; n < shift_count ; n += 1)
           {
-#ifdef NEED_128
             notallzeros |= m2.l & 1;
             m2 = rshift_128 (m2, 1);
-#else
-            notallzeros |= m2 & 1;
-            m2 >>= 1;
-#endif
             if (s)
-#ifdef NEED_128
               m2 = or_128 (m2, SIGN72);
+          }
 #else
-              m2 |= SIGN72;
+        m2 = shiftRight72 (m2, shift_count, & notallzeros);
 #endif
-          }
 #ifdef NEED_128
 #ifdef HEX_MODE
         if (iseq_128 (m2, MASK72) && notallzeros == 1 && shift_count * (int) shift_amt > 71)
@@ -2415,28 +2347,19 @@ void dufa (bool subtract)
 #else
         shift_count = abs(e2 - e1);
 #endif
-        // mantissa negative?
 #ifdef NEED_128
+        // mantissa negative?
         bool s = isnonzero_128 (and_128 (m1, SIGN72));
-#else
-        bool s = (m1 & SIGN72) != (word72)0;
-#endif
         for(int n = 0 ; n < shift_count ; n += 1)
           {
-#ifdef NEED_128
             notallzeros |= m1.l & 1;
             m1 = rshift_128 (m1, 1);
-#else
-            notallzeros |= m1 & 1;
-            m1 >>= 1;
-#endif
             if (s)
-#ifdef NEED_128
               m1 = or_128 (m1, SIGN72);
+          }
 #else
-              m1 |= SIGN72;
+        m1 = shiftRight72 (m1, shift_count, & notallzeros);
 #endif
-          }
 #ifdef NEED_128
 #ifdef HEX_MODE
         if (iseq_128 (m1, MASK72) && notallzeros == 1 && shift_count * (int) shift_amt > 71)
@@ -2471,25 +2394,16 @@ void dufa (bool subtract)
 #endif
 #ifdef NEED_128
         bool s = isnonzero_128 (and_128 (m2, SIGN72));
-#else
-        bool s = (m2 & SIGN72) != (word72)0;    ///< save sign bit
-#endif
         for(int n = 0 ; n < shift_count ; n += 1)
           {
-#ifdef NEED_128
             notallzeros |= m2.l & 1;
             m2 = rshift_128 (m2, 1);
-#else
-            notallzeros |= m2 & 1;
-            m2 >>= 1;
-#endif
             if (s)
-#ifdef NEED_128
               m2 = or_128 (m2, SIGN72);
+          }
 #else
-              m2 |= SIGN72;
+        m2 = shiftRight72 (m2, shift_count, & notallzeros);
 #endif
-          }
 #ifdef NEED_128
 #ifdef HEX_MODE
         if (iseq_128 (m2, MASK72) && notallzeros == 1 && shift_count * (int) shift_amt > 71)
@@ -3079,15 +2993,14 @@ static void dfdvX (bool bInvert)
         e1 += 1;
       }
 #else
-    while (m1 >= m2)
-      {
 #ifdef HEX_MODE
-        m1 >>= shift_amt;
+    int n = divideShift72 (m1, m2, shift_amt);
+    m1 >>= (uint) n * shift_amt;
 #else
-        m1 >>= 1;
+    int n = divideShift72 (m1, m2, 1);
+    m1 >>= n;
 #endif
-        e1 += 1;
-      }
+    e1 += n;
 #endif
     int e3 = e1 - e2;
     if (e3 > 127)
@@ -3923,14 +3836,7 @@ void dfcmp (void)
 #else
         shift_count = abs(e2 - e1);
 #endif
-        bool s = m1 & SIGN72;   ///< mantissa negative?
-        for(int n = 0 ; n < shift_count ; n += 1)
-        {
-            notallzeros |= m1 & 1;
-            m1 >>= 1;
-            if (s)
-                m1 |= SIGN72;
-        }
+        m1 = shiftRight72 (m1, shift_count, & notallzeros);
         
 #ifdef HEX_MODE
         if (m1 == MASK72 && notallzeros == 1 && shift_count * (int) shift_amt > 71)
@@ -3950,14 +3856,7 @@ void dfcmp (void)
 #else
         shift_count = abs(e1 - e2);
 #endif
-        bool s = m2 & SIGN72;   ///< mantissa negative?
-        for(int n = 0 ; n < shift_count ; n += 1)
-        {
-            notallzeros |= m2 & 1;
-            m2 >>= 1;
-            if (s)
-                m2 |= SIGN72;
-        }
+        m2 = shiftRight72 (m2, shift_count, & notallzeros);
 #ifdef HEX_MODE
         if (m2 == MASK72 && notallzeros == 1 && shift_count * (int) shift_amt > 71)
           m2 = 0;
@@ -4060,14 +3959,7 @@ void dfcmg (void)
         m1 = and_128 (m1, MASK72);
         //e3 = e2;
 #else
-        bool s = m1 & SIGN72;   ///< mantissa negative?
-        for( int n = 0; n < shift_count; n += 1)
-          {
-            notallzeros |= m1 & 1;
-            m1 >>= 1;
-            if (s)
-              m1 |= SIGN72;
-          }
+        m1 = shiftRight72 (m1, shift_count, & notallzeros);
 #ifdef HEX_MODE
         if (m1 == MASK72 && notallzeros == 1 && shift_count * (int) shift_amt > 71)
             m1 = 0;
@@ -4106,14 +3998,7 @@ void dfcmg (void)
         m2 = and_128 (m2, MASK72);
         //e3 = e1;
 #else
-        bool s = m2 & SIGN72;   ///< mantissa negative?
-        for(int n = 0; n < shift_count; n += 1)
-          {
-            notallzeros |= m2 & 1;
-            m2 >>= 1;
-            if (s)
-              m2 |= SIGN72;
-          }
+        m2 = shiftRight72 (m2, shift_count, & notallzeros);
 #ifdef HEX_MODE
         if (m2 == MASK72 && notallzeros == 1 && shift_count * (int) shift_amt > 71)
           m2 = 0;
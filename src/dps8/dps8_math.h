@@ -46,4 +46,57 @@ void dvf (void);
 void dfstr (word36 *Ypair);
 void fstr(word36 *CY);
 
+#ifndef NEED_128
+// The alignment and normalization shifts, taken in one step rather than
+// a bit (or, in hex mode, a digit) at a time. They are here rather than
+// in dps8_math.c so that src/utils/shift72test can check them against
+// the loops they replaced.
 
+// Significant bits in m
+
+static inline int bitlen72 (word72 m)
+  {
+    uint64 hi = (uint64) (m >> 64);
+    uint64 lo = (uint64) m;
+    if (hi)
+      return 128 - __builtin_clzll (hi);
+    return lo ? 64 - __builtin_clzll (lo) : 0;
+  }
+
+// m shifted right n places, extending the sign; *lost is ORed with the
+// bits shifted out of AQ71.
+
+static inline word72 shiftRight72 (word72 m, int n, word1 * lost)
+  {
+    if (n <= 0)
+      return m;
+    if (n >= 72)
+      {
+        * lost |= m != 0;
+        return (m & SIGN72) ? MASK72 : 0;
+      }
+    * lost |= (m & ((((word72) 1) << n) - 1)) != 0;
+    return ((word72) (SIGNEXT72_128 (m) >> n)) & MASK72;
+  }
+
+// The number of steps of step bits that m (nonzero) is shifted left to
+// normalize it: until C(AQ)1,step differ from the sign
+
+static inline int normalizeShift72 (word72 m, uint step)
+  {
+    word72 bits = (m & SIGN72) ? ~ m : m;
+    return (71 - bitlen72 (bits & MASK71)) / (int) step;
+  }
+
+// The number of steps of step bits that the dividend m1 is shifted right
+// until it is less than the divisor m2 (nonzero)
+
+static inline int divideShift72 (word72 m1, word72 m2, uint step)
+  {
+    int d = bitlen72 (m1) - bitlen72 (m2);
+    int n = d > 0 ? d / (int) step : 0;
+    while ((m1 >> ((uint) n * step)) >= m2)
+      n ++;
+    return n;
+  }
+#endif
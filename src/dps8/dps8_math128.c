@@ -14,10 +14,17 @@
 
 #ifdef TEST_128
 // gcc -m32 -DTEST_128 -DNEED_128 dps8_math128.c
+//
+// Built for a host that has __int128 (gcc -DTEST_128 -DNEED_128
+// dps8_math128.c on a 64 bit host) the self-test also checks every helper
+// against the compiler's 128 bit arithmetic over random operands:
+// a.out [cases]
 #include <stdbool.h>
 #include <stdint.h>
 #include <inttypes.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 typedef struct { uint64_t h; uint64_t l; } uint128;
 typedef struct { int64_t h; uint64_t l; } int128;
 
@@ -26,7 +33,7 @@ typedef int128  word72s;
 typedef uint128 word73;
 typedef uint128 word74;
 
-#define construct_128(h, l) ((uint128_t) { (h), (l) })
+#define construct_128(h, l) ((uint128) { (h), (l) })
 #define construct_s128(h, l) ((int128) { (h), (l) })
 
 #define MASK63          0x7FFFFFFFFFFFFFFF
@@ -41,300 +48,8 @@ typedef uint128 word74;
 
 #ifdef NEED_128
 
-bool iszero_128 (uint128 w)
-  {
-    if (w.h || w.l)
-      return false;
-    return true;
-  }
-
-bool isnonzero_128 (uint128 w)
-  {
-    if (w.h || w.l)
-      return true;
-    return false;
-  }
-
-bool iseq_128 (uint128 a, uint128 b)
-  {
-    return a.h == b.h && a.l == b.l;
-  }
-
-bool isgt_128 (uint128 a, uint128 b)
-  {
-    if (a.h > b.h) return true;
-    if (a.h < b.h) return false;
-    if (a.l > b.l) return true;
-    return false;
-  }
-
-bool islt_128 (uint128 a, uint128 b)
-  {
-    if (a.h < b.h) return true;
-    if (a.h > b.h) return false;
-    if (a.l < b.l) return true;
-    return false;
-  }
-
-bool isge_128 (uint128 a, uint128 b)
-  {
-    if (a.h > b.h) return true;
-    if (a.h < b.h) return false;
-    if (a.l >= b.l) return true;
-    return false;
-  }
-
-bool islt_s128 (int128 a, int128 b)
-  {
-    if (a.h < b.h) return true;
-    if (a.h > b.h) return false;
-    if (a.l < b.l) return true;
-    return false;
-  }
-
-bool isgt_s128 (int128 a, int128 b)
-  {
-    if (a.h > b.h) return true;
-    if (a.h < b.h) return false;
-    if (a.l > b.l) return true;
-    return false;
-  }
-
-uint128 and_128 (uint128 a, uint128 b)
-  {
-    return (uint128) {a.h & b.h, a.l & b.l};
-  }
-
-int128 and_s128 (int128 a, uint128 b)
-  {
-    return (int128) {a.h & (int64_t)b.h, a.l & b.l};
-  }
-
-uint128 or_128 (uint128 a, uint128 b)
-  {
-    return (uint128) {a.h | b.h, a.l | b.l};
-  }
-
-uint128 xor_128 (uint128 a, uint128 b)
-  {
-    return (uint128) {a.h ^ b.h, a.l ^ b.l};
-  }
-
-uint128 complement_128 (uint128 a)
-  {
-    return (uint128) {~ a.h, ~ a.l};
-  }
-
-uint128 add_128 (uint128 a, uint128 b)
-  {
-// To do carry detection from low to high, bust the low into 1 bit/63
-// bit fields; add the 63 bit fields checking for carry in the "sign"
-// bit; add the 1 bit fields plus that carry 
-
-    uint64_t al63 = a.l & MASK63;  // low 63 bits of a
-    uint64_t bl63 = b.l & MASK63;  // low 63 bits of b
-    uint64_t l63 = al63 + bl63;    // low 63 bits of a + b, with carry into bit 64
-    uint64_t c63 = l63 & SIGN64;   // the carry out of low 63 a + b
-    l63 &= MASK63;               // lose the carry bit
-
-    unsigned int al64 = (a.l >> 63) & 1; // bit 64 of a
-    unsigned int bl64 = (b.l >> 63) & 1; // bit 64 of b
-    unsigned int cl64 = (c63 >> 63) & 1; // the carry out of bit 63
-    uint64_t l64 = al64 + bl64 + cl64; // bit 64 a + b + carry in
-    unsigned int c64 = l64 > 1 ? 1 : 0;    // carry out of bit 64
-    l64 = (l64 & 1) << 63;         // put bit 64 in the right place
-    l64 |= l63;                    // put low 63 bits in
-    uint64_t h64 = a.h + b.h + c64;    // compute the high 
-    return construct_128 (h64, l64);
-  }
-
-uint128 subtract_128 (uint128 a, uint128 b)
-  {
-//printf ("sub a %016llx %016llx\n", a.h, a.l);
-//printf ("sub b %016llx %016llx\n", b.h, b.l);
-    bool borrow = !! (b.l > a.l);
-    uint128 res = construct_128 (a.h - b.h, a.l - b.l);
-    if (borrow)
-      res.h --;
-//printf ("sub res %016llx %016llx\n", res.h, res.l);
-    return res;
-  }
-
-uint128 negate_128 (uint128 a)
-  {
-    return add_128 (complement_128 (a), construct_128 (0, 1));
-  }
-
-int128 negate_s128 (int128 a)
-  {
-    uint128 t = add_128 (complement_128 (cast_128 (a)), construct_128 (0, 1));
-    return cast_s128 (t);
-  }
-
-uint128 lshift_128 (uint128 a, unsigned int n)
-  {
-    if (n < 64)
-      {
-        uint64_t nmask = (uint64_t) ((~(MASK64 << n)));
-//printf ("nmask %016llx\r\n", nmask);
-        // capture the high bits of the low half
-        uint64_t keep = (a.l >> (64 - n)) & nmask;
-//printf ("keep %016llx\r\n", keep);
-        // shift the low half
-        uint64_t l = a.l << n;
-//printf ("l %016llx\r\n", l);
-        // shift the high half
-        uint64_t h = a.h << n;
-//printf ("h %016llx\r\n", h);
-        // put the bits from the low into the high
-        h |= keep;
-//printf ("h|keep %016llx\r\n", h);
-        return construct_128 (h, l);
-      }
-    uint64_t h = a.l << (n - 64);
-    return construct_128 (h, 0);
-  }
-
-int128 lshift_s128 (int128 a, unsigned int n)
-  {
-    uint128 t = lshift_128 (cast_128 (a), n);
-    return cast_s128 (t);
-  }
-
-uint128 rshift_128 (uint128 a, unsigned int n)
-  {
-#if 0
-    uint64_t sign = a.h & SIGN64;
-    if (n < 64)
-      {
-        uint64_t nmask = (uint64_t) ((~(-1 << n)));
-        // capture the low bits of the high half
-        uint64_t keep = (a.h & nmask) << (64 - n);
-        // shift the low half
-        uint64_t l = a.l >> n;
-        // shifting zeros in from on high
-        l &= (uint64_t) (-(1 << (64 - n)));
-        // put in the bits from the high half
-        l |= keep;
-        // shift the high half
-        uint64_t h = a.h >> n;
-        if (sign)
-          // extending the signbit
-          l |= nmask << (64 - n);
-        else
-          // shifting zeros from on high
-          l &= (uint64_t) (-(1 << (64 - n)));
-        return construct_128 (h, l);
-      }
-    if (n == 64)
-      {
-        if (sign)
-          return construct_128 (MASK64, a.h);
-        return construct_128 (0, a.h);
-      }
-    uint64_t nmask = (uint64_t) ((1LLU << (n - 65)) - 1);
-printf ("nmask %016llx\n", nmask);
-    uint64_t l = a.h >> (n - 64);
-printf ("l %016llx\n", l);
-    uint64_t h = sign ? MASK64 : 0;
-printf ("h %016llx\n", h);
-    if (sign)
-      {
-        // extending the signbit
-        l |= nmask << (64 - n);
-      }
-    else
-      {
-        // shifting zeros from on high
-        l &= (uint64_t) (~(-1 << (64 - n)));
-      }
-printf ("l2 %016llx\n", l);
-#endif
-
-    uint64_t h = a.h;
-    uint64_t l = a.l;
-    uint64_t sign = a.h & SIGN64;
-    while (n)
-      {
-        uint64_t b = (h & 1) ? SIGN64 : 0;
-        h >>= 1;
-        h |= sign;
-        l >>= 1;
-        l &= MASK63;
-        l |= b;
-        n --;
-      }
-    return construct_128 (h, l);
-  }
-
-int128 rshift_s128 (int128 a, unsigned int n)
-  {
-    uint128 t = rshift_128 (cast_128 (a), n);
-    return cast_s128 (t);
-  }
-
-
 // http://www.icodeguru.com/Embedded/Hacker's-Delight/
 
-static void mulmn (uint32_t w[], uint32_t u[], 
-                   uint32_t v[], int m, int n)
-  {
-//for (int i = m - 1; i >= 0; i --) printf ("%08x", u [i]);
-//printf ("  ");
-//for (int i = n - 1; i >= 0; i --) printf ("%08x", v [i]);
-//printf ("\n");
-    uint64_t k, t; 
-    int i, j; 
-  
-    for (i = 0; i < m; i++) 
-       w[i] = 0; 
- 
-    for (j = 0; j < n; j++)
-      {
-        k = 0; 
-        for (i = 0; i < m; i++)
-          {
-            t = (uint64_t) u[i] * (uint64_t) v[j] + (uint64_t) w[i + j] + k; 
-//printf ("%d %d %016llx\n",i, j, t);
-            w[i + j] = (uint32_t) t;        // (I.e., t & 0xFFFF). 
-            k = t >> 32; 
-          } 
-        w[j + m] = (uint32_t) k; 
-      } 
-  }
-
-static void mulmns (uint32_t w[], uint32_t u[], 
-                    uint32_t v[], int m, int n)
-  {
-    mulmn (w, u, v, m, n);
-
-    // Now w[] has the unsigned product. Correct by 
-    // subtracting v*2**16m if u < 0, and 
-    // subtracting u*2**16n if v < 0. 
- 
-    if ((int32_t)u[m - 1] < 0)
-      {
-        int b = 0;                  // Initialize borrow. 
-        for (int j = 0; j < n; j++)
-          {
-            int t = (int) w[j + m] - (int) v[j] - b; 
-            w[j + m] = (uint32_t) t; 
-            b = t >> 31; 
-          } 
-      } 
-    if ((int32_t)v[n - 1] < 0)
-      {
-        int b = 0; 
-        for (int i = 0; i < m; i++)
-          {
-            int t = (int) w[i + n] - (int) u[i] - b; 
-            w[i + n] = (uint32_t) t; 
-            b = t >> 31; 
-          } 
-      } 
-    return; 
-  } 
-
 static int32_t nlz (unsigned x)
   {
     unsigned y; 
@@ -444,52 +159,13 @@ again:
     return 0; 
   } 
 
-uint128 multiply_128 (uint128 a, uint128 b)
-  {
-//printf ("%016llx%016llx %016llx%016llx\n", a.h,a.l,b.h,b.l);
-    const int l = 4;
-    uint32_t w[l+l], u[l], v[l];
-
-    u[3] = (uint32_t) (a.h >> 32);
-    u[2] = (uint32_t) a.h;
-    u[1] = (uint32_t) (a.l >> 32);
-    u[0] = (uint32_t) a.l;
-    v[3] = (uint32_t) (b.h >> 32);
-    v[2] = (uint32_t) b.h;
-    v[1] = (uint32_t) (b.l >> 32);
-    v[0] = (uint32_t) b.l;
-    mulmn (w, u, v, l, l);
-    return construct_128 (
-       (((uint64_t) w[3]) << 32) | w[2],
-       (((uint64_t) w[1]) << 32) | w[0]);
-  }
-
-int128 multiply_s128 (int128 a, int128 b)
-  {
-//printf ("%016llx%016llx %016llx%016llx\n", a.h,a.l,b.h,b.l);
-    const int l = 4;
-    uint32_t w[l+l], u[l], v[l];
-
-    u[3] = (uint32_t) (a.h >> 32);
-    u[2] = (uint32_t) a.h;
-    u[1] = (uint32_t) (a.l >> 32);
-    u[0] = (uint32_t) a.l;
-    v[3] = (uint32_t) (b.h >> 32);
-    v[2] = (uint32_t) b.h;
-    v[1] = (uint32_t) (b.l >> 32);
-    v[0] = (uint32_t) b.l;
-    mulmns (w, u, v, l, l);
-    return construct_s128 (
-       (((int64_t) w[3]) << 32) | w[2],
-       (((uint64_t) w[1]) << 32) | w[0]);
-  }
-
-// Note: divisor is < 2^16
 uint128 divide_128 (uint128 a, uint128 b, uint128 * remp)
   {
     const int m = 8;
     const int n = 8;
+    // divmnu only writes the m - n + 1 low quotient digits
     uint16_t q[m], u[m], v[n];
+    memset (q, 0, sizeof (q));
     u[0] = (uint16_t) a.l;
     u[1] = (uint16_t) (a.l >> 16);
     u[2] = (uint16_t) (a.l >> 32);
@@ -537,72 +213,6 @@ uint128 divide_128 (uint128 a, uint128 b, uint128 * remp)
        (((uint64_t) q [0]) <<  0));
   }
 
-// Note: divisor is < 2^16
-uint128 divide_128_16 (uint128 a, uint16_t b, uint16_t * remp)
-  {
-    const int m = 8;
-    const int n = 1;
-    uint16_t q[m], u[m], v[n];
-    u[0] = (uint16_t) a.l;
-    u[1] = (uint16_t) (a.l >> 16);
-    u[2] = (uint16_t) (a.l >> 32);
-    u[3] = (uint16_t) (a.l >> 48);
-    u[4] = (uint16_t) a.h;
-    u[5] = (uint16_t) (a.h >> 16);
-    u[6] = (uint16_t) (a.h >> 32);
-    u[7] = (uint16_t) (a.h >> 48);
-
-    v[0] = (uint16_t) b;
-    divmnu (q, remp, u, v, m, n);
-    return construct_128 (
-       (((uint64_t) q [7]) << 48) |
-       (((uint64_t) q [6]) << 32) |
-       (((uint64_t) q [5]) << 16) |
-       (((uint64_t) q [4]) <<  0),
-       (((uint64_t) q [3]) << 48) |
-       (((uint64_t) q [2]) << 32) |
-       (((uint64_t) q [1]) << 16) |
-       (((uint64_t) q [0]) <<  0));
-  }
-
-//divide_128_32 (
-//00000000000000010000000000000000, 00010000) returned 
-//00000000000000000001000000000000, 00000000
-//divide_128_32 (ffffffffffffffffffffffffffffffff, 00010000) returned f771ffffffffffffffffffffffffffff, 0000ffff
-
-// Note: divisor is < 2^32 and >= 2^16; i.e. high 16 bits *must* be none zero
-uint128 divide_128_32 (uint128 a, uint32_t b, uint32_t * remp)
-  {
-    const int m = 8;
-    const int n = 2;
-    uint16_t q[m], u[m], v[n], r[2];
-    u[0] = (uint16_t) a.l;
-    u[1] = (uint16_t) (a.l >> 16);
-    u[2] = (uint16_t) (a.l >> 32);
-    u[3] = (uint16_t) (a.l >> 48);
-    u[4] = (uint16_t) a.h;
-    u[5] = (uint16_t) (a.h >> 16);
-    u[6] = (uint16_t) (a.h >> 32);
-    u[7] = (uint16_t) (a.h >> 48);
-
-    v[0] = (uint16_t) b;
-    v[1] = (uint16_t) (b >> 16);
-
-    divmnu (q, remp ? r : NULL, u, v, m, n);
-    if (remp)
-      * remp = r [0] | (uint32_t) r[1] << 16;
-        
-    return construct_128 (
-       (((uint64_t) q [7]) << 48) |
-       (((uint64_t) q [6]) << 32) |
-       (((uint64_t) q [5]) << 16) |
-       (((uint64_t) q [4]) <<  0),
-       (((uint64_t) q [3]) << 48) |
-       (((uint64_t) q [2]) << 32) |
-       (((uint64_t) q [1]) << 16) |
-       (((uint64_t) q [0]) <<  0));
-  }
-
 #ifdef TEST_128
 
 static void tisz (uint64_t h, uint64_t l, bool expect)
@@ -754,6 +364,211 @@ static void tdiv32 (uint64_t ah, uint64_t al, uint32_t b,
               ah, al, b, res.h, res.l, rem);
   }
 
+static void tcmp (uint64_t ah, uint64_t al, uint64_t bh, uint64_t bl,
+                  bool eq, bool lt)
+  {
+    uint128 a = construct_128 (ah, al);
+    uint128 b = construct_128 (bh, bl);
+    if (iseq_128 (a, b) != eq || islt_128 (a, b) != lt ||
+        isge_128 (a, b) != ! lt || isgt_128 (a, b) != (! lt && ! eq))
+      printf ("compare_128 (%016"PRIx64"%016"PRIx64", %016"PRIx64"%016"PRIx64") returned eq %u lt %u ge %u gt %u\n",
+              ah, al, bh, bl, iseq_128 (a, b), islt_128 (a, b),
+              isge_128 (a, b), isgt_128 (a, b));
+  }
+
+static void tscmp (int64_t ah, uint64_t al, int64_t bh, uint64_t bl,
+                   bool lt, bool gt)
+  {
+    int128 a = construct_s128 (ah, al);
+    int128 b = construct_s128 (bh, bl);
+    if (islt_s128 (a, b) != lt || isgt_s128 (a, b) != gt)
+      printf ("compare_s128 (%016"PRIx64"%016"PRIx64", %016"PRIx64"%016"PRIx64") returned lt %u gt %u\n",
+              ah, al, bh, bl, islt_s128 (a, b), isgt_s128 (a, b));
+  }
+
+static void txor (uint64_t ah, uint64_t al, uint64_t bh, uint64_t bl,
+                  uint64_t rh, uint64_t rl)
+  {
+    uint128 a = construct_128 (ah, al);
+    uint128 b = construct_128 (bh, bl);
+    uint128 r = xor_128 (a, b);
+    if (r.h != rh || r.l != rl)
+      printf ("xor_128 (%016"PRIx64"%016"PRIx64", %016"PRIx64"%016"PRIx64") returned %016"PRIx64"%016"PRIx64"\n",
+              ah, al, bh, bl, r.h, r.l);
+  }
+
+static void tsneg (int64_t ah, uint64_t al, int64_t rh, uint64_t rl)
+  {
+    int128 r = negate_s128 (construct_s128 (ah, al));
+    if (r.h != rh || r.l != rl)
+      printf ("negate_s128 (%016"PRIx64"%016"PRIx64") returned %016"PRIx64"%016"PRIx64"\n",
+              ah, al, r.h, r.l);
+  }
+
+static void tsrs (int64_t ah, uint64_t al, unsigned int n,
+                  int64_t rh, uint64_t rl)
+  {
+    int128 r = rshift_s128 (construct_s128 (ah, al), n);
+    if (r.h != rh || r.l != rl)
+      printf ("rshift_s128 (%016"PRIx64"%016"PRIx64", %u) returned %016"PRIx64"%016"PRIx64"\n",
+              ah, al, n, r.h, r.l);
+  }
+
+static void tmul64 (uint64_t a, uint64_t b, uint64_t rh, uint64_t rl)
+  {
+    uint128 r = multiply_64_128 (a, b);
+    if (r.h != rh || r.l != rl)
+      printf ("multiply_64_128 (%016"PRIx64", %016"PRIx64") returned %016"PRIx64"%016"PRIx64"\n",
+              a, b, r.h, r.l);
+  }
+
+#ifdef __SIZEOF_INT128__
+// Random operands, with whole or partial halves of zeros and ones often
+// enough to reach the carries, borrows and shift boundaries
+
+typedef unsigned __int128 u128;
+typedef __int128 s128;
+
+static uint64_t rng_state = 0x128;
+
+static uint64_t rng (void)
+  {
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1DULL;
+  }
+
+static uint128 rand128 (void)
+  {
+    uint64_t h = rng ();
+    uint64_t l = rng ();
+    switch (rng () & 7)
+      {
+        case 0: h = 0; break;
+        case 1: h = MASK64; break;
+        case 2: l = 0; break;
+        case 3: l = MASK64; break;
+        case 4: h = 0; l >>= rng () & 63; break;
+        case 5: h >>= rng () & 63; break;
+        default: break;
+      }
+    return construct_128 (h, l);
+  }
+
+static u128 to_u128 (uint128 a)
+  {
+    return ((u128) a.h << 64) | a.l;
+  }
+
+static bool same (uint128 a, u128 b)
+  {
+    return a.h == (uint64_t) (b >> 64) && a.l == (uint64_t) b;
+  }
+
+static unsigned long random_fails = 0;
+
+static void rfail (const char * op, uint128 a, uint128 b, unsigned int n)
+  {
+    if (random_fails ++ < 20)
+      printf ("%s (%016"PRIx64"%016"PRIx64", %016"PRIx64"%016"PRIx64", %u) differs from __int128\n",
+              op, a.h, a.l, b.h, b.l, n);
+  }
+
+static void random_check (unsigned long cases)
+  {
+    for (unsigned long i = 0; i < cases; i ++)
+      {
+        uint128 a = rand128 ();
+        uint128 b = (rng () & 3) ? rand128 () : a;
+        u128 ua = to_u128 (a);
+        u128 ub = to_u128 (b);
+        s128 sa = (s128) ua;
+        s128 sb = (s128) ub;
+        int128 ia = cast_s128 (a);
+        int128 ib = cast_s128 (b);
+        // 128 and 129 check the out of range shifts
+        unsigned int n = (unsigned int) (rng () % 130);
+
+        if (iszero_128 (a) != (ua == 0))
+          rfail ("iszero_128", a, b, 0);
+        if (isnonzero_128 (a) != (ua != 0))
+          rfail ("isnonzero_128", a, b, 0);
+        if (iseq_128 (a, b) != (ua == ub))
+          rfail ("iseq_128", a, b, 0);
+        if (isgt_128 (a, b) != (ua > ub))
+          rfail ("isgt_128", a, b, 0);
+        if (islt_128 (a, b) != (ua < ub))
+          rfail ("islt_128", a, b, 0);
+        if (isge_128 (a, b) != (ua >= ub))
+          rfail ("isge_128", a, b, 0);
+        if (islt_s128 (ia, ib) != (sa < sb))
+          rfail ("islt_s128", a, b, 0);
+        if (isgt_s128 (ia, ib) != (sa > sb))
+          rfail ("isgt_s128", a, b, 0);
+
+        if (! same (and_128 (a, b), ua & ub))
+          rfail ("and_128", a, b, 0);
+        if (! same (cast_128 (and_s128 (ia, b)), ua & ub))
+          rfail ("and_s128", a, b, 0);
+        if (! same (or_128 (a, b), ua | ub))
+          rfail ("or_128", a, b, 0);
+        if (! same (xor_128 (a, b), ua ^ ub))
+          rfail ("xor_128", a, b, 0);
+        if (! same (complement_128 (a), ~ ua))
+          rfail ("complement_128", a, b, 0);
+
+        if (! same (add_128 (a, b), ua + ub))
+          rfail ("add_128", a, b, 0);
+        if (! same (subtract_128 (a, b), ua - ub))
+          rfail ("subtract_128", a, b, 0);
+        if (! same (negate_128 (a), - ua))
+          rfail ("negate_128", a, b, 0);
+        if (! same (cast_128 (negate_s128 (ia)), - ua))
+          rfail ("negate_s128", a, b, 0);
+
+        u128 ls = n < 128 ? ua << n : 0;
+        u128 rs = n < 128 ? (u128) (sa >> n) : (u128) (sa >> 127);
+        if (! same (lshift_128 (a, n), ls))
+          rfail ("lshift_128", a, b, n);
+        if (! same (cast_128 (lshift_s128 (ia, n)), ls))
+          rfail ("lshift_s128", a, b, n);
+        if (! same (rshift_128 (a, n), rs))
+          rfail ("rshift_128", a, b, n);
+        if (! same (cast_128 (rshift_s128 (ia, n)), rs))
+          rfail ("rshift_s128", a, b, n);
+
+        if (! same (multiply_64_128 (a.l, b.l), (u128) a.l * b.l))
+          rfail ("multiply_64_128", a, b, 0);
+        if (! same (multiply_128 (a, b), ua * ub))
+          rfail ("multiply_128", a, b, 0);
+        if (! same (cast_128 (multiply_s128 (ia, ib)), ua * ub))
+          rfail ("multiply_s128", a, b, 0);
+
+        uint32_t d32 = (uint32_t) b.l ? (uint32_t) b.l : 1;
+        uint32_t r32;
+        if (! same (divide_128_32 (a, d32, & r32), ua / d32) ||
+            r32 != (uint32_t) (ua % d32))
+          rfail ("divide_128_32", a, b, 0);
+        uint16_t d16 = (uint16_t) b.l ? (uint16_t) b.l : 1;
+        uint16_t r16;
+        if (! same (divide_128_16 (a, d16, & r16), ua / d16) ||
+            r16 != (uint16_t) (ua % d16))
+          rfail ("divide_128_16", a, b, 0);
+        if (ub)
+          {
+            uint128 r128;
+            if (! same (divide_128 (a, b, & r128), ua / ub) ||
+                ! same (r128, ua % ub))
+              rfail ("divide_128", a, b, 0);
+          }
+      }
+    printf ("%lu random cases of each helper, %lu differences\n",
+            cases, random_fails);
+  }
+#endif
+
 int main (int argc, char * argv [])
   {
 
@@ -850,7 +665,45 @@ int main (int argc, char * argv [])
 
     tdiv32 (1, 0,           1 << 16,          0, 1ll << 48,         0);
     tdiv32 (MASK64, MASK64, 1 << 16,          MASK64 >> 16, MASK64, 0xffff);
+
+    tcmp (0, 0,             0, 0,             true, false);
+    tcmp (0, 1,             0, 0,             false, false);
+    tcmp (0, 0,             0, 1,             false, true);
+    tcmp (1, 0,             0, MASK64,        false, false);
+    tcmp (0, MASK64,        1, 0,             false, true);
+    tcmp (MASK64, MASK64,   MASK64, MASK64,   true, false);
+
+    tscmp (0, 0,            0, 0,             false, false);
+    tscmp (-1, MASK64,      0, 0,             true, false);
+    tscmp (0, 0,            -1, MASK64,       false, true);
+    tscmp (-1, 0,           -1, 1,            true, false);
+    tscmp ((int64_t) SIGN64, 0, MASK63, MASK64, true, false);
+
+    txor (0, 0,             0, 0,             0, 0);
+    txor (MASK64, MASK64,   MASK64, MASK64,   0, 0);
+    txor (MASK64, 0,        0, MASK64,        MASK64, MASK64);
+
+    tsneg (0, 0,            0, 0);
+    tsneg (0, 1,            -1, MASK64);
+    tsneg (-1, MASK64,      0, 1);
+    tsneg ((int64_t) SIGN64, 0, (int64_t) SIGN64, 0);
+
+    tsrs (-1, 0,            64,   -1, MASK64);
+    tsrs ((int64_t) SIGN64, 0, 127, -1, MASK64);
+    tsrs (MASK63, MASK64,   127,  0, 0);
+    tsrs (1, 0,             1,    0, SIGN64);
+
+    tmul64 (0, 0,                 0, 0);
+    tmul64 (MASK64, 1,            0, MASK64);
+    tmul64 (MASK64, MASK64,       MASK64 - 1, 1);
+    tmul64 (1ull << 32, 1ull << 32, 1, 0);
+
+#ifdef __SIZEOF_INT128__
+    random_check (argc > 1 ? strtoul (argv [1], NULL, 0) : 5000000);
+    return random_fails != 0;
+#else
     return 0;
+#endif
   }
 #endif
 
@@ -11,6 +11,9 @@
 Defines 128 bits Integer for 32 bits platform
 */
 
+#ifndef DPS8_MATH128_H
+#define DPS8_MATH128_H
+
 #ifdef NEED_128
 
 //#define cast_128(x) (* (uint128 *) & (x))
@@ -18,32 +21,194 @@ Defines 128 bits Integer for 32 bits platform
 #define cast_128(x) construct_128 ((uint64_t) (x).h, (x).l)
 #define cast_s128(x) construct_s128 ((int64_t) (x).h, (x).l)
 
-bool iszero_128 (uint128 w);
-bool isnonzero_128 (uint128 w);
-bool iseq_128 (uint128 a, uint128 b);
-bool isgt_128 (uint128 a, uint128 b);
-bool islt_128 (uint128 a, uint128 b);
-bool isge_128 (uint128 a, uint128 b);
-bool islt_s128 (int128 a, int128 b);
-bool isgt_s128 (int128 a, int128 b);
-uint128 and_128 (uint128 a, uint128 b);
-int128 and_s128 (int128 a, uint128 b);
-uint128 or_128 (uint128 a, uint128 b);
-uint128 xor_128 (uint128 a, uint128 b);
-uint128 add_128 (uint128 a, uint128 b);
-uint128 subtract_128 (uint128 a, uint128 b);
-uint128 multiply_128 (uint128 a, uint128 b);
-int128 multiply_s128 (int128 a, int128 b);
-uint128 divide_128_16 (uint128 a, uint16_t b, uint16_t * rem);
-uint128 divide_128_32 (uint128 a, uint32_t b, uint32_t * rem);
+// These sit under every word72 operation in the FP and EIS code, so they
+// are inline here rather than out of line in dps8_math128.c; only the
+// general 128/128 divide remains there.
+
+static inline bool iszero_128 (uint128 w)
+  {
+    return (w.h | w.l) == 0;
+  }
+
+static inline bool isnonzero_128 (uint128 w)
+  {
+    return (w.h | w.l) != 0;
+  }
+
+static inline bool iseq_128 (uint128 a, uint128 b)
+  {
+    return a.h == b.h && a.l == b.l;
+  }
+
+static inline bool isgt_128 (uint128 a, uint128 b)
+  {
+    return a.h > b.h || (a.h == b.h && a.l > b.l);
+  }
+
+static inline bool islt_128 (uint128 a, uint128 b)
+  {
+    return a.h < b.h || (a.h == b.h && a.l < b.l);
+  }
+
+static inline bool isge_128 (uint128 a, uint128 b)
+  {
+    return a.h > b.h || (a.h == b.h && a.l >= b.l);
+  }
+
+static inline bool islt_s128 (int128 a, int128 b)
+  {
+    return a.h < b.h || (a.h == b.h && a.l < b.l);
+  }
+
+static inline bool isgt_s128 (int128 a, int128 b)
+  {
+    return a.h > b.h || (a.h == b.h && a.l > b.l);
+  }
+
+static inline uint128 and_128 (uint128 a, uint128 b)
+  {
+    return (uint128) {a.h & b.h, a.l & b.l};
+  }
+
+static inline int128 and_s128 (int128 a, uint128 b)
+  {
+    return (int128) {a.h & (int64_t)b.h, a.l & b.l};
+  }
+
+static inline uint128 or_128 (uint128 a, uint128 b)
+  {
+    return (uint128) {a.h | b.h, a.l | b.l};
+  }
+
+static inline uint128 xor_128 (uint128 a, uint128 b)
+  {
+    return (uint128) {a.h ^ b.h, a.l ^ b.l};
+  }
+
+static inline uint128 complement_128 (uint128 a)
+  {
+    return (uint128) {~ a.h, ~ a.l};
+  }
+
+static inline uint128 add_128 (uint128 a, uint128 b)
+  {
+    uint64_t l = a.l + b.l;
+    // unsigned wrap-around is the carry out of the low half
+    return (uint128) {a.h + b.h + (l < a.l), l};
+  }
+
+static inline uint128 subtract_128 (uint128 a, uint128 b)
+  {
+    return (uint128) {a.h - b.h - (b.l > a.l), a.l - b.l};
+  }
+
+static inline uint128 negate_128 (uint128 a)
+  {
+    return (uint128) {~ a.h + (a.l == 0), - a.l};
+  }
+
+static inline int128 negate_s128 (int128 a)
+  {
+    uint128 t = negate_128 (cast_128 (a));
+    return cast_s128 (t);
+  }
+
+static inline uint128 lshift_128 (uint128 a, unsigned int n)
+  {
+    if (n == 0)
+      return a;
+    if (n < 64)
+      return (uint128) {(a.h << n) | (a.l >> (64 - n)), a.l << n};
+    if (n < 128)
+      return (uint128) {a.l << (n - 64), 0};
+    return (uint128) {0, 0};
+  }
+
+static inline int128 lshift_s128 (int128 a, unsigned int n)
+  {
+    uint128 t = lshift_128 (cast_128 (a), n);
+    return cast_s128 (t);
+  }
+
+// Arithmetic shift; bit 127 is propagated
+static inline uint128 rshift_128 (uint128 a, unsigned int n)
+  {
+    uint64_t sign = (uint64_t) ((int64_t) a.h >> 63);
+    if (n == 0)
+      return a;
+    if (n < 64)
+      return (uint128) {(uint64_t) ((int64_t) a.h >> n),
+                        (a.l >> n) | (a.h << (64 - n))};
+    if (n < 128)
+      return (uint128) {sign, (uint64_t) ((int64_t) a.h >> (n - 64))};
+    return (uint128) {sign, sign};
+  }
+
+static inline int128 rshift_s128 (int128 a, unsigned int n)
+  {
+    uint128 t = rshift_128 (cast_128 (a), n);
+    return cast_s128 (t);
+  }
+
+// 64 x 64 -> 128 from four 32 x 32 partial products
+
+static inline uint128 multiply_64_128 (uint64_t a, uint64_t b)
+  {
+    uint64_t a0 = (uint32_t) a, a1 = a >> 32;
+    uint64_t b0 = (uint32_t) b, b1 = b >> 32;
+    uint64_t p00 = a0 * b0;
+    uint64_t p01 = a0 * b1;
+    uint64_t p10 = a1 * b0;
+    uint64_t p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (uint32_t) p01 + (uint32_t) p10;
+    return (uint128) {p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32),
+                      (mid << 32) | (uint32_t) p00};
+  }
+
+// Low 128 bits of the product; the cross terms only reach the high half
+
+static inline uint128 multiply_128 (uint128 a, uint128 b)
+  {
+    uint128 r = multiply_64_128 (a.l, b.l);
+    r.h += a.h * b.l + a.l * b.h;
+    return r;
+  }
+
+// The low 128 bits of a two's complement product do not depend on the
+// signs of the operands
+
+static inline int128 multiply_s128 (int128 a, int128 b)
+  {
+    uint128 t = multiply_128 (cast_128 (a), cast_128 (b));
+    return cast_s128 (t);
+  }
+
+// Short division, one 32 bit digit at a time; the partial remainder is
+// always less than b, so each step fits in a uint64_t.
+
+static inline uint128 divide_128_32 (uint128 a, uint32_t b, uint32_t * remp)
+  {
+    uint64_t r = a.h >> 32;
+    uint64_t q3 = r / b; r = ((r % b) << 32) | (uint32_t) a.h;
+    uint64_t q2 = r / b; r = ((r % b) << 32) | (a.l >> 32);
+    uint64_t q1 = r / b; r = ((r % b) << 32) | (uint32_t) a.l;
+    uint64_t q0 = r / b;
+    if (remp)
+      * remp = (uint32_t) (r % b);
+    return (uint128) {(q3 << 32) | q2, (q1 << 32) | q0};
+  }
+
+static inline uint128 divide_128_16 (uint128 a, uint16_t b, uint16_t * remp)
+  {
+    uint32_t r;
+    uint128 q = divide_128_32 (a, b, remp ? & r : NULL);
+    if (remp)
+      * remp = (uint16_t) r;
+    return q;
+  }
+
 uint128 divide_128 (uint128 a, uint128 b, uint128 * rem);
-uint128 complement_128 (uint128 a);
-uint128 negate_128 (uint128 a);
-int128 negate_s128 (int128 a);
-uint128 lshift_128 (uint128 a, unsigned int n);
-int128 lshift_s128 (int128 a, unsigned int n);
-uint128 rshift_128 (uint128 a, unsigned int n);
-int128 rshift_s128 (int128 a, unsigned int n);
+
 #else
 
 /* if (sizeof(long) < 8), I expect we're on a 32 bit system */
@@ -57,3 +222,4 @@ typedef TItype __int128_t ;
 typedef UTItype __uint128_t ;
 #endif
 #endif
+#endif // DPS8_MATH128_H
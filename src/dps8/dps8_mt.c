@@ -745,18 +745,10 @@ ddcws:;
                        "%s: Tally %d (%o)\n", __func__, tally, tally);
 
             word36 buffer [tally];
-            uint i;
-            for (i = 0; i < tally; i ++)
-              {
-                if (tape_statep -> is9)
-                  rc2 = extractASCII36FromBuffer (tape_statep -> buf, tape_statep -> tbc, & tape_statep -> words_processed, buffer + i);
-                else
-                  rc2 = extractWord36FromBuffer (tape_statep -> buf, tape_statep -> tbc, & tape_statep -> words_processed, buffer + i);
-                if (rc2)
-                  {
-                     break;
-                  }
-              }
+            if (tape_statep -> is9)
+              extractASCII36NFromBuffer (tape_statep -> buf, tape_statep -> tbc, & tape_statep -> words_processed, buffer, tally);
+            else
+              extractWord36NFromBuffer (tape_statep -> buf, tape_statep -> tbc, & tape_statep -> words_processed, buffer, tally);
 #if 0
             if (tape_statep -> is9) {
               sim_printf ("<");
@@ -889,33 +881,22 @@ loop:;
 
     tape_statep -> words_processed = 0;
     uint i;
-    for (i = 0; i < tally; i ++)
+    if (tape_statep -> is9)
+      i = insertASCII36NtoBuffer (tape_statep -> buf, tape_statep -> tbc,
+                                  & tape_statep -> words_processed,
+                                  buffer, tally);
+    else
+      i = insertWord36NtoBuffer (tape_statep -> buf, tape_statep -> tbc,
+                                 & tape_statep -> words_processed,
+                                 buffer, tally);
+    if (i < tally)
       {
-        int rc2;
-        if (tape_statep -> is9)
-          {
-            rc2 = insertASCII36toBuffer (tape_statep -> buf, 
-                                        tape_statep -> tbc, 
-                                        & tape_statep -> words_processed, 
-                                        buffer [i]);
-          }
-        else
-          {
-            rc2 = insertWord36toBuffer (tape_statep -> buf, 
-                                       tape_statep -> tbc, 
-                                       & tape_statep -> words_processed, 
-                                       buffer [i]);
-            }
-        if (rc2)
-          {
-            p -> stati = 04000;
-            if (sim_tape_wrp (unitp))
-              p -> stati |= 1;
-            sim_debug (DBG_WARN, & tape_dev,
-                       "%s: Write buffer exhausted on channel %d\n",
-                       __func__, chan);
-            break;
-          }
+        p -> stati = 04000;
+        if (sim_tape_wrp (unitp))
+          p -> stati |= 1;
+        sim_debug (DBG_WARN, & tape_dev,
+                   "%s: Write buffer exhausted on channel %d\n",
+                   __func__, chan);
       }
     p -> tallyResidue = (word12) (tally - i);
 
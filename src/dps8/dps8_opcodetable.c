@@ -16,7 +16,8 @@
  * \project dps8
 */
 
-//#include <string.h>
+#include <string.h>
+#include <ctype.h>
 
 #include "dps8.h"
 #include "dps8_opcodetable.h"
@@ -1664,3 +1665,67 @@ word8 insGrp [02000] =
        GRP_UNKN,  GRP_UNKN,  GRP_UNKN,  GRP_UNKN,  GRP_PRL,   GRP_UNKN,  GRP_UNKN,  GRP_UNKN,  // 770-777
   };
 #endif
+
+// The disassembler depends only on the tables above, so that the tools
+// in src/utils can link this file without the rest of the simulator.
+
+static char * dps8_strupr(char *str)
+{
+    char *s;
+    
+    for(s = str; *s; s++)
+        *s = (char) toupper((unsigned char)*s);
+    return str;
+}
+
+char *disassemble(char * result, word36 instruction)
+{
+    uint32 opcode  = GET_OP(instruction);   ///< get opcode
+    uint32 opcodeX = GET_OPX(instruction);  ///< opcode extension
+    uint32 opcode10 = opcode | (opcodeX ? 01000 : 0);
+    word18 address = GET_ADDR(instruction);
+    word1  a       = GET_A(instruction);
+    //int32 i       = GET_I(instruction);
+    word6  tag     = GET_TAG(instruction);
+
+    //static char result[132] = "???";
+    strcpy(result, "???");
+    
+    // get mnemonic ...
+    if (opcodes10[opcode10].mne)
+        strcpy(result, opcodes10[opcode10].mne);
+
+    // XXX need to reconstruct multi-word EIS instruction.
+
+    char buff[64];
+    
+    if (a)
+    {
+        int n = (address >> 15) & 07;
+        int offset = address & 077777;
+    
+        sprintf(buff, " pr%d|%o", n, offset);
+        strcat (result, buff);
+        // return dps8_strupr(result);
+    } else {
+        sprintf(buff, " %06o", address);
+        strcat (result, buff);
+    }
+    // get mod
+    strcpy(buff, "");
+    for(uint n = 0 ; n < 0100 ; n++)
+        if (extMods[n].mod)
+            if(n == tag)
+            {
+                strcpy(buff, extMods[n].mod);
+                break;
+            }
+
+    if (strlen(buff))
+    {
+        strcat(result, ",");
+        strcat(result, buff);
+    }
+    
+    return dps8_strupr(result);
+}
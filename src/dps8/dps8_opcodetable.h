@@ -31,6 +31,8 @@ typedef struct adrMods adrMods;
 
 extern struct adrMods extMods[0100]; ///< extended address modifiers
 extern struct opcode_s opcodes10[02000];
+
+char *disassemble(char * result, word36 instruction);
 #ifdef PANEL
 extern word8 insGrp [02000];
 // CPT 3U 0-35, 3L 0-17
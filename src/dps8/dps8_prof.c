@@ -0,0 +1,509 @@
+/*
+ Copyright 2016 by Charles Anthony
+
+ All rights reserved.
+
+ This software is made available under the terms of the
+ ICU License -- ICU 1.8.1 and later.
+ See the LICENSE file at the top-level directory of this distribution and
+ at https://sourceforge.net/p/dps8m/code/ci/master/tree/LICENSE
+ */
+
+// Sampling profiler
+//
+// A clock thread sets PROF_TICK in each profiled CPU's prof_flags at the
+// sample rate; the next instruction that CPU executes records its
+// opcode, PPR.PSR and PPR.IC into that CPU's sample ring (struct
+// prof_ring). prof_drain empties the rings into the histograms from the
+// clock thread and before a report. In TESTING builds sample addresses
+// are resolved to components through the system book (LD_SYSTEM_BOOK);
+// otherwise they are reported by segment number. Samples are taken on
+// wall clock time, so the profile shows where the emulator spends its
+// time rather than where Multics executes the most instructions. While
+// profiling, every instruction is also counted by opcode; the two
+// together give an estimate of the host time each opcode costs.
+//
+//   profile [rate]      start sampling, rate samples/second (default 1000)
+//   noprofile           stop sampling
+//   clrprofile          discard the collected samples
+//   profile_show [file] print the profile, or write all of it to file
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <time.h>
+
+#include "dps8.h"
+#include "dps8_sys.h"
+#include "dps8_cpu.h"
+#include "dps8_opcodetable.h"
+#include "dps8_utils.h"
+#include "dps8_prof.h"
+#include "uthash.h"
+
+#ifdef PROFILER
+
+#define PROF_RING_SIZE (1u << 14) // Must be a power of 2
+#define PROF_RING_MASK (PROF_RING_SIZE - 1)
+#define PROF_DEFAULT_RATE 1000
+#define PROF_MAX_RATE 100000
+#define PROF_SHOW_LINES 40
+// A CPU records at most one sample per tick, so draining every quarter
+// ring of ticks keeps the rings from filling at any rate.
+#define PROF_DRAIN_TICKS (PROF_RING_SIZE / 4)
+
+// A sample is packed as
+//   bit  43     absolute mode
+//   bits 42-33  opcode (with the extension bit)
+//   bits 32-18  PPR.PSR
+//   bits 17-0   PPR.IC
+#define SAMPLE_ABS (1llu << 43)
+#define SAMPLE_LOC_MASK (SAMPLE_ABS | ((1llu << 33) - 1))
+
+// Each CPU has its own ring, with one producer, the CPU, which alone
+// writes head, and one consumer, which alone writes tail. The producer
+// fills slots and then publishes them with a release store of head; the
+// consumer loads head with acquire, empties the ring up to it and frees
+// the slots with a release store of tail. Neither side takes a lock, so
+// recording never stalls a CPU thread; when a ring is full the record is
+// dropped and counted. The instruction trace rings in dps8_btrace.c work
+// the same way.
+
+struct prof_ring
+  {
+    uint64 samples [PROF_RING_SIZE];
+    uint head;   // written by the CPU
+    uint tail;   // written by prof_drain
+    unsigned long long dropped;
+    unsigned long long opcodes [02000];
+  };
+
+static struct prof_ring prof_rings [N_CPU_UNITS_MAX];
+
+struct prof_loc
+  {
+    uint64 key; // SAMPLE_ABS, PSR and IC of the sample
+    unsigned long long count;
+    UT_hash_handle hh;
+  };
+
+struct prof_comp
+  {
+    char name [160];
+    unsigned long long count;
+    UT_hash_handle hh;
+  };
+
+static struct prof_loc * prof_locs = NULL;
+static unsigned long long prof_op_samples [02000];
+static unsigned long long prof_nsamples = 0;
+
+static bool prof_inited = false;
+static uv_mutex_t prof_lock;
+static uv_thread_t prof_thread;
+static volatile bool prof_running = false;
+static uint prof_rate = PROF_DEFAULT_RATE;
+static double prof_seconds = 0;
+static struct timespec prof_t0;
+
+static void prof_clock (UNUSED void * arg)
+  {
+    long ns = 1000000000L / (long) prof_rate;
+    struct timespec period = { ns / 1000000000L, ns % 1000000000L };
+    uint ticks = 0;
+    while (prof_running)
+      {
+        nanosleep (& period, NULL);
+        for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+          if (cpus[i].prof_flags & PROF_ON)
+            __atomic_fetch_or (& cpus[i].prof_flags, PROF_TICK,
+                               __ATOMIC_RELAXED);
+        if (++ ticks == PROF_DRAIN_TICKS)
+          {
+            ticks = 0;
+            prof_drain ();
+          }
+      }
+  }
+
+// Called from executeInstruction when prof_flags is non-zero
+
+void prof_record (uint opcode10)
+  {
+    struct prof_ring * r = prof_rings + current_running_cpu_idx;
+    r->opcodes[opcode10] ++;
+    if (! (cpu.prof_flags & PROF_TICK))
+      return;
+    __atomic_fetch_and (& cpu.prof_flags, ~PROF_TICK, __ATOMIC_RELAXED);
+
+    uint head = r->head;
+    if (head - __atomic_load_n (& r->tail, __ATOMIC_ACQUIRE) >= PROF_RING_SIZE)
+      {
+        r->dropped ++;
+        return;
+      }
+    uint64 s = ((uint64) opcode10 << 33) |
+               ((uint64) cpu.PPR.PSR << 18) |
+               (uint64) cpu.PPR.IC;
+    if (get_addr_mode () == ABSOLUTE_mode)
+      s |= SAMPLE_ABS;
+    r->samples[head & PROF_RING_MASK] = s;
+    __atomic_store_n (& r->head, head + 1, __ATOMIC_RELEASE);
+  }
+
+void prof_drain (void)
+  {
+    if (! prof_inited)
+      return;
+    uv_mutex_lock (& prof_lock);
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      {
+        struct prof_ring * r = prof_rings + i;
+        uint head = __atomic_load_n (& r->head, __ATOMIC_ACQUIRE);
+        uint tail = r->tail;
+        for ( ; tail != head; tail ++)
+          {
+            uint64 s = r->samples[tail & PROF_RING_MASK];
+            uint64 key = s & SAMPLE_LOC_MASK;
+            struct prof_loc * p;
+            HASH_FIND (hh, prof_locs, & key, sizeof (key), p);
+            if (! p)
+              {
+                p = malloc (sizeof (struct prof_loc));
+                if (! p)
+                  break;
+                p->key = key;
+                p->count = 0;
+                HASH_ADD (hh, prof_locs, key, sizeof (key), p);
+              }
+            p->count ++;
+            prof_op_samples[(s >> 33) & 01777] ++;
+            prof_nsamples ++;
+          }
+        __atomic_store_n (& r->tail, tail, __ATOMIC_RELEASE);
+      }
+    uv_mutex_unlock (& prof_lock);
+  }
+
+static double prof_elapsed (void)
+  {
+    double secs = prof_seconds;
+    if (prof_running)
+      {
+        struct timespec now, delta;
+        clock_gettime (CLOCK_MONOTONIC, & now);
+        timespec_diff (& prof_t0, & now, & delta);
+        secs += (double) delta.tv_sec + (double) delta.tv_nsec / 1.0e9;
+      }
+    return secs;
+  }
+
+static t_stat prof_start (const char * buf)
+  {
+    uint rate = PROF_DEFAULT_RATE;
+    if (buf && * buf)
+      {
+        char * end;
+        unsigned long n = strtoul (buf, & end, 0);
+        if (* end || n < 1 || n > PROF_MAX_RATE)
+          {
+            sim_warn ("profile: rate must be 1 to %d samples per second\n",
+                      PROF_MAX_RATE);
+            return SCPE_ARG;
+          }
+        rate = (uint) n;
+      }
+    if (! prof_inited)
+      {
+        uv_mutex_init (& prof_lock);
+        prof_inited = true;
+      }
+    if (prof_running)
+      {
+        prof_seconds = prof_elapsed ();
+        prof_running = false;
+        uv_thread_join (& prof_thread);
+      }
+    prof_rate = rate;
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      cpus[i].prof_flags = PROF_ON;
+    clock_gettime (CLOCK_MONOTONIC, & prof_t0);
+    prof_running = true;
+    if (uv_thread_create (& prof_thread, prof_clock, NULL))
+      {
+        prof_running = false;
+        for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+          cpus[i].prof_flags = 0;
+        sim_warn ("profile: can't create the sample clock thread\n");
+        return SCPE_IERR;
+      }
+    sim_msg ("Profiling at %u samples per second\n", prof_rate);
+    return SCPE_OK;
+  }
+
+static t_stat prof_stop (void)
+  {
+    if (! prof_running)
+      return SCPE_OK;
+    prof_seconds = prof_elapsed ();
+    prof_running = false;
+    uv_thread_join (& prof_thread);
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      cpus[i].prof_flags = 0;
+    prof_drain ();
+    return SCPE_OK;
+  }
+
+static t_stat prof_clear (void)
+  {
+    if (! prof_inited)
+      return SCPE_OK;
+    prof_drain ();
+    uv_mutex_lock (& prof_lock);
+    struct prof_loc * p, * tmp;
+    HASH_ITER (hh, prof_locs, p, tmp)
+      {
+        HASH_DEL (prof_locs, p);
+        free (p);
+      }
+    memset (prof_op_samples, 0, sizeof (prof_op_samples));
+    prof_nsamples = 0;
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      {
+        prof_rings[i].dropped = 0;
+        memset (prof_rings[i].opcodes, 0, sizeof (prof_rings[i].opcodes));
+      }
+    prof_seconds = 0;
+    clock_gettime (CLOCK_MONOTONIC, & prof_t0);
+    uv_mutex_unlock (& prof_lock);
+    return SCPE_OK;
+  }
+
+// Report to the console (f == NULL) or a file
+
+static void pout (FILE * f, const char * fmt, ...)
+  {
+    char buf [256];
+    va_list ap;
+    va_start (ap, fmt);
+    vsnprintf (buf, sizeof (buf), fmt, ap);
+    va_end (ap);
+    if (f)
+      fputs (buf, f);
+    else
+      sim_printf ("%s", buf);
+  }
+
+static int comp_cmp (struct prof_comp * a, struct prof_comp * b)
+  {
+    return a->count < b->count ? 1 : a->count > b->count ? -1 : 0;
+  }
+
+static int loc_cmp (struct prof_loc * a, struct prof_loc * b)
+  {
+    return a->count < b->count ? 1 : a->count > b->count ? -1 : 0;
+  }
+
+static void loc_name (uint64 key, char * buf, size_t len, bool offset)
+  {
+    word15 segno = (key >> 18) & MASK15;
+    word18 ic = key & MASK18;
+    if (key & SAMPLE_ABS)
+      {
+        if (offset)
+          snprintf (buf, len, "(absolute) %06o", ic);
+        else
+          snprintf (buf, len, "(absolute)");
+        return;
+      }
+#ifdef TESTING
+    char * where = lookup_address (segno, ic, NULL, NULL);
+#else
+    char * where = NULL;
+#endif
+    if (! where)
+      {
+        if (offset)
+          snprintf (buf, len, "%05o:%06o", segno, ic);
+        else
+          snprintf (buf, len, "segment %05o", segno);
+        return;
+      }
+    snprintf (buf, len, "%s", where);
+    // "segname:compname+0offset"
+    char * plus = strrchr (buf, '+');
+    if (plus && ! offset)
+      * plus = 0;
+  }
+
+static void prof_report (FILE * f, uint limit)
+  {
+    uv_mutex_lock (& prof_lock);
+
+    unsigned long long dropped = 0;
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      dropped += prof_rings[i].dropped;
+    pout (f, "Profile: %llu samples at %u/s over %.1f seconds; %llu dropped\n",
+          prof_nsamples, prof_rate, prof_elapsed (), dropped);
+    double total = prof_nsamples ? (double) prof_nsamples : 1.0;
+
+    // Flat profile by component
+
+    struct prof_comp * comps = NULL, * c, * ctmp;
+    struct prof_loc * p, * ptmp;
+    HASH_ITER (hh, prof_locs, p, ptmp)
+      {
+        char name [sizeof (c->name)];
+        loc_name (p->key, name, sizeof (name), false);
+        HASH_FIND_STR (comps, name, c);
+        if (! c)
+          {
+            c = malloc (sizeof (struct prof_comp));
+            if (! c)
+              break;
+            strcpy (c->name, name);
+            c->count = 0;
+            HASH_ADD_STR (comps, name, c);
+          }
+        c->count += p->count;
+      }
+    HASH_SORT (comps, comp_cmp);
+
+    pout (f, "\n     samples       %%   cum %%  component\n");
+    double cum = 0;
+    uint n = 0;
+    HASH_ITER (hh, comps, c, ctmp)
+      {
+        cum += (double) c->count;
+        if (! limit || n < limit)
+          pout (f, "%12llu  %6.2f  %6.2f  %s\n", c->count,
+                100.0 * (double) c->count / total, 100.0 * cum / total,
+                c->name);
+        n ++;
+        HASH_DEL (comps, c);
+        free (c);
+      }
+
+    // Hottest addresses
+
+    HASH_SORT (prof_locs, loc_cmp);
+    pout (f, "\n     samples       %%  address\n");
+    n = 0;
+    HASH_ITER (hh, prof_locs, p, ptmp)
+      {
+        if (limit && n >= limit)
+          break;
+        char name [sizeof (c->name)];
+        loc_name (p->key, name, sizeof (name), true);
+        pout (f, "%12llu  %6.2f  %s\n", p->count,
+              100.0 * (double) p->count / total, name);
+        n ++;
+      }
+
+    // Opcodes; the estimated host time per instruction is the opcode's
+    // share of the sampled time divided by its execution count.
+
+    static uint ops [02000];
+    static unsigned long long counts [02000];
+    uint nops = 0;
+    for (uint op = 0; op < 02000; op ++)
+      {
+        counts[op] = 0;
+        for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+          counts[op] += prof_rings[i].opcodes[op];
+        if (counts[op] || prof_op_samples[op])
+          ops[nops ++] = op;
+      }
+    // Insertion sort by samples, then count; nops is small
+    for (uint i = 1; i < nops; i ++)
+      {
+        uint op = ops[i];
+        uint j = i;
+        while (j > 0 &&
+               (prof_op_samples[ops[j - 1]] < prof_op_samples[op] ||
+                (prof_op_samples[ops[j - 1]] == prof_op_samples[op] &&
+                 counts[ops[j - 1]] < counts[op])))
+          {
+            ops[j] = ops[j - 1];
+            j --;
+          }
+        ops[j] = op;
+      }
+
+    double ns_per_sample = 1.0e9 / (double) prof_rate;
+    pout (f, "\nopcode            executed     samples       %%   ns/instr\n");
+    for (uint i = 0; i < nops && (! limit || i < limit); i ++)
+      {
+        uint op = ops[i];
+        char mne [16];
+        if (opcodes10[op].mne)
+          snprintf (mne, sizeof (mne), "%s", opcodes10[op].mne);
+        else
+          snprintf (mne, sizeof (mne), "%04o", op);
+        if (counts[op])
+          pout (f, "%-8s %17llu %11llu  %6.2f  %9.1f\n", mne, counts[op],
+                prof_op_samples[op],
+                100.0 * (double) prof_op_samples[op] / total,
+                (double) prof_op_samples[op] * ns_per_sample /
+                  (double) counts[op]);
+        else
+          pout (f, "%-8s %17llu %11llu  %6.2f\n", mne, counts[op],
+                prof_op_samples[op],
+                100.0 * (double) prof_op_samples[op] / total);
+      }
+
+    uv_mutex_unlock (& prof_lock);
+  }
+
+static t_stat prof_show (const char * buf)
+  {
+    if (! prof_inited)
+      {
+        sim_msg ("No profile collected\n");
+        return SCPE_OK;
+      }
+    prof_drain ();
+    if (! buf || ! * buf)
+      {
+        prof_report (NULL, PROF_SHOW_LINES);
+        return SCPE_OK;
+      }
+    FILE * f = fopen (buf, "w");
+    if (! f)
+      {
+        sim_warn ("profile: can't open %s: %s\n", buf, strerror (errno));
+        return SCPE_OPENERR;
+      }
+    prof_report (f, 0);
+    fclose (f);
+    sim_msg ("Profile written to %s\n", buf);
+    return SCPE_OK;
+  }
+
+// arg: 0 start, 1 stop, 2 clear, 3 show
+
+t_stat prof_cmd (int32 arg, const char * buf)
+  {
+    switch (arg)
+      {
+        case 0:
+          return prof_start (buf);
+        case 1:
+          return prof_stop ();
+        case 2:
+          return prof_clear ();
+        case 3:
+          return prof_show (buf);
+      }
+    return SCPE_ARG;
+  }
+
+#else // ! PROFILER
+
+t_stat prof_cmd (UNUSED int32 arg, UNUSED const char * buf)
+  {
+    sim_printf ("profiler not enabled; ignoring\n");
+    return SCPE_OK;
+  }
+
+#endif // PROFILER
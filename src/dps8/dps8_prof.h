@@ -0,0 +1,27 @@
+/*
+ Copyright 2016 by Charles Anthony
+
+ All rights reserved.
+
+ This software is made available under the terms of the
+ ICU License -- ICU 1.8.1 and later.
+ See the LICENSE file at the top-level directory of this distribution and
+ at https://sourceforge.net/p/dps8m/code/ci/master/tree/LICENSE
+ */
+
+#ifndef DPS8_PROF_H
+#define DPS8_PROF_H
+
+// Sampling profiler
+
+t_stat prof_cmd (int32 arg, const char * buf);
+
+#ifdef PROFILER
+// cpu.prof_flags
+#define PROF_ON   1u  // Count opcodes
+#define PROF_TICK 2u  // The sample clock has fired; record PPR
+
+void prof_record (uint opcode10);
+void prof_drain (void);
+#endif
+#endif
@@ -606,12 +606,7 @@ sim_printf ("\n");
                   openPrtFile (prt_unit_num, buffer, tally);
 
                 uint8 bytes [tally * 4];
-                for (uint i = 0; i < tally * 4; i ++)
-                  {
-                    uint wordno = i / 4;
-                    uint charno = i % 4;
-                    bytes [i] = (uint8) (buffer [wordno] >> ((3 - charno) * 9)) & 0377;
-                  }
+                putASCII36N (buffer, bytes, tally);
 
                 for (uint i = 0; i < tally * 4; i ++)
                   {
@@ -2177,12 +2177,12 @@ clock_gettime (CLOCK_REALTIME, & cioc_t0);
         int iom_unit_idx = portp->dev_idx;
 #if defined(THREADZ) || defined(LOCKLESS)
         unlock_scu ();
-#if !defined(IO_ASYNC_PAYLOAD_CHAN) && !defined(IO_ASYNC_PAYLOAD_CHAN_THREAD)
+#if !defined(IO_ASYNC_PAYLOAD_CHAN) && !defined(IO_ASYNC_PAYLOAD_CHAN_THREAD) && !defined(IOM_ASYNC)
         lock_iom ();
 	lock_libuv ();
 #endif
         iom_interrupt (scu_unit_idx, (uint) iom_unit_idx);
-#if !defined(IO_ASYNC_PAYLOAD_CHAN) && !defined(IO_ASYNC_PAYLOAD_CHAN_THREAD)
+#if !defined(IO_ASYNC_PAYLOAD_CHAN) && !defined(IO_ASYNC_PAYLOAD_CHAN_THREAD) && !defined(IOM_ASYNC)
 	unlock_libuv ();
         unlock_iom ();
 #endif
@@ -120,6 +120,7 @@ extern DEVICE scu_dev;
 #define CONT_XEC    -3  // instruction was a XEC or XED 
 #define CONT_RET    -5  // encountered a return instruction; don't bump PPR.IC,
 			// do instruction fetch
+#define CONT_FAULT  -6  // a fault has been set up; return to the CPU loop
 
 //
 // mask entry flags
@@ -0,0 +1,396 @@
+/*
+ Copyright 2019 by Charles Anthony
+
+ All rights reserved.
+
+ This software is made available under the terms of the
+ ICU License -- ICU 1.8.1 and later.
+ See the LICENSE file at the top-level directory of this distribution and
+ at https://sourceforge.net/p/dps8m/code/ci/master/tree/LICENSE
+ */
+
+// Machine snapshots
+//
+//   save file      write a snapshot of the stopped machine
+//   restore file   load a snapshot; continue with "cont"
+//
+// A snapshot holds memory, the CPUs and SCUs, the IOM unit and channel
+// state, the disk seek state and the FNP line state; the cabling is
+// recorded only to check it against the restoring emulator's. Memory is
+// written a page at a time, packed 2 words to 9 bytes, and pages of
+// zeros are left out.
+//
+// A snapshot is not a configuration: the restoring emulator must be
+// configured and have the same disk and tape images attached as the one
+// that saved it, and those images must be in the state they were in
+// when the snapshot was taken. Host connections to FNP lines do not
+// survive; lines that were connected are reported to Multics as hung
+// up. Snapshots are tied to the build that wrote them; the section sizes
+// are checked and a different build is refused or warned about.
+//
+// File layout: a header (magic, version, commit id, the address of the
+// cpus array when saved) followed by sections, each an 8 character tag,
+// a 64 bit length and the data. A restore makes a validation pass over
+// the whole file before it changes anything.
+
+#include <stdio.h>
+#include <errno.h>
+
+#include "dps8.h"
+#include "dps8_sys.h"
+#include "dps8_cpu.h"
+#include "dps8_scu.h"
+#include "dps8_iom.h"
+#include "dps8_cable.h"
+#include "dps8_disk.h"
+#include "dps8_fnp2.h"
+#include "dps8_utils.h"
+#include "dps8_state.h"
+#include "dps8_snap.h"
+
+#define SNAP_MAGIC "DPS8SNAP"
+#define SNAP_VERSION 1
+#define SNAP_TAG_LEN 8
+#define SNAP_PAGE_WORDS MEM_PAGE_WORDS
+#define SNAP_PAGE_BYTES (SNAP_PAGE_WORDS * 9 / 2)
+
+struct snap_s
+  {
+    FILE * fp;
+    bool restoring;
+    bool apply;     // false on the validation pass of a restore
+    bool ok;
+  };
+
+struct snap_hdr
+  {
+    char magic [8];
+    uint32 version;
+    char commit_id [41];
+    uint64 cpus_base;  // & cpus[0] in the saving emulator
+  };
+
+static bool snap_fail (struct snap_s * s, const char * tag, const char * why)
+  {
+    if (s->ok)
+      sim_warn ("snapshot: section %s: %s\n", tag, why);
+    s->ok = false;
+    return false;
+  }
+
+// Write or read and check a section header
+
+static bool snap_section (struct snap_s * s, const char * tag, uint64 * len)
+  {
+    char t [SNAP_TAG_LEN];
+    memset (t, 0, sizeof (t));
+    size_t n = strlen (tag);
+    memcpy (t, tag, n < sizeof (t) ? n : sizeof (t));
+    if (! s->restoring)
+      {
+        if (fwrite (t, sizeof (t), 1, s->fp) != 1 ||
+            fwrite (len, sizeof (* len), 1, s->fp) != 1)
+          return snap_fail (s, tag, strerror (errno));
+        return true;
+      }
+    char got [SNAP_TAG_LEN];
+    if (fread (got, sizeof (got), 1, s->fp) != 1 ||
+        fread (len, sizeof (* len), 1, s->fp) != 1)
+      return snap_fail (s, tag, "truncated");
+    if (memcmp (got, t, sizeof (t)) != 0)
+      return snap_fail (s, tag, "missing");
+    return true;
+  }
+
+bool snap_restoring (struct snap_s * s)
+  {
+    return s->restoring;
+  }
+
+bool snap_io (struct snap_s * s, const char * tag, void * data, size_t len)
+  {
+    if (! s->ok)
+      return false;
+    uint64 n = len;
+    if (! s->restoring)
+      {
+        if (! snap_section (s, tag, & n))
+          return false;
+        if (fwrite (data, 1, len, s->fp) != len)
+          return snap_fail (s, tag, strerror (errno));
+        return true;
+      }
+    if (! snap_section (s, tag, & n))
+      return false;
+    if (n != len)
+      return snap_fail (s, tag, "size differs; snapshot is from another build");
+    if (! s->apply)
+      {
+        if (fseek (s->fp, (long) len, SEEK_CUR))
+          return snap_fail (s, tag, "truncated");
+        return false;
+      }
+    if (fread (data, 1, len, s->fp) != len)
+      return snap_fail (s, tag, "truncated");
+    return true;
+  }
+
+bool snap_check (struct snap_s * s, const char * tag, const void * data,
+                 size_t len)
+  {
+    if (! s->ok)
+      return false;
+    uint64 n = len;
+    if (! s->restoring)
+      {
+        if (! snap_section (s, tag, & n))
+          return false;
+        if (fwrite (data, 1, len, s->fp) != len)
+          return snap_fail (s, tag, strerror (errno));
+        return true;
+      }
+    if (! snap_section (s, tag, & n))
+      return false;
+    if (n != len)
+      return snap_fail (s, tag, "size differs; snapshot is from another build");
+    uint8 * saved = malloc (len);
+    if (! saved)
+      return snap_fail (s, tag, "out of memory");
+    bool same = fread (saved, 1, len, s->fp) == len;
+    if (! same)
+      snap_fail (s, tag, "truncated");
+    else if (memcmp (saved, data, len) != 0)
+      {
+        snap_fail (s, tag, "differs from the running configuration");
+        same = false;
+      }
+    free (saved);
+    return same;
+  }
+
+// Memory: the memory size, then (page number, packed page) for each
+// page that is not all zeros.
+
+static void snap_memory (struct snap_s * s)
+  {
+    static word36 page [SNAP_PAGE_WORDS];
+    static uint8 packed [SNAP_PAGE_BYTES];
+    static uint8 in_use [MEM_PAGES];
+    const uint npages = MEMSIZE / SNAP_PAGE_WORDS;
+    const uint64 rec = sizeof (uint32) + SNAP_PAGE_BYTES;
+    uint32 nwords = MEMSIZE;
+
+    if (! s->ok)
+      return;
+
+    // Pages the host has never committed are known to be zero
+    mem_in_use (in_use);
+
+    if (! s->restoring)
+      {
+        uint64 len = sizeof (nwords);
+        for (uint p = 0; p < npages; p ++)
+          for (uint i = 0; in_use [p] && i < SNAP_PAGE_WORDS; i ++)
+            if (M[p * SNAP_PAGE_WORDS + i] & MASK36)
+              {
+                len += rec;
+                break;
+              }
+        if (! snap_section (s, "mem", & len))
+          return;
+        if (fwrite (& nwords, sizeof (nwords), 1, s->fp) != 1)
+          {
+            snap_fail (s, "mem", strerror (errno));
+            return;
+          }
+        for (uint32 p = 0; p < npages; p ++)
+          {
+            if (! in_use [p])
+              continue;
+            word36 any = 0;
+            for (uint i = 0; i < SNAP_PAGE_WORDS; i ++)
+              {
+                // Drop the LOCKLESS lock bit
+                page[i] = M[p * SNAP_PAGE_WORDS + i] & MASK36;
+                any |= page[i];
+              }
+            if (! any)
+              continue;
+            put36N (page, packed, SNAP_PAGE_WORDS);
+            if (fwrite (& p, sizeof (p), 1, s->fp) != 1 ||
+                fwrite (packed, sizeof (packed), 1, s->fp) != 1)
+              {
+                snap_fail (s, "mem", strerror (errno));
+                return;
+              }
+          }
+        return;
+      }
+
+    uint64 len;
+    if (! snap_section (s, "mem", & len))
+      return;
+    if (len < sizeof (nwords) || (len - sizeof (nwords)) % rec != 0 ||
+        fread (& nwords, sizeof (nwords), 1, s->fp) != 1)
+      {
+        snap_fail (s, "mem", "malformed");
+        return;
+      }
+    if (nwords != MEMSIZE)
+      {
+        snap_fail (s, "mem", "memory size differs");
+        return;
+      }
+    uint64 nrecs = (len - sizeof (nwords)) / rec;
+    if (! s->apply)
+      {
+        if (fseek (s->fp, (long) (nrecs * rec), SEEK_CUR))
+          snap_fail (s, "mem", "truncated");
+        return;
+      }
+    // Pages not in the snapshot are cleared; storing only to nonzero
+    // words leaves untouched memory uncommitted.
+    for (uint p = 0; p < npages; p ++)
+      if (in_use [p])
+        for (uint i = p * SNAP_PAGE_WORDS; i < (p + 1) * SNAP_PAGE_WORDS; i ++)
+          if (M[i])
+            M[i] = 0;
+    for (uint64 r = 0; r < nrecs; r ++)
+      {
+        uint32 p;
+        if (fread (& p, sizeof (p), 1, s->fp) != 1 ||
+            fread (packed, sizeof (packed), 1, s->fp) != 1)
+          {
+            snap_fail (s, "mem", "truncated");
+            return;
+          }
+        if (p >= npages)
+          {
+            snap_fail (s, "mem", "bad page number");
+            return;
+          }
+        extr36N (packed, page, SNAP_PAGE_WORDS);
+        for (uint i = 0; i < SNAP_PAGE_WORDS; i ++)
+          M[p * SNAP_PAGE_WORDS + i] = page[i];
+      }
+  }
+
+// Finish the I/O in flight before any section is read or written, so
+// that none of it stores into memory or the SCUs behind the snapshot.
+
+static void snap_quiesce (void)
+  {
+    // The payload channels first, as they start disk transfers
+    iom_quiesce ();
+    disk_quiesce ();
+  }
+
+static void snap_all (struct snap_s * s, uint64 cpus_base)
+  {
+    snap_memory (s);
+    cpu_snap (s, cpus_base);
+    snap_io (s, "scu", scu, sizeof (scu));
+    cable_snap (s);
+    iom_snap (s);
+    disk_snap (s);
+    fnp_snap (s);
+    snap_io (s, "end", NULL, 0);
+  }
+
+t_stat snap_save (UNUSED int32 arg, const char * buf)
+  {
+#ifdef SCUMEM
+    sim_warn ("save: not supported with SCUMEM\n");
+    return SCPE_NOFNC;
+#else
+    if (! buf || ! * buf)
+      {
+        sim_warn ("save: missing file name\n");
+        return SCPE_ARG;
+      }
+    FILE * fp = fopen (buf, "wb");
+    if (! fp)
+      {
+        sim_warn ("save: can't open %s: %s\n", buf, strerror (errno));
+        return SCPE_OPENERR;
+      }
+    struct snap_hdr hdr;
+    memset (& hdr, 0, sizeof (hdr));
+    memcpy (hdr.magic, SNAP_MAGIC, sizeof (hdr.magic));
+    hdr.version = SNAP_VERSION;
+    snprintf (hdr.commit_id, sizeof (hdr.commit_id), "%s",
+              system_state->commit_id);
+    hdr.cpus_base = (uint64) (uintptr_t) cpus;
+
+    snap_quiesce ();
+    struct snap_s s = { fp, false, false, true };
+    if (fwrite (& hdr, sizeof (hdr), 1, fp) != 1)
+      snap_fail (& s, "header", strerror (errno));
+    snap_all (& s, hdr.cpus_base);
+    if (fclose (fp) && s.ok)
+      snap_fail (& s, "end", strerror (errno));
+    if (! s.ok)
+      {
+        remove (buf);
+        return SCPE_IOERR;
+      }
+    sim_msg ("Snapshot saved to %s\n", buf);
+    return SCPE_OK;
+#endif
+  }
+
+t_stat snap_restore (UNUSED int32 arg, const char * buf)
+  {
+#ifdef SCUMEM
+    sim_warn ("restore: not supported with SCUMEM\n");
+    return SCPE_NOFNC;
+#else
+    if (! buf || ! * buf)
+      {
+        sim_warn ("restore: missing file name\n");
+        return SCPE_ARG;
+      }
+    FILE * fp = fopen (buf, "rb");
+    if (! fp)
+      {
+        sim_warn ("restore: can't open %s: %s\n", buf, strerror (errno));
+        return SCPE_OPENERR;
+      }
+    struct snap_hdr hdr;
+    if (fread (& hdr, sizeof (hdr), 1, fp) != 1 ||
+        memcmp (hdr.magic, SNAP_MAGIC, sizeof (hdr.magic)) != 0)
+      {
+        sim_warn ("restore: %s is not a snapshot\n", buf);
+        fclose (fp);
+        return SCPE_FMT;
+      }
+    if (hdr.version != SNAP_VERSION)
+      {
+        sim_warn ("restore: %s is snapshot version %u; expected %u\n",
+                  buf, hdr.version, SNAP_VERSION);
+        fclose (fp);
+        return SCPE_INCOMP;
+      }
+    hdr.commit_id[sizeof (hdr.commit_id) - 1] = 0;
+    if (strcmp (hdr.commit_id, system_state->commit_id) != 0)
+      sim_warn ("restore: %s was saved by build %s\n", buf, hdr.commit_id);
+
+    // Validate, then apply
+    snap_quiesce ();
+    struct snap_s s = { fp, true, false, true };
+    snap_all (& s, hdr.cpus_base);
+    if (s.ok)
+      {
+        fseek (fp, (long) sizeof (hdr), SEEK_SET);
+        s.apply = true;
+        snap_all (& s, hdr.cpus_base);
+        if (! s.ok)
+          sim_warn ("restore: machine state is now inconsistent\n");
+      }
+    fclose (fp);
+    if (! s.ok)
+      return SCPE_IOERR;
+    sim_msg ("Snapshot restored from %s\n", buf);
+    return SCPE_OK;
+#endif
+  }
@@ -0,0 +1,34 @@
+/*
+ Copyright 2019 by Charles Anthony
+
+ All rights reserved.
+
+ This software is made available under the terms of the
+ ICU License -- ICU 1.8.1 and later.
+ See the LICENSE file at the top-level directory of this distribution and
+ at https://sourceforge.net/p/dps8m/code/ci/master/tree/LICENSE
+ */
+
+#ifndef DPS8_SNAP_H
+#define DPS8_SNAP_H
+
+// Machine snapshots
+
+struct snap_s;
+
+// Save or restore one section. When saving, writes len bytes from data;
+// when restoring, reads them into data and returns true. Returns false
+// on the validation pass of a restore and on any error, so callers only
+// apply restored state when it returns true.
+bool snap_io (struct snap_s * s, const char * tag, void * data, size_t len);
+// A section that must match the running emulator rather than be loaded
+// into it. When saving, writes len bytes from data; when restoring,
+// compares them with data on both passes and fails the restore if they
+// differ.
+bool snap_check (struct snap_s * s, const char * tag, const void * data,
+                 size_t len);
+bool snap_restoring (struct snap_s * s);
+
+t_stat snap_save (int32 arg, const char * buf);
+t_stat snap_restore (int32 arg, const char * buf);
+#endif
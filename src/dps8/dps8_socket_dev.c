@@ -44,7 +44,7 @@ static struct
     int fd_unit[N_FDS]; // unit number that a FD is associated with; -1 is free.   
     word6 fd_dev_code[N_FDS]; // dev_code that a FD is associated with; -1 is free.   
     bool fd_nonblock[N_FDS]; // socket() call had NON_BLOCK set
-    struct
+    struct sk_unit_s
       {
         enum 
           {
@@ -57,9 +57,17 @@ static struct
          int read_fd;
          uint read_buffer_sz;
          uint words_processed;
+         // Bumped each time the unit starts waiting on a socket
+         uint wait_gen;
+         // The event loop's watch of the socket being waited on
+         uv_poll_t * poll;
+         uint poll_gen;
       } unit_data[N_SKC_UNITS_MAX][N_DEV_CODES];
   } sk_data;
 
+// Set when a unit starts waiting; the event loop then updates its watches
+static bool sk_watch_changed = false;
+
 #define N_SKC_UNITS 64 // default
 
 static t_stat sk_show_nunits (UNUSED FILE * st, UNUSED UNIT * uptr, 
@@ -210,6 +218,23 @@ static void set_error (word36 * error_str, int _errno)
     set_error_str (error_str, huh);
   }
 
+// The unit is now waiting on a socket, or has closed one. The commands
+// may run on an IOM thread, which must not take the libuv lock under the
+// controller lock, so the event loop is asked to update the watches
+// (sk_process_event).
+
+static void sk_rewatch (void)
+  {
+    __atomic_store_n (& sk_watch_changed, true, __ATOMIC_RELEASE);
+    ev_poll_kick ();
+  }
+
+static void sk_wait (uint unit_idx, word6 dev_code)
+  {
+    sk_data.unit_data[unit_idx][dev_code].wait_gen ++;
+    sk_rewatch ();
+  }
+
 static void skt_socket (uint unit_idx, word5 dev_code, word36 * buffer)
   {
 // /* Data block for socket() call */
@@ -520,6 +545,7 @@ sim_printf ("accept() socket     %d\n", socket_fd);
     //FD_SET (socket_fd, & sk_data.unit_data[unit_idx][dev_code].accept_fds);
     sk_data.unit_data[unit_idx][dev_code].accept_fd = socket_fd;
     sk_data.unit_data[unit_idx][dev_code].unit_state = unit_accept;
+    sk_wait (unit_idx, dev_code);
     return IOM_CMD_PENDING; // don't send terminate interrupt
   }
 
@@ -556,6 +582,7 @@ sim_printf ("close() socket doesn't belong to us\n");
       {
         sk_data.unit_data[unit_idx][dev_code].unit_state = unit_idle;
         sk_data.unit_data[unit_idx][dev_code].accept_fd = -1;
+        sk_rewatch ();
       }
     rc = close (socket_fd);
 
@@ -602,6 +629,7 @@ sim_printf ("read8() socket doesn't belong to us\n");
     sk_data.unit_data[unit_idx][dev_code].read_fd = socket_fd;
     sk_data.unit_data[unit_idx][dev_code].read_buffer_sz = count;
     sk_data.unit_data[unit_idx][dev_code].unit_state = unit_read;
+    sk_wait (unit_idx, dev_code);
     return IOM_CMD_PENDING; // don't send terminate interrupt
   }
 
@@ -1103,23 +1131,121 @@ static void do_try_read (uint unit_idx, word6 dev_code)
     send_terminate_interrupt (iom_unit_idx, chan);
   }
 
-void sk_process_event (void)
+//
+// Pending accepts and reads are completed from the event loop when their
+// socket polls readable. Each waiting unit has a uv_poll_t on its socket;
+// the watch is dropped when the unit stops waiting or starts a new wait,
+// as the socket may have been closed and its descriptor reused.
+//
+// Called from the event loop with the controller locked.
+//
+
+static void sk_poll_cb (uv_poll_t * handle, int status, int events);
+
+static void sk_poll_close_cb (uv_handle_t * handle)
+  {
+    free (handle);
+  }
+
+static int sk_wait_fd (struct sk_unit_s * up)
+  {
+    if (up->unit_state == unit_accept)
+      return up->accept_fd;
+    if (up->unit_state == unit_read)
+      return up->read_fd;
+    return -1;
+  }
+
+// Drop the unit's watch if it is no longer waiting on that socket
+
+static void sk_unwatch (uint unit_idx, word6 dev_code)
   {
-// Accepts
-    for (uint unit_idx = 0; unit_idx < N_SKC_UNITS_MAX; unit_idx ++)
+    struct sk_unit_s * up = & sk_data.unit_data[unit_idx][dev_code];
+    if (up->poll && (sk_wait_fd (up) < 0 || up->poll_gen != up->wait_gen))
       {
-        for (word6 dev_code = 0; dev_code < N_DEV_CODES; dev_code ++)
-          {
-            if (sk_data.unit_data[unit_idx][dev_code].unit_state == unit_accept)
-              {
-                do_try_accept (unit_idx, dev_code);
-              }
-            else if (sk_data.unit_data[unit_idx][dev_code].unit_state == unit_read)
-              {
-                do_try_read (unit_idx, dev_code);
-              }
-          }
+        uv_poll_stop (up->poll);
+        uv_close ((uv_handle_t *) up->poll, sk_poll_close_cb);
+        up->poll = NULL;
+      }
+  }
+
+// Watch the socket the unit is waiting on. A reused descriptor may still
+// have a stale watch on another unit; those are dropped first.
+
+static void sk_watch (uint unit_idx, word6 dev_code)
+  {
+    struct sk_unit_s * up = & sk_data.unit_data[unit_idx][dev_code];
+    int fd = sk_wait_fd (up);
+    if (fd < 0 || up->poll)
+      return;
+
+    up->poll = malloc (sizeof (uv_poll_t));
+    if (! up->poll)
+      {
+        sim_warn ("%s: out of memory\n", __func__);
+        return;
       }
+    int rc = uv_poll_init (uv_default_loop (), up->poll, fd);
+    if (rc)
+      {
+        sim_warn ("%s: uv_poll_init %d: %s\n", __func__, fd, uv_strerror (rc));
+        free (up->poll);
+        up->poll = NULL;
+        return;
+      }
+    up->poll->data = (void *) (uintptr_t) (unit_idx * N_DEV_CODES + dev_code);
+    up->poll_gen = up->wait_gen;
+    uv_poll_start (up->poll, UV_READABLE, sk_poll_cb);
+  }
+
+static void sk_poll_cb (uv_poll_t * handle, UNUSED int status,
+                        UNUSED int events)
+  {
+    uint unit_idx = (uint) ((uintptr_t) handle->data / N_DEV_CODES);
+    word6 dev_code = (word6) ((uintptr_t) handle->data % N_DEV_CODES);
+#ifdef IOM_ASYNC
+    // The controller's commands may be running on an IOM worker
+    lock_ctlr (CTLR_T_SKC, unit_idx);
+#endif
+    struct sk_unit_s * up = & sk_data.unit_data[unit_idx][dev_code];
+    // Ignore a watch left over from an earlier wait
+    if (up->poll == handle)
+      {
+        if (up->unit_state == unit_accept)
+          do_try_accept (unit_idx, dev_code);
+        else if (up->unit_state == unit_read)
+          do_try_read (unit_idx, dev_code);
+        sk_unwatch (unit_idx, dev_code);
+      }
+#ifdef IOM_ASYNC
+    unlock_ctlr (CTLR_T_SKC, unit_idx);
+#endif
+  }
+
+// Stop and start watches for the units that have changed what they are
+// waiting on
+
+void sk_process_event (void)
+  {
+    if (! __atomic_exchange_n (& sk_watch_changed, false, __ATOMIC_ACQ_REL))
+      return;
+    for (int pass = 0; pass < 2; pass ++)
+      for (uint unit_idx = 0; unit_idx < N_SKC_UNITS_MAX; unit_idx ++)
+        {
+#ifdef IOM_ASYNC
+          lock_ctlr (CTLR_T_SKC, unit_idx);
+#endif
+          for (word6 dev_code = 0; dev_code < N_DEV_CODES; dev_code ++)
+            {
+              if (pass == 0)
+                sk_unwatch (unit_idx, dev_code);
+              else
+                sk_watch (unit_idx, dev_code);
+            }
+#ifdef IOM_ASYNC
+          unlock_ctlr (CTLR_T_SKC, unit_idx);
+#endif
+        }
   }
 
 
@@ -45,6 +45,7 @@
 #include "dps8_ins.h"
 #include "dps8_loader.h"
 #include "dps8_math.h"
+#include "dps8_eis.h"
 #include "dps8_mt.h"
 #include "dps8_socket_dev.h"
 #include "dps8_disk.h"
@@ -55,7 +56,12 @@
 #include "dps8_prt.h"
 #include "dps8_urp.h"
 #include "dps8_absi.h"
+#include "dps8_book.h"
+#include "dps8_btrace.h"
+#include "dps8_opcodetable.h"
 #include "dps8_utils.h"
+#include "dps8_prof.h"
+#include "dps8_snap.h"
 #include "shm.h"
 #include "utlist.h"
 #if defined(THREADZ) || defined(LOCKLESS)
@@ -2056,145 +2062,7 @@ static t_stat abs_addr (UNUSED int32 arg, const char * buf)
     return abs_addr_n (segno, offset);
   }
 
-// LOAD_SYSTEM_BOOK <filename>
-
-// Read a system_book segment, extracting segment names and numbers
-// and component names, offsets, and lengths
-
-#define BOOT_SEGMENTS_MAX 1024
-#define BOOT_COMPONENTS_MAX 4096
-#define BOOK_SEGMENT_NAME_LEN 33
-
-static struct book_segment
-  {
-    char * segname;
-    int segno;
-  } book_segments[BOOT_SEGMENTS_MAX];
-
-static int n_book_segments = 0;
-
-static struct book_component
-  {
-    char * compname;
-    int book_segment_number;
-    uint txt_start, txt_length;
-    int intstat_start, intstat_length, symbol_start, symbol_length;
-  } book_components[BOOT_COMPONENTS_MAX];
-
-static int n_book_components = 0;
-
-static int lookup_book_segment (char * name)
-  {
-    for (int i = 0; i < n_book_segments; i ++)
-      if (strcmp (name, book_segments[i].segname) == 0)
-        return i;
-    return -1;
-  }
-
-static int add_book_segment (char * name, int segno)
-  {
-    int n = lookup_book_segment (name);
-    if (n >= 0)
-      return n;
-    if (n_book_segments >= BOOT_SEGMENTS_MAX)
-      return -1;
-    book_segments[n_book_segments].segname = strdup (name);
-    book_segments[n_book_segments].segno = segno;
-    n = n_book_segments;
-    n_book_segments ++;
-    return n;
-  }
- 
-static int add_book_component (int segnum, char * name, uint txt_start,
-                               uint txt_length, int intstat_start, 
-                               int intstat_length, int symbol_start,
-                               int symbol_length)
-  {
-    if (n_book_components >= BOOT_COMPONENTS_MAX)
-      return -1;
-    book_components[n_book_components].compname = strdup (name);
-    book_components[n_book_components].book_segment_number = segnum;
-    book_components[n_book_components].txt_start = txt_start;
-    book_components[n_book_components].txt_length = txt_length;
-    book_components[n_book_components].intstat_start = intstat_start;
-    book_components[n_book_components].intstat_length = intstat_length;
-    book_components[n_book_components].symbol_start = symbol_start;
-    book_components[n_book_components].symbol_length = symbol_length;
-    int n = n_book_components;
-    n_book_components ++;
-    return n;
-  }
- 
-
-// Given a segno:offset, try to translate to
-// component name and offset in the component
-
-// Warning: returns ptr to static buffer
-static char * lookup_system_book_address (word18 segno, word18 offset,
-                                         char * * compname, word18 * compoffset)
-  {
-    static char buf[129];
-    int i;
-
-    for (i = 0; i < n_book_segments; i ++)
-      if (book_segments[i].segno == (int) segno)
-        break;
-
-    if (i >= n_book_segments)
-      return NULL;
-
-    int best = -1;
-    uint bestoffset = 0;
-
-    for (int j = 0; j < n_book_components; j ++)
-      {
-        if (book_components[j].book_segment_number != i)
-          continue;
-        if (book_components[j].txt_start <= offset &&
-            book_components[j].txt_start + book_components[j].txt_length > offset)
-          {
-            sprintf (buf, "%s:%s+0%0o", book_segments[i].segname,
-              book_components[j].compname,
-              offset - book_components[j].txt_start);
-            if (compname)
-              * compname = book_components[j].compname;
-            if (compoffset)
-              * compoffset = offset - book_components[j].txt_start;
-            return buf;
-          }
-        if (book_components[j].txt_start <= offset &&
-            book_components[j].txt_start > bestoffset)
-          {
-            best = j;
-            bestoffset = book_components[j].txt_start;
-          }
-      }
-
-    if (best != -1)
-      {
-        // Didn't find a component track bracketed the offset; return the
-        // component that was before the offset
-        if (compname)
-          * compname = book_components[best].compname;
-        if (compoffset)
-          * compoffset = offset - book_components[best].txt_start;
-        sprintf (buf, "%s:%s+0%0o", book_segments[i].segname,
-          book_components[best].compname,
-          offset - book_components[best].txt_start);
-        return buf;
-      }
-
-    // Found a segment, but it had no components. Return the segment name
-    // as the component name
-
-    if (compname)
-      * compname = book_segments[i].segname;
-    if (compoffset)
-      * compoffset = offset;
-    sprintf (buf, "%s:+0%0o", book_segments[i].segname,
-             offset);
-    return buf;
-  }
+// The system book itself is kept by dps8_book.c
 
 // Given a segno and offset, find the component name and its
 // offset in the segment
@@ -2256,7 +2124,7 @@ char * lookup_address (word18 segno, word18 offset, char * * compname,
       }
 #endif
 
-    char * ret = lookup_system_book_address (segno, offset, compname, compoffset);
+    char * ret = book_lookup_address (segno, offset, compname, compoffset);
 #ifndef SCUMEM
     if (ret)
       return ret;
@@ -2265,35 +2133,6 @@ char * lookup_address (word18 segno, word18 offset, char * * compname,
     return ret;
   }
 
-// Given a segment name and component name, return the
-// components segment number and offset
-
-// Warning: returns ptr to static buffer
-static int lookup_system_book_name (char * segname, char * compname, long * segno,
-                                    long * offset)
-  {
-    int i;
-    for (i = 0; i < n_book_segments; i ++)
-      if (strcmp (book_segments[i].segname, segname) == 0)
-        break;
-    if (i >= n_book_segments)
-      return -1;
-
-    for (int j = 0; j < n_book_components; j ++)
-      {
-        if (book_components[j].book_segment_number != i)
-          continue;
-        if (strcmp (book_components[j].compname, compname) == 0)
-          {
-            * segno = book_segments[i].segno;
-            * offset = (long) book_components[j].txt_start;
-            return 0;
-          }
-      }
-
-   return -1;
- }
-
 static char * source_search_path = NULL;
 
 // Given a component name and an offset in the component,
@@ -2696,146 +2535,23 @@ static t_stat list_source_at (UNUSED int32 arg, UNUSED const char *  buf)
     return SCPE_OK;
   }
 
+// LOAD_SYSTEM_BOOK <filename>
+
 static t_stat load_system_book (UNUSED int32 arg, UNUSED const char * buf)
   {
 // Quietly ignore if not debug enabled
 #ifndef SPEED
-    // Multics 12.5 assigns segment number to collection 3 starting at 0244.
-    uint c3 = 0244;
-
-#define bufSz 257
-    char filebuf[bufSz];
-    int current = -1;
-
-    FILE * fp = fopen (buf, "r");
-    if (! fp)
+    int rc = book_load (buf);
+    if (rc == BOOK_OPEN_ERR)
       {
         sim_msg ("error opening file %s\n", buf);
         return SCPE_ARG;
       }
-    for (;;)
+    if (rc == BOOK_FULL)
       {
-        char * bufp = fgets (filebuf, bufSz, fp);
-        if (! bufp)
-          break;
-        //sim_msg ("<%s\n>", filebuf);
-        char name[BOOK_SEGMENT_NAME_LEN];
-        int segno, p0, p1, p2;
-
-        // 32 is BOOK_SEGMENT_NAME_LEN - 1
-        int cnt = sscanf (filebuf, "%32s %o  (%o, %o, %o)", name, & segno, 
-          & p0, & p1, & p2);
-        if (filebuf[0] != '\t' && cnt == 5)
-          {
-            //sim_msg ("A: %s %d\n", name, segno);
-            int rc = add_book_segment (name, segno);
-            if (rc < 0)
-              {
-                sim_warn ("error adding segment name\n");
-                fclose (fp);
-                return SCPE_ARG;
-              }
-            continue;
-          }
-        else
-          {
-            // Check for collection 3 segment
-            // 32 is BOOK_SEGMENT_NAME_LEN - 1
-            cnt = sscanf (filebuf, "%32s  (%o, %o, %o)", name, 
-              & p0, & p1, & p2);
-            if (filebuf[0] != '\t' && cnt == 4)
-              {
-                if (strstr (name, "fw.") || strstr (name, ".ec"))
-                  continue;
-                //sim_msg ("A: %s %d\n", name, segno);
-                int rc = add_book_segment (name, (int) (c3 ++));
-                if (rc < 0)
-                  {
-                    sim_warn ("error adding segment name\n");
-                    fclose (fp);
-                    return SCPE_ARG;
-                  }
-                continue;
-              }
-          }
-        cnt = sscanf (filebuf, "Bindmap for >ldd>h>e>%32s", name);
-        if (cnt != 1)
-          cnt = sscanf (filebuf, "Bindmap for >ldd>hard>e>%32s", name);
-        if (cnt == 1)
-          {
-            //sim_msg ("B: %s\n", name);
-            //int rc = add_book_segment (name);
-            int rc = lookup_book_segment (name);
-            if (rc < 0)
-              {
-                // The collection 3.0 segments do not have segment numbers,
-                // and the 1st digit of the 3-tuple is 1, not 0. Ignore
-                // them for now.
-                current = -1;
-                continue;
-                //sim_warn ("error adding segment name\n");
-                //return SCPE_ARG;
-              }
-            current = rc;
-            continue;
-          }
-
-        uint txt_start, txt_length;
-        int intstat_start, intstat_length, symbol_start, symbol_length;
-        cnt = sscanf (filebuf, "%32s %o %o %o %o %o %o", name, & txt_start,
-                      & txt_length, & intstat_start, & intstat_length,
-                      & symbol_start, & symbol_length);
-
-        if (cnt == 7)
-          {
-            //sim_msg ("C: %s\n", name);
-            if (current >= 0)
-              {
-                add_book_component (current, name, txt_start, txt_length,
-                                    intstat_start, intstat_length, symbol_start,
-                                    symbol_length);
-              }
-            continue;
-          }
-
-        cnt = sscanf (filebuf, "%32s %o  (%o, %o, %o)", name, & segno, 
-          & p0, & p1, & p2);
-        if (filebuf[0] == '\t' && cnt == 5)
-          {
-            //sim_msg ("D: %s %d\n", name, segno);
-            int rc = add_book_segment (name, segno);
-            if (rc < 0)
-              {
-                sim_warn ("error adding segment name\n");
-                fclose (fp);
-                return SCPE_ARG;
-              }
-            continue;
-          }
-
-      }
-    fclose (fp);
-#if 0
-    for (int i = 0; i < n_book_segments; i ++)
-      { 
-        sim_msg ("  %-32s %6o\n", book_segments[i].segname,
-                    book_segments[i].segno);
-        for (int j = 0; j < n_book_components; j ++)
-          {
-            if (book_components[j].book_segment_number == i)
-              {
-                printf ("    %-32s %6o %6o %6o %6o %6o %6o\n",
-                  book_components[j].compname, 
-                  book_components[j].txt_start, 
-                  book_components[j].txt_length, 
-                  book_components[j].intstat_start, 
-                  book_components[j].intstat_length, 
-                  book_components[j].symbol_start, 
-                  book_components[j].symbol_length);
-              }
-          }
+        sim_warn ("error adding segment name\n");
+        return SCPE_ARG;
       }
-#endif
 #endif
     return SCPE_OK;
   }
@@ -2858,11 +2574,11 @@ static t_stat add_system_book_entry (UNUSED int32 arg, const char * buf)
                 & symbol_start, & symbol_length) != 9)
       return SCPE_ARG;
 
-    int idx = add_book_segment (segname, (int) segno);
+    int idx = book_add_segment (segname, (int) segno);
     if (idx < 0)
       return SCPE_ARG;
 
-    if (add_book_component (idx, compname, txt_start, txt_len, (int) intstat_start,
+    if (book_add_component (idx, compname, txt_start, txt_len, (int) intstat_start,
                            (int) intstat_length, (int) symbol_start, 
                            (int) symbol_length) < 0)
       return SCPE_ARG;
@@ -2930,7 +2646,7 @@ static t_stat lookup_system_book (UNUSED int32  arg, const char * buf)
         else
           offset = 0;
         long comp_offset;
-        int rc = lookup_system_book_name (w1, w2, & segno, & comp_offset);
+        int rc = book_lookup_name (w1, w2, & segno, & comp_offset);
         if (rc)
           {
             sim_warn ("not found\n");
@@ -3325,9 +3041,11 @@ static t_stat search_memory (UNUSED int32 arg, const char * buf)
     if (sscanf (buf, "%"PRIo64"", & value) != 1)
       return SCPE_ARG;
     
-    uint i;
-    for (i = 0; i < MEMSIZE; i ++)
-      if ((M[i] & DMASK) == value)
+    // Pages the host has never committed hold only zeros
+    static uint8 in_use [MEM_PAGES];
+    mem_in_use (in_use);
+    for (uint i = 0; i < MEMSIZE; i ++)
+      if (in_use [i / MEM_PAGE_WORDS] ? (M[i] & DMASK) == value : value == 0)
         sim_msg ("%08o\n", i);
     return SCPE_OK;
   }
@@ -3635,6 +3353,8 @@ static CTAB dps8_cmds[] =
     {"POLL",                set_sys_polling_interval, 0, "Set polling interval in milliseconds", NULL, NULL },
     {"SLOWPOLL",            set_sys_slow_polling_interval, 0, "Set slow polling interval in polling intervals", NULL, NULL },
     {"CHECKPOLL",           set_sys_poll_check_rate, 0, "Set slow polling interval in polling intervals", NULL, NULL },
+    {"SAVE",                snap_save,                0, "save file: Save a snapshot of the machine\n", NULL, NULL},
+    {"RESTORE",             snap_restore,             0, "restore file: Restore a snapshot of the machine\n", NULL, NULL},
 
 //
 // Debugging
@@ -3651,10 +3371,6 @@ static CTAB dps8_cmds[] =
     {"DBGRINGNO",           dps_debug_ringno,         0, "dbgsegno: Limit debugging to PRR == ringno\n", NULL, NULL},
     {"DBGBAR",              dps_debug_bar,            1, "dbgbar: Limit debugging to BAR mode\n", NULL, NULL},
     {"NODBGBAR",            dps_debug_bar,            0, "dbgbar: Limit debugging to BAR mode\n", NULL, NULL},
-#ifdef HDBG
-    {"HDBG",                hdbg_size,                0, "hdbg: set history buffer size\n", NULL, NULL},
-    {"PHDBG",               hdbg_print,               0, "phdbg: display history size\n", NULL, NULL},
-#endif
     {"ABSOLUTE",            abs_addr,                 0, "abs: Compute the absolute address of segno:offset\n", NULL, NULL},
 #ifndef SCUMEM
     {"STK",                 stack_trace,              0, "stk: Print a stack trace\n", NULL, NULL},
@@ -3703,6 +3419,9 @@ static CTAB dps8_cmds[] =
     {"SEARCHMEMORY",        search_memory,            0, "searchmemory: Search memory for value\n", NULL, NULL},
 #endif
     {"DBGCPUMASK",          set_dbg_cpu_mask,         0, "dbgcpumask: Set per CPU debug enable", NULL, NULL},
+#ifndef NEED_128
+    {"EIS128TEST",          eis128_test,              0, "eis128test [cases [seed]]: Check the binary decimal arithmetic against decNumber\n", NULL, NULL},
+#endif
 #endif // TESTING
 
 //
@@ -3712,6 +3431,24 @@ static CTAB dps8_cmds[] =
 #ifdef MATRIX
     {"DISPLAYMATRIX",       display_the_matrix,         0, "displaymatrix: Display instruction usage counts\n", NULL, NULL},
 #endif
+    {"PROFILE",             prof_cmd,                   0, "profile [rate]: Start the sampling profiler\n", NULL, NULL},
+    {"NOPROFILE",           prof_cmd,                   1, "noprofile: Stop the sampling profiler\n", NULL, NULL},
+    {"CLRPROFILE",          prof_cmd,                   2, "clrprofile: Discard the profile samples\n", NULL, NULL},
+    {"PROFILE_SHOW",        prof_cmd,                   3, "profile_show [file]: Display the profile or write it to a file\n", NULL, NULL},
+    {"BTRACE",              btrace_cmd,                 0, "btrace file: Record a binary instruction trace to file\n", NULL, NULL},
+    {"NOBTRACE",            btrace_cmd,                 1, "nobtrace: Stop recording the binary instruction trace\n", NULL, NULL},
+
+#ifdef HDBG
+    {"HDBG",                hdbg_size,                  0, "hdbg n: keep the last n events of each CPU\n", NULL, NULL},
+    {"PHDBG",               hdbg_print,                 0, "phdbg [file]: write the history, or a streamed history file, to hdbg.list\n", NULL, NULL},
+    {"HDBG_STREAM",         hdbg_stream,                0, "hdbg_stream file: stream the history to a file\n", NULL, NULL},
+    {"NOHDBG_STREAM",       hdbg_stream,                1, "nohdbg_stream: stop streaming the history\n", NULL, NULL},
+#endif
+
+#ifdef THREADED_DISPATCH
+    {"DISPATCHTRACE",       set_dispatch_trace,         1, "dispatchtrace: Trace register state after each instruction to a file\n", NULL, NULL},
+    {"NODISPATCHTRACE",     set_dispatch_trace,         0, "nodispatchtrace: Stop the dispatch trace\n", NULL, NULL},
+#endif
 
 
 //
@@ -4889,5 +4626,7 @@ void start_machine_room (void)
     unlock_libuv ();
 #endif
 #endif
+    // The CPU page shows the once a second instruction rates
+    ev_poll_slow_start ();
   }
 
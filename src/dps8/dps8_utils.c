@@ -32,6 +32,10 @@
 #include "dps8_ins.h"
 #include "dps8_opcodetable.h"
 #include "dps8_utils.h"
+#if defined(__GNUC__) && defined(__x86_64__)
+#define AVX2_KERNELS
+#include <immintrin.h>
+#endif
 
 #define DBG_CTR 1
 
@@ -69,15 +73,6 @@ char * dump_flags(char * buffer, word18 flags)
     
 }
 
-static char * dps8_strupr(char *str)
-{
-    char *s;
-    
-    for(s = str; *s; s++)
-        *s = (char) toupper((unsigned char)*s);
-    return str;
-}
-
 //! get instruction info for IWB ...
 
 static struct opcode_s unimplented = {"(unimplemented)", 0, 0, 0, 0};
@@ -88,58 +83,6 @@ struct opcode_s * get_iwb_info  (DCDstruct * i)
     return p->mne ? p : &unimplented;
   }
 
-char *disassemble(char * result, word36 instruction)
-{
-    uint32 opcode  = GET_OP(instruction);   ///< get opcode
-    uint32 opcodeX = GET_OPX(instruction);  ///< opcode extension
-    uint32 opcode10 = opcode | (opcodeX ? 01000 : 0);
-    word18 address = GET_ADDR(instruction);
-    word1  a       = GET_A(instruction);
-    //int32 i       = GET_I(instruction);
-    word6  tag     = GET_TAG(instruction);
-
-    //static char result[132] = "???";
-    strcpy(result, "???");
-    
-    // get mnemonic ...
-    if (opcodes10[opcode10].mne)
-        strcpy(result, opcodes10[opcode10].mne);
-
-    // XXX need to reconstruct multi-word EIS instruction.
-
-    char buff[64];
-    
-    if (a)
-    {
-        int n = (address >> 15) & 07;
-        int offset = address & 077777;
-    
-        sprintf(buff, " pr%d|%o", n, offset);
-        strcat (result, buff);
-        // return dps8_strupr(result);
-    } else {
-        sprintf(buff, " %06o", address);
-        strcat (result, buff);
-    }
-    // get mod
-    strcpy(buff, "");
-    for(uint n = 0 ; n < 0100 ; n++)
-        if (extMods[n].mod)
-            if(n == tag)
-            {
-                strcpy(buff, extMods[n].mod);
-                break;
-            }
-
-    if (strlen(buff))
-    {
-        strcat(result, ",");
-        strcat(result, buff);
-    }
-    
-    return dps8_strupr(result);
-}
-
 /*
  * get_mod__string ()
  *
@@ -2069,6 +2012,300 @@ void put36 (word36 val, uint8 * bits, uint woffset)
     // mask shouldn't be neccessary but is robust
   }
 
+// Bulk conversion kernels
+//
+// extr36N/put36N move n words between word36 and packed72 (an even/odd
+// pair per 9 bytes, starting on an even word); extrASCII36N/putASCII36N
+// do the same for one 9-bit character per byte, the tape is9 and printer
+// format. The portable loops work on big-endian loads and stores; on x86
+// the AVX2 versions run the bulk of the buffer when the processor has it.
+// SSE2 alone has no byte shuffle, so it buys nothing over the portable
+// loops.
+
+static inline uint64 load_be64 (const uint8 * p)
+  {
+    uint64 v;
+    memcpy (& v, p, sizeof (v));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap64 (v);
+#endif
+    return v;
+  }
+
+static inline void store_be64 (uint8 * p, uint64 v)
+  {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap64 (v);
+#endif
+    memcpy (p, & v, sizeof (v));
+  }
+
+static inline uint32 load_be32 (const uint8 * p)
+  {
+    uint32 v;
+    memcpy (& v, p, sizeof (v));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap32 (v);
+#endif
+    return v;
+  }
+
+static inline void store_be32 (uint8 * p, uint32 v)
+  {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap32 (v);
+#endif
+    memcpy (p, & v, sizeof (v));
+  }
+
+#ifdef AVX2_KERNELS
+static bool have_avx2 (void)
+  {
+    static int avx2 = -1;
+    if (avx2 < 0)
+      {
+        __builtin_cpu_init ();
+        avx2 = __builtin_cpu_supports ("avx2") ? 1 : 0;
+      }
+    return avx2 != 0;
+  }
+
+// Two 9 byte groups per step; each 16 byte load reads past its group, so
+// the last two groups are left to the caller.
+
+__attribute__ ((target ("avx2")))
+static uint extr36N_avx2 (uint8 * bits, word36 * words, uint n)
+  {
+    const __m256i shuf = _mm256_setr_epi8 (
+      4, 3, 2, 1, 0, -1, -1, -1,  8, 7, 6, 5, 4, -1, -1, -1,
+      4, 3, 2, 1, 0, -1, -1, -1,  8, 7, 6, 5, 4, -1, -1, -1);
+    const __m256i shift = _mm256_setr_epi64x (4, 0, 4, 0);
+    const __m256i mask = _mm256_set1_epi64x ((long long) MASK36);
+    uint groups = n / 2;
+    uint g;
+    for (g = 0; g + 3 <= groups; g += 2)
+      {
+        const uint8 * p = bits + g * 9;
+        __m256i v = _mm256_inserti128_si256 (
+          _mm256_castsi128_si256 (_mm_loadu_si128 ((const __m128i *) p)),
+          _mm_loadu_si128 ((const __m128i *) (p + 9)), 1);
+        v = _mm256_shuffle_epi8 (v, shuf);
+        v = _mm256_and_si256 (_mm256_srlv_epi64 (v, shift), mask);
+        _mm256_storeu_si256 ((__m256i *) (words + g * 2), v);
+      }
+    return g * 2;
+  }
+
+__attribute__ ((target ("avx2")))
+static uint put36N_avx2 (word36 * words, uint8 * bits, uint n)
+  {
+    // even lane: even << 28 | odd >> 8 (bytes 0-7); odd lane: odd (byte 8)
+    const __m256i shuf = _mm256_setr_epi8 (
+      7, 6, 5, 4, 3, 2, 1, 0,  8, -1, -1, -1, -1, -1, -1, -1,
+      7, 6, 5, 4, 3, 2, 1, 0,  8, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i mask = _mm256_set1_epi64x ((long long) MASK36);
+    uint groups = n / 2;
+    uint g;
+    for (g = 0; g + 3 <= groups; g += 2)
+      {
+        uint8 * p = bits + g * 9;
+        __m256i v = _mm256_and_si256 (
+          _mm256_loadu_si256 ((const __m256i *) (words + g * 2)), mask);
+        __m256i x = _mm256_or_si256 (_mm256_slli_epi64 (v, 28),
+          _mm256_shuffle_epi32 (_mm256_srli_epi64 (v, 8),
+                                _MM_SHUFFLE (1, 0, 3, 2)));
+        x = _mm256_shuffle_epi8 (_mm256_blend_epi32 (x, v, 0xcc), shuf);
+        // The second store overwrites the tail of the first.
+        _mm_storeu_si128 ((__m128i *) p, _mm256_castsi256_si128 (x));
+        _mm_storeu_si128 ((__m128i *) (p + 9), _mm256_extracti128_si256 (x, 1));
+      }
+    return g * 2;
+  }
+
+__attribute__ ((target ("avx2")))
+static uint extrASCII36N_avx2 (uint8 * bits, word36 * words, uint n)
+  {
+    const __m256i m8 = _mm256_set1_epi64x (0xff);
+    uint i;
+    for (i = 0; i + 4 <= n; i += 4)
+      {
+        // one little-endian 32 bit group per lane: b0 is the low byte
+        __m256i x = _mm256_cvtepu32_epi64 (
+          _mm_loadu_si128 ((const __m128i *) (bits + i * 4)));
+        __m256i w = _mm256_slli_epi64 (_mm256_and_si256 (x, m8), 27);
+        w = _mm256_or_si256 (w, _mm256_slli_epi64 (
+          _mm256_and_si256 (_mm256_srli_epi64 (x, 8), m8), 18));
+        w = _mm256_or_si256 (w, _mm256_slli_epi64 (
+          _mm256_and_si256 (_mm256_srli_epi64 (x, 16), m8), 9));
+        w = _mm256_or_si256 (w, _mm256_srli_epi64 (x, 24));
+        _mm256_storeu_si256 ((__m256i *) (words + i), w);
+      }
+    return i;
+  }
+
+__attribute__ ((target ("avx2")))
+static uint putASCII36N_avx2 (word36 * words, uint8 * bits, uint n)
+  {
+    const __m256i m8 = _mm256_set1_epi64x (0xff);
+    const __m256i pick = _mm256_setr_epi32 (0, 2, 4, 6, 0, 2, 4, 6);
+    uint i;
+    for (i = 0; i + 4 <= n; i += 4)
+      {
+        __m256i w = _mm256_loadu_si256 ((const __m256i *) (words + i));
+        __m256i x = _mm256_and_si256 (_mm256_srli_epi64 (w, 27), m8);
+        x = _mm256_or_si256 (x, _mm256_slli_epi64 (
+          _mm256_and_si256 (_mm256_srli_epi64 (w, 18), m8), 8));
+        x = _mm256_or_si256 (x, _mm256_slli_epi64 (
+          _mm256_and_si256 (_mm256_srli_epi64 (w, 9), m8), 16));
+        x = _mm256_or_si256 (x, _mm256_slli_epi64 (
+          _mm256_and_si256 (w, m8), 24));
+        x = _mm256_permutevar8x32_epi32 (x, pick);
+        _mm_storeu_si128 ((__m128i *) (bits + i * 4),
+                          _mm256_castsi256_si128 (x));
+      }
+    return i;
+  }
+#endif
+
+void extr36N (uint8 * bits, word36 * words, uint n)
+  {
+    uint i = 0;
+#ifdef AVX2_KERNELS
+    if (have_avx2 ())
+      i = extr36N_avx2 (bits, words, n);
+#endif
+    for (; i + 1 < n; i += 2)
+      {
+        const uint8 * p = bits + i / 2 * 9;
+        uint64 v = load_be64 (p);
+        words [i]     = (word36) (v >> 28);
+        words [i + 1] = (word36) (((v & 0xfffffffu) << 8) | p [8]);
+      }
+    if (i < n)
+      words [i] = extr36 (bits, i);
+  }
+
+// If n is odd the last word is stored into the first half of its group;
+// the low nibble of byte 4 and bytes 5-8 belong to the next word and are
+// left as they are.
+
+void put36N (word36 * words, uint8 * bits, uint n)
+  {
+    uint i = 0;
+#ifdef AVX2_KERNELS
+    if (have_avx2 ())
+      i = put36N_avx2 (words, bits, n);
+#endif
+    for (; i + 1 < n; i += 2)
+      {
+        uint8 * p = bits + i / 2 * 9;
+        uint64 even = words [i] & MASK36;
+        uint64 odd = words [i + 1] & MASK36;
+        store_be64 (p, (even << 28) | (odd >> 8));
+        p [8] = (uint8) odd;
+      }
+    if (i < n)
+      put36 (words [i], bits, i);
+  }
+
+void extrASCII36N (uint8 * bits, word36 * words, uint n)
+  {
+    uint i = 0;
+#ifdef AVX2_KERNELS
+    if (have_avx2 ())
+      i = extrASCII36N_avx2 (bits, words, n);
+#endif
+    for (; i < n; i ++)
+      {
+        uint64 x = load_be32 (bits + i * 4);
+        words [i] = ((x & 0xff000000u) << 3) | ((x & 0xff0000u) << 2) |
+                    ((x & 0xff00u) << 1) | (x & 0xffu);
+      }
+  }
+
+void putASCII36N (word36 * words, uint8 * bits, uint n)
+  {
+    uint i = 0;
+#ifdef AVX2_KERNELS
+    if (have_avx2 ())
+      i = putASCII36N_avx2 (words, bits, n);
+#endif
+    for (; i < n; i ++)
+      {
+        word36 w = words [i];
+        store_be32 (bits + i * 4,
+                    (uint32) ((((w >> 27) & 0xff) << 24) |
+                              (((w >> 18) & 0xff) << 16) |
+                              (((w >>  9) & 0xff) <<  8) |
+                              ( w         & 0xff)));
+      }
+  }
+
+// Bulk versions of the FromBuffer/toBuffer routines below: convert up to
+// n words, stopping at the same place the word at a time versions would,
+// and return the number converted.
+
+uint extractASCII36NFromBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 * wordp, uint n)
+  {
+    uint wp = * words_processed;
+    uint avail = (tbc + 3) / 4;
+    if (wp >= avail)
+      return 0;
+    if (n > avail - wp)
+      n = avail - wp;
+    extrASCII36N (bufp + wp * 4, wordp, n);
+    * words_processed = wp + n;
+    return n;
+  }
+
+uint extractWord36NFromBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 * wordp, uint n)
+  {
+    uint wp = * words_processed;
+    // word wp is available while (wp * 9 + 1) / 2 < tbc
+    uint avail = tbc ? (2 * tbc + 7) / 9 : 0;
+    if (wp >= avail)
+      return 0;
+    if (n > avail - wp)
+      n = avail - wp;
+    uint i = 0;
+    if (wp % 2)
+      wordp [i ++] = extr36 (bufp, wp);
+    if (i < n)
+      extr36N (bufp + (wp + i) / 2 * 9, wordp + i, n - i);
+    * words_processed = wp + n;
+    return n;
+  }
+
+uint insertASCII36NtoBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 * words, uint n)
+  {
+    uint wp = * words_processed;
+    uint avail = (tbc + 3) / 4;
+    if (wp >= avail)
+      return 0;
+    if (n > avail - wp)
+      n = avail - wp;
+    putASCII36N (words, bufp + wp * 4, n);
+    * words_processed = wp + n;
+    return n;
+  }
+
+uint insertWord36NtoBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 * words, uint n)
+  {
+    uint wp = * words_processed;
+    uint avail = tbc ? (2 * tbc + 7) / 9 : 0;
+    if (wp >= avail)
+      return 0;
+    if (n > avail - wp)
+      n = avail - wp;
+    uint i = 0;
+    if (wp % 2)
+      put36 (words [i ++], bufp, wp);
+    if (i < n)
+      put36N (words + i, bufp + (wp + i) / 2 * 9, n - i);
+    * words_processed = wp + n;
+    return n;
+  }
+
 
 int extractASCII36FromBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 *wordp)
   {
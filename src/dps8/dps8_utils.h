@@ -37,7 +37,6 @@ void cfg_parse_done (config_state_t * state);
 
 struct opcode_s * get_iwb_info (DCDstruct *i);
 char * dump_flags(char * buffer, word18 flags);
-char *disassemble(char * result, word36 instruction);
 char *get_mod_string(char * msg, word6 tag);
 word72 convert_to_word72 (word36 even, word36 odd);
 void convert_to_word36 (word72 src, word36 *even, word36 *odd);
@@ -857,10 +856,18 @@ static inline void clrmask (word36 * v, word36 mask)
 char * strdupesc (const char * str);
 word36 extr36 (uint8 * bits, uint woffset);
 void put36 (word36 val, uint8 * bits, uint woffset);
+void extr36N (uint8 * bits, word36 * words, uint n);
+void put36N (word36 * words, uint8 * bits, uint n);
+void extrASCII36N (uint8 * bits, word36 * words, uint n);
+void putASCII36N (word36 * words, uint8 * bits, uint n);
 int extractASCII36FromBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 *wordp);
 int extractWord36FromBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, uint64 *wordp);
 int insertASCII36toBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 word);
 int insertWord36toBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 word);
+uint extractASCII36NFromBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 * wordp, uint n);
+uint extractWord36NFromBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 * wordp, uint n);
+uint insertASCII36NtoBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 * words, uint n);
+uint insertWord36NtoBuffer (uint8 * bufp, t_mtrlnt tbc, uint * words_processed, word36 * words, uint n);
 void print_int128 (int128 n, char * p);
 word36 Add36b (word36 op1, word36 op2, word1 carryin, word18 flagsToSet, word18 * flags, bool * ovf);
 word36 Sub36b (word36 op1, word36 op2, word1 carryin, word18 flagsToSet, word18 * flags, bool * ovf);
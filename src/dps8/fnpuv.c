@@ -119,16 +119,17 @@
 // data.
 
 // Data are written to the TCP connections with 'fnpuv_start_write()'. The
-// 'uvClientData' is inspected for telnet usage; if so, the data is passed
-// to libtelnet for telnet packaging and is sent on to 
-// 'fnpuv_start_write_actual'. If telnet is not in play, the data is sent
-// directly on to 'fnpuv_start_write_actual()' There, a buffer is allocated
-// and the data copied and a 'uv_write_t' request object is created and
-// initalized data the buffer address and length, and a write request
-// is send to libuv.
-//
-// When the write is complete, libuv calls the write callback 'fuv_write_cb()',
-// which frees the data buffers and destroys the write request object.
+// 'uvClientData' is inspected for telnet usage; if so, the data is copied
+// to the connection's output queue with IAC bytes doubled. If telnet is not
+// in play, the data is sent directly on to 'fnpuv_start_write_actual()',
+// which copies it to the queue as is; telnet commands from libtelnet take
+// that path too. The queue is a chain of blocks from a free list. If no
+// write is in flight, the queued blocks are handed to libuv as the buffers
+// of one write request.
+//
+// When the write is complete, libuv calls the write callback
+// 'fuv_out_write_cb()', which returns the blocks to the free list and
+// starts a write of anything queued in the meantime.
 
 // Dialout logic
 //
@@ -211,6 +212,9 @@
 // Making it up...
 #define DEFAULT_BACKLOG 1024
 
+struct fnpuv_wbuf;
+static void wbuf_put (struct fnpuv_wbuf * b);
+
 #ifdef TUN
 static int tun_alloc (char * dev)
   {
@@ -271,6 +275,7 @@ void fnpuv_associated_brk (uv_tcp_t * client)
     // the line_break before the accept input?
     linep->accept_input = 1;
     linep->line_break=true;
+    fnp_line_ready (linep);
   }
 
 // read callback for connections that are associated with an HSLA line;
@@ -341,6 +346,7 @@ void close_connection (uv_stream_t* stream)
                 linep -> line_disconnected = true;
 #endif
                 linep -> listen = false;
+                fnp_line_ready (linep);
                 if (linep->inBuffer)
                   free (linep->inBuffer);
                 linep->inBuffer = NULL;
@@ -369,6 +375,8 @@ void close_connection (uv_stream_t* stream)
           }
         if (((uvClientData *) stream->data)->ttype)
           free (((uvClientData *) stream->data)->ttype);
+        // A write in flight releases its own blocks
+        wbuf_put (p->out_head);
         free (stream->data);
         stream->data = NULL;
       } // if (p)
@@ -501,6 +509,177 @@ static void fuv_write_3270_cb (uv_write_t * req, int status)
     set_3270_write_complete ((uv_tcp_t *) req->handle);
   }
 
+//
+// Output queue
+//
+// Output to a connection is copied once, into fixed size blocks kept on a
+// free list, and waits there while a write is in flight; the next write
+// takes everything queued, so output produced faster than the connection
+// drains goes out in large writes rather than one write per call.
+//
+
+#define WBUF_SIZE 4096
+#define WBUF_IOVS 4        // libuv mallocs a copy of more buffers than this
+#define WBUF_FREE_MAX 256  // free blocks kept
+
+struct fnpuv_wbuf
+  {
+    uv_write_t req;  // used in the first block of a write
+    struct fnpuv_wbuf * next;
+    size_t len;
+    unsigned char data [WBUF_SIZE];
+  };
+
+static struct fnpuv_wbuf * wbuf_free = NULL;
+static uint wbuf_nfree = 0;
+
+static struct fnpuv_wbuf * wbuf_get (void)
+  {
+    struct fnpuv_wbuf * b = wbuf_free;
+    if (b)
+      {
+        wbuf_free = b->next;
+        wbuf_nfree --;
+      }
+    else
+      {
+        b = (struct fnpuv_wbuf *) malloc (sizeof (struct fnpuv_wbuf));
+        if (! b)
+          return NULL;
+      }
+    b->next = NULL;
+    b->len = 0;
+    return b;
+  }
+
+// Release a chain of blocks
+
+static void wbuf_put (struct fnpuv_wbuf * b)
+  {
+    while (b)
+      {
+        struct fnpuv_wbuf * next = b->next;
+        if (wbuf_nfree < WBUF_FREE_MAX)
+          {
+            b->next = wbuf_free;
+            wbuf_free = b;
+            wbuf_nfree ++;
+          }
+        else
+          free (b);
+        b = next;
+      }
+  }
+
+// Append data to the client's output queue, optionally doubling IACs
+
+static void fnpuv_out_append (uvClientData * p, const unsigned char * data,
+                              size_t len, bool escape_iac)
+  {
+    struct fnpuv_wbuf * b = p->out_tail;
+    while (len)
+      {
+        // Leave room for a doubled IAC
+        if (! b || b->len + 2 > WBUF_SIZE)
+          {
+            struct fnpuv_wbuf * nb = wbuf_get ();
+            if (! nb)
+              {
+                sim_warn ("fnpuv output buffer malloc failed; dropping data\n");
+                return;
+              }
+            if (b)
+              b->next = nb;
+            else
+              p->out_head = nb;
+            p->out_tail = b = nb;
+          }
+        size_t n = WBUF_SIZE - 1 - b->len;
+        if (n > len)
+          n = len;
+        if (escape_iac)
+          {
+            const unsigned char * iac = memchr (data, TELNET_IAC, n);
+            if (iac)
+              n = (size_t) (iac - data) + 1;
+          }
+        memcpy (b->data + b->len, data, n);
+        b->len += n;
+        if (escape_iac && data[n - 1] == TELNET_IAC)
+          b->data[b->len ++] = TELNET_IAC;
+        data += n;
+        len -= n;
+      }
+  }
+
+static void fnpuv_out_submit (uv_tcp_t * client);
+
+static void fuv_out_write_cb (uv_write_t * req, int status)
+  {
+    uv_stream_t * stream = req->handle;
+    wbuf_put ((struct fnpuv_wbuf *) req->data);
+    if (status < 0)
+      {
+        if (status == -ECONNRESET || status == -ECANCELED ||
+            status == -EPIPE)
+          {
+            // This occurs when the other end disconnects; not an "error"
+          }
+        else
+          {
+            sim_warn ("fuv_out_write_cb status %d (%s)\n", -status, strerror (-status));
+          }
+
+        // connection reset by peer
+        close_connection (stream);
+        return;
+      }
+    uvClientData * p = (uvClientData *) stream->data;
+    if (p)
+      {
+        p->out_busy = false;
+        fnpuv_out_submit ((uv_tcp_t *) stream);
+      }
+  }
+
+// If no write is in flight, write the queued output
+
+static void fnpuv_out_submit (uv_tcp_t * client)
+  {
+    uvClientData * p = (uvClientData *) client->data;
+    if (! p || p->out_busy || ! p->out_head)
+      return;
+    uv_buf_t bufs [WBUF_IOVS];
+    struct fnpuv_wbuf * first = p->out_head;
+    struct fnpuv_wbuf * last = first;
+    uint n = 0;
+    for (struct fnpuv_wbuf * b = first; b && n < WBUF_IOVS; b = b->next)
+      {
+        bufs[n ++] = uv_buf_init ((char *) b->data, (uint) b->len);
+        last = b;
+      }
+    p->out_head = last->next;
+    if (! p->out_head)
+      p->out_tail = NULL;
+    last->next = NULL;
+
+    memset (& first->req, 0, sizeof (first->req));
+    first->req.data = first;
+    int ret = uv_write (& first->req, (uv_stream_t *) client, bufs, n, fuv_out_write_cb);
+// There seems to be a race condition when Mulitcs signals a disconnect_line;
+// We close the socket, but Mulitcs is still writing its goodbye text trailing
+// NULs.
+// If the socket has been closed, write will return BADF; just ignore it.
+    if (ret < 0)
+      {
+        wbuf_put (first);
+        if (ret != -EBADF)
+          sim_printf ("[FNP emulation: uv_write returns %d]\n", ret);
+        return;
+      }
+    p->out_busy = true;
+  }
+
 // Create and start a write request
 
 static void fnpuv_start_write_3270_actual (UNUSED uv_tcp_t * client, unsigned char * data, ssize_t datalen)
@@ -571,25 +750,10 @@ sim_printf ("\r\n");
 
 void fnpuv_start_write_actual (uv_tcp_t * client, unsigned char * data, ssize_t datalen)
   {
-    if (! client || uv_is_closing ((uv_handle_t *) client))
+    if (! client || uv_is_closing ((uv_handle_t *) client) || ! client->data)
       return;
-    uv_write_t * req = (uv_write_t *) malloc (sizeof (uv_write_t));
-    // This makes sure that bufs*.base and bufsml*.base are NULL
-    memset (req, 0, sizeof (uv_write_t));
-    uv_buf_t buf = uv_buf_init ((char *) malloc ((unsigned long) datalen), (uint) datalen);
-//sim_printf ("allocated req %p data %p\n", req, buf.base);
-#ifdef USE_REQ_DATA
-    req->data = buf.base;
-#endif
-//sim_printf ("fnpuv_start_write_actual req %p buf.base %p\n", req, buf.base);
-    memcpy (buf.base, data, (unsigned long) datalen);
-    int ret = uv_write (req, (uv_stream_t *) client, & buf, 1, fuv_write_cb);
-// There seems to be a race condition when Mulitcs signals a disconnect_line;
-// We close the socket, but Mulitcs is still writing its goodbye text trailing
-// NULs.
-// If the socket has been closed, write will return BADF; just ignore it.
-    if (ret < 0 && ret != -EBADF)
-      sim_printf ("[FNP emulation: uv_write returns %d]\n", ret);
+    fnpuv_out_append ((uvClientData *) client->data, data, (size_t) datalen, false);
+    fnpuv_out_submit (client);
   }
 
 //
@@ -608,6 +772,14 @@ void fnpuv_start_write (uv_tcp_t * client, unsigned char * data, ssize_t datalen
         sim_warn ("telnetp NULL; dropping fnpuv_start_write()\n");
         return;
       }
+    // Do libtelnet's escaping here, saving the trip through its send
+    // callback
+    if (p->write_actual_cb == fnpuv_start_write_actual)
+      {
+        fnpuv_out_append (p, data, (size_t) datalen, true);
+        fnpuv_out_submit (client);
+        return;
+      }
     telnet_send (p->telnetp, (char *) data, (size_t) datalen);
   }
 
@@ -818,6 +990,8 @@ sim_printf ("[FNP emulation: dropping 2nd slave]\n");
          sim_warn ("uvClientData malloc failed\n");
          return;
       }
+    p->out_head = p->out_tail = NULL;
+    p->out_busy = false;
     client->data = p;
     p->assoc = false;
     p->nPos = 0;
@@ -857,6 +1031,7 @@ sim_printf ("[FNP emulation: dropping 2nd slave]\n");
           linep->lineType = 1; /* LINE_ASCII */
         linep->accept_new_terminal = true;
         reset_line (linep);
+        fnp_line_ready (linep);
       }
   }
 
@@ -938,6 +1113,7 @@ static void on_dialout_connect (uv_connect_t * server, int status)
         //sim_printf ("%p\n", p);
         //sim_printf ("%d.%d\n", p->fnpno, p->lineno);
         linep->acu_dial_failure = true;
+        fnp_line_ready (linep);
         return;
       }
 
@@ -946,6 +1122,7 @@ static void on_dialout_connect (uv_connect_t * server, int status)
     if (linep->lineType == 0) /* LINE_NONE */
       linep->lineType = 1; /* LINE_ASCII */
     linep->accept_new_terminal = true;
+    fnp_line_ready (linep);
     linep->was_CR = false;
     linep->line_client->data = p;
     if (p->telnetp)
@@ -1051,6 +1228,7 @@ void fnpuv_dial_out (uint fnpno, uint lineno, word36 d1, word36 d2, word36 d3)
       {
         sim_printf ("Dialout %c.d%03d denied\r\n", fnpno + 'a', lineno);
         linep->acu_dial_failure = true;
+        fnp_line_ready (linep);
         return;
       }
 
@@ -1071,6 +1249,8 @@ void fnpuv_dial_out (uint fnpno, uint lineno, word36 d1, word36 d2, word36 d3)
          sim_warn ("uvClientData malloc failed\n");
          return;
       }
+    p->out_head = p->out_tail = NULL;
+    p->out_busy = false;
     p->assoc = true;
     p->read_cb = fnpuv_associated_readcb;
     p->nPos = 0;
@@ -1114,6 +1294,7 @@ static void on_slave_connect (uv_stream_t * server, int status)
 
     uv_read_start ((uv_stream_t *) & linep->line_client, alloc_buffer, do_readcb);
     linep->accept_new_terminal = true;
+    fnp_line_ready (linep);
   }
 #endif
 
@@ -1146,6 +1327,8 @@ void fnpuv_open_slave (uint fnpno, uint lineno)
          sim_warn ("uvClientData malloc failed\n");
          return;
       }
+    p->out_head = p->out_tail = NULL;
+    p->out_busy = false;
     p->assoc = false;
     p->read_cb = fnpuv_associated_readcb;
     p->write_cb = fnpuv_start_write_actual;
@@ -1181,6 +1364,8 @@ void fnpuv_open_slave (uint fnpno, uint lineno)
          sim_warn ("uvClientData malloc failed\n");
          return;
       }
+    p->out_head = p->out_tail = NULL;
+    p->out_busy = false;
     p->assoc = false;
     p->ttype = NULL;
     p->telnetp = NULL;
@@ -1243,6 +1428,7 @@ static void processPacketInput (int fnpno, int lineno, unsigned char * buf, ssiz
         linep->inSize = (uint) nread;
         linep->inUsed = 0;
       }
+    fnp_line_ready (linep);
 
 done:;
   }
@@ -1357,8 +1543,10 @@ void fnpTUNProcessEvent (void)
 
 void fnpuv3270Poll (bool start)
   {
-// Called at 100Hz; to 1 second poll
+// Counted down in sys_poll_interval ticks; to 1 second poll
     fnpData.du3270_poll = start ? 100 : 0;
+    if (start)
+      ev_poll_kick ();
   }
 
 //
@@ -1426,6 +1614,8 @@ static void on_new_3270_connection (uv_stream_t * server, int status)
          sim_warn ("uvClientData malloc failed\n");
          return;
       }
+    p->out_head = p->out_tail = NULL;
+    p->out_busy = false;
     client->data = p;
     p->assoc = false;
     p->fnpno = fnpno;
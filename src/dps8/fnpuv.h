@@ -11,6 +11,7 @@
 
 typedef void (* uv_read_cb_t) (uv_tcp_t * client, ssize_t nread, unsigned char * buf);
 typedef void (* uv_write_cb_t) (uv_tcp_t * client, unsigned char * data, ssize_t datalen);
+struct fnpuv_wbuf;
 struct uvClientData_s
   {
     bool assoc;
@@ -26,6 +27,9 @@ struct uvClientData_s
     // 3270
     char * ttype;
     uint stationNo;
+    // Output not yet given to libuv, and whether a write is in flight
+    struct fnpuv_wbuf * out_head, * out_tail;
+    bool out_busy;
   };
 
 typedef struct uvClientData_s uvClientData;
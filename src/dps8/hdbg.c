@@ -9,8 +9,28 @@
  at https://sourceforge.net/p/dps8m/code/ci/master/tree/LICENSE
  */
 
-// history debugging
+// History debugging
+//
+// Each CPU records its events into its own ring of fixed size records.
+// A producer claims a slot by atomically incrementing the ring head and
+// publishes the record by storing the slot's sequence number last, so
+// neither the CPUs nor the IOM and SCU code that record interrupts into
+// the current CPU's ring take a lock. Records carry a host timestamp;
+// the history is written with the CPUs merged in time order.
+//
+//   hdbg n               keep the last n events of each CPU (0 disables)
+//   phdbg [file]         write the history to hdbg.list and memory to
+//                        M.dump, or write a streamed file to hdbg.list
+//   hdbg_stream file     write every event to file from a background
+//                        thread, as well as keeping the history
+//   nohdbg_stream        stop streaming
+//
+// The ring size is set with the machine stopped. A streamed file is raw
+// records, tied to the build that wrote it.
+
 #include <unistd.h>
+#include <errno.h>
+#include <time.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -18,6 +38,7 @@
 #include "dps8.h"
 #include "dps8_sys.h"
 #include "dps8_cpu.h"
+#include "dps8_opcodetable.h"
 #include "dps8_utils.h"
 #include "hdbg.h"
 
@@ -29,8 +50,11 @@ enum hevtType { hevtEmpty = 0, hevtTrace, hevtMRead, hevtMWrite, hevtIWBUpdate,
 
 struct hevt
   {
+    uint64 seq;    // slot number + 1 once published; 0 while being written
+    uint64 stamp;  // host clock; orders the events of different CPUs
+    uint64 time;   // cycle count of the recording CPU
     enum hevtType type;
-    uint64 time;
+    uint cpu_idx;
     union
       {
         struct
@@ -81,242 +105,239 @@ struct hevt
       };
   };
 
-static struct hevt * hevents = NULL;
-static unsigned long hdbgSize = 0;
-static unsigned long hevtPtr = 0;
-static unsigned long hevtMark = 0;
+struct hring
+  {
+    struct hevt * evts;
+    uint64 head;   // slots claimed
+    uint64 tail;   // next slot for the stream writer
+  };
+
+static struct hring hrings [N_CPU_UNITS_MAX];
+static uint64 hdbgSize = 0;  // per CPU; a power of 2
+static uint64 hdbgMask = 0;
+static long hevtMark = 0;
+
+static bool hdbg_inited = false;
+static uv_mutex_t hdbg_lock;  // printing, streaming and resizing
+
+#define HDBG_STREAM_MAGIC "HDBGSTRM"
+#define HDBG_STREAM_VERSION 1
+
+struct hdbg_stream_hdr
+  {
+    char magic [8];
+    uint32 version;
+    uint32 evt_size;
+  };
+
+static FILE * hdbg_stream_fp = NULL;
+static uv_thread_t hdbg_stream_thread;
+static volatile bool hdbg_streaming = false;
+static struct hevt * hdbg_batch = NULL;
+static unsigned long long hdbg_stream_cnt, hdbg_stream_dropped;
+
+static void hdbg_init (void)
+  {
+    if (hdbg_inited)
+      return;
+    uv_mutex_init (& hdbg_lock);
+    hdbg_inited = true;
+  }
 
-#ifdef THREADZ
-static pthread_mutex_t hdbg_lock = PTHREAD_MUTEX_INITIALIZER;
+static inline uint64 hdbg_now (void)
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc ();
+#else
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, & ts);
+    return (uint64) ts.tv_sec * 1000000000llu + (uint64) ts.tv_nsec;
 #endif
+  }
 
 static void createBuffer (void)
   {
-    if (hevents)
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
       {
-        free (hevents);
-        hevents = NULL;
+        struct hring * r = hrings + i;
+        free (r->evts);
+        r->evts = NULL;
+        r->head = r->tail = 0;
       }
     if (! hdbgSize)
       return;
-    hevents = malloc (sizeof (struct hevt) * hdbgSize);
-    if (! hevents)
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
       {
-        sim_printf ("hdbg createBuffer failed\n");
-        return;
+        hrings[i].evts = calloc (hdbgSize, sizeof (struct hevt));
+        if (! hrings[i].evts)
+          {
+            sim_printf ("hdbg createBuffer failed\n");
+            hdbgSize = 0;
+            createBuffer ();
+            return;
+          }
       }
-    memset (hevents, 0, sizeof (struct hevt) * hdbgSize);
+  }
 
-    hevtPtr = 0;
+// Claim the next slot of this CPU's ring; NULL if history is off.
+
+static inline struct hevt * hdbg_begin (enum hevtType type, uint64 * slot)
+  {
+    struct hring * r = hrings + current_running_cpu_idx;
+    if (! r->evts)
+      return NULL;
+    uint64 n = __atomic_fetch_add (& r->head, 1, __ATOMIC_RELAXED);
+    struct hevt * e = r->evts + (n & hdbgMask);
+    __atomic_store_n (& e->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence (__ATOMIC_RELEASE);
+    e->stamp = hdbg_now ();
+    e->time = cpu.cycleCnt;
+    e->type = type;
+    e->cpu_idx = current_running_cpu_idx;
+    * slot = n;
+    return e;
   }
 
-static void hdbg_inc (void)
+static inline void hdbg_end (struct hevt * e, uint64 slot)
   {
-    hevtPtr = (hevtPtr + 1) % hdbgSize;
-    if (hevtMark)
-      {
-        hevtMark --;
-        if (hevtMark == 0)
-          hdbgPrint ();
-      }
+    __atomic_store_n (& e->seq, slot + 1, __ATOMIC_RELEASE);
+    if (__atomic_load_n (& hevtMark, __ATOMIC_RELAXED) > 0 &&
+        __atomic_sub_fetch (& hevtMark, 1, __ATOMIC_RELAXED) == 0)
+      hdbgPrint ();
+  }
+
+// Copy out slot n of a ring; false if it is not published or is being
+// rewritten.
+
+static bool hdbg_read (struct hring * r, uint64 n, struct hevt * out)
+  {
+    struct hevt * e = r->evts + (n & hdbgMask);
+    uint64 seq = __atomic_load_n (& e->seq, __ATOMIC_ACQUIRE);
+    if (seq != n + 1)
+      return false;
+    memcpy (out, e, sizeof (* out));
+    __atomic_thread_fence (__ATOMIC_ACQUIRE);
+    return __atomic_load_n (& e->seq, __ATOMIC_RELAXED) == seq;
+  }
+
+static int hevt_cmp (const void * a, const void * b)
+  {
+    const struct hevt * x = a;
+    const struct hevt * y = b;
+    if (x->stamp != y->stamp)
+      return x->stamp < y->stamp ? -1 : 1;
+    if (x->cpu_idx != y->cpu_idx)
+      return x->cpu_idx < y->cpu_idx ? -1 : 1;
+    return x->seq < y->seq ? -1 : x->seq > y->seq;
   }
 
 void hdbgTrace (void)
   {
-#ifdef THREADZ
-    pthread_mutex_lock (& hdbg_lock);
-#endif
-    if (! hevents)
-      goto done;
-#ifdef ISOLTS
-if (current_running_cpu_idx == 0)
-  goto done;
-#endif
-    hevents [hevtPtr] . type = hevtTrace;
-    hevents [hevtPtr] . time = cpu.cycleCnt;
-    hevents [hevtPtr] . trace . addrMode = get_addr_mode ();
-    hevents [hevtPtr] . trace . segno = cpu . PPR.PSR;
-    hevents [hevtPtr] . trace . ic = cpu . PPR.IC;
-    hevents [hevtPtr] . trace . ring = cpu . PPR.PRR;
-    hevents [hevtPtr] . trace . inst = cpu.cu.IWB;
-    hdbg_inc ();
-done: ;
-#ifdef THREADZ
-    pthread_mutex_unlock (& hdbg_lock);
-#endif
+    uint64 n;
+    struct hevt * e = hdbg_begin (hevtTrace, & n);
+    if (! e)
+      return;
+    e->trace.addrMode = get_addr_mode ();
+    e->trace.segno = cpu.PPR.PSR;
+    e->trace.ic = cpu.PPR.IC;
+    e->trace.ring = cpu.PPR.PRR;
+    e->trace.inst = cpu.cu.IWB;
+    hdbg_end (e, n);
   }
 
 void hdbgMRead (word24 addr, word36 data)
   {
-#ifdef THREADZ
-    pthread_mutex_lock (& hdbg_lock);
-#endif
-    if (! hevents)
-      goto done;
-#ifdef ISOLTS
-if (current_running_cpu_idx == 0)
-  goto done;
-#endif
-    hevents [hevtPtr] . type = hevtMRead;
-    hevents [hevtPtr] . time = cpu.cycleCnt;
-    hevents [hevtPtr] . memref . addr = addr;
-    hevents [hevtPtr] . memref . data = data;
-    hdbg_inc ();
-done: ;
-#ifdef THREADZ
-    pthread_mutex_unlock (& hdbg_lock);
-#endif
+    uint64 n;
+    struct hevt * e = hdbg_begin (hevtMRead, & n);
+    if (! e)
+      return;
+    e->memref.addr = addr;
+    e->memref.data = data;
+    hdbg_end (e, n);
   }
 
 void hdbgMWrite (word24 addr, word36 data)
   {
-#ifdef THREADZ
-    pthread_mutex_lock (& hdbg_lock);
-#endif
-    if (! hevents)
-      goto done;
-#ifdef ISOLTS
-if (current_running_cpu_idx == 0)
-  goto done;
-#endif
-    hevents [hevtPtr] . type = hevtMWrite;
-    hevents [hevtPtr] . time = cpu.cycleCnt;
-    hevents [hevtPtr] . memref . addr = addr;
-    hevents [hevtPtr] . memref . data = data;
-    hdbg_inc ();
-done: ;
-#ifdef THREADZ
-    pthread_mutex_unlock (& hdbg_lock);
-#endif
+    uint64 n;
+    struct hevt * e = hdbg_begin (hevtMWrite, & n);
+    if (! e)
+      return;
+    e->memref.addr = addr;
+    e->memref.data = data;
+    hdbg_end (e, n);
   }
 
 void hdbgFault (_fault faultNumber, _fault_subtype subFault,
                 const char * faultMsg)
   {
-#ifdef THREADZ
-    pthread_mutex_lock (& hdbg_lock);
-#endif
-    if (! hevents)
-      goto done;
-#ifdef ISOLTS
-if (current_running_cpu_idx == 0)
-  goto done;
-#endif
-    hevents [hevtPtr] . type = hevtFault;
-    hevents [hevtPtr] . time = cpu.cycleCnt;
-    hevents [hevtPtr] . fault . faultNumber = faultNumber;
-    hevents [hevtPtr] . fault . subFault = subFault;
-    strncpy (hevents [hevtPtr] . fault . faultMsg, faultMsg, 63);
-    hevents [hevtPtr] . fault . faultMsg [63] = 0;
-    hdbg_inc ();
-done: ;
-#ifdef THREADZ
-    pthread_mutex_unlock (& hdbg_lock);
-#endif
+    uint64 n;
+    struct hevt * e = hdbg_begin (hevtFault, & n);
+    if (! e)
+      return;
+    e->fault.faultNumber = faultNumber;
+    e->fault.subFault = subFault;
+    strncpy (e->fault.faultMsg, faultMsg, 63);
+    e->fault.faultMsg [63] = 0;
+    hdbg_end (e, n);
   }
 
 void hdbgIntrSet (uint inum, uint cpuUnitIdx, uint scuUnitIdx)
   {
-#ifdef THREADZ
-    pthread_mutex_lock (& hdbg_lock);
-#endif
-    if (! hevents)
-      goto done;
-#ifdef ISOLTS
-if (current_running_cpu_idx == 0)
-  goto done;
-#endif
-    hevents [hevtPtr].type = hevtIntrSet;
-    hevents [hevtPtr].time = cpu.cycleCnt;
-    hevents [hevtPtr].intrSet.inum = inum;
-    hevents [hevtPtr].intrSet.cpuUnitIdx = cpuUnitIdx;
-    hevents [hevtPtr].intrSet.scuUnitIdx = scuUnitIdx;
-    hdbg_inc ();
-done: ;
-#ifdef THREADZ
-    pthread_mutex_unlock (& hdbg_lock);
-#endif
+    uint64 n;
+    struct hevt * e = hdbg_begin (hevtIntrSet, & n);
+    if (! e)
+      return;
+    e->intrSet.inum = inum;
+    e->intrSet.cpuUnitIdx = cpuUnitIdx;
+    e->intrSet.scuUnitIdx = scuUnitIdx;
+    hdbg_end (e, n);
   }
 
 void hdbgIntr (uint intr_pair_addr)
   {
-#ifdef THREADZ
-    pthread_mutex_lock (& hdbg_lock);
-#endif
-    if (! hevents)
-      goto done;
-#ifdef ISOLTS
-if (current_running_cpu_idx == 0)
-  goto done;
-#endif
-    hevents [hevtPtr].type = hevtIntr;
-    hevents [hevtPtr].time = cpu.cycleCnt;
-    hevents [hevtPtr].intr.intr_pair_addr = intr_pair_addr;
-    hdbg_inc ();
-done: ;
-#ifdef THREADZ
-    pthread_mutex_unlock (& hdbg_lock);
-#endif
+    uint64 n;
+    struct hevt * e = hdbg_begin (hevtIntr, & n);
+    if (! e)
+      return;
+    e->intr.intr_pair_addr = intr_pair_addr;
+    hdbg_end (e, n);
   }
 
 void hdbgReg (enum hregs_t type, word36 data)
   {
-#ifdef THREADZ
-    pthread_mutex_lock (& hdbg_lock);
-#endif
-    if (! hevents)
-      goto done;
-#ifdef ISOLTS
-if (current_running_cpu_idx == 0)
-  goto done;
-#endif
-    hevents[hevtPtr].type = hevtReg;
-    hevents[hevtPtr].time = cpu.cycleCnt;
-    hevents[hevtPtr].reg.type = type;
-    hevents[hevtPtr].reg.data = data;
-    hdbg_inc ();
-done: ;
-#ifdef THREADZ
-    pthread_mutex_unlock (& hdbg_lock);
-#endif
+    uint64 n;
+    struct hevt * e = hdbg_begin (hevtReg, & n);
+    if (! e)
+      return;
+    e->reg.type = type;
+    e->reg.data = data;
+    hdbg_end (e, n);
   }
 
-
 void hdbgPAReg (enum hregs_t type, struct par_s * data)
   {
-#ifdef THREADZ
-    pthread_mutex_lock (& hdbg_lock);
-#endif
-    if (! hevents)
-      goto done;
-#ifdef ISOLTS
-if (current_running_cpu_idx == 0)
-  goto done;
-#endif
-    hevents[hevtPtr].type = hevtPAReg;
-    hevents[hevtPtr].time = cpu.cycleCnt;
-    hevents[hevtPtr].par.type = type;
-    hevents[hevtPtr].par.data =  * data;
-    hdbg_inc ();
-done: ;
-#ifdef THREADZ
-    pthread_mutex_unlock (& hdbg_lock);
-#endif
+    uint64 n;
+    struct hevt * e = hdbg_begin (hevtPAReg, & n);
+    if (! e)
+      return;
+    e->par.type = type;
+    e->par.data = * data;
+    hdbg_end (e, n);
   }
 
 static FILE * hdbgOut = NULL;
 
 static void printMRead (struct hevt * p)
   {
-    fprintf (hdbgOut, "DBG(%"PRId64")> CPU FINAL: Read %08o %012"PRIo64"\n",
-                p -> time, 
+    fprintf (hdbgOut, "DBG(%"PRId64")> CPU %c FINAL: Read %08o %012"PRIo64"\n",
+                p -> time, 'A' + p -> cpu_idx,
                 p -> memref . addr, p -> memref . data);
   }
 
 static void printMWrite (struct hevt * p)
   {
-    fprintf (hdbgOut, "DBG(%"PRId64")> CPU FINAL: Write %08o %012"PRIo64"\n",
-                p -> time, 
+    fprintf (hdbgOut, "DBG(%"PRId64")> CPU %c FINAL: Write %08o %012"PRIo64"\n",
+                p -> time, 'A' + p -> cpu_idx,
                 p -> memref . addr, p -> memref . data);
   }
 
@@ -325,15 +346,15 @@ static void printTrace (struct hevt * p)
     char buf [256];
     if (p -> trace . addrMode == ABSOLUTE_mode)
       {
-        fprintf (hdbgOut, "DBG(%"PRId64")> CPU TRACE: %06o %o %012"PRIo64" (%s)\n",
-                    p -> time, 
+        fprintf (hdbgOut, "DBG(%"PRId64")> CPU %c TRACE: %06o %o %012"PRIo64" (%s)\n",
+                    p -> time, 'A' + p -> cpu_idx,
                     p -> trace . ic, p -> trace . ring,
                     p -> trace . inst, disassemble (buf, p -> trace . inst));
       }
     else
       {
-        fprintf (hdbgOut, "DBG(%"PRId64")> CPU TRACE: %05o:%06o %o %012"PRIo64" (%s)\n",
-                    p -> time, p -> trace . segno,
+        fprintf (hdbgOut, "DBG(%"PRId64")> CPU %c TRACE: %05o:%06o %o %012"PRIo64" (%s)\n",
+                    p -> time, 'A' + p -> cpu_idx, p -> trace . segno,
                     p -> trace . ic, p -> trace . ring,
                     p -> trace . inst, disassemble (buf, p -> trace . inst));
       }
@@ -341,8 +362,8 @@ static void printTrace (struct hevt * p)
 
 static void printFault (struct hevt * p)
   {
-    fprintf (hdbgOut, "DBG(%"PRId64")> CPU FAULT: Fault %d(0%o), sub %"PRId64"(0%"PRIo64"), '%s'\n",
-                p -> time, 
+    fprintf (hdbgOut, "DBG(%"PRId64")> CPU %c FAULT: Fault %d(0%o), sub %"PRId64"(0%"PRIo64"), '%s'\n",
+                p -> time, 'A' + p -> cpu_idx,
                 p -> fault.faultNumber, p -> fault.faultNumber,
                 p -> fault.subFault.bits, p -> fault.subFault.bits,
                 p -> fault.faultMsg);
@@ -350,8 +371,8 @@ static void printFault (struct hevt * p)
 
 static void printIntrSet (struct hevt * p)
   {
-    fprintf (hdbgOut, "DBG(%"PRId64")> CPU INTR_SET: Number %d(0%o), CPU %u SCU %u\n",
-                p -> time, 
+    fprintf (hdbgOut, "DBG(%"PRId64")> CPU %c INTR_SET: Number %d(0%o), CPU %u SCU %u\n",
+                p -> time, 'A' + p -> cpu_idx,
                 p -> intrSet.inum, p -> intrSet.inum,
                 p -> intrSet.cpuUnitIdx,
                 p -> intrSet.scuUnitIdx);
@@ -359,8 +380,8 @@ static void printIntrSet (struct hevt * p)
 
 static void printIntr (struct hevt * p)
   {
-    fprintf (hdbgOut, "DBG(%"PRId64")> CPU INTR: Interrupt pair address %o\n",
-                p -> time, 
+    fprintf (hdbgOut, "DBG(%"PRId64")> CPU %c INTR: Interrupt pair address %o\n",
+                p -> time, 'A' + p -> cpu_idx,
                 p -> intr.intr_pair_addr);
   }
 
@@ -376,13 +397,13 @@ static char * regNames [] =
 static void printReg (struct hevt * p)
   {
     if (p->reg.type >= hreg_X0 && p->reg.type <= hreg_X7)
-      fprintf (hdbgOut, "DBG(%"PRId64")> CPU REG: %s %06"PRIo64"\n",
-                  p->time, 
+      fprintf (hdbgOut, "DBG(%"PRId64")> CPU %c REG: %s %06"PRIo64"\n",
+                  p->time, 'A' + p->cpu_idx,
                   regNames[p->reg.type],
                   p->reg.data);
     else
-      fprintf (hdbgOut, "DBG(%"PRId64")> CPU REG: %s %012"PRIo64"\n",
-                  p->time, 
+      fprintf (hdbgOut, "DBG(%"PRId64")> CPU %c REG: %s %012"PRIo64"\n",
+                  p->time, 'A' + p->cpu_idx,
                   regNames[p->reg.type],
                   p->reg.data);
   }
@@ -390,18 +411,18 @@ static void printReg (struct hevt * p)
 static void printPAReg (struct hevt * p)
   {
     if (p->reg.type >= hreg_PR0 && p->reg.type <= hreg_PR7)
-      fprintf (hdbgOut, "DBG(%"PRId64")> CPU REG: %s "
+      fprintf (hdbgOut, "DBG(%"PRId64")> CPU %c REG: %s "
                "%05o:%06o BIT %2o RNR %o\n",
-               p->time, 
+               p->time, 'A' + p->cpu_idx,
                regNames[p->reg.type],
                p->par.data.SNR,
                p->par.data.WORDNO,
                p->par.data.PR_BITNO,
                p->par.data.RNR);
     else
-      fprintf (hdbgOut, "DBG(%"PRId64")> CPU REG: %s "
+      fprintf (hdbgOut, "DBG(%"PRId64")> CPU %c REG: %s "
                "%05o:%06o CHAR %o BIT %2o RNR %o\n",
-               p->time, 
+               p->time, 'A' + p->cpu_idx,
                regNames[p->reg.type],
                p->par.data.SNR,
                p->par.data.WORDNO,
@@ -410,70 +431,101 @@ static void printPAReg (struct hevt * p)
                p->par.data.RNR);
   }
 
-void hdbgPrint (void)
+static void printEvt (struct hevt * evtp)
+  {
+    switch (evtp -> type)
+      {
+        case hevtEmpty:
+          break;
+
+        case hevtTrace:
+          printTrace (evtp);
+          break;
+            
+        case hevtMRead:
+          printMRead (evtp);
+          break;
+            
+        case hevtMWrite:
+          printMWrite (evtp);
+          break;
+            
+        case hevtFault:
+          printFault (evtp);
+          break;
+            
+        case hevtIntrSet:
+          printIntrSet (evtp);
+          break;
+            
+        case hevtIntr:
+          printIntr (evtp);
+          break;
+            
+        case hevtReg:
+          printReg (evtp);
+          break;
+            
+        case hevtPAReg:
+          printPAReg (evtp);
+          break;
+            
+        default:
+          fprintf (hdbgOut, "hdbgPrint ? %d\n", evtp -> type);
+          break;
+      }
+  }
+
+static bool openList (void)
   {
-#ifdef THREADZ
-    pthread_mutex_lock (& hdbg_lock);
-#endif
-    if (! hevents)
-      goto done;
     hdbgOut = fopen ("hdbg.list", "w");
     if (! hdbgOut)
       {
         sim_printf ("can't open hdbg.list\n");
-        goto done;
+        return false;
       }
     time_t curtime;
     time (& curtime);
     fprintf (hdbgOut, "%s\n", ctime (& curtime));
+    return true;
+  }
 
-    for (unsigned long p = 0; p < hdbgSize; p ++)
+void hdbgPrint (void)
+  {
+    hdbg_init ();
+    uv_mutex_lock (& hdbg_lock);
+    if (! hdbgSize)
+      goto done;
+
+    // Copy out what each ring holds, then merge the CPUs by time
+    struct hevt * evts = malloc (N_CPU_UNITS_MAX * hdbgSize * sizeof (struct hevt));
+    if (! evts)
       {
-        unsigned long q = (hevtPtr + p) % hdbgSize;
-        struct hevt * evtp = hevents + q;
-        switch (evtp -> type)
-          {
-            case hevtEmpty:
-              break;
+        sim_printf ("hdbgPrint malloc failed\n");
+        goto done;
+      }
+    size_t nevts = 0;
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      {
+        struct hring * r = hrings + i;
+        uint64 head = __atomic_load_n (& r->head, __ATOMIC_ACQUIRE);
+        uint64 n = head > hdbgSize ? head - hdbgSize : 0;
+        for ( ; n < head; n ++)
+          if (hdbg_read (r, n, evts + nevts))
+            nevts ++;
+      }
+    qsort (evts, nevts, sizeof (struct hevt), hevt_cmp);
 
-            case hevtTrace:
-              printTrace (evtp);
-              break;
-                
-            case hevtMRead:
-              printMRead (evtp);
-              break;
-                
-            case hevtMWrite:
-              printMWrite (evtp);
-              break;
-                
-            case hevtFault:
-              printFault (evtp);
-              break;
-                
-            case hevtIntrSet:
-              printIntrSet (evtp);
-              break;
-                
-            case hevtIntr:
-              printIntr (evtp);
-              break;
-                
-            case hevtReg:
-              printReg (evtp);
-              break;
-                
-            case hevtPAReg:
-              printPAReg (evtp);
-              break;
-                
-            default:
-              fprintf (hdbgOut, "hdbgPrint ? %d\n", evtp -> type);
-              break;
-          }
+    if (! openList ())
+      {
+        free (evts);
+        goto done;
       }
+    for (size_t i = 0; i < nevts; i ++)
+      printEvt (evts + i);
     fclose (hdbgOut);
+    free (evts);
+
     int fd = open ("M.dump", O_WRONLY | O_CREAT, 0660);
     if (fd == -1)
       {
@@ -484,40 +536,209 @@ void hdbgPrint (void)
     /* ssize_t n = */ write (fd, (const void *) M, MEMSIZE * sizeof (word36));
     close (fd);
 done: ;
-#ifdef THREADZ
-    pthread_mutex_unlock (& hdbg_lock);
-#endif
+    uv_mutex_unlock (& hdbg_lock);
+  }
+
+// Write a streamed file to hdbg.list
+
+static t_stat hdbgPrintStream (const char * fname)
+  {
+    FILE * fp = fopen (fname, "rb");
+    if (! fp)
+      {
+        sim_warn ("phdbg: can't open %s: %s\n", fname, strerror (errno));
+        return SCPE_OPENERR;
+      }
+    struct hdbg_stream_hdr hdr;
+    if (fread (& hdr, sizeof (hdr), 1, fp) != 1 ||
+        memcmp (hdr.magic, HDBG_STREAM_MAGIC, sizeof (hdr.magic)) != 0 ||
+        hdr.version != HDBG_STREAM_VERSION ||
+        hdr.evt_size != sizeof (struct hevt))
+      {
+        sim_warn ("phdbg: %s is not a history stream from this build\n", fname);
+        fclose (fp);
+        return SCPE_FMT;
+      }
+    if (! openList ())
+      {
+        fclose (fp);
+        return SCPE_OPENERR;
+      }
+    struct hevt e;
+    unsigned long long n = 0;
+    while (fread (& e, sizeof (e), 1, fp) == 1)
+      {
+        printEvt (& e);
+        n ++;
+      }
+    fclose (hdbgOut);
+    fclose (fp);
+    sim_msg ("%llu events written to hdbg.list\n", n);
+    return SCPE_OK;
+  }
+
+// Move the published events of every ring to the stream file, merged by
+// time within each pass. Events overwritten before they were taken are
+// counted as dropped. Called with hdbg_lock held.
+
+static void hdbg_stream_pass (void)
+  {
+    size_t nevts = 0;
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      {
+        struct hring * r = hrings + i;
+        uint64 tail = r->tail;
+        uint64 head = __atomic_load_n (& r->head, __ATOMIC_ACQUIRE);
+        while (tail < head)
+          {
+            if (head - tail > hdbgSize)
+              {
+                hdbg_stream_dropped += head - hdbgSize - tail;
+                tail = head - hdbgSize;
+              }
+            if (hdbg_read (r, tail, hdbg_batch + nevts))
+              {
+                nevts ++;
+                tail ++;
+                continue;
+              }
+            // Not yet published, or overwritten since head was read
+            head = __atomic_load_n (& r->head, __ATOMIC_ACQUIRE);
+            if (head - tail <= hdbgSize)
+              break;
+          }
+        r->tail = tail;
+      }
+    qsort (hdbg_batch, nevts, sizeof (struct hevt), hevt_cmp);
+    if (fwrite (hdbg_batch, sizeof (struct hevt), nevts, hdbg_stream_fp) != nevts)
+      hdbg_stream_dropped += nevts;
+    else
+      hdbg_stream_cnt += nevts;
+  }
+
+static void hdbg_stream_main (UNUSED void * arg)
+  {
+    struct timespec period = { 0, 10000000L }; // 10 ms
+    while (hdbg_streaming)
+      {
+        nanosleep (& period, NULL);
+        uv_mutex_lock (& hdbg_lock);
+        hdbg_stream_pass ();
+        uv_mutex_unlock (& hdbg_lock);
+      }
+  }
+
+static t_stat hdbg_stream_stop (void)
+  {
+    if (! hdbg_streaming)
+      return SCPE_OK;
+    hdbg_streaming = false;
+    uv_thread_join (& hdbg_stream_thread);
+    uv_mutex_lock (& hdbg_lock);
+    hdbg_stream_pass ();
+    t_stat rc = SCPE_OK;
+    if (fclose (hdbg_stream_fp))
+      {
+        sim_warn ("hdbg_stream: %s\n", strerror (errno));
+        rc = SCPE_IOERR;
+      }
+    hdbg_stream_fp = NULL;
+    free (hdbg_batch);
+    hdbg_batch = NULL;
+    sim_msg ("hdbg stream: %llu events written, %llu dropped\n",
+             hdbg_stream_cnt, hdbg_stream_dropped);
+    uv_mutex_unlock (& hdbg_lock);
+    return rc;
+  }
+
+static t_stat hdbg_stream_start (const char * fname)
+  {
+    if (! fname || ! * fname)
+      {
+        sim_warn ("hdbg_stream: missing file name\n");
+        return SCPE_ARG;
+      }
+    if (! hdbgSize)
+      {
+        sim_warn ("hdbg_stream: set the history size with hdbg first\n");
+        return SCPE_ARG;
+      }
+    hdbg_stream_stop ();
+    hdbg_batch = malloc (N_CPU_UNITS_MAX * hdbgSize * sizeof (struct hevt));
+    if (! hdbg_batch)
+      {
+        sim_warn ("hdbg_stream: malloc failed\n");
+        return SCPE_MEM;
+      }
+    hdbg_stream_fp = fopen (fname, "wb");
+    if (! hdbg_stream_fp)
+      {
+        sim_warn ("hdbg_stream: can't open %s: %s\n", fname, strerror (errno));
+        free (hdbg_batch);
+        hdbg_batch = NULL;
+        return SCPE_OPENERR;
+      }
+    struct hdbg_stream_hdr hdr;
+    memset (& hdr, 0, sizeof (hdr));
+    memcpy (hdr.magic, HDBG_STREAM_MAGIC, sizeof (hdr.magic));
+    hdr.version = HDBG_STREAM_VERSION;
+    hdr.evt_size = sizeof (struct hevt);
+    fwrite (& hdr, sizeof (hdr), 1, hdbg_stream_fp);
+    // Only events recorded from now on
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      hrings[i].tail = __atomic_load_n (& hrings[i].head, __ATOMIC_ACQUIRE);
+    hdbg_stream_cnt = hdbg_stream_dropped = 0;
+    hdbg_streaming = true;
+    if (uv_thread_create (& hdbg_stream_thread, hdbg_stream_main, NULL))
+      {
+        hdbg_streaming = false;
+        fclose (hdbg_stream_fp);
+        hdbg_stream_fp = NULL;
+        free (hdbg_batch);
+        hdbg_batch = NULL;
+        sim_warn ("hdbg_stream: can't create the stream thread\n");
+        return SCPE_IERR;
+      }
+    sim_msg ("Streaming history to %s\n", fname);
+    return SCPE_OK;
+  }
+
+t_stat hdbg_stream (int32 arg, const char * buf)
+  {
+    hdbg_init ();
+    if (arg)
+      return hdbg_stream_stop ();
+    return hdbg_stream_start (buf);
   }
 
 void hdbg_mark (void)
   {
-#ifdef THREADZ
-    pthread_mutex_lock (& hdbg_lock);
-#endif
-    hevtMark = hdbgSize;
+    hevtMark = (long) hdbgSize;
     sim_printf ("hdbg mark set to %ld\n", hevtMark);
-#ifdef THREADZ
-    pthread_mutex_unlock (& hdbg_lock);
-#endif
   }
 
 // set buffer size 
 t_stat hdbg_size (UNUSED int32 arg, const char * buf)
   {
-#ifdef THREADZ
-    pthread_mutex_lock (& hdbg_lock);
-#endif
-    hdbgSize = strtoul (buf, NULL, 0);
-    sim_printf ("hdbg size set to %ld\n", hdbgSize);
+    hdbg_init ();
+    hdbg_stream_stop ();
+    uv_mutex_lock (& hdbg_lock);
+    unsigned long n = strtoul (buf, NULL, 0);
+    hdbgSize = 0;
+    if (n)
+      for (hdbgSize = 1; hdbgSize < n; hdbgSize <<= 1)
+        ;
+    hdbgMask = hdbgSize ? hdbgSize - 1 : 0;
     createBuffer ();
-#ifdef THREADZ
-    pthread_mutex_unlock (& hdbg_lock);
-#endif
+    sim_printf ("hdbg size set to %"PRIu64" per CPU\n", hdbgSize);
+    uv_mutex_unlock (& hdbg_lock);
     return SCPE_OK;
   }
 
 t_stat hdbg_print (UNUSED int32 arg, const char * buf)
   {
+    if (buf && * buf)
+      return hdbgPrintStream (buf);
     hdbgPrint ();
     return SCPE_OK;
   }
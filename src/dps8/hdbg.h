@@ -14,6 +14,7 @@
 void hdbg_mark (void);
 t_stat hdbg_size (int32 arg, UNUSED const char * buf);
 t_stat hdbg_print (int32 arg, UNUSED const char * buf);
+t_stat hdbg_stream (int32 arg, const char * buf);
 #ifdef HDBG
 void hdbgTrace (void);
 void hdbgPrint (void);
@@ -77,3 +77,50 @@ void * open_shm (char * key, size_t size)
       }
     return p;
   }
+
+// Mark map [i] for each chunk bytes of the file behind key, starting at
+// offset, that may hold nonzero data. The files are created sparse and
+// holes read as zeros, so a chunk lying wholly in a hole has never been
+// written. Returns -1 if the host can't tell; the caller should then
+// assume that every chunk may hold data.
+
+int shm_data_map (char * key, size_t offset, size_t len, size_t chunk,
+                  unsigned char * map)
+  {
+#ifdef SEEK_DATA
+    char buf [256];
+    sprintf (buf, "dps8m.%s", key);
+    int fd = open (buf, O_RDONLY);
+    if (fd == -1)
+      return -1;
+
+    memset (map, 0, (len + chunk - 1) / chunk);
+    off_t end = (off_t) (offset + len);
+    off_t pos = (off_t) offset;
+    while (pos < end)
+      {
+        off_t data = lseek (fd, pos, SEEK_DATA);
+        if (data == -1 && errno == ENXIO) // Nothing but holes to EOF
+          break;
+        off_t hole = data == -1 ? -1 : lseek (fd, data, SEEK_HOLE);
+        if (hole == -1)
+          {
+            close (fd);
+            return -1;
+          }
+        if (data >= end)
+          break;
+        if (hole > end)
+          hole = end;
+        size_t first = ((size_t) data - offset) / chunk;
+        size_t last = ((size_t) hole - 1 - offset) / chunk;
+        for (size_t i = first; i <= last; i ++)
+          map [i] = 1;
+        pos = hole;
+      }
+    close (fd);
+    return 0;
+#else
+    return -1;
+#endif
+  }
@@ -11,4 +11,6 @@
 
 void * create_shm (char * key, size_t size);
 void * open_shm (char * key, size_t size);
+int shm_data_map (char * key, size_t offset, size_t len, size_t chunk,
+                  unsigned char * map);
 
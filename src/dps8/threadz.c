@@ -45,6 +45,9 @@ void unlock_simh (void)
 
 static pthread_mutex_t libuv_lock;
 
+// The thread that runs the event loop
+static pthread_t main_thread;
+
 void lock_libuv (void)
   {
     pthread_mutex_lock (& libuv_lock);
@@ -53,6 +56,10 @@ void lock_libuv (void)
 void unlock_libuv (void)
   {
     pthread_mutex_unlock (& libuv_lock);
+    // The event loop may be asleep in its poll; have it look at whatever
+    // this thread has done to it
+    if (! pthread_equal (pthread_self (), main_thread))
+      ev_poll_kick ();
   }
 
 bool test_libuv_lock (void)
@@ -75,135 +82,9 @@ bool test_libuv_lock (void)
 
 // Memory serializer
 
-//   addrmods RMW lock
-//     Read()
-//     Write()
-//
-//   CPU -- reset locks
-//
-//   core_read/core_write locks
-//
-//   read_operand/write operand RMW lock
-//     Read()
-//     Write()
-//
-//  IOM 
-
-// mem_lock -- memory atomicity lock
-// rmw_lock -- big R/M/W cycle lock
-
-#ifndef LOCKLESS
-pthread_rwlock_t mem_lock = PTHREAD_RWLOCK_INITIALIZER;
-static __thread bool have_mem_lock = false;
-static __thread bool have_rmw_lock = false;
-
-bool get_rmw_lock (void)
-  {
-    return have_rmw_lock;
-  }
-
-void lock_rmw (void)
-  {
-    if (have_rmw_lock)
-      {
-        sim_warn ("%s: Already have RMW lock\n", __func__);
-        return;
-      }
-    if (have_mem_lock)
-      {
-        sim_warn ("%s: Already have memory lock\n", __func__);
-        return;
-      }
-    int rc= pthread_rwlock_wrlock (& mem_lock);
-    if (rc)
-      sim_printf ("%s pthread_rwlock_rdlock mem_lock %d\n", __func__, rc);
-    have_mem_lock = true;
-    have_rmw_lock = true;
-  }
-
-void lock_mem_rd (void)
-  {
-    // If the big RMW lock is on, do nothing.
-    if (have_rmw_lock)
-      return;
-
-    if (have_mem_lock)
-      {
-        sim_warn ("%s: Already have memory lock\n", __func__);
-        return;
-      }
-    int rc= pthread_rwlock_rdlock (& mem_lock);
-    if (rc)
-      sim_printf ("%s pthread_rwlock_rdlock mem_lock %d\n", __func__, rc);
-    have_mem_lock = true;
-  }
-
-void lock_mem_wr (void)
-  {
-    // If the big RMW lock is on, do nothing.
-    if (have_rmw_lock)
-      return;
-
-    if (have_mem_lock)
-      {
-        sim_warn ("%s: Already have memory lock\n", __func__);
-        return;
-      }
-    int rc= pthread_rwlock_wrlock (& mem_lock);
-    if (rc)
-      sim_printf ("%s pthread_rwlock_wrlock mem_lock %d\n", __func__, rc);
-    have_mem_lock = true;
-  }
-
-
-void unlock_rmw (void)
-  {
-    if (! have_mem_lock)
-      {
-        sim_warn ("%s: Don't have memory lock\n", __func__);
-        return;
-      }
-    if (! have_rmw_lock)
-      {
-        sim_warn ("%s: Don't have RMW lock\n", __func__);
-        return;
-      }
-
-    int rc = pthread_rwlock_unlock (& mem_lock);
-    if (rc)
-      sim_printf ("%s pthread_rwlock_ublock mem_lock %d\n", __func__, rc);
-    have_mem_lock = false;
-    have_rmw_lock = false;
-  }
-
-void unlock_mem (void)
-  {
-    if (have_rmw_lock)
-      return; 
-    if (! have_mem_lock)
-      {
-        sim_warn ("%s: Don't have memory lock\n", __func__);
-        return;
-      }
-
-    int rc = pthread_rwlock_unlock (& mem_lock);
-    if (rc)
-      sim_printf ("%s pthread_rwlock_ublock mem_lock %d\n", __func__, rc);
-    have_mem_lock = false;
-  }
-
-void unlock_mem_force (void)
-  {
-    if (have_mem_lock)
-      {
-        int rc = pthread_rwlock_unlock (& mem_lock);
-        if (rc)
-          sim_printf ("%s pthread_rwlock_unlock mem_lock %d\n", __func__, rc);
-      }
-    have_mem_lock = false;
-    have_rmw_lock = false;
-  }
-#endif
+// Main memory is not guarded by a lock; core_read_lock()/core_write_unlock()
+// and LOCK_CORE_WORD() serialize R/M/W cycles on a single word by setting
+// MEM_LOCKED in the spare high bits of that word. See dps8_cpu.h.
 
 // local serializer
 
@@ -361,11 +242,6 @@ void createCPUThread (uint cpuNum)
 
     p->run = true;
 
-    // initialize DIS sleep
-    rc = pthread_cond_init (& p->sleepCond, NULL);
-    if (rc)
-      sim_printf ("createCPUThread pthread_cond_init sleepCond %d\n", rc);
-
     rc = pthread_create (& p->cpuThread, NULL, cpu_thread_main, 
                     & p->cpuThreadArg);
     if (rc)
@@ -429,6 +305,9 @@ void setCPURun (uint cpuNum, bool run)
     rc = pthread_mutex_unlock (& p->runLock);
     if (rc)
       sim_printf ("setCPUrun pthread_mutex_unlock %d\n", rc);
+    // Don't leave a stopped CPU sleeping in DIS
+    if (! run)
+      wakeCPU (cpuNum);
   }
 
 // Called by CPU thread to block on run/sleep
@@ -453,6 +332,23 @@ void cpuRunningWait (void)
       sim_printf ("cpuRunningWait pthread_mutex_unlock %d\n", rc);
   }
 
+// DIS sleep
+//
+// The CPU thread blocks until wakeCPU is called for it or the time is up.
+// wakeCPU leaves 'wake' set, so an interrupt or fault posted after the
+// CPU last looked for one, but before it got here, makes sleepCPU return
+// at once instead of being lost. A stale 'wake' costs one extra pass
+// through DIS.
+//
+// The timeout is on the monotonic clock where the platform lets the
+// condition variable use it.
+
+#ifdef __APPLE__
+#define SLEEP_CLOCK CLOCK_REALTIME
+#else
+#define SLEEP_CLOCK CLOCK_MONOTONIC
+#endif
+
 // Called by CPU thread to sleep until time up or signaled
 // Return time left
 unsigned long  sleepCPU (unsigned long usec)
@@ -460,26 +356,38 @@ unsigned long  sleepCPU (unsigned long usec)
     int rc;
     struct cpuThreadz_t * p = & cpuThreadz[current_running_cpu_idx];
     struct timespec abstime;
-    clock_gettime (CLOCK_REALTIME, & abstime);
-    abstime.tv_nsec += (long int) usec * 1000;
+    clock_gettime (SLEEP_CLOCK, & abstime);
+    abstime.tv_sec += (time_t) (usec / 1000000);
+    abstime.tv_nsec += (long int) (usec % 1000000) * 1000;
     abstime.tv_sec += abstime.tv_nsec / 1000000000;
     abstime.tv_nsec %= 1000000000;
 
-    rc = pthread_cond_timedwait (& p->sleepCond,
-                                 & scu_lock,
-                                 & abstime);
-//sim_printf ("wake %u %u %lu\n", cpu.rTR, current_running_cpu_idx, usec);
-    if (rc && rc != ETIMEDOUT)
-      sim_printf ("sleepCPU pthread_cond_timedwait %d\n", rc);
-    if (rc == ETIMEDOUT)
-      return 0;
+    rc = pthread_mutex_lock (& p->sleepLock);
+    if (rc)
+      sim_printf ("sleepCPU pthread_mutex_lock %d\n", rc);
+    rc = 0;
+    while (! p->wake && rc != ETIMEDOUT)
+      {
+        rc = pthread_cond_timedwait (& p->sleepCond, & p->sleepLock,
+                                     & abstime);
+        if (rc && rc != ETIMEDOUT)
+          {
+            sim_printf ("sleepCPU pthread_cond_timedwait %d\n", rc);
+            break;
+          }
+      }
+    p->wake = false;
+    rc = pthread_mutex_unlock (& p->sleepLock);
+    if (rc)
+      sim_printf ("sleepCPU pthread_mutex_unlock %d\n", rc);
+
     struct timespec newtime, delta;
-    clock_gettime (CLOCK_REALTIME, & newtime);
-    timespec_diff (& abstime, & newtime, & delta);
-//sim_printf ("wake %u %u %lu %lu\n", cpu.rTR, current_running_cpu_idx, usec, delta.tv_nsec / 1000);
-    if (delta.tv_nsec < 0)
-      return 0; // safety
-    return (unsigned long) delta.tv_nsec / 1000;
+    clock_gettime (SLEEP_CLOCK, & newtime);
+    timespec_diff (& newtime, & abstime, & delta);
+    if (delta.tv_sec < 0 || (delta.tv_sec == 0 && delta.tv_nsec <= 0))
+      return 0;
+    return (unsigned long) delta.tv_sec * 1000000 +
+           (unsigned long) delta.tv_nsec / 1000;
   }
 
 // Called to wake sleeping CPU; such as interrupt during DIS
@@ -489,9 +397,16 @@ void wakeCPU (uint cpuNum)
     int rc;
     struct cpuThreadz_t * p = & cpuThreadz[cpuNum];
 
+    rc = pthread_mutex_lock (& p->sleepLock);
+    if (rc)
+      sim_printf ("wakeCPU pthread_mutex_lock %d\n", rc);
+    p->wake = true;
     rc = pthread_cond_signal (& p->sleepCond);
     if (rc)
       sim_printf ("wakeCPU pthread_cond_signal %d\n", rc);
+    rc = pthread_mutex_unlock (& p->sleepLock);
+    if (rc)
+      sim_printf ("wakeCPU pthread_mutex_unlock %d\n", rc);
   }
 
 #ifdef IO_THREADZ
@@ -793,16 +708,13 @@ void chnRdyWait (uint iomNum, uint chnNum)
 
 void initThreadz (void)
   {
+    main_thread = pthread_self ();
+
 #ifdef IO_THREADZ
     // chnThreadz is sparse; make sure 'started' is false
     memset (chnThreadz, 0, sizeof (chnThreadz));
 #endif
 
-#ifndef LOCKLESS
-    //pthread_rwlock_init (& mem_lock, PTHREAD_PROCESS_PRIVATE);
-    have_mem_lock = false;
-    have_rmw_lock = false;
-#endif
 #ifdef __FreeBSD__
     pthread_mutexattr_t scu_attr;
     pthread_mutexattr_init(&scu_attr);
@@ -828,17 +740,40 @@ void initThreadz (void)
     pthread_cond_init (& iomCond, NULL);
     pthread_mutex_init (& iom_start_lock, NULL);
 #endif
+
+    // DIS sleep
+    pthread_condattr_t sleep_attr;
+    pthread_condattr_init (& sleep_attr);
+#ifndef __APPLE__
+    pthread_condattr_setclock (& sleep_attr, SLEEP_CLOCK);
+#endif
+    for (uint i = 0; i < N_CPU_UNITS_MAX; i ++)
+      {
+        pthread_cond_init (& cpuThreadz[i].sleepCond, & sleep_attr);
+        pthread_mutex_init (& cpuThreadz[i].sleepLock, NULL);
+        cpuThreadz[i].wake = false;
+      }
+    pthread_condattr_destroy (& sleep_attr);
   }
 
 // Set up per-thread signal handlers
 
 void int_handler (int signal);
 
+// simh's ^C handler, which sets stop_cpu; the main thread may be asleep
+// in the event loop and needs waking to see it
+
+static void thread_int_handler (int signal)
+  {
+    int_handler (signal);
+    ev_poll_kick ();
+  }
+
 void setSignals (void)
   {
     struct sigaction act;
     memset (& act, 0, sizeof (act));
-    act.sa_handler = int_handler;
+    act.sa_handler = thread_int_handler;
     act.sa_flags = 0;
     sigaction (SIGINT, & act, NULL);
     //sigaction (SIGHUP, & act, NULL);
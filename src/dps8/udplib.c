@@ -319,6 +319,18 @@ printf("link %d - closed\n", link);
     return 0;
   }
 
+// The link's socket, for the caller's event loop to watch; -1 if the link
+// is not open
+
+int udp_get_socket (int link)
+  {
+    if ((link < 0) || (link >= MAXLINKS))
+      return -1;
+    if (! udp_links [link] . used)
+      return -1;
+    return udp_links [link] . sock;
+  }
+
 int udp_send (int link, uint16_t * pdata, uint16_t count, uint16_t flags)
   {
     //   This routine does all the work of sending an IMP data packet.  pdata
@@ -15,4 +15,5 @@ int udp_create (const char * premote, int32_t * plink);
 int udp_release (int32_t link);
 int udp_send (int32_t link, uint16_t * pdata, uint16_t count, uint16_t flags);
 int udp_receive (int32_t link, uint16_t * pdata, uint16_t maxbufg);
+int udp_get_socket (int32_t link);
 
@@ -355,6 +355,8 @@ static void accessProcessInput (uv_access * access, unsigned char * buf,
       }
 
 done:;
+    // Let the console see the input now rather than at the next tick
+    ev_poll_kick ();
     // Prevent further reading until this buffer is consumed
     //fnpuv_read_stop (client);
     //if (! client || uv_is_closing ((uv_handle_t *) client))
@@ -0,0 +1,290 @@
+/*
+ Copyright 2019 by Charles Anthony
+
+ All rights reserved.
+
+ This software is made available under the terms of the
+ ICU License -- ICU 1.8.1 and later.
+ See the LICENSE file at the top-level directory of this distribution and
+ at https://sourceforge.net/p/dps8m/code/ci/master/tree/LICENSE
+ */
+
+// Check the indexed lookups of dps8_book.c against the linear searches
+// they replaced.
+//
+//   booktest [seed]
+//
+// Builds a random system book, with overlapping and repeated components,
+// repeated segment numbers and component names, and names longer than
+// the book reader's 32 characters, and compares every book_lookup_address
+// and book_lookup_name result with the old code's. Exits non-zero if any
+// differ.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "dps8_book.h"
+
+#define N_SEGMENTS 200
+#define N_COMPONENTS 3000
+#define N_ADDRESSES 200000
+#define N_NAMES 50000
+
+static uint64_t rng_state;
+
+static uint64_t rng (void)
+  {
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1DULL;
+  }
+
+// The book as the old code kept it
+
+static struct
+  {
+    char * segname;
+    int segno;
+  } segs [N_SEGMENTS];
+
+static int n_segs = 0;
+
+static struct
+  {
+    char * compname;
+    int segnum;
+    unsigned int txt_start, txt_length;
+  } comps [N_COMPONENTS];
+
+static int n_comps = 0;
+
+// The segment and component names share a long prefix half the time, so
+// that names that differ only past 32 characters are common
+
+static char * rand_name (const char * prefix, unsigned int range)
+  {
+    char name [80];
+    if (rng () & 1)
+      sprintf (name, "%s_%u", prefix, (unsigned int) (rng () % range));
+    else
+      sprintf (name, "%s_with_a_rather_long_common_prefix_%u", prefix,
+               (unsigned int) (rng () % range));
+    return strdup (name);
+  }
+
+static int old_lookup_segment (const char * name)
+  {
+    for (int i = 0; i < n_segs; i ++)
+      if (strcmp (name, segs[i].segname) == 0)
+        return i;
+    return -1;
+  }
+
+static char * old_lookup_address (unsigned int segno, unsigned int offset,
+                                  char * * compname, unsigned int * compoffset)
+  {
+    static char buf[129];
+    int i;
+
+    for (i = 0; i < n_segs; i ++)
+      if (segs[i].segno == (int) segno)
+        break;
+    if (i >= n_segs)
+      return NULL;
+
+    int best = -1;
+    unsigned int bestoffset = 0;
+    for (int j = 0; j < n_comps; j ++)
+      {
+        if (comps[j].segnum != i)
+          continue;
+        if (comps[j].txt_start <= offset &&
+            comps[j].txt_start + comps[j].txt_length > offset)
+          {
+            sprintf (buf, "%s:%s+0%0o", segs[i].segname, comps[j].compname,
+                     offset - comps[j].txt_start);
+            * compname = comps[j].compname;
+            * compoffset = offset - comps[j].txt_start;
+            return buf;
+          }
+        if (comps[j].txt_start <= offset &&
+            comps[j].txt_start > bestoffset)
+          {
+            best = j;
+            bestoffset = comps[j].txt_start;
+          }
+      }
+
+    if (best != -1)
+      {
+        * compname = comps[best].compname;
+        * compoffset = offset - comps[best].txt_start;
+        sprintf (buf, "%s:%s+0%0o", segs[i].segname, comps[best].compname,
+                 offset - comps[best].txt_start);
+        return buf;
+      }
+
+    * compname = segs[i].segname;
+    * compoffset = offset;
+    sprintf (buf, "%s:+0%0o", segs[i].segname, offset);
+    return buf;
+  }
+
+static int old_lookup_name (const char * segname, const char * compname,
+                            long * segno, long * offset)
+  {
+    int i = old_lookup_segment (segname);
+    if (i < 0)
+      return -1;
+    for (int j = 0; j < n_comps; j ++)
+      {
+        if (comps[j].segnum != i)
+          continue;
+        if (strcmp (comps[j].compname, compname) == 0)
+          {
+            * segno = segs[i].segno;
+            * offset = (long) comps[j].txt_start;
+            return 0;
+          }
+      }
+    return -1;
+  }
+
+static int build_book (void)
+  {
+    for (int i = 0; i < N_SEGMENTS; i ++)
+      {
+        char * name = rand_name ("seg", N_SEGMENTS);
+        // Some segment numbers repeat
+        int segno = (int) (rng () % (N_SEGMENTS + N_SEGMENTS / 4));
+        int n = book_add_segment (name, segno);
+        int old = old_lookup_segment (name);
+        if (old < 0)
+          {
+            old = n_segs ++;
+            segs[old].segname = name;
+            segs[old].segno = segno;
+          }
+        else
+          free (name);
+        if (n != old)
+          {
+            printf ("book_add_segment %s: %d, expected %d\n", segs[old].segname,
+                    n, old);
+            return 1;
+          }
+      }
+
+    for (int i = 0; i < N_COMPONENTS; i ++)
+      {
+        int segnum = (int) (rng () % (uint64_t) n_segs);
+        char * name = rand_name ("comp", N_COMPONENTS / 2);
+        // Mostly small components in a small segment, so that they
+        // overlap, touch and repeat; a few zero length or at 0
+        unsigned int start = (rng () % 8) ? (unsigned int) (rng () % 010000) :
+                                            0;
+        unsigned int length = (rng () % 8) ? (unsigned int) (rng () % 01000) :
+                                             0;
+        int n = book_add_component (segnum, name, start, length, 0, 0, 0, 0);
+        if (n != n_comps)
+          {
+            printf ("book_add_component %s: %d, expected %d\n", name, n,
+                    n_comps);
+            return 1;
+          }
+        comps[n_comps].compname = name;
+        comps[n_comps].segnum = segnum;
+        comps[n_comps].txt_start = start;
+        comps[n_comps].txt_length = length;
+        n_comps ++;
+      }
+    return 0;
+  }
+
+static unsigned int test_lookup_address (void)
+  {
+    unsigned int bad = 0;
+    for (unsigned int i = 0; i < N_ADDRESSES; i ++)
+      {
+        unsigned int segno = (unsigned int) (rng () % (N_SEGMENTS * 2));
+        unsigned int offset = (unsigned int) (rng () % 012000);
+        char * oldName = NULL, * newName = NULL;
+        unsigned int oldOffset = 0, newOffset = 0;
+        char oldBuf [129];
+        char * old = old_lookup_address (segno, offset, & oldName, & oldOffset);
+        if (old)
+          old = strcpy (oldBuf, old);
+        char * new = book_lookup_address (segno, offset, & newName,
+                                          & newOffset);
+        if ((old == NULL) != (new == NULL) ||
+            (old && (strcmp (old, new) != 0 || strcmp (oldName, newName) != 0 ||
+                     oldOffset != newOffset)))
+          {
+            if (bad ++ < 10)
+              printf ("book_lookup_address %o:%o: %s %s\n", segno, offset,
+                      old ? old : "(none)", new ? new : "(none)");
+          }
+      }
+    printf ("book_lookup_address: %u cases, %u mismatches\n", N_ADDRESSES,
+            bad);
+    return bad;
+  }
+
+static unsigned int test_lookup_name (void)
+  {
+    unsigned int bad = 0;
+    for (unsigned int i = 0; i < N_NAMES; i ++)
+      {
+        // Mostly names that are in the book, with their own segment or
+        // another one
+        const char * segname;
+        char * compname;
+        if (rng () % 4)
+          {
+            int j = (int) (rng () % (uint64_t) n_comps);
+            segname = segs[(rng () % 4) ? comps[j].segnum :
+                           (int) (rng () % (uint64_t) n_segs)].segname;
+            compname = strdup (comps[j].compname);
+          }
+        else
+          {
+            segname = segs[rng () % (uint64_t) n_segs].segname;
+            compname = rand_name ("comp", N_COMPONENTS);
+          }
+        long oldSegno = -1, newSegno = -1, oldOffset = -1, newOffset = -1;
+        int old = old_lookup_name (segname, compname, & oldSegno, & oldOffset);
+        int new = book_lookup_name (segname, compname, & newSegno, & newOffset);
+        if (old != new || oldSegno != newSegno || oldOffset != newOffset)
+          {
+            if (bad ++ < 10)
+              printf ("book_lookup_name %s %s: %d %lo:%lo %d %lo:%lo\n",
+                      segname, compname, old, oldSegno, oldOffset, new,
+                      newSegno, newOffset);
+          }
+        free (compname);
+      }
+    printf ("book_lookup_name: %u cases, %u mismatches\n", N_NAMES, bad);
+    return bad;
+  }
+
+int main (int argc, char * argv [])
+  {
+    if (argc > 2)
+      {
+        fprintf (stderr, "usage: booktest [seed]\n");
+        return 2;
+      }
+    rng_state = argc == 2 ? strtoull (argv[1], NULL, 0) : 0x72;
+    if (rng_state == 0)
+      rng_state = 1;
+
+    if (build_book ())
+      return 1;
+    unsigned int bad = test_lookup_address ();
+    bad += test_lookup_name ();
+    return bad ? 1 : 0;
+  }
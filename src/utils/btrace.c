@@ -0,0 +1,241 @@
+/*
+ Copyright 2019 by Charles Anthony
+
+ All rights reserved.
+
+ This software is made available under the terms of the
+ ICU License -- ICU 1.8.1 and later.
+ See the LICENSE file at the top-level directory of this distribution and
+ at https://sourceforge.net/p/dps8m/code/ci/master/tree/LICENSE
+ */
+
+// Decode a binary instruction trace written by the emulator's btrace
+// command.
+//
+//   btrace [-c cpu] tracefile [system_book]
+//
+// Each instruction is listed with its CPU, instruction count, PPR,
+// disassembly, CA and final address, and the registers it changed.
+// Given a system book, addresses are also shown as segment:component.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "dps8.h"
+#include "dps8_opcodetable.h"
+#include "dps8_book.h"
+#include "dps8_btrace.h"
+
+struct cpu_state
+  {
+    bool synced;
+    unsigned long long count;
+    uint64 regs [BT_NREGS];
+  };
+
+static struct cpu_state cpu_states [N_CPU_UNITS_MAX];
+static bool have_book = false;
+
+static void print_reg (uint r, uint64 v)
+  {
+    if (r == BT_REG_A)
+      printf (" A=%012llo", (unsigned long long) v);
+    else if (r == BT_REG_Q)
+      printf (" Q=%012llo", (unsigned long long) v);
+    else if (r == BT_REG_E)
+      printf (" E=%03llo", (unsigned long long) v);
+    else if (r < BT_REG_IR)
+      printf (" X%u=%06llo", r - BT_REG_X0, (unsigned long long) v);
+    else if (r == BT_REG_IR)
+      printf (" IR=%06llo", (unsigned long long) v);
+    else
+      printf (" PR%u=%05llo:%06llo(%02llo)R%llo", r - BT_REG_PR0,
+              (unsigned long long) (v >> 27) & 077777,
+              (unsigned long long) v & 0777777,
+              (unsigned long long) (v >> 18) & 077,
+              (unsigned long long) (v >> 24) & 07);
+  }
+
+// Decode one record; returns its length, or 0 if it is malformed
+
+static size_t decode (uint cpu_idx, const uint8 * p, size_t left)
+  {
+    const size_t fixed = 2 * sizeof (uint64) + sizeof (uint32);
+    if (left < fixed)
+      return 0;
+    uint64 w0, w1;
+    uint32 mask;
+    memcpy (& w0, p, sizeof (w0));
+    memcpy (& w1, p + 8, sizeof (w1));
+    memcpy (& mask, p + 16, sizeof (mask));
+    size_t len = fixed;
+
+    struct cpu_state * s = cpu_states + cpu_idx;
+    if (w0 & BT_SYNC)
+      {
+        if (left < len + sizeof (uint64))
+          return 0;
+        uint64 count;
+        memcpy (& count, p + len, sizeof (count));
+        len += sizeof (count);
+        if (! s->synced || count != s->count + 1)
+          printf ("CPU %c sync at %llu\n", 'A' + cpu_idx,
+                  (unsigned long long) count);
+        s->count = count;
+        s->synced = true;
+      }
+    else
+      s->count ++;
+
+    uint64 vals [BT_NREGS];
+    for (uint r = 0; r < BT_NREGS; r ++)
+      if (mask & (1u << r))
+        {
+          if (left < len + sizeof (uint64))
+            return 0;
+          memcpy (vals + r, p + len, sizeof (uint64));
+          len += sizeof (uint64);
+        }
+
+    // Records before the first sync record are left over from an earlier
+    // trace.
+    if (! s->synced)
+      return len;
+
+    word36 iwb = w0 & BT_W0_IWB_MASK;
+    uint ic = (w0 >> BT_W0_IC_SHIFT) & 0777777;
+    uint prr = (w0 >> BT_W0_PRR_SHIFT) & 07;
+    uint psr = w1 & BT_W1_PSR_MASK;
+    uint ca = (w1 >> BT_W1_CA_SHIFT) & 0777777;
+    uint fa = (w1 >> BT_W1_FA_SHIFT) & 077777777;
+
+    char dis [132];
+    disassemble (dis, iwb);
+    if (w0 & BT_ABS)
+      printf ("%c %10llu abs%s  %06o  %012llo %-24s CA %06o FA %08o",
+              'A' + cpu_idx, s->count, w0 & BT_BAR ? "/bar" : "    ",
+              ic, (unsigned long long) iwb, dis, ca, fa);
+    else
+      printf ("%c %10llu R%o %05o:%06o %012llo %-24s CA %06o FA %08o",
+              'A' + cpu_idx, s->count, prr, psr, ic,
+              (unsigned long long) iwb, dis, ca, fa);
+    if (w0 & BT_FAULT)
+      printf (" FAULT %llu", (unsigned long long) (w1 >> BT_W1_FLT_SHIFT) & 037);
+    for (uint r = 0; r < BT_NREGS; r ++)
+      if (mask & (1u << r))
+        {
+          if ((w0 & BT_SYNC) || vals[r] != s->regs[r])
+            print_reg (r, vals[r]);
+          s->regs[r] = vals[r];
+        }
+    if (have_book && ! (w0 & BT_ABS))
+      {
+        char * where = book_lookup_address (psr, ic, NULL, NULL);
+        if (where)
+          printf ("  %s", where);
+      }
+    printf ("\n");
+    return len;
+  }
+
+static void usage (void)
+  {
+    fprintf (stderr, "usage: btrace [-c cpu] tracefile [system_book]\n");
+    exit (1);
+  }
+
+int main (int argc, char * argv [])
+  {
+    int only = -1;
+    int c;
+    while ((c = getopt (argc, argv, "c:")) != -1)
+      {
+        if (c != 'c')
+          usage ();
+        only = optarg[0] >= 'a' ? optarg[0] - 'a' :
+               optarg[0] >= 'A' ? optarg[0] - 'A' : atoi (optarg);
+        if (only < 0 || only >= N_CPU_UNITS_MAX)
+          usage ();
+      }
+    if (optind >= argc || argc - optind > 2)
+      usage ();
+
+    FILE * fp = fopen (argv[optind], "rb");
+    if (! fp)
+      {
+        perror (argv[optind]);
+        return 1;
+      }
+    if (argc - optind == 2)
+      {
+        int rc = book_load (argv[optind + 1]);
+        if (rc == BOOK_OPEN_ERR)
+          {
+            perror (argv[optind + 1]);
+            return 1;
+          }
+        if (rc == BOOK_FULL)
+          fprintf (stderr, "%s: too many entries; some ignored\n",
+                   argv[optind + 1]);
+        have_book = true;
+      }
+
+    struct btrace_hdr hdr;
+    if (fread (& hdr, sizeof (hdr), 1, fp) != 1 ||
+        memcmp (hdr.magic, BTRACE_MAGIC, sizeof (hdr.magic)) != 0)
+      {
+        fprintf (stderr, "%s is not a btrace file\n", argv[optind]);
+        return 1;
+      }
+    if (hdr.version != BTRACE_VERSION || hdr.nregs != BT_NREGS)
+      {
+        fprintf (stderr, "%s is btrace version %u; expected %u\n",
+                 argv[optind], hdr.version, BTRACE_VERSION);
+        return 1;
+      }
+
+    uint8 * buf = NULL;
+    size_t bufsz = 0;
+    struct btrace_blk blk;
+    while (fread (& blk, sizeof (blk), 1, fp) == 1)
+      {
+        if (blk.cpu_idx >= N_CPU_UNITS_MAX)
+          {
+            fprintf (stderr, "bad block header\n");
+            return 1;
+          }
+        if (blk.len > bufsz)
+          {
+            bufsz = blk.len;
+            buf = realloc (buf, bufsz);
+            if (! buf)
+              {
+                fprintf (stderr, "out of memory\n");
+                return 1;
+              }
+          }
+        if (fread (buf, 1, blk.len, fp) != blk.len)
+          {
+            fprintf (stderr, "truncated block\n");
+            return 1;
+          }
+        if (only >= 0 && (int) blk.cpu_idx != only)
+          continue;
+        size_t off = 0;
+        while (off < blk.len)
+          {
+            size_t n = decode (blk.cpu_idx, buf + off, blk.len - off);
+            if (! n)
+              {
+                fprintf (stderr, "bad record\n");
+                return 1;
+              }
+            off += n;
+          }
+      }
+    free (buf);
+    fclose (fp);
+    return 0;
+  }
@@ -0,0 +1,281 @@
+/*
+ Copyright 2019 by Charles Anthony
+
+ All rights reserved.
+
+ This software is made available under the terms of the
+ ICU License -- ICU 1.8.1 and later.
+ See the LICENSE file at the top-level directory of this distribution and
+ at https://sourceforge.net/p/dps8m/code/ci/master/tree/LICENSE
+ */
+
+// Time the word72 arithmetic of mpy, div, dvf and dufm and of the 72 bit
+// mantissa shifts, done the way those instructions do it.
+//
+//   math128bench [iterations]
+//
+// The Makefile builds this twice: math128bench with the compiler's
+// __int128 and math128bench128 with -DNEED_128 and the helpers in
+// dps8_math128.h, so the two can be compared on one host. Both builds
+// work on the same operands and must print the same checksums.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "dps8.h"
+#include "dps8_math.h"
+
+#define N_OPS 4096
+
+static word36 opA [N_OPS];
+static word36 opQ [N_OPS];
+static word36 opY0 [N_OPS];
+static word36 opY1 [N_OPS];
+static uint opN [N_OPS];
+
+static uint64 rng_state = 0x72;
+
+static uint64 rng (void)
+  {
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1DULL;
+  }
+
+// A 36 bit word of random length, sign extended half the time
+
+static word36 rand36 (void)
+  {
+    uint len = (uint) (rng () % 37);
+    word36 mask = len ? (MASK36 >> (36 - len)) : 0;
+    word36 w = rng () & mask;
+    if (rng () & 1)
+      w |= MASK36 & ~ mask;
+    return w;
+  }
+
+#ifdef NEED_128
+static word72 join72 (word36 even, word36 odd)
+  {
+    return or_128 (lshift_128 (construct_128 (0, even), 36),
+                   construct_128 (0, odd));
+  }
+
+static uint64 sum72 (word72 w)
+  {
+    return w.h + w.l;
+  }
+#else
+static word72 join72 (word36 even, word36 odd)
+  {
+    return ((word72) even << 36) | odd;
+  }
+
+static uint64 sum72 (word72 w)
+  {
+    return (uint64) (w >> 64) + (uint64) w;
+  }
+#endif
+
+// C(Q) * C(Y) -> C(AQ)
+
+static uint64 bench_mpy (uint iter)
+  {
+    uint64 sum = 0;
+    for (uint i = 0; i < N_OPS; i ++)
+      {
+        word36 q = opQ [(i + iter) % N_OPS];
+        word36 y = opY0 [i];
+#ifdef NEED_128
+        int128 prod = multiply_s128 (SIGNEXT36_128 (q), SIGNEXT36_128 (y));
+        sum += sum72 (and_128 (cast_128 (prod), MASK72));
+#else
+        __int128_t prod = (__int128_t) SIGNEXT36_64 (q) *
+                          (__int128_t) SIGNEXT36_64 (y);
+        sum += sum72 ((word72) prod & MASK72);
+#endif
+      }
+    return sum;
+  }
+
+// C(Q) / C(Y): quotient and remainder
+
+static uint64 bench_div (uint iter)
+  {
+    uint64 sum = 0;
+    for (uint i = 0; i < N_OPS; i ++)
+      {
+        word36 q = opQ [(i + iter) % N_OPS];
+        word36 y = opY0 [i];
+        if (y == 0 || (q == MAXNEG && (y == 1 || y == NEG136)))
+          continue;
+        t_int64 dividend = SIGNEXT36_64 (q);
+        t_int64 divisor = SIGNEXT36_64 (y);
+        sum += (uint64) (dividend / divisor) + (uint64) (dividend % divisor);
+      }
+    return sum;
+  }
+
+// C(AQ) / C(Y): the 70 bit fraction by the 35 bit divisor
+
+static uint64 bench_dvf (uint iter)
+  {
+    uint64 sum = 0;
+    for (uint i = 0; i < N_OPS; i ++)
+      {
+        word36 a = opA [(i + iter) % N_OPS];
+        word36 q = opQ [i];
+        word36 y = opY0 [i];
+#ifdef NEED_128
+        uint128 zFrac = lshift_128 (construct_128 (0, a & MASK35), 35);
+        zFrac = or_128 (zFrac, construct_128 (0, (q >> 1) & MASK35));
+        if (a & SIGN36)
+          zFrac = negate_128 (zFrac);
+        zFrac = and_128 (zFrac, MASK70);
+        uint128 dFrac = construct_128 (0, y & MASK35);
+        if (y & SIGN36)
+          dFrac = negate_128 (dFrac);
+        dFrac = and_128 (dFrac, construct_128 (0, MASK35));
+        if (iszero_128 (dFrac))
+          continue;
+        uint128 remainder;
+        uint128 quot = divide_128 (zFrac, dFrac, & remainder);
+        sum += sum72 (quot) + sum72 (remainder);
+#else
+        uint128 zFrac = ((uint128) (a & MASK35) << 35) | ((q >> 1) & MASK35);
+        if (a & SIGN36)
+          zFrac = ~ zFrac + 1;
+        zFrac &= MASK70;
+        uint128 dFrac = y & MASK35;
+        if (y & SIGN36)
+          dFrac = ~ dFrac + 1;
+        dFrac &= MASK35;
+        if (dFrac == 0)
+          continue;
+        sum += sum72 (zFrac / dFrac) + sum72 (zFrac % dFrac);
+#endif
+      }
+    return sum;
+  }
+
+// C(AQ) * C(Y-pair)8,71: the 72 by 64 bit signed product
+
+static uint64 bench_dufm (uint iter)
+  {
+    uint64 sum = 0;
+    for (uint i = 0; i < N_OPS; i ++)
+      {
+        word72 m1 = join72 (opA [(i + iter) % N_OPS], opQ [i]);
+#ifdef NEED_128
+        word72 m2 = or_128 (
+          lshift_128 (construct_128 (0, opY0 [i] & MASK28), 44u),
+          lshift_128 (construct_128 (0, opY1 [i]), 8u));
+        int128 m2s = rshift_s128 (SIGNEXT72_128 (m2), 8);
+        int128 m1l = and_s128 (cast_s128 (m1), construct_128 (0, MASK64));
+        int128 m1h = rshift_s128 (SIGNEXT72_128 (m1), 64);
+        int128 m3h = multiply_s128 (m1h, m2s);
+        int128 m3l = multiply_s128 (m1l, m2s);
+        m3l = rshift_s128 (m3l, 63);
+        m3h = lshift_s128 (m3h, 1);
+        sum += sum72 (and_128 (add_128 (cast_128 (m3h), cast_128 (m3l)),
+                               MASK72));
+#else
+        word72 m2 = ((word72) (opY0 [i] & MASK28)) << 44;
+        m2 |= (word72) opY1 [i] << 8;
+        int128 m2s = SIGNEXT72_128 (m2) >> 8;
+        int128 m1l = m1 & (((uint128) 1 << 64) - 1);
+        int128 m1h = SIGNEXT72_128 (m1) >> 64;
+        int128 m3h = m1h * m2s;
+        int128 m3l = m1l * m2s;
+        m3l >>= 63;
+        m3h <<= 1;
+        sum += sum72 (((word72) (m3h + m3l)) & MASK72);
+#endif
+      }
+    return sum;
+  }
+
+// The sign extending alignment shift of ufa/fcmp and the normalizing
+// left shift of fno
+
+static uint64 bench_shift72 (uint iter)
+  {
+    uint64 sum = 0;
+    for (uint i = 0; i < N_OPS; i ++)
+      {
+        word72 m = join72 (opA [(i + iter) % N_OPS], opQ [i]);
+        uint n = opN [i];
+#ifdef NEED_128
+        word72 r = and_128 (cast_128 (rshift_s128 (SIGNEXT72_128 (m), n)),
+                            MASK72);
+        word72 l = and_128 (lshift_128 (m, n), MASK72);
+#else
+        word1 lost = 0;
+        word72 r = shiftRight72 (m, (int) n, & lost);
+        word72 l = (m << n) & MASK72;
+#endif
+        sum += sum72 (r) + sum72 (l);
+      }
+    return sum;
+  }
+
+static const struct
+  {
+    const char * name;
+    uint64 (* fn) (uint iter);
+  } benches [] =
+  {
+    { "mpy",     bench_mpy },
+    { "div",     bench_div },
+    { "dvf",     bench_dvf },
+    { "dufm",    bench_dufm },
+    { "shift72", bench_shift72 },
+  };
+
+static double now (void)
+  {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, & ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1.0e9;
+  }
+
+int main (int argc, char * argv [])
+  {
+    if (argc > 2)
+      {
+        fprintf (stderr, "usage: math128bench [iterations]\n");
+        return 2;
+      }
+    uint iterations = argc == 2 ? (uint) strtoul (argv[1], NULL, 0) : 2000;
+    if (iterations == 0)
+      iterations = 1;
+
+    for (uint i = 0; i < N_OPS; i ++)
+      {
+        opA [i] = rand36 ();
+        opQ [i] = rand36 ();
+        opY0 [i] = rand36 ();
+        opY1 [i] = rand36 ();
+        opN [i] = (uint) (rng () % 72);
+      }
+
+#ifdef NEED_128
+    printf ("NEED_128 helpers, %u x %u operations\n", iterations, N_OPS);
+#else
+    printf ("native __int128, %u x %u operations\n", iterations, N_OPS);
+#endif
+    for (uint b = 0; b < sizeof (benches) / sizeof (benches [0]); b ++)
+      {
+        uint64 sum = 0;
+        double t0 = now ();
+        for (uint it = 0; it < iterations; it ++)
+          sum += benches [b].fn (it);
+        double ns = (now () - t0) * 1.0e9 / ((double) iterations * N_OPS);
+        printf ("%-8s %8.2f ns/op  checksum %016llx\n", benches [b].name,
+                ns, (unsigned long long) sum);
+      }
+    return 0;
+  }
@@ -0,0 +1,248 @@
+/*
+ Copyright 2019 by Charles Anthony
+
+ All rights reserved.
+
+ This software is made available under the terms of the
+ ICU License -- ICU 1.8.1 and later.
+ See the LICENSE file at the top-level directory of this distribution and
+ at https://sourceforge.net/p/dps8m/code/ci/master/tree/LICENSE
+ */
+
+// Check the one step mantissa shifts in dps8_math.h (shiftRight72,
+// normalizeShift72 and divideShift72) against the bit and digit at a time
+// loops they replaced in the floating point instructions.
+//
+//   shift72test [seed]
+//
+// Runs about 62,000 random and edge cases and exits non-zero if any
+// result differs.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "dps8.h"
+#include "dps8_math.h"
+
+#ifdef NEED_128
+int main (void)
+  {
+    printf ("shift72test: the shift helpers are not built with NEED_128\n");
+    return 0;
+  }
+#else
+
+#define N_SHIFT  20000
+#define N_NORM   10000
+#define N_DIVIDE 11000
+
+// Bits 1-4 of AQ, as HEX_NORM in dps8_math.c
+#define NORM4 (BIT71 | BIT70 | BIT69 | BIT68)
+
+static uint64 rng_state;
+
+static uint64 rng (void)
+  {
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1DULL;
+  }
+
+// A 72 bit value of random length, sign extended half the time
+
+static word72 rand72 (void)
+  {
+    uint len = (uint) (rng () % 73);
+    word72 m = (((word72) rng ()) << 64 | rng ()) & MASK72;
+    word72 mask = len ? (MASK72 >> (72 - len)) : 0;
+    m &= mask;
+    if (rng () & 1)
+      m |= MASK72 & ~ mask;
+    return m;
+  }
+
+static const word72 edges [] =
+  {
+    0, 1, 2, 3, 15, 16, 17, MASK36, (word72) 1 << 36, (word72) UINT64_MAX,
+    (word72) 1 << 64, MASK71, MASK72, SIGN72, SIGN72 | 1, BIT71, BIT68,
+    SIGN72 | BIT71, MASK72 & ~ (word72) 1, MASK72 & ~ BIT68
+  };
+#define N_EDGES (sizeof (edges) / sizeof (edges [0]))
+
+static word72 pick72 (uint i)
+  {
+    return i < N_EDGES ? edges [i] : rand72 ();
+  }
+
+// The alignment loop from ufa, fcmp, fcmg, dufa, dfcmp and dfcmg
+
+static word72 oldShiftRight72 (word72 m, int n, word1 * lost)
+  {
+    bool sign = m & SIGN72;
+    for (int i = 0; i < n; i ++)
+      {
+        * lost |= m & 1;
+        m >>= 1;
+        if (sign)
+          m |= SIGN72;
+      }
+    return m;
+  }
+
+// The normalization loops from fno
+
+static int oldNormalizeShift72 (word72 m, uint step)
+  {
+    bool s = (m & SIGN72) != 0;
+    int n = 0;
+    if (step == 4)
+      {
+        if (s)
+          while ((m & NORM4) == NORM4)
+            {
+              m <<= 4;
+              n ++;
+            }
+        else
+          while ((m & NORM4) == 0)
+            {
+              m <<= 4;
+              n ++;
+            }
+      }
+    else
+      while (s == !! (m & BIT71))
+        {
+          m <<= 1;
+          n ++;
+        }
+    return n;
+  }
+
+// The dividend pre-shift from fdv, fdi, dfdv and dfdi
+
+static int oldDivideShift72 (word72 m1, word72 m2, uint step)
+  {
+    int n = 0;
+    while (m1 >= m2)
+      {
+        m1 >>= step;
+        n ++;
+      }
+    return n;
+  }
+
+static void show72 (const char * tag, word72 m)
+  {
+    printf (" %s %012llo%012llo", tag,
+            (unsigned long long) ((m >> 36) & MASK36),
+            (unsigned long long) (m & MASK36));
+  }
+
+static uint testShiftRight72 (void)
+  {
+    uint bad = 0;
+    for (uint i = 0; i < N_SHIFT; i ++)
+      {
+        word72 m = pick72 (i % (N_EDGES * 2));
+        // Mostly in range, with some of the long alignments of extreme
+        // exponents
+        int n = (rng () & 7) ? (int) (rng () % 80) - 2 :
+                               (int) (rng () % 1100);
+        word1 lost0 = (word1) (rng () & 1);
+        word1 lostOld = lost0, lostNew = lost0;
+        word72 old = oldShiftRight72 (m, n, & lostOld);
+        word72 new = shiftRight72 (m, n, & lostNew);
+        if (old != new || lostOld != lostNew)
+          {
+            if (bad ++ < 10)
+              {
+                printf ("shiftRight72 n %d lost %u", n, lost0);
+                show72 ("m", m);
+                show72 ("old", old);
+                show72 ("new", new);
+                printf (" lost %u/%u\n", lostOld, lostNew);
+              }
+          }
+      }
+    printf ("shiftRight72: %u cases, %u mismatches\n", N_SHIFT, bad);
+    return bad;
+  }
+
+static uint testNormalizeShift72 (uint step)
+  {
+    uint bad = 0;
+    for (uint i = 0; i < N_NORM; i ++)
+      {
+        word72 m = pick72 (i);
+        // fno has already dealt with a zero mantissa
+        if (m == 0)
+          m = 1;
+        int old = oldNormalizeShift72 (m, step);
+        int new = normalizeShift72 (m, step);
+        if (old != new)
+          {
+            if (bad ++ < 10)
+              {
+                printf ("normalizeShift72 step %u", step);
+                show72 ("m", m);
+                printf (" old %d new %d\n", old, new);
+              }
+          }
+      }
+    printf ("normalizeShift72 step %u: %u cases, %u mismatches\n",
+            step, N_NORM, bad);
+    return bad;
+  }
+
+static uint testDivideShift72 (uint step)
+  {
+    uint bad = 0;
+    for (uint i = 0; i < N_DIVIDE; i ++)
+      {
+        // Magnitudes: a 72 bit dividend and a 36 (single) or 72 (double)
+        // bit divisor
+        word72 m1 = pick72 (i % (N_EDGES * 2)) & MASK71;
+        word72 m2 = rand72 () & ((rng () & 1) ? MASK36 << 36 : MASK71);
+        if (m2 == 0)
+          m2 = (word72) 1 << (rng () % 71);
+        int old = oldDivideShift72 (m1, m2, step);
+        int new = divideShift72 (m1, m2, step);
+        if (old != new)
+          {
+            if (bad ++ < 10)
+              {
+                printf ("divideShift72 step %u", step);
+                show72 ("m1", m1);
+                show72 ("m2", m2);
+                printf (" old %d new %d\n", old, new);
+              }
+          }
+      }
+    printf ("divideShift72 step %u: %u cases, %u mismatches\n",
+            step, N_DIVIDE, bad);
+    return bad;
+  }
+
+int main (int argc, char * argv [])
+  {
+    if (argc > 2)
+      {
+        fprintf (stderr, "usage: shift72test [seed]\n");
+        return 2;
+      }
+    rng_state = argc == 2 ? strtoull (argv[1], NULL, 0) : 0x72;
+    if (rng_state == 0)
+      rng_state = 1;
+
+    uint bad = testShiftRight72 ();
+    bad += testNormalizeShift72 (1);
+    bad += testNormalizeShift72 (4);
+    bad += testDivideShift72 (1);
+    bad += testDivideShift72 (4);
+    return bad ? 1 : 0;
+  }
+#endif